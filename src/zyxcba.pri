@@ -2,17 +2,73 @@ INCLUDEPATH+=$$PWD
 
 HEADERS += \
     $$PWD/zyxcba/zvariant.h \
+    $$PWD/zyxcba/zvariantserializer.h \
+    $$PWD/zyxcba/zvariantview.h \
+    $$PWD/zyxcba/zstringview.h \
+    $$PWD/zyxcba/zsnapshot.h \
     $$PWD/zyxcba/ztype.h \
+    $$PWD/zyxcba/zarena.h \
+    $$PWD/zyxcba/zvector.h \
+    $$PWD/zyxcba/zhashmap.h \
+    $$PWD/zyxcba/ztrace.h \
+    $$PWD/zyxcba/zcpu.h \
+    $$PWD/zyxcba/zhash.h \
+    $$PWD/zyxcba/zchecksum.h \
+    $$PWD/zyxcba/zendian.h \
     $$PWD/zyxcba/zendianutility.h \
-    $$PWD/zyxcba/znestedmap.h
+    $$PWD/zyxcba/zbulkbyteswap.h \
+    $$PWD/zyxcba/zvarint.h \
+    $$PWD/zyxcba/zbytereader.h \
+    $$PWD/zyxcba/zbytewriter.h \
+    $$PWD/zyxcba/zbufferchain.h \
+    $$PWD/zyxcba/zradixtree.h \
+    $$PWD/zyxcba/znestedmap.h \
+    $$PWD/zyxcba/zepoch.h \
+    $$PWD/zyxcba/zconcurrentnestedmap.h \
+    $$PWD/zyxcba/zpersistentnestedmap.h
 
 SOURCES += \
     $$PWD/zyxcba/zvariant.cpp \
+    $$PWD/zyxcba/zvariantview.cpp \
+    $$PWD/zyxcba/zsnapshot.cpp \
+    $$PWD/zyxcba/ztrace.cpp \
+    $$PWD/zyxcba/zarena.cpp \
+    $$PWD/zyxcba/zcpu.cpp \
+    $$PWD/zyxcba/zhash.cpp \
+    $$PWD/zyxcba/zchecksum.cpp \
     $$PWD/zyxcba/zendianutility.cpp \
-    $$PWD/zyxcba/znestedmap.cpp
+    $$PWD/zyxcba/zbulkbyteswap.cpp \
+    $$PWD/zyxcba/zvarint.cpp \
+    $$PWD/zyxcba/zbufferchain.cpp \
+    $$PWD/zyxcba/zradixtree.cpp \
+    $$PWD/zyxcba/znestedmap.cpp \
+    $$PWD/zyxcba/zepoch.cpp \
+    $$PWD/zyxcba/zconcurrentnestedmap.cpp \
+    $$PWD/zyxcba/zpersistentnestedmap.cpp
 
 HEADERS += \
     $$PWD/ZType \
+    $$PWD/ZArena \
+    $$PWD/ZVector \
+    $$PWD/ZHashMap \
+    $$PWD/ZTrace \
     $$PWD/ZVariant \
+    $$PWD/ZVariantSerializer \
+    $$PWD/ZVariantView \
+    $$PWD/ZStringView \
+    $$PWD/ZSnapshot \
+    $$PWD/ZCpu \
+    $$PWD/ZHash \
+    $$PWD/ZChecksum \
+    $$PWD/ZEndian \
     $$PWD/ZEndianUtility \
-    $$PWD/ZNestedMap
+    $$PWD/ZBulkByteSwap \
+    $$PWD/ZVarint \
+    $$PWD/ZByteReader \
+    $$PWD/ZByteWriter \
+    $$PWD/ZBufferChain \
+    $$PWD/ZRadixTree \
+    $$PWD/ZNestedMap \
+    $$PWD/ZEpoch \
+    $$PWD/ZConcurrentNestedMap \
+    $$PWD/ZPersistentNestedMap
@@ -0,0 +1,162 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "zarena.h"
+
+#include <cstring>
+
+namespace zyxcba {
+
+const std::size_t ZArena::DefaultChunkSize;
+const std::size_t ZArena::MaxChunkSize;
+const std::size_t ZArena::Alignment;
+
+namespace {
+
+thread_local ZArena *t_currentArena = nullptr;
+
+}
+
+ZArena::ZArena(const std::size_t &chunkSize):
+    m_chunks(nullptr),
+    m_cursor(nullptr),
+    m_end(nullptr),
+    m_last(nullptr),
+    m_chunkSize(chunkSize ? chunkSize : DefaultChunkSize),
+    m_bytesUsed(0)
+{
+
+}
+
+ZArena::~ZArena()
+{
+    Chunk *chunk = this->m_chunks;
+    while(chunk != nullptr)
+    {
+        Chunk *next = chunk->next;
+        std::free(chunk);
+        chunk = next;
+    }
+}
+
+void *ZArena::allocateSlow(std::size_t size)
+{
+    /* chunks double up to MaxChunkSize, oversized requests get a chunk of their own */
+    std::size_t chunkSize = this->m_chunkSize;
+    while(chunkSize < size + ZArena::headerSize()) chunkSize *= 2;
+    if(this->m_chunkSize < MaxChunkSize) this->m_chunkSize *= 2;
+
+    Chunk *chunk = static_cast<Chunk*>(std::malloc(chunkSize));
+    if(chunk == nullptr) throw std::bad_alloc();
+    chunk->next = this->m_chunks;
+    chunk->size = chunkSize;
+    this->m_chunks = chunk;
+
+    this->m_cursor = reinterpret_cast<char*>(chunk) + ZArena::headerSize();
+    this->m_end = reinterpret_cast<char*>(chunk) + chunkSize;
+
+    this->m_last = this->m_cursor;
+    this->m_cursor += size;
+    this->m_bytesUsed += size;
+    return this->m_last;
+}
+
+void *ZArena::reallocate(void *pointer, std::size_t oldSize, std::size_t newSize)
+{
+    if(pointer == nullptr) return this->allocate(newSize);
+
+    oldSize = ZArena::alignUp(oldSize ? oldSize : 1);
+    newSize = ZArena::alignUp(newSize ? newSize : 1);
+
+    /* the most recent allocation grows or shrinks in place while the chunk has room */
+    if(pointer == this->m_last && static_cast<std::size_t>(this->m_end - this->m_last) >= newSize)
+    {
+        this->m_cursor = this->m_last + newSize;
+        this->m_bytesUsed = this->m_bytesUsed - oldSize + newSize;
+        return pointer;
+    }
+
+    if(newSize <= oldSize) return pointer;
+
+    void *data = this->allocate(newSize);
+    std::memcpy(data, pointer, oldSize);
+    return data;
+}
+
+void ZArena::reset()
+{
+    if(this->m_chunks == nullptr) return;
+
+    /* keep the newest chunk, it is the largest, so a steady workload stops calling malloc */
+    Chunk *chunk = this->m_chunks->next;
+    while(chunk != nullptr)
+    {
+        Chunk *next = chunk->next;
+        std::free(chunk);
+        chunk = next;
+    }
+
+    this->m_chunks->next = nullptr;
+    this->m_cursor = reinterpret_cast<char*>(this->m_chunks) + ZArena::headerSize();
+    this->m_end = reinterpret_cast<char*>(this->m_chunks) + this->m_chunks->size;
+    this->m_last = nullptr;
+    this->m_bytesUsed = 0;
+}
+
+std::size_t ZArena::bytesUsed() const
+{
+    return this->m_bytesUsed;
+}
+
+std::size_t ZArena::bytesReserved() const
+{
+    std::size_t total = 0;
+    for(Chunk *chunk = this->m_chunks; chunk != nullptr; chunk = chunk->next) total += chunk->size;
+    return total;
+}
+
+ZArena *ZArena::current()
+{
+    return t_currentArena;
+}
+
+ZArenaScope::ZArenaScope(ZArena &arena):
+    m_previous(t_currentArena)
+{
+    t_currentArena = &arena;
+}
+
+ZArenaScope::~ZArenaScope()
+{
+    t_currentArena = this->m_previous;
+}
+
+}
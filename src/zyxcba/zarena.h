@@ -0,0 +1,242 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ZARENA_H
+#define ZARENA_H
+
+#include <new>
+#include <cstdlib>
+#include <cstddef>
+#include <type_traits>
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZArena class
+///
+/// ZArena is a monotonic bump pointer allocator. Memory is carved out of large chunks and is
+/// only given back as a whole by reset() or the destructor, which makes both allocation and
+/// release nearly free. Freeing the most recent allocation rewinds the cursor, and growing it
+/// happens in place when the chunk has room. An arena must only be used by one thread at a time.
+///
+/// Everything allocated from an arena must be destroyed before the arena is reset.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZArena
+{
+public:
+    static const std::size_t DefaultChunkSize = 64 * 1024;
+    static const std::size_t MaxChunkSize = 4 * 1024 * 1024;
+    static const std::size_t Alignment = alignof(std::max_align_t);
+
+    explicit ZArena(const std::size_t &chunkSize = DefaultChunkSize);
+    ~ZArena();
+
+    ZArena(const ZArena &) = delete;
+    ZArena &operator=(const ZArena &) = delete;
+
+    void *allocate(std::size_t size);
+    void deallocate(void *pointer, std::size_t size);
+    void *reallocate(void *pointer, std::size_t oldSize, std::size_t newSize);
+
+    void reset();
+
+    std::size_t bytesUsed() const;
+    std::size_t bytesReserved() const;
+
+    /* the arena new ZVariant payloads are allocated from on the calling thread, or nullptr */
+    static ZArena *current();
+
+private:
+    friend class ZArenaScope;
+
+    struct Chunk
+    {
+        Chunk *next;
+        std::size_t size;
+    };
+
+    static std::size_t alignUp(std::size_t size)
+    {
+        return (size + Alignment - 1) & ~(Alignment - 1);
+    }
+
+    static std::size_t headerSize()
+    {
+        return ZArena::alignUp(sizeof(Chunk));
+    }
+
+    void *allocateSlow(std::size_t size);
+
+    Chunk *m_chunks;
+    char *m_cursor;
+    char *m_end;
+    char *m_last;
+    std::size_t m_chunkSize;
+    std::size_t m_bytesUsed;
+};
+
+inline void *ZArena::allocate(std::size_t size)
+{
+    size = ZArena::alignUp(size ? size : 1);
+    if(static_cast<std::size_t>(this->m_end - this->m_cursor) < size) return this->allocateSlow(size);
+
+    this->m_last = this->m_cursor;
+    this->m_cursor += size;
+    this->m_bytesUsed += size;
+    return this->m_last;
+}
+
+inline void ZArena::deallocate(void *pointer, std::size_t size)
+{
+    /* only the most recent allocation can be handed back */
+    if(pointer != nullptr && pointer == this->m_last)
+    {
+        size = ZArena::alignUp(size ? size : 1);
+        this->m_cursor = this->m_last;
+        this->m_bytesUsed -= size;
+        this->m_last = nullptr;
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZArenaScope class
+///
+/// ZArenaScope makes an arena current on the calling thread for its lifetime. Every ZVariant
+/// string or container created inside the scope allocates from that arena. Scopes nest.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZArenaScope
+{
+public:
+    explicit ZArenaScope(ZArena &arena);
+    ~ZArenaScope();
+
+    ZArenaScope(const ZArenaScope &) = delete;
+    ZArenaScope &operator=(const ZArenaScope &) = delete;
+
+private:
+    ZArena *m_previous;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZArenaAllocator class
+///
+/// ZArenaAllocator allocates from an arena, or from the heap with malloc when it has none.
+/// Containers keep the allocator they were created with: it is not propagated on assignment,
+/// and copies pick up the arena current on the copying thread.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+class ZArenaAllocator
+{
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::false_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    template<typename U>
+    struct rebind
+    {
+        typedef ZArenaAllocator<U> other;
+    };
+
+    ZArenaAllocator() noexcept:
+        m_arena(nullptr)
+    {
+
+    }
+
+    explicit ZArenaAllocator(ZArena *arena) noexcept:
+        m_arena(arena)
+    {
+
+    }
+
+    template<typename U>
+    ZArenaAllocator(const ZArenaAllocator<U> &other) noexcept:
+        m_arena(other.arena())
+    {
+
+    }
+
+    ZArena *arena() const { return this->m_arena; }
+
+    T *allocate(std::size_t count)
+    {
+        static_assert(alignof(T) <= ZArena::Alignment, "ZArenaAllocator does not support over-aligned types");
+
+        if(this->m_arena) return static_cast<T*>(this->m_arena->allocate(count * sizeof(T)));
+
+        void *pointer = std::malloc(count * sizeof(T));
+        if(pointer == nullptr) throw std::bad_alloc();
+        return static_cast<T*>(pointer);
+    }
+
+    void deallocate(T *pointer, std::size_t count)
+    {
+        if(this->m_arena) this->m_arena->deallocate(pointer, count * sizeof(T));
+        else std::free(pointer);
+    }
+
+    /* only valid for trivially relocatable T, the contents are moved with a bulk copy */
+    T *reallocate(T *pointer, std::size_t oldCount, std::size_t newCount)
+    {
+        if(this->m_arena)
+        {
+            return static_cast<T*>(this->m_arena->reallocate(pointer, oldCount * sizeof(T), newCount * sizeof(T)));
+        }
+
+        void *data = std::realloc(static_cast<void*>(pointer), newCount * sizeof(T));
+        if(data == nullptr) throw std::bad_alloc();
+        return static_cast<T*>(data);
+    }
+
+    ZArenaAllocator select_on_container_copy_construction() const
+    {
+        return ZArenaAllocator(ZArena::current());
+    }
+
+    template<typename U>
+    bool operator==(const ZArenaAllocator<U> &other) const { return this->m_arena == other.arena(); }
+
+    template<typename U>
+    bool operator!=(const ZArenaAllocator<U> &other) const { return this->m_arena != other.arena(); }
+
+private:
+    ZArena *m_arena;
+};
+
+}
+
+#endif // ZARENA_H
@@ -0,0 +1,327 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "zbufferchain.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace zyxcba {
+
+namespace {
+
+/* large enough for any scalar or varint written through reserve */
+const std::size_t MinimumSegmentSize = 64;
+
+/* segments passed to one writev call, well below the IOV_MAX of every supported system */
+const std::size_t WriteBatch = 256;
+
+}
+
+const std::size_t ZBufferPool::DefaultSegmentSize;
+const std::size_t ZBufferPool::DefaultMaxCachedSegments;
+
+ZBufferPool::ZBufferPool(const std::size_t &segmentSize, const std::size_t &maxCachedSegments):
+    m_segmentSize(std::max(segmentSize, MinimumSegmentSize)),
+    m_maxCachedSegments(maxCachedSegments)
+{
+
+}
+
+ZBufferPool::~ZBufferPool()
+{
+    this->trim();
+}
+
+char *ZBufferPool::acquire()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        if(!this->m_free.empty())
+        {
+            char *segment = this->m_free.back();
+            this->m_free.pop_back();
+            return segment;
+        }
+    }
+
+    char *segment = static_cast<char*>(std::malloc(this->m_segmentSize));
+    if(segment == nullptr) throw std::bad_alloc();
+    return segment;
+}
+
+void ZBufferPool::release(char *segment)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        if(this->m_free.size() < this->m_maxCachedSegments)
+        {
+            this->m_free.push_back(segment);
+            return;
+        }
+    }
+    std::free(segment);
+}
+
+void ZBufferPool::trim()
+{
+    std::vector<char*> segments;
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        segments.swap(this->m_free);
+    }
+
+    for(char *segment : segments)
+    {
+        std::free(segment);
+    }
+}
+
+std::size_t ZBufferPool::segmentSize() const
+{
+    return this->m_segmentSize;
+}
+
+std::size_t ZBufferPool::cachedSegments() const
+{
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    return this->m_free.size();
+}
+
+ZBufferPool &ZBufferPool::global()
+{
+    static ZBufferPool pool;
+    return pool;
+}
+
+ZBufferChain::ZBufferChain(ZBufferPool &pool):
+    m_pool(&pool),
+    m_current(nullptr),
+    m_end(nullptr)
+{
+
+}
+
+ZBufferChain::~ZBufferChain()
+{
+    this->clear();
+}
+
+ZBufferChain::ZBufferChain(ZBufferChain &&other) noexcept:
+    m_pool(other.m_pool),
+    m_segments(std::move(other.m_segments)),
+    m_current(other.m_current),
+    m_end(other.m_end)
+{
+    other.m_segments.clear();
+    other.m_current = nullptr;
+    other.m_end = nullptr;
+}
+
+ZBufferChain &ZBufferChain::operator=(ZBufferChain &&other) noexcept
+{
+    if(this != &other)
+    {
+        this->clear();
+        this->m_pool = other.m_pool;
+        this->m_segments = std::move(other.m_segments);
+        this->m_current = other.m_current;
+        this->m_end = other.m_end;
+
+        other.m_segments.clear();
+        other.m_current = nullptr;
+        other.m_end = nullptr;
+    }
+    return *this;
+}
+
+std::size_t ZBufferChain::size() const
+{
+    std::size_t size = 0;
+    for(std::size_t index = 0; index < this->m_segments.size(); ++index)
+    {
+        size += this->segment(index).size;
+    }
+    return size;
+}
+
+bool ZBufferChain::empty() const
+{
+    return this->size() == 0;
+}
+
+std::size_t ZBufferChain::segmentCount() const
+{
+    return this->m_segments.size();
+}
+
+ZBufferSegment ZBufferChain::segment(const std::size_t &index) const
+{
+    const ZSegmentEntry &entry = this->m_segments[index];
+
+    /* the size of the open segment is only known from the write position */
+    ZBufferSegment segment;
+    segment.data = entry.data;
+    segment.size = index + 1 == this->m_segments.size() ? static_cast<std::size_t>(this->m_current - entry.data) : entry.size;
+    return segment;
+}
+
+bool ZBufferChain::writeTo(const int &fileDescriptor) const
+{
+    const std::size_t count = this->segmentCount();
+
+#ifdef _WIN32
+    for(std::size_t index = 0; index < count; ++index)
+    {
+        const ZBufferSegment part = this->segment(index);
+        std::size_t offset = 0;
+        while(offset < part.size)
+        {
+            const int written = ::_write(fileDescriptor, part.data + offset, static_cast<unsigned>(part.size - offset));
+            if(written <= 0) return false;
+            offset += static_cast<std::size_t>(written);
+        }
+    }
+    return true;
+#else
+    std::size_t index = 0;
+    std::size_t offset = 0;
+    struct iovec vectors[WriteBatch];
+
+    while(index < count)
+    {
+        std::size_t filled = this->toIovec(vectors, WriteBatch, index);
+        vectors[0].iov_base = static_cast<char*>(vectors[0].iov_base) + offset;
+        vectors[0].iov_len -= offset;
+
+        ssize_t written = ::writev(fileDescriptor, vectors, static_cast<int>(filled));
+        if(written < 0)
+        {
+            if(errno == EINTR) continue;
+            return false;
+        }
+
+        /* a short write resumes inside the segment it stopped in */
+        std::size_t left = static_cast<std::size_t>(written);
+        while(index < count)
+        {
+            const std::size_t rest = this->segment(index).size - offset;
+            if(left < rest)
+            {
+                offset += left;
+                break;
+            }
+            left -= rest;
+            offset = 0;
+            ++index;
+        }
+    }
+    return true;
+#endif
+}
+
+std::string ZBufferChain::toString() const
+{
+    std::string result;
+    result.reserve(this->size());
+    for(std::size_t index = 0; index < this->segmentCount(); ++index)
+    {
+        const ZBufferSegment part = this->segment(index);
+        result.append(part.data, part.size);
+    }
+    return result;
+}
+
+void ZBufferChain::clear()
+{
+    for(const ZSegmentEntry &entry : this->m_segments)
+    {
+        this->m_pool->release(entry.data);
+    }
+    this->m_segments.clear();
+    this->m_current = nullptr;
+    this->m_end = nullptr;
+}
+
+void ZBufferChain::appendSlow(const char *data, std::size_t size)
+{
+    while(size != 0)
+    {
+        if(this->m_current == this->m_end) this->startSegment();
+
+        const std::size_t part = std::min(size, static_cast<std::size_t>(this->m_end - this->m_current));
+        std::memcpy(this->m_current, data, part);
+        this->m_current += part;
+        data += part;
+        size -= part;
+    }
+}
+
+char *ZBufferChain::reserveSlow(const std::size_t &size)
+{
+    if(size > this->m_pool->segmentSize()) return nullptr;
+
+    this->startSegment();
+    return this->m_current;
+}
+
+void ZBufferChain::startSegment()
+{
+    this->closeSegment();
+
+    ZSegmentEntry entry;
+    entry.data = this->m_pool->acquire();
+    entry.size = 0;
+    this->m_segments.push_back(entry);
+
+    this->m_current = entry.data;
+    this->m_end = entry.data + this->m_pool->segmentSize();
+}
+
+void ZBufferChain::closeSegment()
+{
+    if(this->m_segments.empty()) return;
+
+    ZSegmentEntry &entry = this->m_segments.back();
+    entry.size = static_cast<std::size_t>(this->m_current - entry.data);
+}
+
+}
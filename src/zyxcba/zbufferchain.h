@@ -0,0 +1,218 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef ZBUFFERCHAIN_H
+#define ZBUFFERCHAIN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "zendian.h"
+#include "zvarint.h"
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZBufferPool class
+///
+/// ZBufferPool hands out fixed size segments and keeps released ones for reuse, up to a
+/// limit. Acquiring and releasing is thread safe.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZBufferPool
+{
+public:
+    static const std::size_t DefaultSegmentSize = 64 * 1024;
+    static const std::size_t DefaultMaxCachedSegments = 256;
+
+    explicit ZBufferPool(const std::size_t &segmentSize = DefaultSegmentSize,
+                         const std::size_t &maxCachedSegments = DefaultMaxCachedSegments);
+    ~ZBufferPool();
+
+    ZBufferPool(const ZBufferPool &) = delete;
+    ZBufferPool &operator=(const ZBufferPool &) = delete;
+
+    char *acquire();
+    void release(char *segment);
+
+    /* frees the cached segments */
+    void trim();
+
+    std::size_t segmentSize() const;
+    std::size_t cachedSegments() const;
+
+    static ZBufferPool &global();
+
+private:
+    std::size_t m_segmentSize;
+    std::size_t m_maxCachedSegments;
+    std::vector<char*> m_free;
+    mutable std::mutex m_mutex;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZBufferSegment struct
+///
+/// One filled segment of a ZBufferChain.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct ZBufferSegment
+{
+    const char *data;
+    std::size_t size;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZBufferChain class
+///
+/// ZBufferChain collects output in a list of pooled segments instead of one growing string, so
+/// appending never moves what was written before. It is a ZVariantSerializer sink, and the
+/// segments can be exported as iovecs and written with writev without joining them first.
+///
+/// reserve() and commit() give direct access to the free space of the current segment for the
+/// encoders which write through a char pointer:
+///
+///     chain.commit(utility.toBECS(value, chain.reserve(8)));
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZBufferChain
+{
+public:
+    explicit ZBufferChain(ZBufferPool &pool = ZBufferPool::global());
+    ~ZBufferChain();
+
+    ZBufferChain(ZBufferChain &&other) noexcept;
+    ZBufferChain &operator=(ZBufferChain &&other) noexcept;
+
+    ZBufferChain(const ZBufferChain &) = delete;
+    ZBufferChain &operator=(const ZBufferChain &) = delete;
+
+    void append(const char *data, const std::size_t &size)
+    {
+        if(size <= static_cast<std::size_t>(this->m_end - this->m_current))
+        {
+            if(size != 0) std::memcpy(this->m_current, data, size);
+            this->m_current += size;
+            return;
+        }
+        this->appendSlow(data, size);
+    }
+
+    /* returns size contiguous bytes of free space, nullptr when size exceeds the segment size */
+    char *reserve(const std::size_t &size)
+    {
+        if(size <= static_cast<std::size_t>(this->m_end - this->m_current)) return this->m_current;
+        return this->reserveSlow(size);
+    }
+
+    /* marks the reserved space up to end as written */
+    void commit(const char *end)
+    {
+        this->m_current = const_cast<char*>(end);
+    }
+
+    template<typename T>
+    void appendBigEndian(const T &value)
+    {
+        char *data = this->reserve(sizeof(T));
+        store_be(data, value);
+        this->commit(data + sizeof(T));
+    }
+
+    template<typename T>
+    void appendLittleEndian(const T &value)
+    {
+        char *data = this->reserve(sizeof(T));
+        store_le(data, value);
+        this->commit(data + sizeof(T));
+    }
+
+    void appendVarint(const std::uint64_t &value)
+    {
+        this->commit(ZVarint::encodeVarint(value, this->reserve(ZVarint::MaxVarintSize)));
+    }
+
+    std::size_t size() const;
+    bool empty() const;
+
+    std::size_t segmentCount() const;
+    ZBufferSegment segment(const std::size_t &index) const;
+
+    /* fills up to count iovec like structures with iov_base and iov_len members, starting at
+     * segment first, and returns how many were filled
+     */
+    template<typename IoVec>
+    std::size_t toIovec(IoVec *vectors, const std::size_t &count, const std::size_t &first = 0) const
+    {
+        std::size_t filled = 0;
+        for(std::size_t index = first; index < this->segmentCount() && filled < count; ++index)
+        {
+            const ZBufferSegment part = this->segment(index);
+            vectors[filled].iov_base = const_cast<char*>(part.data);
+            vectors[filled].iov_len = part.size;
+            ++filled;
+        }
+        return filled;
+    }
+
+    /* writes every segment to a file descriptor, with writev where available */
+    bool writeTo(const int &fileDescriptor) const;
+
+    std::string toString() const;
+
+    /* returns the segments to the pool */
+    void clear();
+
+private:
+    struct ZSegmentEntry
+    {
+        char *data;
+        std::size_t size;
+    };
+
+    void appendSlow(const char *data, std::size_t size);
+    char *reserveSlow(const std::size_t &size);
+    void startSegment();
+    void closeSegment();
+
+    ZBufferPool *m_pool;
+    std::vector<ZSegmentEntry> m_segments;
+    char *m_current;
+    char *m_end;
+};
+
+}
+
+#endif // ZBUFFERCHAIN_H
@@ -0,0 +1,586 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "zbulkbyteswap.h"
+#include "zcpu.h"
+#include "zendian.h"
+
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define ZYXCBA_BULKBYTESWAP_X86 1
+#include <immintrin.h>
+#endif
+
+namespace zyxcba {
+
+namespace {
+
+typedef void (*ZByteSwapFunction)(unsigned char *destination, const unsigned char *source, std::size_t count);
+
+template<std::size_t Size>
+struct ZUnsigned;
+
+template<>
+struct ZUnsigned<2>
+{
+    typedef std::uint16_t type;
+};
+
+template<>
+struct ZUnsigned<4>
+{
+    typedef std::uint32_t type;
+};
+
+template<>
+struct ZUnsigned<8>
+{
+    typedef std::uint64_t type;
+};
+
+template<std::size_t Size>
+void swapScalar(unsigned char *destination, const unsigned char *source, std::size_t count)
+{
+    typedef typename ZUnsigned<Size>::type T;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        T value;
+        std::memcpy(&value, source + i * Size, Size);
+        value = byte_swap(value);
+        std::memcpy(destination + i * Size, &value, Size);
+    }
+}
+
+/* 128 bit elements swap and exchange their two halves, which does not need a 128 bit type */
+template<>
+void swapScalar<16>(unsigned char *destination, const unsigned char *source, std::size_t count)
+{
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        std::uint64_t low;
+        std::uint64_t high;
+        std::memcpy(&low, source + i * 16, 8);
+        std::memcpy(&high, source + i * 16 + 8, 8);
+        low = byte_swap(low);
+        high = byte_swap(high);
+        std::memcpy(destination + i * 16, &high, 8);
+        std::memcpy(destination + i * 16 + 8, &low, 8);
+    }
+}
+
+#ifdef ZYXCBA_BULKBYTESWAP_X86
+
+/* pshufb control reversing every group of Size bytes, pshufb works on 16 byte lanes so the
+ * pattern repeats in every lane of the 256 and 512 bit kernels
+ */
+#define ZYXCBA_SWAP_INDEX(i) static_cast<unsigned char>(((i) / Size) * Size + Size - 1 - (i) % Size)
+#define ZYXCBA_SWAP_LANE \
+    ZYXCBA_SWAP_INDEX(0), ZYXCBA_SWAP_INDEX(1), ZYXCBA_SWAP_INDEX(2), ZYXCBA_SWAP_INDEX(3), \
+    ZYXCBA_SWAP_INDEX(4), ZYXCBA_SWAP_INDEX(5), ZYXCBA_SWAP_INDEX(6), ZYXCBA_SWAP_INDEX(7), \
+    ZYXCBA_SWAP_INDEX(8), ZYXCBA_SWAP_INDEX(9), ZYXCBA_SWAP_INDEX(10), ZYXCBA_SWAP_INDEX(11), \
+    ZYXCBA_SWAP_INDEX(12), ZYXCBA_SWAP_INDEX(13), ZYXCBA_SWAP_INDEX(14), ZYXCBA_SWAP_INDEX(15)
+
+template<std::size_t Size>
+struct ZSwapMask
+{
+    static const unsigned char bytes[64];
+};
+
+template<std::size_t Size>
+const unsigned char ZSwapMask<Size>::bytes[64] = {
+    ZYXCBA_SWAP_LANE, ZYXCBA_SWAP_LANE, ZYXCBA_SWAP_LANE, ZYXCBA_SWAP_LANE
+};
+
+#undef ZYXCBA_SWAP_LANE
+#undef ZYXCBA_SWAP_INDEX
+
+template<std::size_t Size>
+__attribute__((target("ssse3")))
+void swapSSSE3(unsigned char *destination, const unsigned char *source, std::size_t count)
+{
+    const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ZSwapMask<Size>::bytes));
+    const std::size_t bytes = count * Size;
+    std::size_t i = 0;
+    for(; i + 16 <= bytes; i += 16)
+    {
+        const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_shuffle_epi8(value, mask));
+    }
+    swapScalar<Size>(destination + i, source + i, (bytes - i) / Size);
+}
+
+template<std::size_t Size>
+__attribute__((target("avx2")))
+void swapAVX2(unsigned char *destination, const unsigned char *source, std::size_t count)
+{
+    const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ZSwapMask<Size>::bytes));
+    const std::size_t bytes = count * Size;
+    std::size_t i = 0;
+    for(; i + 64 <= bytes; i += 64)
+    {
+        const __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+        const __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i + 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_shuffle_epi8(first, mask));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i + 32), _mm256_shuffle_epi8(second, mask));
+    }
+    for(; i + 32 <= bytes; i += 32)
+    {
+        const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_shuffle_epi8(value, mask));
+    }
+    swapScalar<Size>(destination + i, source + i, (bytes - i) / Size);
+}
+
+template<std::size_t Size>
+__attribute__((target("avx512f,avx512bw")))
+void swapAVX512(unsigned char *destination, const unsigned char *source, std::size_t count)
+{
+    const __m512i mask = _mm512_loadu_si512(reinterpret_cast<const void*>(ZSwapMask<Size>::bytes));
+    const std::size_t bytes = count * Size;
+    std::size_t i = 0;
+    for(; i + 64 <= bytes; i += 64)
+    {
+        const __m512i value = _mm512_loadu_si512(reinterpret_cast<const void*>(source + i));
+        _mm512_storeu_si512(reinterpret_cast<void*>(destination + i), _mm512_shuffle_epi8(value, mask));
+    }
+
+    /* the tail is a single masked load and store */
+    const std::size_t rest = bytes - i;
+    if(rest != 0)
+    {
+        const __mmask64 tail = (~static_cast<__mmask64>(0)) >> (64 - rest);
+        const __m512i value = _mm512_maskz_loadu_epi8(tail, reinterpret_cast<const void*>(source + i));
+        _mm512_mask_storeu_epi8(reinterpret_cast<void*>(destination + i), tail, _mm512_shuffle_epi8(value, mask));
+    }
+}
+
+#endif
+
+struct ZKernelTable
+{
+    ZByteSwapFunction swap16;
+    ZByteSwapFunction swap32;
+    ZByteSwapFunction swap64;
+    ZByteSwapFunction swap128;
+};
+
+const ZKernelTable g_kernels[static_cast<std::size_t>(ZByteSwapKernel::KernelCount)] = {
+    { &swapScalar<2>, &swapScalar<4>, &swapScalar<8>, &swapScalar<16> },
+#ifdef ZYXCBA_BULKBYTESWAP_X86
+    { &swapSSSE3<2>, &swapSSSE3<4>, &swapSSSE3<8>, &swapSSSE3<16> },
+    { &swapAVX2<2>, &swapAVX2<4>, &swapAVX2<8>, &swapAVX2<16> },
+    { &swapAVX512<2>, &swapAVX512<4>, &swapAVX512<8>, &swapAVX512<16> }
+#else
+    { nullptr, nullptr, nullptr, nullptr },
+    { nullptr, nullptr, nullptr, nullptr },
+    { nullptr, nullptr, nullptr, nullptr }
+#endif
+};
+
+ZByteSwapFunction kernelFunction(const ZKernelTable &table, const std::size_t &elementSize)
+{
+    switch(elementSize)
+    {
+    case 2: return table.swap16;
+    case 4: return table.swap32;
+    case 8: return table.swap64;
+    case 16: return table.swap128;
+    default: return nullptr;
+    }
+}
+
+/* the cpu level each kernel needs */
+ZCpuLevel kernelLevel(const ZByteSwapKernel &kernel)
+{
+    switch(kernel)
+    {
+    case ZByteSwapKernel::SSSE3: return ZCpuLevel::SSSE3;
+    case ZByteSwapKernel::AVX2: return ZCpuLevel::AVX2;
+    case ZByteSwapKernel::AVX512: return ZCpuLevel::AVX512;
+    default: return ZCpuLevel::Scalar;
+    }
+}
+
+/* resolved once, function local statics are initialized thread safely */
+const ZKernelTable &activeTable()
+{
+    static const ZKernelTable *table = ZCpuDispatch<const ZKernelTable*>(&g_kernels[0])
+#ifdef ZYXCBA_BULKBYTESWAP_X86
+            .add(ZCpuLevel::SSSE3, &g_kernels[static_cast<std::size_t>(ZByteSwapKernel::SSSE3)])
+            .add(ZCpuLevel::AVX2, &g_kernels[static_cast<std::size_t>(ZByteSwapKernel::AVX2)])
+            .add(ZCpuLevel::AVX512, &g_kernels[static_cast<std::size_t>(ZByteSwapKernel::AVX512)])
+#endif
+            .resolve();
+    return *table;
+}
+
+template<typename T>
+void swapArray(void *destination, const void *source, const std::size_t &count)
+{
+    kernelFunction(activeTable(), sizeof(T))(static_cast<unsigned char*>(destination), static_cast<const unsigned char*>(source), count);
+}
+
+/* arrays already in the requested byte order are copied, empty arrays may come as nullptr */
+template<typename T>
+void convertArray(void *destination, const void *source, const std::size_t &count, const bool &swapBytes)
+{
+    if(swapBytes) swapArray<T>(destination, source, count);
+    else if(count != 0) std::memmove(destination, source, count * sizeof(T));
+}
+
+}
+
+void ZBulkByteSwap::swap(std::uint16_t *destination, const std::uint16_t *source, const std::size_t &count)
+{
+    swapArray<std::uint16_t>(destination, source, count);
+}
+
+void ZBulkByteSwap::swap(std::uint32_t *destination, const std::uint32_t *source, const std::size_t &count)
+{
+    swapArray<std::uint32_t>(destination, source, count);
+}
+
+void ZBulkByteSwap::swap(std::uint64_t *destination, const std::uint64_t *source, const std::size_t &count)
+{
+    swapArray<std::uint64_t>(destination, source, count);
+}
+
+void ZBulkByteSwap::swap(std::int16_t *destination, const std::int16_t *source, const std::size_t &count)
+{
+    swapArray<std::int16_t>(destination, source, count);
+}
+
+void ZBulkByteSwap::swap(std::int32_t *destination, const std::int32_t *source, const std::size_t &count)
+{
+    swapArray<std::int32_t>(destination, source, count);
+}
+
+void ZBulkByteSwap::swap(std::int64_t *destination, const std::int64_t *source, const std::size_t &count)
+{
+    swapArray<std::int64_t>(destination, source, count);
+}
+
+void ZBulkByteSwap::swap(std::uint16_t *data, const std::size_t &count)
+{
+    swapArray<std::uint16_t>(data, data, count);
+}
+
+void ZBulkByteSwap::swap(std::uint32_t *data, const std::size_t &count)
+{
+    swapArray<std::uint32_t>(data, data, count);
+}
+
+void ZBulkByteSwap::swap(std::uint64_t *data, const std::size_t &count)
+{
+    swapArray<std::uint64_t>(data, data, count);
+}
+
+void ZBulkByteSwap::swap(std::int16_t *data, const std::size_t &count)
+{
+    swapArray<std::int16_t>(data, data, count);
+}
+
+void ZBulkByteSwap::swap(std::int32_t *data, const std::size_t &count)
+{
+    swapArray<std::int32_t>(data, data, count);
+}
+
+void ZBulkByteSwap::swap(std::int64_t *data, const std::size_t &count)
+{
+    swapArray<std::int64_t>(data, data, count);
+}
+
+void ZBulkByteSwap::loadBigEndian(std::uint16_t *destination, const void *source, const std::size_t &count)
+{
+    convertArray<std::uint16_t>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::loadBigEndian(std::uint32_t *destination, const void *source, const std::size_t &count)
+{
+    convertArray<std::uint32_t>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::loadBigEndian(std::uint64_t *destination, const void *source, const std::size_t &count)
+{
+    convertArray<std::uint64_t>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::loadBigEndian(std::int16_t *destination, const void *source, const std::size_t &count)
+{
+    convertArray<std::int16_t>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::loadBigEndian(std::int32_t *destination, const void *source, const std::size_t &count)
+{
+    convertArray<std::int32_t>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::loadBigEndian(std::int64_t *destination, const void *source, const std::size_t &count)
+{
+    convertArray<std::int64_t>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::loadBigEndian(float *destination, const void *source, const std::size_t &count)
+{
+    convertArray<float>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::loadBigEndian(double *destination, const void *source, const std::size_t &count)
+{
+    convertArray<double>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::loadLittleEndian(std::uint16_t *destination, const void *source, const std::size_t &count)
+{
+    convertArray<std::uint16_t>(destination, source, count, isBigEndianHost());
+}
+
+void ZBulkByteSwap::loadLittleEndian(std::uint32_t *destination, const void *source, const std::size_t &count)
+{
+    convertArray<std::uint32_t>(destination, source, count, isBigEndianHost());
+}
+
+void ZBulkByteSwap::loadLittleEndian(std::uint64_t *destination, const void *source, const std::size_t &count)
+{
+    convertArray<std::uint64_t>(destination, source, count, isBigEndianHost());
+}
+
+void ZBulkByteSwap::loadLittleEndian(std::int16_t *destination, const void *source, const std::size_t &count)
+{
+    convertArray<std::int16_t>(destination, source, count, isBigEndianHost());
+}
+
+void ZBulkByteSwap::loadLittleEndian(std::int32_t *destination, const void *source, const std::size_t &count)
+{
+    convertArray<std::int32_t>(destination, source, count, isBigEndianHost());
+}
+
+void ZBulkByteSwap::loadLittleEndian(std::int64_t *destination, const void *source, const std::size_t &count)
+{
+    convertArray<std::int64_t>(destination, source, count, isBigEndianHost());
+}
+
+void ZBulkByteSwap::loadLittleEndian(float *destination, const void *source, const std::size_t &count)
+{
+    convertArray<float>(destination, source, count, isBigEndianHost());
+}
+
+void ZBulkByteSwap::loadLittleEndian(double *destination, const void *source, const std::size_t &count)
+{
+    convertArray<double>(destination, source, count, isBigEndianHost());
+}
+
+void ZBulkByteSwap::storeBigEndian(void *destination, const std::uint16_t *source, const std::size_t &count)
+{
+    convertArray<std::uint16_t>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::storeBigEndian(void *destination, const std::uint32_t *source, const std::size_t &count)
+{
+    convertArray<std::uint32_t>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::storeBigEndian(void *destination, const std::uint64_t *source, const std::size_t &count)
+{
+    convertArray<std::uint64_t>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::storeBigEndian(void *destination, const std::int16_t *source, const std::size_t &count)
+{
+    convertArray<std::int16_t>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::storeBigEndian(void *destination, const std::int32_t *source, const std::size_t &count)
+{
+    convertArray<std::int32_t>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::storeBigEndian(void *destination, const std::int64_t *source, const std::size_t &count)
+{
+    convertArray<std::int64_t>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::storeBigEndian(void *destination, const float *source, const std::size_t &count)
+{
+    convertArray<float>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::storeBigEndian(void *destination, const double *source, const std::size_t &count)
+{
+    convertArray<double>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::storeLittleEndian(void *destination, const std::uint16_t *source, const std::size_t &count)
+{
+    convertArray<std::uint16_t>(destination, source, count, isBigEndianHost());
+}
+
+void ZBulkByteSwap::storeLittleEndian(void *destination, const std::uint32_t *source, const std::size_t &count)
+{
+    convertArray<std::uint32_t>(destination, source, count, isBigEndianHost());
+}
+
+void ZBulkByteSwap::storeLittleEndian(void *destination, const std::uint64_t *source, const std::size_t &count)
+{
+    convertArray<std::uint64_t>(destination, source, count, isBigEndianHost());
+}
+
+void ZBulkByteSwap::storeLittleEndian(void *destination, const std::int16_t *source, const std::size_t &count)
+{
+    convertArray<std::int16_t>(destination, source, count, isBigEndianHost());
+}
+
+void ZBulkByteSwap::storeLittleEndian(void *destination, const std::int32_t *source, const std::size_t &count)
+{
+    convertArray<std::int32_t>(destination, source, count, isBigEndianHost());
+}
+
+void ZBulkByteSwap::storeLittleEndian(void *destination, const std::int64_t *source, const std::size_t &count)
+{
+    convertArray<std::int64_t>(destination, source, count, isBigEndianHost());
+}
+
+void ZBulkByteSwap::storeLittleEndian(void *destination, const float *source, const std::size_t &count)
+{
+    convertArray<float>(destination, source, count, isBigEndianHost());
+}
+
+void ZBulkByteSwap::storeLittleEndian(void *destination, const double *source, const std::size_t &count)
+{
+    convertArray<double>(destination, source, count, isBigEndianHost());
+}
+
+#ifdef ZYXCBA_HAS_INT128
+void ZBulkByteSwap::swap(zint128 *destination, const zint128 *source, const std::size_t &count)
+{
+    swapArray<zint128>(destination, source, count);
+}
+
+void ZBulkByteSwap::swap(zuint128 *destination, const zuint128 *source, const std::size_t &count)
+{
+    swapArray<zuint128>(destination, source, count);
+}
+
+void ZBulkByteSwap::swap(zint128 *data, const std::size_t &count)
+{
+    swapArray<zint128>(data, data, count);
+}
+
+void ZBulkByteSwap::swap(zuint128 *data, const std::size_t &count)
+{
+    swapArray<zuint128>(data, data, count);
+}
+
+void ZBulkByteSwap::loadBigEndian(zint128 *destination, const void *source, const std::size_t &count)
+{
+    convertArray<zint128>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::loadBigEndian(zuint128 *destination, const void *source, const std::size_t &count)
+{
+    convertArray<zuint128>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::loadLittleEndian(zint128 *destination, const void *source, const std::size_t &count)
+{
+    convertArray<zint128>(destination, source, count, isBigEndianHost());
+}
+
+void ZBulkByteSwap::loadLittleEndian(zuint128 *destination, const void *source, const std::size_t &count)
+{
+    convertArray<zuint128>(destination, source, count, isBigEndianHost());
+}
+
+void ZBulkByteSwap::storeBigEndian(void *destination, const zint128 *source, const std::size_t &count)
+{
+    convertArray<zint128>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::storeBigEndian(void *destination, const zuint128 *source, const std::size_t &count)
+{
+    convertArray<zuint128>(destination, source, count, isLittleEndianHost());
+}
+
+void ZBulkByteSwap::storeLittleEndian(void *destination, const zint128 *source, const std::size_t &count)
+{
+    convertArray<zint128>(destination, source, count, isBigEndianHost());
+}
+
+void ZBulkByteSwap::storeLittleEndian(void *destination, const zuint128 *source, const std::size_t &count)
+{
+    convertArray<zuint128>(destination, source, count, isBigEndianHost());
+}
+#endif
+
+bool ZBulkByteSwap::swapBytes(const ZByteSwapKernel &kernel,
+                              void *destination,
+                              const void *source,
+                              const std::size_t &count,
+                              const std::size_t &elementSize)
+{
+    if(!ZBulkByteSwap::isSupported(kernel)) return false;
+
+    const ZByteSwapFunction function = kernelFunction(g_kernels[static_cast<std::size_t>(kernel)], elementSize);
+    if(function == nullptr) return false;
+
+    function(static_cast<unsigned char*>(destination), static_cast<const unsigned char*>(source), count);
+    return true;
+}
+
+bool ZBulkByteSwap::isSupported(const ZByteSwapKernel &kernel)
+{
+    if(kernel >= ZByteSwapKernel::KernelCount) return false;
+#ifndef ZYXCBA_BULKBYTESWAP_X86
+    if(kernel != ZByteSwapKernel::Scalar) return false;
+#endif
+    return kernelLevel(kernel) <= ZCpu::detectedLevel();
+}
+
+ZByteSwapKernel ZBulkByteSwap::activeKernel()
+{
+    return static_cast<ZByteSwapKernel>(&activeTable() - g_kernels);
+}
+
+const char *ZBulkByteSwap::kernelName(const ZByteSwapKernel &kernel)
+{
+    switch(kernel)
+    {
+    case ZByteSwapKernel::Scalar: return "scalar";
+    case ZByteSwapKernel::SSSE3: return "ssse3";
+    case ZByteSwapKernel::AVX2: return "avx2";
+    case ZByteSwapKernel::AVX512: return "avx512";
+    default: return "unknown";
+    }
+}
+
+}
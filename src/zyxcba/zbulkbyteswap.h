@@ -0,0 +1,158 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef ZBULKBYTESWAP_H
+#define ZBULKBYTESWAP_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ztype.h"
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZByteSwapKernel enum
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+enum class ZByteSwapKernel : std::uint8_t
+{
+    Scalar,
+    SSSE3,
+    AVX2,
+    AVX512,
+
+    KernelCount
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZBulkByteSwap class
+///
+/// ZBulkByteSwap reverses the bytes of every element of an array of 16, 32, 64 or 128 bit
+/// integers, and converts float and double arrays from and to big or little endian buffers.
+/// On x86 the work is done by pshufb kernels, the widest one ZCpu::level() allows is selected
+/// on first use. Other targets use the scalar kernel. Source and destination may be unaligned and
+/// may be the same array, but must not overlap otherwise.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZBulkByteSwap
+{
+public:
+    static void swap(std::uint16_t *destination, const std::uint16_t *source, const std::size_t &count);
+    static void swap(std::uint32_t *destination, const std::uint32_t *source, const std::size_t &count);
+    static void swap(std::uint64_t *destination, const std::uint64_t *source, const std::size_t &count);
+    static void swap(std::int16_t *destination, const std::int16_t *source, const std::size_t &count);
+    static void swap(std::int32_t *destination, const std::int32_t *source, const std::size_t &count);
+    static void swap(std::int64_t *destination, const std::int64_t *source, const std::size_t &count);
+
+    static void swap(std::uint16_t *data, const std::size_t &count);
+    static void swap(std::uint32_t *data, const std::size_t &count);
+    static void swap(std::uint64_t *data, const std::size_t &count);
+    static void swap(std::int16_t *data, const std::size_t &count);
+    static void swap(std::int32_t *data, const std::size_t &count);
+    static void swap(std::int64_t *data, const std::size_t &count);
+
+    /* convert between native arrays and big or little endian byte buffers */
+    static void loadBigEndian(std::uint16_t *destination, const void *source, const std::size_t &count);
+    static void loadBigEndian(std::uint32_t *destination, const void *source, const std::size_t &count);
+    static void loadBigEndian(std::uint64_t *destination, const void *source, const std::size_t &count);
+    static void loadBigEndian(std::int16_t *destination, const void *source, const std::size_t &count);
+    static void loadBigEndian(std::int32_t *destination, const void *source, const std::size_t &count);
+    static void loadBigEndian(std::int64_t *destination, const void *source, const std::size_t &count);
+    static void loadBigEndian(float *destination, const void *source, const std::size_t &count);
+    static void loadBigEndian(double *destination, const void *source, const std::size_t &count);
+
+    static void loadLittleEndian(std::uint16_t *destination, const void *source, const std::size_t &count);
+    static void loadLittleEndian(std::uint32_t *destination, const void *source, const std::size_t &count);
+    static void loadLittleEndian(std::uint64_t *destination, const void *source, const std::size_t &count);
+    static void loadLittleEndian(std::int16_t *destination, const void *source, const std::size_t &count);
+    static void loadLittleEndian(std::int32_t *destination, const void *source, const std::size_t &count);
+    static void loadLittleEndian(std::int64_t *destination, const void *source, const std::size_t &count);
+    static void loadLittleEndian(float *destination, const void *source, const std::size_t &count);
+    static void loadLittleEndian(double *destination, const void *source, const std::size_t &count);
+
+    static void storeBigEndian(void *destination, const std::uint16_t *source, const std::size_t &count);
+    static void storeBigEndian(void *destination, const std::uint32_t *source, const std::size_t &count);
+    static void storeBigEndian(void *destination, const std::uint64_t *source, const std::size_t &count);
+    static void storeBigEndian(void *destination, const std::int16_t *source, const std::size_t &count);
+    static void storeBigEndian(void *destination, const std::int32_t *source, const std::size_t &count);
+    static void storeBigEndian(void *destination, const std::int64_t *source, const std::size_t &count);
+    static void storeBigEndian(void *destination, const float *source, const std::size_t &count);
+    static void storeBigEndian(void *destination, const double *source, const std::size_t &count);
+
+    static void storeLittleEndian(void *destination, const std::uint16_t *source, const std::size_t &count);
+    static void storeLittleEndian(void *destination, const std::uint32_t *source, const std::size_t &count);
+    static void storeLittleEndian(void *destination, const std::uint64_t *source, const std::size_t &count);
+    static void storeLittleEndian(void *destination, const std::int16_t *source, const std::size_t &count);
+    static void storeLittleEndian(void *destination, const std::int32_t *source, const std::size_t &count);
+    static void storeLittleEndian(void *destination, const std::int64_t *source, const std::size_t &count);
+    static void storeLittleEndian(void *destination, const float *source, const std::size_t &count);
+    static void storeLittleEndian(void *destination, const double *source, const std::size_t &count);
+
+#ifdef ZYXCBA_HAS_INT128
+    static void swap(zint128 *destination, const zint128 *source, const std::size_t &count);
+    static void swap(zuint128 *destination, const zuint128 *source, const std::size_t &count);
+
+    static void swap(zint128 *data, const std::size_t &count);
+    static void swap(zuint128 *data, const std::size_t &count);
+
+    static void loadBigEndian(zint128 *destination, const void *source, const std::size_t &count);
+    static void loadBigEndian(zuint128 *destination, const void *source, const std::size_t &count);
+
+    static void loadLittleEndian(zint128 *destination, const void *source, const std::size_t &count);
+    static void loadLittleEndian(zuint128 *destination, const void *source, const std::size_t &count);
+
+    static void storeBigEndian(void *destination, const zint128 *source, const std::size_t &count);
+    static void storeBigEndian(void *destination, const zuint128 *source, const std::size_t &count);
+
+    static void storeLittleEndian(void *destination, const zint128 *source, const std::size_t &count);
+    static void storeLittleEndian(void *destination, const zuint128 *source, const std::size_t &count);
+#endif
+
+    /* swaps count elements of elementSize bytes with the given kernel, returns false when the
+     * kernel is not supported by the cpu or elementSize is not 2, 4, 8 or 16
+     */
+    static bool swapBytes(const ZByteSwapKernel &kernel,
+                          void *destination,
+                          const void *source,
+                          const std::size_t &count,
+                          const std::size_t &elementSize);
+
+    /* whether the hardware can run the kernel, regardless of ZYXCBA_CPU_LEVEL */
+    static bool isSupported(const ZByteSwapKernel &kernel);
+    static ZByteSwapKernel activeKernel();
+    static const char *kernelName(const ZByteSwapKernel &kernel);
+};
+
+}
+
+#endif // ZBULKBYTESWAP_H
@@ -0,0 +1,237 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef ZBYTEREADER_H
+#define ZBYTEREADER_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "zendian.h"
+#include "zstringview.h"
+#include "zvarint.h"
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZByteReader class
+///
+/// ZByteReader reads scalars, varints and blobs from a contiguous buffer it does not own. Every
+/// read is bounds checked and returns false when the buffer is exhausted or the encoding is
+/// invalid. The first failure is sticky: the position stays where the failed read started and
+/// every later read fails too, so a sequence of reads can be checked once at its end.
+///
+/// A batch of fixed size fields can be checked with a single ensure() and then read with the
+/// unchecked take functions. Blobs are returned as views into the buffer, nothing allocates.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZByteReader
+{
+public:
+    ZByteReader(): m_begin(nullptr), m_current(nullptr), m_end(nullptr), m_failed(false) {}
+
+    ZByteReader(const void *data, const std::size_t &size):
+        m_begin(static_cast<const char*>(data)),
+        m_current(static_cast<const char*>(data)),
+        m_end(static_cast<const char*>(data) + size),
+        m_failed(false)
+    {
+
+    }
+
+    explicit ZByteReader(const ZStringView &data): ZByteReader(data.data(), data.size()) {}
+
+    bool hasError() const { return this->m_failed; }
+    bool atEnd() const { return this->m_current == this->m_end; }
+
+    std::size_t size() const { return static_cast<std::size_t>(this->m_end - this->m_begin); }
+    std::size_t position() const { return static_cast<std::size_t>(this->m_current - this->m_begin); }
+    std::size_t remaining() const { return static_cast<std::size_t>(this->m_end - this->m_current); }
+    const char *current() const { return this->m_current; }
+
+    /* checks that size more bytes can be read, the take functions may then be used for them */
+    bool ensure(const std::size_t &size)
+    {
+        if(this->m_failed || this->remaining() < size) return this->fail();
+        return true;
+    }
+
+    bool seek(const std::size_t &position)
+    {
+        if(this->m_failed || position > this->size()) return this->fail();
+
+        this->m_current = this->m_begin + position;
+        return true;
+    }
+
+    bool skip(const std::size_t &size)
+    {
+        if(!this->ensure(size)) return false;
+
+        this->m_current += size;
+        return true;
+    }
+
+    template<typename T>
+    bool readBigEndian(T &value)
+    {
+        if(!this->ensure(sizeof(T))) return false;
+
+        value = this->takeBigEndian<T>();
+        return true;
+    }
+
+    template<typename T>
+    bool readLittleEndian(T &value)
+    {
+        if(!this->ensure(sizeof(T))) return false;
+
+        value = this->takeLittleEndian<T>();
+        return true;
+    }
+
+    template<typename T>
+    T takeBigEndian()
+    {
+        assert(this->remaining() >= sizeof(T));
+        const T value = load_be<T>(this->m_current);
+        this->m_current += sizeof(T);
+        return value;
+    }
+
+    template<typename T>
+    T takeLittleEndian()
+    {
+        assert(this->remaining() >= sizeof(T));
+        const T value = load_le<T>(this->m_current);
+        this->m_current += sizeof(T);
+        return value;
+    }
+
+    bool readVarint(std::uint64_t &value)
+    {
+        if(this->m_failed) return false;
+        return this->advance(ZVarint::decodeVarint(this->m_current, this->m_end, value));
+    }
+
+    bool readVarint(std::uint32_t &value)
+    {
+        const char *start = this->m_current;
+        std::uint64_t wide;
+        if(!this->readVarint(wide)) return false;
+        if(wide > 0xffffffffU)
+        {
+            this->m_current = start;
+            return this->fail();
+        }
+
+        value = static_cast<std::uint32_t>(wide);
+        return true;
+    }
+
+    bool readSignedVarint(std::int64_t &value)
+    {
+        if(this->m_failed) return false;
+        return this->advance(ZVarint::decodeSignedVarint(this->m_current, this->m_end, value));
+    }
+
+    bool readPrefixVarint(std::uint64_t &value)
+    {
+        if(this->m_failed) return false;
+        return this->advance(ZVarint::decodePrefixVarint(this->m_current, this->m_end, value));
+    }
+
+    bool readBytes(void *destination, const std::size_t &size)
+    {
+        if(!this->ensure(size)) return false;
+
+        if(size != 0) std::memcpy(destination, this->m_current, size);
+        this->m_current += size;
+        return true;
+    }
+
+    /* the view refers into the buffer */
+    bool readView(ZStringView &view, const std::size_t &size)
+    {
+        if(!this->ensure(size)) return false;
+
+        view = ZStringView(this->m_current, size);
+        this->m_current += size;
+        return true;
+    }
+
+    /* a varint length followed by that many bytes */
+    bool readLengthPrefixed(ZStringView &view)
+    {
+        const char *start = this->m_current;
+        std::uint64_t size;
+        if(!this->readVarint(size)) return false;
+        if(size > this->remaining())
+        {
+            this->m_current = start;
+            return this->fail();
+        }
+
+        view = ZStringView(this->m_current, static_cast<std::size_t>(size));
+        this->m_current += size;
+        return true;
+    }
+
+    /* clears the error, the position is left where the failed read started */
+    void clearError() { this->m_failed = false; }
+
+private:
+    bool fail()
+    {
+        this->m_failed = true;
+        return false;
+    }
+
+    bool advance(const char *next)
+    {
+        if(next == nullptr) return this->fail();
+
+        this->m_current = next;
+        return true;
+    }
+
+    const char *m_begin;
+    const char *m_current;
+    const char *m_end;
+    bool m_failed;
+};
+
+}
+
+#endif // ZBYTEREADER_H
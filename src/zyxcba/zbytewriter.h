@@ -0,0 +1,183 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef ZBYTEWRITER_H
+#define ZBYTEWRITER_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "zendian.h"
+#include "zstringview.h"
+#include "zvarint.h"
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZByteWriter class
+///
+/// ZByteWriter writes scalars, varints and blobs into a caller provided buffer of fixed
+/// capacity, it never allocates. A write which does not fit returns false and writes nothing.
+/// The failure is sticky like in ZByteReader, so a message can be written completely and
+/// checked once. After a successful ensure() the unchecked put functions may be used.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZByteWriter
+{
+public:
+    ZByteWriter(): m_begin(nullptr), m_current(nullptr), m_end(nullptr), m_failed(false) {}
+
+    ZByteWriter(void *data, const std::size_t &capacity):
+        m_begin(static_cast<char*>(data)),
+        m_current(static_cast<char*>(data)),
+        m_end(static_cast<char*>(data) + capacity),
+        m_failed(false)
+    {
+
+    }
+
+    bool hasError() const { return this->m_failed; }
+
+    std::size_t capacity() const { return static_cast<std::size_t>(this->m_end - this->m_begin); }
+    std::size_t position() const { return static_cast<std::size_t>(this->m_current - this->m_begin); }
+    std::size_t remaining() const { return static_cast<std::size_t>(this->m_end - this->m_current); }
+
+    char *data() const { return this->m_begin; }
+    char *current() const { return this->m_current; }
+
+    /* the bytes written so far */
+    ZStringView written() const { return ZStringView(this->m_begin, this->position()); }
+
+    bool ensure(const std::size_t &size)
+    {
+        if(this->m_failed || this->remaining() < size) return this->fail();
+        return true;
+    }
+
+    void reset()
+    {
+        this->m_current = this->m_begin;
+        this->m_failed = false;
+    }
+
+    template<typename T>
+    bool writeBigEndian(const T &value)
+    {
+        if(!this->ensure(sizeof(T))) return false;
+
+        this->putBigEndian(value);
+        return true;
+    }
+
+    template<typename T>
+    bool writeLittleEndian(const T &value)
+    {
+        if(!this->ensure(sizeof(T))) return false;
+
+        this->putLittleEndian(value);
+        return true;
+    }
+
+    template<typename T>
+    void putBigEndian(const T &value)
+    {
+        assert(this->remaining() >= sizeof(T));
+        store_be(this->m_current, value);
+        this->m_current += sizeof(T);
+    }
+
+    template<typename T>
+    void putLittleEndian(const T &value)
+    {
+        assert(this->remaining() >= sizeof(T));
+        store_le(this->m_current, value);
+        this->m_current += sizeof(T);
+    }
+
+    bool writeVarint(const std::uint64_t &value)
+    {
+        if(!this->ensure(ZVarint::varintSize(value))) return false;
+
+        this->m_current = ZVarint::encodeVarint(value, this->m_current);
+        return true;
+    }
+
+    bool writeSignedVarint(const std::int64_t &value)
+    {
+        return this->writeVarint(ZVarint::zigzagEncode(value));
+    }
+
+    bool writePrefixVarint(const std::uint64_t &value)
+    {
+        if(!this->ensure(ZVarint::prefixVarintSize(value))) return false;
+
+        this->m_current = ZVarint::encodePrefixVarint(value, this->m_current);
+        return true;
+    }
+
+    bool writeBytes(const void *data, const std::size_t &size)
+    {
+        if(!this->ensure(size)) return false;
+
+        if(size != 0) std::memcpy(this->m_current, data, size);
+        this->m_current += size;
+        return true;
+    }
+
+    /* a varint length followed by the bytes, written completely or not at all */
+    bool writeLengthPrefixed(const ZStringView &data)
+    {
+        if(!this->ensure(ZVarint::varintSize(data.size()) + data.size())) return false;
+
+        this->m_current = ZVarint::encodeVarint(data.size(), this->m_current);
+        return this->writeBytes(data.data(), data.size());
+    }
+
+    void clearError() { this->m_failed = false; }
+
+private:
+    bool fail()
+    {
+        this->m_failed = true;
+        return false;
+    }
+
+    char *m_begin;
+    char *m_current;
+    char *m_end;
+    bool m_failed;
+};
+
+}
+
+#endif // ZBYTEWRITER_H
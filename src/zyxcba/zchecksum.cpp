@@ -0,0 +1,171 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "zchecksum.h"
+#include "zcpu.h"
+#include "zendian.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define ZYXCBA_CHECKSUM_X86 1
+#include <immintrin.h>
+#endif
+
+namespace zyxcba {
+
+namespace {
+
+const std::uint32_t Crc32cPolynomial = 0x82F63B78U;
+
+typedef std::uint32_t (*ZCrc32cFunction)(std::uint32_t crc, const unsigned char *data, std::size_t size);
+
+struct ZCrc32cTable
+{
+    std::uint32_t entries[8][256];
+
+    ZCrc32cTable()
+    {
+        for(std::uint32_t index = 0; index < 256; ++index)
+        {
+            std::uint32_t crc = index;
+            for(int bit = 0; bit < 8; ++bit)
+            {
+                crc = (crc >> 1) ^ (Crc32cPolynomial & (0U - (crc & 1U)));
+            }
+            this->entries[0][index] = crc;
+        }
+
+        for(std::uint32_t index = 0; index < 256; ++index)
+        {
+            for(std::size_t slice = 1; slice < 8; ++slice)
+            {
+                const std::uint32_t previous = this->entries[slice - 1][index];
+                this->entries[slice][index] = (previous >> 8) ^ this->entries[0][previous & 0xffU];
+            }
+        }
+    }
+};
+
+const ZCrc32cTable &crc32cTable()
+{
+    static const ZCrc32cTable table;
+    return table;
+}
+
+std::uint32_t crc32cSlicing(std::uint32_t crc, const unsigned char *data, std::size_t size)
+{
+    const ZCrc32cTable &table = crc32cTable();
+    while(size >= 8)
+    {
+        const std::uint64_t value = load_le<std::uint64_t>(data) ^ crc;
+        crc = table.entries[7][value & 0xffU] ^ table.entries[6][(value >> 8) & 0xffU]
+                ^ table.entries[5][(value >> 16) & 0xffU] ^ table.entries[4][(value >> 24) & 0xffU]
+                ^ table.entries[3][(value >> 32) & 0xffU] ^ table.entries[2][(value >> 40) & 0xffU]
+                ^ table.entries[1][(value >> 48) & 0xffU] ^ table.entries[0][value >> 56];
+        data += 8;
+        size -= 8;
+    }
+
+    while(size > 0)
+    {
+        crc = (crc >> 8) ^ table.entries[0][(crc ^ *data) & 0xffU];
+        ++data;
+        --size;
+    }
+    return crc;
+}
+
+#ifdef ZYXCBA_CHECKSUM_X86
+
+/* a single dependency chain runs at one crc32 per three cycles, roughly 8 bytes per ns; the
+ * unrolled loop only removes the loop overhead between them
+ */
+__attribute__((target("sse4.2")))
+std::uint32_t crc32cSSE42(std::uint32_t crc, const unsigned char *data, std::size_t size)
+{
+    std::uint64_t state = crc;
+    while(size >= 32)
+    {
+        state = _mm_crc32_u64(state, load_le<std::uint64_t>(data));
+        state = _mm_crc32_u64(state, load_le<std::uint64_t>(data + 8));
+        state = _mm_crc32_u64(state, load_le<std::uint64_t>(data + 16));
+        state = _mm_crc32_u64(state, load_le<std::uint64_t>(data + 24));
+        data += 32;
+        size -= 32;
+    }
+
+    while(size >= 8)
+    {
+        state = _mm_crc32_u64(state, load_le<std::uint64_t>(data));
+        data += 8;
+        size -= 8;
+    }
+
+    crc = static_cast<std::uint32_t>(state);
+    while(size > 0)
+    {
+        crc = _mm_crc32_u8(crc, *data);
+        ++data;
+        --size;
+    }
+    return crc;
+}
+
+#endif
+
+}
+
+std::uint32_t ZChecksum::crc32c(const void *data, const std::size_t &size, const std::uint32_t &crc)
+{
+    static const ZCrc32cFunction function = ZCpuDispatch<ZCrc32cFunction>(&crc32cSlicing)
+#ifdef ZYXCBA_CHECKSUM_X86
+            .add(ZCpuLevel::SSE42, &crc32cSSE42)
+#endif
+            .resolve();
+
+    return ~function(~crc, static_cast<const unsigned char*>(data), size);
+}
+
+std::uint32_t ZChecksum::crc32cScalar(const void *data, const std::size_t &size, const std::uint32_t &crc)
+{
+    return ~crc32cSlicing(~crc, static_cast<const unsigned char*>(data), size);
+}
+
+bool ZChecksum::isCrc32cAccelerated()
+{
+#ifdef ZYXCBA_CHECKSUM_X86
+    return ZCpu::supports(ZCpuLevel::SSE42);
+#else
+    return false;
+#endif
+}
+
+}
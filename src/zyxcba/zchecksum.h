@@ -0,0 +1,65 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef ZCHECKSUM_H
+#define ZCHECKSUM_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZChecksum class
+///
+/// ZChecksum computes CRC32C (Castagnoli, reflected polynomial 0x82F63B78), the checksum used by
+/// iSCSI, ext4 and most storage formats. It uses the SSE4.2 crc32 instruction when the cpu has
+/// it and a slicing-by-8 table walk otherwise; both give the same result.
+///
+/// The value is chainable: crc32c(second, n, crc32c(first, m)) equals the checksum of the
+/// concatenation, so a ZBufferChain can be checked segment by segment.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZChecksum
+{
+public:
+    static std::uint32_t crc32c(const void *data, const std::size_t &size, const std::uint32_t &crc = 0);
+
+    /* always uses the table walk regardless of the cpu */
+    static std::uint32_t crc32cScalar(const void *data, const std::size_t &size, const std::uint32_t &crc = 0);
+
+    static bool isCrc32cAccelerated();
+};
+
+}
+
+#endif // ZCHECKSUM_H
@@ -0,0 +1,565 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "zconcurrentnestedmap.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#include "zepoch.h"
+#include "zhash.h"
+
+namespace zyxcba {
+
+namespace {
+
+const std::size_t NoSlot = std::numeric_limits<std::size_t>::max();
+
+inline const char *segmentEnd(const char *begin, const char *end, const char &separator)
+{
+    const void *found = std::memchr(begin, separator, static_cast<std::size_t>(end - begin));
+    return found ? static_cast<const char*>(found) : end;
+}
+
+inline std::uint64_t segmentHash(const char *key, const std::size_t &keySize)
+{
+    return ZHash::hash64(key, keySize);
+}
+
+bool isValidPath(const ZStringView &path, const char &separator)
+{
+    if(path.empty()) return false;
+
+    const char *begin = path.begin();
+    const char *end = path.end();
+    for(;;)
+    {
+        const char *last = segmentEnd(begin, end, separator);
+        std::size_t size = static_cast<std::size_t>(last - begin);
+        if(size == 0 || size > std::numeric_limits<std::uint32_t>::max()) return false;
+        if(last == end) return true;
+        begin = last + 1;
+    }
+}
+
+/* a node is never resized once published, its table is sized for the children it starts with */
+std::uint32_t capacityFor(const std::size_t &childCount)
+{
+    if(childCount == 0) return 0;
+
+    std::uint32_t capacity = 4;
+    while(childCount * 4 > static_cast<std::size_t>(capacity) * 3) capacity *= 2;
+    return capacity;
+}
+
+}
+
+struct ZConcurrentNestedMap::ZSlot
+{
+    std::uint64_t hash;
+    ZNode *node;
+};
+
+/* one allocation holds the node, its child table and then the segment name */
+struct ZConcurrentNestedMap::ZNode
+{
+    ZNode(): childCount(0), capacity(0), keySize(0), hasValue(false) {}
+
+    ZSlot *slots() { return reinterpret_cast<ZSlot*>(this + 1); }
+    const ZSlot *slots() const { return reinterpret_cast<const ZSlot*>(this + 1); }
+
+    char *key() { return reinterpret_cast<char*>(this->slots() + this->capacity); }
+    const char *key() const { return reinterpret_cast<const char*>(this->slots() + this->capacity); }
+
+    ZVariant value;
+    std::uint32_t childCount;
+    std::uint32_t capacity;
+    std::uint32_t keySize;
+    bool hasValue;
+};
+
+ZConcurrentNestedMap::ZConcurrentNestedMap(const char &separator):
+    m_root(nullptr),
+    m_size(0),
+    m_separator(separator)
+{
+
+}
+
+ZConcurrentNestedMap::~ZConcurrentNestedMap()
+{
+    /* no reader may use a map that is being destroyed, the tree goes right away */
+    ZNode *root = this->m_root.load(std::memory_order_relaxed);
+    if(root) ZConcurrentNestedMap::destroyTree(root);
+    ZEpoch::reclaim();
+}
+
+bool ZConcurrentNestedMap::set(const ZStringView &path, const ZVariant &value)
+{
+    if(!isValidPath(path, this->m_separator)) return false;
+
+    std::lock_guard<std::mutex> lock(this->m_writer);
+    std::vector<ZNode*> replaced;
+    std::vector<ZNode*> created;
+    bool inserted = false;
+    ZNode *root = nullptr;
+    try
+    {
+        root = ZConcurrentNestedMap::assignPath(this->m_root.load(std::memory_order_relaxed), nullptr, 0, path.begin(), path.end(),
+                                                this->m_separator, value, replaced, created, inserted);
+    }
+    catch(...)
+    {
+        /* nothing was published, the copies made so far share their children with the live tree */
+        for(ZNode *node : created) ZConcurrentNestedMap::destroyNode(node);
+        throw;
+    }
+
+    this->publish(root, replaced, nullptr);
+    if(inserted) this->m_size.store(this->m_size.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return true;
+}
+
+bool ZConcurrentNestedMap::erase(const ZStringView &path)
+{
+    if(path.empty()) return false;
+
+    std::lock_guard<std::mutex> lock(this->m_writer);
+
+    /* the nodes from the root down to the one removed, with the slot each hangs in */
+    std::vector<const ZNode*> chain;
+    std::vector<std::size_t> slots;
+    const ZNode *node = this->m_root.load(std::memory_order_relaxed);
+    if(node == nullptr) return false;
+    chain.push_back(node);
+
+    const char *begin = path.begin();
+    const char *end = path.end();
+    for(;;)
+    {
+        const char *last = segmentEnd(begin, end, this->m_separator);
+        std::size_t keySize = static_cast<std::size_t>(last - begin);
+        if(keySize == 0) return false;
+
+        std::size_t slot = ZConcurrentNestedMap::findSlot(node, begin, keySize, segmentHash(begin, keySize));
+        if(slot == NoSlot) return false;
+
+        node = node->slots()[slot].node;
+        chain.push_back(node);
+        slots.push_back(slot);
+        if(last == end) break;
+        begin = last + 1;
+    }
+
+    std::vector<ZNode*> replaced;
+    std::vector<ZNode*> created;
+    ZNode *child = nullptr;
+    try
+    {
+        for(std::size_t level = chain.size() - 1; level-- > 0;)
+        {
+            const ZNode *parent = chain[level];
+            ZNode *copy = nullptr;
+            if(child == nullptr)
+            {
+                /* a level left without a value and without children goes as well */
+                if(!parent->hasValue && parent->childCount == 1)
+                {
+                    replaced.push_back(const_cast<ZNode*>(parent));
+                    continue;
+                }
+
+                copy = ZConcurrentNestedMap::copyNode(parent, parent->childCount - 1);
+                for(std::size_t index = 0; index < parent->capacity; ++index)
+                {
+                    const ZSlot &entry = parent->slots()[index];
+                    if(entry.node && index != slots[level]) ZConcurrentNestedMap::placeChild(copy, entry.hash, entry.node);
+                }
+            }
+            else
+            {
+                /* the same capacity keeps the same layout, the child stays in its slot */
+                copy = ZConcurrentNestedMap::copyNode(parent, parent->childCount);
+                std::memcpy(copy->slots(), parent->slots(), parent->capacity * sizeof(ZSlot));
+                copy->childCount = parent->childCount;
+                copy->slots()[slots[level]].node = child;
+            }
+            created.push_back(copy);
+            replaced.push_back(const_cast<ZNode*>(parent));
+            child = copy;
+        }
+    }
+    catch(...)
+    {
+        for(ZNode *copy : created) ZConcurrentNestedMap::destroyNode(copy);
+        throw;
+    }
+
+    ZNode *removed = const_cast<ZNode*>(chain.back());
+    std::size_t count = ZConcurrentNestedMap::countValues(removed);
+    this->publish(child, replaced, removed);
+    this->m_size.store(this->m_size.load(std::memory_order_relaxed) - count, std::memory_order_relaxed);
+    return true;
+}
+
+void ZConcurrentNestedMap::assign(const ZNestedMap &map)
+{
+    /* the new tree is private until published, it is built in place */
+    ZNode *root = nullptr;
+    const char separator = this->m_separator;
+    try
+    {
+        map.forEach(ZStringView(), [&](const ZStringView &path, const ZVariant &value) {
+            if(isValidPath(path, separator))
+            {
+                ZConcurrentNestedMap::insertPrivate(root, nullptr, 0, path.begin(), path.end(), separator, value);
+            }
+            return true;
+        });
+    }
+    catch(...)
+    {
+        if(root) ZConcurrentNestedMap::destroyTree(root);
+        throw;
+    }
+
+    std::lock_guard<std::mutex> lock(this->m_writer);
+    this->publish(root, std::vector<ZNode*>(), this->m_root.load(std::memory_order_relaxed));
+    this->m_size.store(root ? ZConcurrentNestedMap::countValues(root) : 0, std::memory_order_relaxed);
+}
+
+void ZConcurrentNestedMap::clear()
+{
+    std::lock_guard<std::mutex> lock(this->m_writer);
+    this->publish(nullptr, std::vector<ZNode*>(), this->m_root.load(std::memory_order_relaxed));
+    this->m_size.store(0, std::memory_order_relaxed);
+}
+
+bool ZConcurrentNestedMap::get(const ZStringView &path, ZVariant &value) const
+{
+    ZEpochGuard guard;
+    const ZNode *node = path.empty() ? nullptr : this->findNode(path);
+    if(node == nullptr || !node->hasValue) return false;
+
+    value = node->value;
+    return true;
+}
+
+ZVariant ZConcurrentNestedMap::get(const ZStringView &path, const ZVariant &defaultValue) const
+{
+    ZVariant value;
+    return this->get(path, value) ? value : defaultValue;
+}
+
+bool ZConcurrentNestedMap::contains(const ZStringView &path) const
+{
+    ZEpochGuard guard;
+    const ZNode *node = path.empty() ? nullptr : this->findNode(path);
+    return node && node->hasValue;
+}
+
+bool ZConcurrentNestedMap::read(const ZStringView &path, const ZReader &reader) const
+{
+    ZEpochGuard guard;
+    const ZNode *node = path.empty() ? nullptr : this->findNode(path);
+    if(node == nullptr || !node->hasValue) return false;
+
+    reader(node->value);
+    return true;
+}
+
+bool ZConcurrentNestedMap::forEach(const ZStringView &prefix, const ZVisitor &visitor) const
+{
+    ZEpochGuard guard;
+    const ZNode *node = this->findNode(prefix);
+    if(node == nullptr) return true;
+
+    std::string path(prefix.data(), prefix.size());
+    return ZConcurrentNestedMap::visit(node, path, this->m_separator, visitor);
+}
+
+std::size_t ZConcurrentNestedMap::size() const
+{
+    return this->m_size.load(std::memory_order_relaxed);
+}
+
+bool ZConcurrentNestedMap::empty() const
+{
+    return this->size() == 0;
+}
+
+char ZConcurrentNestedMap::separator() const
+{
+    return this->m_separator;
+}
+
+ZConcurrentNestedMap::ZNode *ZConcurrentNestedMap::createNode(const char *key, const std::size_t &keySize, const std::size_t &childCount)
+{
+    std::uint32_t capacity = capacityFor(childCount);
+    void *memory = std::malloc(sizeof(ZNode) + capacity * sizeof(ZSlot) + keySize);
+    if(memory == nullptr) throw std::bad_alloc();
+
+    ZNode *node = new (memory) ZNode();
+    node->capacity = capacity;
+    node->keySize = static_cast<std::uint32_t>(keySize);
+    if(capacity != 0) std::memset(node->slots(), 0, capacity * sizeof(ZSlot));
+    if(keySize != 0) std::memcpy(node->key(), key, keySize);
+    return node;
+}
+
+ZConcurrentNestedMap::ZNode *ZConcurrentNestedMap::copyNode(const ZNode *node, const std::size_t &childCount)
+{
+    /* copies the name and the value, the caller fills the children */
+    ZNode *copy = ZConcurrentNestedMap::createNode(node->key(), node->keySize, childCount);
+    try
+    {
+        copy->value = node->value;
+    }
+    catch(...)
+    {
+        ZConcurrentNestedMap::destroyNode(copy);
+        throw;
+    }
+    copy->hasValue = node->hasValue;
+    return copy;
+}
+
+void ZConcurrentNestedMap::destroyNode(void *node)
+{
+    ZNode *n = static_cast<ZNode*>(node);
+    n->~ZNode();
+    std::free(n);
+}
+
+void ZConcurrentNestedMap::destroyTree(void *node)
+{
+    ZNode *n = static_cast<ZNode*>(node);
+    for(std::uint32_t slot = 0; slot < n->capacity; ++slot)
+    {
+        if(n->slots()[slot].node) ZConcurrentNestedMap::destroyTree(n->slots()[slot].node);
+    }
+    ZConcurrentNestedMap::destroyNode(n);
+}
+
+std::size_t ZConcurrentNestedMap::countValues(const ZNode *node)
+{
+    std::size_t count = node->hasValue ? 1 : 0;
+    for(std::uint32_t slot = 0; slot < node->capacity; ++slot)
+    {
+        if(node->slots()[slot].node) count += ZConcurrentNestedMap::countValues(node->slots()[slot].node);
+    }
+    return count;
+}
+
+std::size_t ZConcurrentNestedMap::findSlot(const ZNode *node, const char *key, const std::size_t &keySize, const std::uint64_t &hash)
+{
+    if(node->childCount == 0) return NoSlot;
+
+    std::size_t mask = node->capacity - 1;
+    const ZSlot *slots = node->slots();
+    for(std::size_t slot = hash & mask; slots[slot].node != nullptr; slot = (slot + 1) & mask)
+    {
+        if(slots[slot].hash == hash && slots[slot].node->keySize == keySize && std::memcmp(slots[slot].node->key(), key, keySize) == 0)
+        {
+            return slot;
+        }
+    }
+    return NoSlot;
+}
+
+void ZConcurrentNestedMap::placeChild(ZNode *node, const std::uint64_t &hash, ZNode *child)
+{
+    std::size_t mask = node->capacity - 1;
+    std::size_t slot = hash & mask;
+    while(node->slots()[slot].node != nullptr) slot = (slot + 1) & mask;
+
+    node->slots()[slot].hash = hash;
+    node->slots()[slot].node = child;
+    ++node->childCount;
+}
+
+bool ZConcurrentNestedMap::visit(const ZNode *node, std::string &path, const char &separator, const ZVisitor &visitor)
+{
+    if(node->hasValue && !visitor(ZStringView(path), node->value)) return false;
+
+    const std::size_t mark = path.size();
+    for(std::uint32_t slot = 0; slot < node->capacity; ++slot)
+    {
+        const ZNode *child = node->slots()[slot].node;
+        if(child == nullptr) continue;
+
+        if(mark != 0) path.push_back(separator);
+        path.append(child->key(), child->keySize);
+        bool proceed = ZConcurrentNestedMap::visit(child, path, separator, visitor);
+        path.resize(mark);
+        if(!proceed) return false;
+    }
+    return true;
+}
+
+ZConcurrentNestedMap::ZNode *ZConcurrentNestedMap::assignPath(const ZNode *node, const char *key, const std::size_t &keySize,
+                                                              const char *begin, const char *end, const char &separator,
+                                                              const ZVariant &value, std::vector<ZNode*> &replaced,
+                                                              std::vector<ZNode*> &created, bool &inserted)
+{
+    /* returns the copy of node with value stored below it, [begin, end) is the rest of the path */
+    if(begin == end)
+    {
+        ZNode *copy = node ? ZConcurrentNestedMap::copyNode(node, node->childCount) : ZConcurrentNestedMap::createNode(key, keySize, 0);
+        created.push_back(copy);
+        if(node)
+        {
+            std::memcpy(copy->slots(), node->slots(), node->capacity * sizeof(ZSlot));
+            copy->childCount = node->childCount;
+            replaced.push_back(const_cast<ZNode*>(node));
+        }
+        inserted = node == nullptr || !node->hasValue;
+        copy->value = value;
+        copy->hasValue = true;
+        return copy;
+    }
+
+    const char *last = segmentEnd(begin, end, separator);
+    const std::size_t childKeySize = static_cast<std::size_t>(last - begin);
+    const std::uint64_t hash = segmentHash(begin, childKeySize);
+    const std::size_t slot = node ? ZConcurrentNestedMap::findSlot(node, begin, childKeySize, hash) : NoSlot;
+    const ZNode *child = slot != NoSlot ? node->slots()[slot].node : nullptr;
+
+    ZNode *childCopy = ZConcurrentNestedMap::assignPath(child, begin, childKeySize, last == end ? end : last + 1, end,
+                                                        separator, value, replaced, created, inserted);
+
+    ZNode *copy = nullptr;
+    if(child)
+    {
+        copy = ZConcurrentNestedMap::copyNode(node, node->childCount);
+        std::memcpy(copy->slots(), node->slots(), node->capacity * sizeof(ZSlot));
+        copy->childCount = node->childCount;
+        copy->slots()[slot].node = childCopy;
+    }
+    else
+    {
+        std::size_t childCount = node ? node->childCount + 1 : 1;
+        copy = node ? ZConcurrentNestedMap::copyNode(node, childCount) : ZConcurrentNestedMap::createNode(key, keySize, childCount);
+        if(node)
+        {
+            for(std::uint32_t index = 0; index < node->capacity; ++index)
+            {
+                const ZSlot &entry = node->slots()[index];
+                if(entry.node) ZConcurrentNestedMap::placeChild(copy, entry.hash, entry.node);
+            }
+        }
+        ZConcurrentNestedMap::placeChild(copy, hash, childCopy);
+    }
+    created.push_back(copy);
+    if(node) replaced.push_back(const_cast<ZNode*>(node));
+    return copy;
+}
+
+void ZConcurrentNestedMap::insertPrivate(ZNode *&node, const char *key, const std::size_t &keySize, const char *begin, const char *end,
+                                         const char &separator, const ZVariant &value)
+{
+    if(node == nullptr) node = ZConcurrentNestedMap::createNode(key, keySize, 0);
+    if(begin == end)
+    {
+        node->value = value;
+        node->hasValue = true;
+        return;
+    }
+
+    const char *last = segmentEnd(begin, end, separator);
+    const std::size_t childKeySize = static_cast<std::size_t>(last - begin);
+    const std::uint64_t hash = segmentHash(begin, childKeySize);
+    const char *rest = last == end ? end : last + 1;
+
+    std::size_t slot = ZConcurrentNestedMap::findSlot(node, begin, childKeySize, hash);
+    if(slot != NoSlot)
+    {
+        ZConcurrentNestedMap::insertPrivate(node->slots()[slot].node, begin, childKeySize, rest, end, separator, value);
+        return;
+    }
+
+    /* nobody else sees this tree yet, a full table is replaced by the next size up. The capacity
+     * has to stay capacityFor(childCount), the writers copy a node with its slots as they are
+     */
+    if((node->childCount + 1) * 4 > node->capacity * 3)
+    {
+        ZNode *grown = ZConcurrentNestedMap::copyNode(node, node->childCount + 1);
+        for(std::uint32_t index = 0; index < node->capacity; ++index)
+        {
+            const ZSlot &entry = node->slots()[index];
+            if(entry.node) ZConcurrentNestedMap::placeChild(grown, entry.hash, entry.node);
+        }
+        ZConcurrentNestedMap::destroyNode(node);
+        node = grown;
+    }
+
+    ZNode *child = nullptr;
+    ZConcurrentNestedMap::insertPrivate(child, begin, childKeySize, rest, end, separator, value);
+    ZConcurrentNestedMap::placeChild(node, hash, child);
+}
+
+const ZConcurrentNestedMap::ZNode *ZConcurrentNestedMap::findNode(const ZStringView &path) const
+{
+    const ZNode *node = this->m_root.load(std::memory_order_acquire);
+    if(node == nullptr || path.empty()) return node;
+
+    const char *begin = path.begin();
+    const char *end = path.end();
+    for(;;)
+    {
+        const char *last = segmentEnd(begin, end, this->m_separator);
+        std::size_t keySize = static_cast<std::size_t>(last - begin);
+        if(keySize == 0) return nullptr;
+
+        std::size_t slot = ZConcurrentNestedMap::findSlot(node, begin, keySize, segmentHash(begin, keySize));
+        if(slot == NoSlot) return nullptr;
+
+        node = node->slots()[slot].node;
+        if(last == end) return node;
+        begin = last + 1;
+    }
+}
+
+void ZConcurrentNestedMap::publish(ZNode *root, const std::vector<ZNode*> &replaced, ZNode *removed)
+{
+    /* readers entering after the store only reach the new version */
+    this->m_root.store(root, std::memory_order_release);
+
+    for(ZNode *node : replaced) ZEpoch::retire(node, &ZConcurrentNestedMap::destroyNode);
+    if(removed) ZEpoch::retire(removed, &ZConcurrentNestedMap::destroyTree);
+    ZEpoch::reclaim();
+}
+
+}
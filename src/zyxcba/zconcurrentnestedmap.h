@@ -0,0 +1,137 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef ZCONCURRENTNESTEDMAP_H
+#define ZCONCURRENTNESTEDMAP_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "znestedmap.h"
+#include "zstringview.h"
+#include "zvariant.h"
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZConcurrentNestedMap class
+///
+/// ZConcurrentNestedMap is the concurrent counterpart of ZNestedMap for data read by many
+/// threads and changed rarely, like configuration and feature flags. It uses the same path
+/// syntax and per-segment hash nodes.
+///
+/// Published nodes are never modified. A writer copies the nodes on the path it changes,
+/// shares every other subtree with the previous version and publishes the new root with one
+/// atomic store. Readers take no lock and issue no atomic read-modify-write, they enter a
+/// ZEpoch read section, load the root and walk it, so every call sees one consistent version.
+/// The replaced nodes are retired to ZEpoch and freed once no reader can reach them. Writers
+/// are serialized by a mutex.
+///
+/// get() returns a copy, which for strings and containers copies the whole payload. read()
+/// hands the stored value to the callback without copying it.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZConcurrentNestedMap
+{
+public:
+    typedef ZNestedMap::ZVisitor ZVisitor;
+    typedef std::function<void(const ZVariant &value)> ZReader;
+
+    explicit ZConcurrentNestedMap(const char &separator = ZNestedMap::DefaultSeparator);
+    ~ZConcurrentNestedMap();
+
+    ZConcurrentNestedMap(const ZConcurrentNestedMap &) = delete;
+    ZConcurrentNestedMap &operator=(const ZConcurrentNestedMap &) = delete;
+
+    /* writers, returns false for an invalid path */
+    bool set(const ZStringView &path, const ZVariant &value);
+
+    /* removes the value at path together with everything below it */
+    bool erase(const ZStringView &path);
+
+    /* publishes the content of map as a whole, readers see either the old or the new tree */
+    void assign(const ZNestedMap &map);
+    void clear();
+
+    /* readers */
+    bool get(const ZStringView &path, ZVariant &value) const;
+    ZVariant get(const ZStringView &path, const ZVariant &defaultValue = ZVariant()) const;
+    bool contains(const ZStringView &path) const;
+
+    /* calls reader with the stored value while it is protected, returns false when there is none */
+    bool read(const ZStringView &path, const ZReader &reader) const;
+
+    /* visits one consistent version of everything at or below prefix, in unspecified order */
+    bool forEach(const ZStringView &prefix, const ZVisitor &visitor) const;
+
+    std::size_t size() const;
+    bool empty() const;
+
+    char separator() const;
+
+private:
+    struct ZNode;
+    struct ZSlot;
+
+    static ZNode *createNode(const char *key, const std::size_t &keySize, const std::size_t &childCount);
+    static ZNode *copyNode(const ZNode *node, const std::size_t &childCount);
+    static void destroyNode(void *node);
+    static void destroyTree(void *node);
+    static std::size_t countValues(const ZNode *node);
+
+    static std::size_t findSlot(const ZNode *node, const char *key, const std::size_t &keySize, const std::uint64_t &hash);
+    static void placeChild(ZNode *node, const std::uint64_t &hash, ZNode *child);
+    static bool visit(const ZNode *node, std::string &path, const char &separator, const ZVisitor &visitor);
+
+    static ZNode *assignPath(const ZNode *node, const char *key, const std::size_t &keySize, const char *begin, const char *end,
+                             const char &separator, const ZVariant &value, std::vector<ZNode*> &replaced,
+                             std::vector<ZNode*> &created, bool &inserted);
+    static void insertPrivate(ZNode *&node, const char *key, const std::size_t &keySize, const char *begin, const char *end,
+                              const char &separator, const ZVariant &value);
+
+    const ZNode *findNode(const ZStringView &path) const;
+    void publish(ZNode *root, const std::vector<ZNode*> &replaced, ZNode *removed);
+
+    std::atomic<ZNode*> m_root;
+    std::atomic<std::size_t> m_size;
+    char m_separator;
+    std::mutex m_writer;
+};
+
+}
+
+#endif // ZCONCURRENTNESTEDMAP_H
@@ -0,0 +1,188 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "zcpu.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define ZYXCBA_CPU_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace zyxcba {
+
+namespace {
+
+#ifdef ZYXCBA_CPU_X86
+
+struct ZCpuidRegisters
+{
+    std::uint32_t eax;
+    std::uint32_t ebx;
+    std::uint32_t ecx;
+    std::uint32_t edx;
+};
+
+ZCpuidRegisters cpuid(const std::uint32_t &leaf, const std::uint32_t &subleaf)
+{
+    ZCpuidRegisters registers = {0, 0, 0, 0};
+#if defined(_MSC_VER)
+    int values[4];
+    __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+    registers.eax = static_cast<std::uint32_t>(values[0]);
+    registers.ebx = static_cast<std::uint32_t>(values[1]);
+    registers.ecx = static_cast<std::uint32_t>(values[2]);
+    registers.edx = static_cast<std::uint32_t>(values[3]);
+#else
+    __cpuid_count(leaf, subleaf, registers.eax, registers.ebx, registers.ecx, registers.edx);
+#endif
+    return registers;
+}
+
+/* the register state the operating system saves on a context switch */
+std::uint64_t xgetbv()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    std::uint32_t low;
+    std::uint32_t high;
+    __asm__ __volatile__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return (static_cast<std::uint64_t>(high) << 32) | low;
+#endif
+}
+
+bool hasBits(const std::uint32_t &value, const std::uint32_t &bits)
+{
+    return (value & bits) == bits;
+}
+
+ZCpuLevel probe()
+{
+    const std::uint32_t maxLeaf = cpuid(0, 0).eax;
+    if(maxLeaf < 1) return ZCpuLevel::Scalar;
+
+    const ZCpuidRegisters leaf1 = cpuid(1, 0);
+    const bool sse2 = hasBits(leaf1.edx, 1U << 26);
+    const bool ssse3 = sse2 && hasBits(leaf1.ecx, (1U << 0) | (1U << 9));
+    const bool sse42 = ssse3 && hasBits(leaf1.ecx, (1U << 19) | (1U << 20) | (1U << 23));
+    if(!ssse3) return ZCpuLevel::Scalar;
+    if(!sse42) return ZCpuLevel::SSSE3;
+
+    /* AVX needs OSXSAVE and the xmm and ymm state enabled */
+    const bool osxsave = hasBits(leaf1.ecx, (1U << 27) | (1U << 28));
+    const std::uint64_t state = osxsave ? xgetbv() : 0;
+    if(maxLeaf < 7 || (state & 0x6) != 0x6) return ZCpuLevel::SSE42;
+
+    const ZCpuidRegisters leaf7 = cpuid(7, 0);
+    const bool fma = hasBits(leaf1.ecx, 1U << 12);
+    const bool avx2 = fma && hasBits(leaf7.ebx, (1U << 3) | (1U << 5) | (1U << 8));
+    if(!avx2) return ZCpuLevel::SSE42;
+
+    /* AVX-512 additionally needs the opmask and zmm state */
+    const bool avx512 = (state & 0xe6) == 0xe6 && hasBits(leaf7.ebx, (1U << 16) | (1U << 17) | (1U << 30) | (1U << 31));
+    return avx512 ? ZCpuLevel::AVX512 : ZCpuLevel::AVX2;
+}
+
+#else
+
+ZCpuLevel probe()
+{
+    return ZCpuLevel::Scalar;
+}
+
+#endif
+
+ZCpuLevel selectLevel()
+{
+    const ZCpuLevel detected = ZCpu::detectedLevel();
+
+    ZCpuLevel requested;
+    const char *name = std::getenv("ZYXCBA_CPU_LEVEL");
+    if(name == nullptr || !ZCpu::parseLevel(name, requested)) return detected;
+
+    return requested < detected ? requested : detected;
+}
+
+}
+
+ZCpuLevel ZCpu::detectedLevel()
+{
+    static const ZCpuLevel level = probe();
+    return level;
+}
+
+ZCpuLevel ZCpu::level()
+{
+    static const ZCpuLevel level = selectLevel();
+    return level;
+}
+
+bool ZCpu::supports(const ZCpuLevel &level)
+{
+    return level <= ZCpu::level();
+}
+
+const char *ZCpu::levelName(const ZCpuLevel &level)
+{
+    switch(level)
+    {
+    case ZCpuLevel::Scalar: return "scalar";
+    case ZCpuLevel::SSSE3: return "ssse3";
+    case ZCpuLevel::SSE42: return "sse4.2";
+    case ZCpuLevel::AVX2: return "avx2";
+    case ZCpuLevel::AVX512: return "avx512";
+    default: return "unknown";
+    }
+}
+
+bool ZCpu::parseLevel(const char *name, ZCpuLevel &level)
+{
+    for(std::size_t index = 0; index < static_cast<std::size_t>(ZCpuLevel::LevelCount); ++index)
+    {
+        const ZCpuLevel candidate = static_cast<ZCpuLevel>(index);
+        if(std::strcmp(name, ZCpu::levelName(candidate)) == 0)
+        {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+}
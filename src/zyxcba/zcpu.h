@@ -0,0 +1,136 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef ZCPU_H
+#define ZCPU_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZCpuLevel enum
+///
+/// Instruction set levels, every level includes the ones before it. SSE42 includes POPCNT,
+/// AVX2 includes BMI1, BMI2 and FMA, AVX512 includes the F, BW, DQ and VL subsets.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+enum class ZCpuLevel : std::uint8_t
+{
+    Scalar,
+    SSSE3,
+    SSE42,
+    AVX2,
+    AVX512,
+
+    LevelCount
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZCpu class
+///
+/// ZCpu probes the instruction set level of the cpu once, including whether the operating
+/// system saves the vector registers. The environment variable ZYXCBA_CPU_LEVEL lowers the
+/// level used for dispatch, for example to test the scalar kernels on a recent machine. It
+/// accepts scalar, ssse3, sse4.2, avx2 and avx512, a level above the detected one is ignored.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZCpu
+{
+public:
+    /* the level of the hardware */
+    static ZCpuLevel detectedLevel();
+
+    /* the level kernels are selected for, the detected level lowered by ZYXCBA_CPU_LEVEL */
+    static ZCpuLevel level();
+
+    static bool supports(const ZCpuLevel &level);
+
+    static const char *levelName(const ZCpuLevel &level);
+    static bool parseLevel(const char *name, ZCpuLevel &level);
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZCpuDispatch class
+///
+/// ZCpuDispatch holds the variants of one kernel, one function pointer per level, and picks the
+/// best variant the cpu supports. A dispatcher is typically a function local static whose
+/// resolved pointer is cached by the caller:
+///
+///     static const Function function = ZCpuDispatch<Function>(&scalar)
+///             .add(ZCpuLevel::AVX2, &avx2)
+///             .resolve();
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename Function>
+class ZCpuDispatch
+{
+public:
+    explicit ZCpuDispatch(Function scalar)
+    {
+        for(std::size_t index = 0; index < LevelCount; ++index)
+        {
+            this->m_functions[index] = nullptr;
+        }
+        this->m_functions[0] = scalar;
+    }
+
+    ZCpuDispatch &add(const ZCpuLevel &level, Function function)
+    {
+        this->m_functions[static_cast<std::size_t>(level)] = function;
+        return *this;
+    }
+
+    /* the best variant registered at or below the given level */
+    Function resolve(const ZCpuLevel &level) const
+    {
+        for(std::size_t index = static_cast<std::size_t>(level) + 1; index-- > 0;)
+        {
+            if(this->m_functions[index] != nullptr) return this->m_functions[index];
+        }
+        return this->m_functions[0];
+    }
+
+    Function resolve() const
+    {
+        return this->resolve(ZCpu::level());
+    }
+
+private:
+    static const std::size_t LevelCount = static_cast<std::size_t>(ZCpuLevel::LevelCount);
+
+    Function m_functions[LevelCount];
+};
+
+}
+
+#endif // ZCPU_H
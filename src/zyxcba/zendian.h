@@ -0,0 +1,274 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ZENDIAN_H
+#define ZENDIAN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "ztype.h"
+
+/* The byte order of the target is resolved by the preprocessor, so every conversion below
+ * is either nothing or a single byte swap instruction.
+ */
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define ZYXCBA_LITTLE_ENDIAN 1
+#elif defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define ZYXCBA_LITTLE_ENDIAN 0
+#elif defined(_WIN32) || defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64) || defined(_M_ARM) || defined(_M_ARM64)
+#define ZYXCBA_LITTLE_ENDIAN 1
+#else
+#error "zyxcba: unable to determine the byte order of the target"
+#endif
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZByteOrder enum
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+enum class ZByteOrder : std::uint8_t
+{
+    LittleEndian,
+    BigEndian,
+
+    Native = ZYXCBA_LITTLE_ENDIAN ? LittleEndian : BigEndian
+};
+
+constexpr bool isLittleEndianHost()
+{
+    return ZByteOrder::Native == ZByteOrder::LittleEndian;
+}
+
+constexpr bool isBigEndianHost()
+{
+    return ZByteOrder::Native == ZByteOrder::BigEndian;
+}
+
+namespace detail {
+
+#if defined(__GNUC__) || defined(__clang__)
+constexpr std::uint16_t byteSwap16(std::uint16_t value) { return __builtin_bswap16(value); }
+constexpr std::uint32_t byteSwap32(std::uint32_t value) { return __builtin_bswap32(value); }
+constexpr std::uint64_t byteSwap64(std::uint64_t value) { return __builtin_bswap64(value); }
+#else
+/* compilers recognise these patterns and emit a single byte swap instruction */
+constexpr std::uint16_t byteSwap16(std::uint16_t value)
+{
+    return static_cast<std::uint16_t>((value << 8) | (value >> 8));
+}
+
+constexpr std::uint32_t byteSwap32(std::uint32_t value)
+{
+    return ((value & 0x000000ffU) << 24) | ((value & 0x0000ff00U) << 8)
+            | ((value & 0x00ff0000U) >> 8) | ((value & 0xff000000U) >> 24);
+}
+
+constexpr std::uint64_t byteSwap64(std::uint64_t value)
+{
+    return (static_cast<std::uint64_t>(byteSwap32(static_cast<std::uint32_t>(value))) << 32)
+            | byteSwap32(static_cast<std::uint32_t>(value >> 32));
+}
+#endif
+
+#ifdef ZYXCBA_HAS_INT128
+constexpr zuint128 byteSwap128(zuint128 value)
+{
+    return (static_cast<zuint128>(byteSwap64(static_cast<std::uint64_t>(value))) << 64)
+            | byteSwap64(static_cast<std::uint64_t>(value >> 64));
+}
+#endif
+
+template<std::size_t Size>
+struct ZByteSwap;
+
+template<>
+struct ZByteSwap<1>
+{
+    template<typename T>
+    static constexpr T swap(T value) { return value; }
+};
+
+template<>
+struct ZByteSwap<2>
+{
+    template<typename T>
+    static constexpr T swap(T value) { return static_cast<T>(byteSwap16(static_cast<std::uint16_t>(value))); }
+};
+
+template<>
+struct ZByteSwap<4>
+{
+    template<typename T>
+    static constexpr T swap(T value) { return static_cast<T>(byteSwap32(static_cast<std::uint32_t>(value))); }
+};
+
+template<>
+struct ZByteSwap<8>
+{
+    template<typename T>
+    static constexpr T swap(T value) { return static_cast<T>(byteSwap64(static_cast<std::uint64_t>(value))); }
+};
+
+#ifdef ZYXCBA_HAS_INT128
+template<>
+struct ZByteSwap<16>
+{
+    template<typename T>
+    static constexpr T swap(T value) { return static_cast<T>(byteSwap128(static_cast<zuint128>(value))); }
+};
+#endif
+
+/* std::is_integral does not know the 128 bit types in strict iso mode */
+template<typename T>
+struct ZIsInteger : std::is_integral<T>
+{
+};
+
+#ifdef ZYXCBA_HAS_INT128
+template<>
+struct ZIsInteger<zint128> : std::true_type
+{
+};
+
+template<>
+struct ZIsInteger<zuint128> : std::true_type
+{
+};
+#endif
+
+/* the unsigned integer holding the bits of a value, floating point values are converted
+ * through it so that every bit, including the payload of a NaN, is preserved
+ */
+template<typename T, bool IsInteger = ZIsInteger<T>::value>
+struct ZBitsOf
+{
+    typedef T type;
+};
+
+template<>
+struct ZBitsOf<float, false>
+{
+    static_assert(sizeof(float) == 4, "float is expected to be 32 bit");
+    typedef std::uint32_t type;
+};
+
+template<>
+struct ZBitsOf<double, false>
+{
+    static_assert(sizeof(double) == 8, "double is expected to be 64 bit");
+    typedef std::uint64_t type;
+};
+
+}
+
+/* reverses the bytes of an integer */
+template<typename T>
+constexpr T byte_swap(T value)
+{
+    static_assert(detail::ZIsInteger<T>::value, "byte_swap requires an integral type");
+    return detail::ZByteSwap<sizeof(T)>::swap(value);
+}
+
+/* converts between native and big or little endian byte order, the conversion is its own inverse */
+template<typename T>
+constexpr T to_be(T value)
+{
+    return isLittleEndianHost() ? byte_swap(value) : value;
+}
+
+template<typename T>
+constexpr T to_le(T value)
+{
+    return isLittleEndianHost() ? value : byte_swap(value);
+}
+
+template<typename T>
+constexpr T from_be(T value)
+{
+    return to_be(value);
+}
+
+template<typename T>
+constexpr T from_le(T value)
+{
+    return to_le(value);
+}
+
+/* reads or writes an integer, float or double at an unaligned address, memcpy folds into a
+ * single load or store
+ */
+template<typename T>
+inline T load_be(const void *data)
+{
+    typename detail::ZBitsOf<T>::type bits;
+    std::memcpy(&bits, data, sizeof(T));
+    bits = from_be(bits);
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+}
+
+template<typename T>
+inline T load_le(const void *data)
+{
+    typename detail::ZBitsOf<T>::type bits;
+    std::memcpy(&bits, data, sizeof(T));
+    bits = from_le(bits);
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+}
+
+template<typename T>
+inline void store_be(void *data, T value)
+{
+    typename detail::ZBitsOf<T>::type bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    bits = to_be(bits);
+    std::memcpy(data, &bits, sizeof(T));
+}
+
+template<typename T>
+inline void store_le(void *data, T value)
+{
+    typename detail::ZBitsOf<T>::type bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    bits = to_le(bits);
+    std::memcpy(data, &bits, sizeof(T));
+}
+
+}
+
+#endif // ZENDIAN_H
@@ -30,6 +30,7 @@
  */
 
 #include "zendianutility.h"
+#include "zbulkbyteswap.h"
 
 namespace zyxcba {
 
@@ -50,13 +51,8 @@ bool ZEndianUtility::isBigEndian() const
 
 bool ZEndianUtility::isLittleEndian() const
 {
-    /* runtime endianess detection
-     * Check this url to understand about the process
-     * https://stackoverflow.com/questions/4239993/determining-endianness-at-compile-time/4240029
-    */
-    short int number = 0x1;
-    char *numPtr = reinterpret_cast<char*>(&number);
-    return (numPtr[0] == 1);
+    /* resolved at compile time, see zendian.h */
+    return isLittleEndianHost();
 }
 
 bool ZEndianUtility::isBigEndianFromFlag() const
@@ -129,117 +125,845 @@ std::string ZEndianUtility::toLESS(const unsigned long long &num) const
     return this->toLittleEndianStdStringFromUInt64(num);
 }
 
+std::string ZEndianUtility::toBESS(const char &num) const
+{
+    return this->toBigEndianStdStringFromInt8(num);
+}
+
+std::string ZEndianUtility::toBESS(const short &num) const
+{
+    return this->toBigEndianStdStringFromInt16(num);
+}
+
+std::string ZEndianUtility::toBESS(const int &num) const
+{
+    return this->toBigEndianStdStringFromInt32(num);
+}
+
+std::string ZEndianUtility::toBESS(const long long &num) const
+{
+    return this->toBigEndianStdStringFromInt64(num);
+}
+
+std::string ZEndianUtility::toBESS(const float &num) const
+{
+    return this->toBigEndianStdStringFromFloat32(num);
+}
+
+std::string ZEndianUtility::toBESS(const double &num) const
+{
+    return this->toBigEndianStdStringFromFloat64(num);
+}
+
+#ifdef ZYXCBA_HAS_INT128
+std::string ZEndianUtility::toBESS(const zint128 &num) const
+{
+    return this->toBigEndianStdStringFromInt128(num);
+}
+
+std::string ZEndianUtility::toBESS(const zuint128 &num) const
+{
+    return this->toBigEndianStdStringFromUInt128(num);
+}
+#endif
+
+std::string ZEndianUtility::toLESS(const char &num) const
+{
+    return this->toLittleEndianStdStringFromInt8(num);
+}
+
+std::string ZEndianUtility::toLESS(const short &num) const
+{
+    return this->toLittleEndianStdStringFromInt16(num);
+}
+
+std::string ZEndianUtility::toLESS(const int &num) const
+{
+    return this->toLittleEndianStdStringFromInt32(num);
+}
+
+std::string ZEndianUtility::toLESS(const long long &num) const
+{
+    return this->toLittleEndianStdStringFromInt64(num);
+}
+
+std::string ZEndianUtility::toLESS(const float &num) const
+{
+    return this->toLittleEndianStdStringFromFloat32(num);
+}
+
+std::string ZEndianUtility::toLESS(const double &num) const
+{
+    return this->toLittleEndianStdStringFromFloat64(num);
+}
+
+#ifdef ZYXCBA_HAS_INT128
+std::string ZEndianUtility::toLESS(const zint128 &num) const
+{
+    return this->toLittleEndianStdStringFromInt128(num);
+}
+
+std::string ZEndianUtility::toLESS(const zuint128 &num) const
+{
+    return this->toLittleEndianStdStringFromUInt128(num);
+}
+#endif
+
+template<typename T>
+char *ZEndianUtility::storeBigEndian(const T &num, char *destination, const char *end)
+{
+    if(end != nullptr && (end < destination || static_cast<std::size_t>(end - destination) < sizeof(T))) return nullptr;
+    store_be(destination, num);
+    return destination + sizeof(T);
+}
+
+template<typename T>
+char *ZEndianUtility::storeLittleEndian(const T &num, char *destination, const char *end)
+{
+    if(end != nullptr && (end < destination || static_cast<std::size_t>(end - destination) < sizeof(T))) return nullptr;
+    store_le(destination, num);
+    return destination + sizeof(T);
+}
+
+char *ZEndianUtility::toBECS(const unsigned char &num, char *destination) const
+{
+    return ZEndianUtility::storeBigEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toBECS(const unsigned short &num, char *destination) const
+{
+    return ZEndianUtility::storeBigEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toBECS(const unsigned int &num, char *destination) const
+{
+    return ZEndianUtility::storeBigEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toBECS(const unsigned long long &num, char *destination) const
+{
+    return ZEndianUtility::storeBigEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toLECS(const unsigned char &num, char *destination) const
+{
+    return ZEndianUtility::storeLittleEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toLECS(const unsigned short &num, char *destination) const
+{
+    return ZEndianUtility::storeLittleEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toLECS(const unsigned int &num, char *destination) const
+{
+    return ZEndianUtility::storeLittleEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toLECS(const unsigned long long &num, char *destination) const
+{
+    return ZEndianUtility::storeLittleEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toBECS(const char &num, char *destination) const
+{
+    return ZEndianUtility::storeBigEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toBECS(const short &num, char *destination) const
+{
+    return ZEndianUtility::storeBigEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toBECS(const int &num, char *destination) const
+{
+    return ZEndianUtility::storeBigEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toBECS(const long long &num, char *destination) const
+{
+    return ZEndianUtility::storeBigEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toBECS(const float &num, char *destination) const
+{
+    return ZEndianUtility::storeBigEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toBECS(const double &num, char *destination) const
+{
+    return ZEndianUtility::storeBigEndian(num, destination, nullptr);
+}
+
+#ifdef ZYXCBA_HAS_INT128
+char *ZEndianUtility::toBECS(const zint128 &num, char *destination) const
+{
+    return ZEndianUtility::storeBigEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toBECS(const zuint128 &num, char *destination) const
+{
+    return ZEndianUtility::storeBigEndian(num, destination, nullptr);
+}
+#endif
+
+char *ZEndianUtility::toLECS(const char &num, char *destination) const
+{
+    return ZEndianUtility::storeLittleEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toLECS(const short &num, char *destination) const
+{
+    return ZEndianUtility::storeLittleEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toLECS(const int &num, char *destination) const
+{
+    return ZEndianUtility::storeLittleEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toLECS(const long long &num, char *destination) const
+{
+    return ZEndianUtility::storeLittleEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toLECS(const float &num, char *destination) const
+{
+    return ZEndianUtility::storeLittleEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toLECS(const double &num, char *destination) const
+{
+    return ZEndianUtility::storeLittleEndian(num, destination, nullptr);
+}
+
+#ifdef ZYXCBA_HAS_INT128
+char *ZEndianUtility::toLECS(const zint128 &num, char *destination) const
+{
+    return ZEndianUtility::storeLittleEndian(num, destination, nullptr);
+}
+
+char *ZEndianUtility::toLECS(const zuint128 &num, char *destination) const
+{
+    return ZEndianUtility::storeLittleEndian(num, destination, nullptr);
+}
+#endif
+
+char *ZEndianUtility::toBECS(const unsigned char &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeBigEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toBECS(const unsigned short &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeBigEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toBECS(const unsigned int &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeBigEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toBECS(const unsigned long long &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeBigEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toLECS(const unsigned char &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeLittleEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toLECS(const unsigned short &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeLittleEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toLECS(const unsigned int &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeLittleEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toLECS(const unsigned long long &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeLittleEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toBECS(const char &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeBigEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toBECS(const short &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeBigEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toBECS(const int &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeBigEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toBECS(const long long &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeBigEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toBECS(const float &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeBigEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toBECS(const double &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeBigEndian(num, destination, end);
+}
+
+#ifdef ZYXCBA_HAS_INT128
+char *ZEndianUtility::toBECS(const zint128 &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeBigEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toBECS(const zuint128 &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeBigEndian(num, destination, end);
+}
+#endif
+
+char *ZEndianUtility::toLECS(const char &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeLittleEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toLECS(const short &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeLittleEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toLECS(const int &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeLittleEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toLECS(const long long &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeLittleEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toLECS(const float &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeLittleEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toLECS(const double &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeLittleEndian(num, destination, end);
+}
+
+#ifdef ZYXCBA_HAS_INT128
+char *ZEndianUtility::toLECS(const zint128 &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeLittleEndian(num, destination, end);
+}
+
+char *ZEndianUtility::toLECS(const zuint128 &num, char *destination, const char *end) const
+{
+    if(end == nullptr) return nullptr;
+    return ZEndianUtility::storeLittleEndian(num, destination, end);
+}
+#endif
+
+void ZEndianUtility::appendBESS(std::string &buffer, const unsigned char &num) const
+{
+    char temp[1];
+    this->toBECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendBESS(std::string &buffer, const unsigned short &num) const
+{
+    char temp[2];
+    this->toBECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendBESS(std::string &buffer, const unsigned int &num) const
+{
+    char temp[4];
+    this->toBECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendBESS(std::string &buffer, const unsigned long long &num) const
+{
+    char temp[8];
+    this->toBECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendLESS(std::string &buffer, const unsigned char &num) const
+{
+    char temp[1];
+    this->toLECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendLESS(std::string &buffer, const unsigned short &num) const
+{
+    char temp[2];
+    this->toLECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendLESS(std::string &buffer, const unsigned int &num) const
+{
+    char temp[4];
+    this->toLECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendLESS(std::string &buffer, const unsigned long long &num) const
+{
+    char temp[8];
+    this->toLECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendBESS(std::string &buffer, const char &num) const
+{
+    char temp[1];
+    this->toBECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendBESS(std::string &buffer, const short &num) const
+{
+    char temp[2];
+    this->toBECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendBESS(std::string &buffer, const int &num) const
+{
+    char temp[4];
+    this->toBECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendBESS(std::string &buffer, const long long &num) const
+{
+    char temp[8];
+    this->toBECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendBESS(std::string &buffer, const float &num) const
+{
+    char temp[4];
+    this->toBECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendBESS(std::string &buffer, const double &num) const
+{
+    char temp[8];
+    this->toBECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+#ifdef ZYXCBA_HAS_INT128
+void ZEndianUtility::appendBESS(std::string &buffer, const zint128 &num) const
+{
+    char temp[16];
+    this->toBECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendBESS(std::string &buffer, const zuint128 &num) const
+{
+    char temp[16];
+    this->toBECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+#endif
+
+void ZEndianUtility::appendLESS(std::string &buffer, const char &num) const
+{
+    char temp[1];
+    this->toLECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendLESS(std::string &buffer, const short &num) const
+{
+    char temp[2];
+    this->toLECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendLESS(std::string &buffer, const int &num) const
+{
+    char temp[4];
+    this->toLECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendLESS(std::string &buffer, const long long &num) const
+{
+    char temp[8];
+    this->toLECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendLESS(std::string &buffer, const float &num) const
+{
+    char temp[4];
+    this->toLECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendLESS(std::string &buffer, const double &num) const
+{
+    char temp[8];
+    this->toLECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+#ifdef ZYXCBA_HAS_INT128
+void ZEndianUtility::appendLESS(std::string &buffer, const zint128 &num) const
+{
+    char temp[16];
+    this->toLECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+
+void ZEndianUtility::appendLESS(std::string &buffer, const zuint128 &num) const
+{
+    char temp[16];
+    this->toLECS(num, temp);
+    buffer.append(temp, sizeof(temp));
+}
+#endif
+
 unsigned char ZEndianUtility::toUInt8FromBESS(const std::string &numstr) const
 {
-    return this->toUInt8FromBigEndianStdString(numstr);
+    return this->toUInt8FromBigEndianStdString(numstr);
+}
+
+unsigned short ZEndianUtility::toUInt16FromBESS(const std::string &numstr) const
+{
+    return this->toUInt16FromBigEndianStdString(numstr);
+}
+
+unsigned int ZEndianUtility::toUInt32FromBESS(const std::string &numstr) const
+{
+    return this->toUInt32FromBigEndianStdString(numstr);
+}
+
+unsigned long long ZEndianUtility::toUInt64FromBESS(const std::string &numstr) const
+{
+    return this->toUInt64FromBigEndianStdString(numstr);
+}
+
+char ZEndianUtility::toInt8FromBESS(const std::string &numstr) const
+{
+    return this->toInt8FromBigEndianStdString(numstr);
+}
+
+short ZEndianUtility::toInt16FromBESS(const std::string &numstr) const
+{
+    return this->toInt16FromBigEndianStdString(numstr);
+}
+
+int ZEndianUtility::toInt32FromBESS(const std::string &numstr) const
+{
+    return this->toInt32FromBigEndianStdString(numstr);
+}
+
+long long ZEndianUtility::toInt64FromBESS(const std::string &numstr) const
+{
+    return this->toInt64FromBigEndianStdString(numstr);
+}
+
+float ZEndianUtility::toFloat32FromBESS(const std::string &numstr) const
+{
+    return this->toFloat32FromBigEndianStdString(numstr);
+}
+
+double ZEndianUtility::toFloat64FromBESS(const std::string &numstr) const
+{
+    return this->toFloat64FromBigEndianStdString(numstr);
+}
+
+#ifdef ZYXCBA_HAS_INT128
+zint128 ZEndianUtility::toInt128FromBESS(const std::string &numstr) const
+{
+    return this->toInt128FromBigEndianStdString(numstr);
+}
+
+zuint128 ZEndianUtility::toUInt128FromBESS(const std::string &numstr) const
+{
+    return this->toUInt128FromBigEndianStdString(numstr);
+}
+#endif
+
+unsigned char ZEndianUtility::toUInt8FromLESS(const std::string &numstr) const
+{
+    return this->toUInt8FromLittleEndianStdString(numstr);
+}
+
+unsigned short ZEndianUtility::toUInt16FromLESS(const std::string &numstr) const
+{
+    return this->toUInt16FromLittleEndianStdString(numstr);
+}
+
+unsigned int ZEndianUtility::toUInt32FromLESS(const std::string &numstr) const
+{
+    return this->toUInt32FromLittleEndianStdString(numstr);
+}
+
+unsigned long long ZEndianUtility::toUInt64FromLESS(const std::string &numstr) const
+{
+    return this->toUInt64FromLittleEndianStdString(numstr);
 }
 
-unsigned short ZEndianUtility::toUInt16FromBESS(const std::string &numstr) const
+char ZEndianUtility::toInt8FromLESS(const std::string &numstr) const
 {
-    return this->toUInt16FromBigEndianStdString(numstr);
+    return this->toInt8FromLittleEndianStdString(numstr);
 }
 
-unsigned int ZEndianUtility::toUInt32FromBESS(const std::string &numstr) const
+short ZEndianUtility::toInt16FromLESS(const std::string &numstr) const
 {
-    return this->toUInt32FromBigEndianStdString(numstr);
+    return this->toInt16FromLittleEndianStdString(numstr);
 }
 
-unsigned long long ZEndianUtility::toUInt64FromBESS(const std::string &numstr) const
+int ZEndianUtility::toInt32FromLESS(const std::string &numstr) const
 {
-    return this->toUInt64FromBigEndianStdString(numstr);
+    return this->toInt32FromLittleEndianStdString(numstr);
+}
+
+long long ZEndianUtility::toInt64FromLESS(const std::string &numstr) const
+{
+    return this->toInt64FromLittleEndianStdString(numstr);
+}
+
+float ZEndianUtility::toFloat32FromLESS(const std::string &numstr) const
+{
+    return this->toFloat32FromLittleEndianStdString(numstr);
+}
+
+double ZEndianUtility::toFloat64FromLESS(const std::string &numstr) const
+{
+    return this->toFloat64FromLittleEndianStdString(numstr);
+}
+
+#ifdef ZYXCBA_HAS_INT128
+zint128 ZEndianUtility::toInt128FromLESS(const std::string &numstr) const
+{
+    return this->toInt128FromLittleEndianStdString(numstr);
+}
+
+zuint128 ZEndianUtility::toUInt128FromLESS(const std::string &numstr) const
+{
+    return this->toUInt128FromLittleEndianStdString(numstr);
 }
+#endif
 
 std::string ZEndianUtility::toBigEndianStdStringFromUInt8(const unsigned char &num) const
 {
-    std::string r;
-    r.reserve(1);
-    r.push_back(static_cast<char>( num));
-    return r;
+    char temp[1];
+    this->toBECS(num, temp);
+    return std::string(temp, sizeof(temp));
 }
 
 std::string ZEndianUtility::toBigEndianStdStringFromUInt16(const unsigned short &num) const
 {
-    unsigned short temp = this->m_isLittleEndian?this->byteSwapUInt16(num):num;
-    std::string r;
-    r.reserve(2);
-    r.push_back(static_cast<char>(temp & 0xFF));
-    r.push_back(static_cast<char>((temp>>8) & 0xFF));
-    return r;
+    char temp[2];
+    this->toBECS(num, temp);
+    return std::string(temp, sizeof(temp));
 }
 
 std::string ZEndianUtility::toBigEndianStdStringFromUInt32(const unsigned int &num) const
 {
-    unsigned int temp = this->m_isLittleEndian?this->byteSwapUInt32(num):num;
-    std::string r;
-    r.reserve(4);
-    r.push_back(static_cast<char>(temp & 0xFF));
-    r.push_back(static_cast<char>((temp>>8) & 0xFF));
-    r.push_back(static_cast<char>((temp>>16) & 0xFF));
-    r.push_back(static_cast<char>((temp>>24) & 0xFF));
-    return r;
+    char temp[4];
+    this->toBECS(num, temp);
+    return std::string(temp, sizeof(temp));
 }
 
 std::string ZEndianUtility::toBigEndianStdStringFromUInt64(const unsigned long long &num) const
 {
-    unsigned long long temp = this->m_isLittleEndian?this->byteSwapUInt64(num):num;
-    std::string r;
-    r.reserve(8);
-    r.push_back(static_cast<char>(temp & 0xFF));
-    r.push_back(static_cast<char>((temp>>8) & 0xFF));
-    r.push_back(static_cast<char>((temp>>16) & 0xFF));
-    r.push_back(static_cast<char>((temp>>24) & 0xFF));
-    r.push_back(static_cast<char>((temp>>32) & 0xFF));
-    r.push_back(static_cast<char>((temp>>40) & 0xFF));
-    r.push_back(static_cast<char>((temp>>48) & 0xFF));
-    r.push_back(static_cast<char>((temp>>56) & 0xFF));
-    return r;
+    char temp[8];
+    this->toBECS(num, temp);
+    return std::string(temp, sizeof(temp));
 }
 
 std::string ZEndianUtility::toLittleEndianStdStringFromUInt8(const unsigned char &num) const
 {
-    std::string r;
-    r.reserve(1);
-    r.push_back(static_cast<char>( num));
-    return r;
+    char temp[1];
+    this->toLECS(num, temp);
+    return std::string(temp, sizeof(temp));
 }
 
 std::string ZEndianUtility::toLittleEndianStdStringFromUInt16(const unsigned short &num) const
 {
-    unsigned short temp = this->m_isLittleEndian?this->byteSwapUInt16(num):num;
-    std::string r;
-    r.reserve(2);
-    r.push_back(static_cast<char>((temp>>8) & 0xFF));
-    r.push_back(static_cast<char>(temp & 0xFF));
-    return r;
+    char temp[2];
+    this->toLECS(num, temp);
+    return std::string(temp, sizeof(temp));
 }
 
 std::string ZEndianUtility::toLittleEndianStdStringFromUInt32(const unsigned int &num) const
 {
-    unsigned int temp = this->m_isLittleEndian?this->byteSwapUInt32(num):num;
-    std::string r;
-    r.reserve(4);
-    r.push_back(static_cast<char>((temp>>24) & 0xFF));
-    r.push_back(static_cast<char>((temp>>16) & 0xFF));
-    r.push_back(static_cast<char>((temp>>8) & 0xFF));
-    r.push_back(static_cast<char>(temp & 0xFF));
-    return r;
+    char temp[4];
+    this->toLECS(num, temp);
+    return std::string(temp, sizeof(temp));
 }
 
 std::string ZEndianUtility::toLittleEndianStdStringFromUInt64(const unsigned long long &num) const
 {
-    unsigned long long temp = this->m_isLittleEndian?this->byteSwapUInt64(num):num;
-    std::string r;
-    r.reserve(8);
-    r.push_back(static_cast<char>((temp>>56) & 0xFF));
-    r.push_back(static_cast<char>((temp>>48) & 0xFF));
-    r.push_back(static_cast<char>((temp>>40) & 0xFF));
-    r.push_back(static_cast<char>((temp>>32) & 0xFF));
-    r.push_back(static_cast<char>((temp>>24) & 0xFF));
-    r.push_back(static_cast<char>((temp>>16) & 0xFF));
-    r.push_back(static_cast<char>((temp>>8) & 0xFF));
-    r.push_back(static_cast<char>(temp & 0xFF));
-    return r;
+    char temp[8];
+    this->toLECS(num, temp);
+    return std::string(temp, sizeof(temp));
+}
+
+std::string ZEndianUtility::toBigEndianStdStringFromInt8(const char &num) const
+{
+    char temp[1];
+    this->toBECS(num, temp);
+    return std::string(temp, sizeof(temp));
+}
+
+std::string ZEndianUtility::toBigEndianStdStringFromInt16(const short &num) const
+{
+    char temp[2];
+    this->toBECS(num, temp);
+    return std::string(temp, sizeof(temp));
+}
+
+std::string ZEndianUtility::toBigEndianStdStringFromInt32(const int &num) const
+{
+    char temp[4];
+    this->toBECS(num, temp);
+    return std::string(temp, sizeof(temp));
+}
+
+std::string ZEndianUtility::toBigEndianStdStringFromInt64(const long long &num) const
+{
+    char temp[8];
+    this->toBECS(num, temp);
+    return std::string(temp, sizeof(temp));
+}
+
+std::string ZEndianUtility::toBigEndianStdStringFromFloat32(const float &num) const
+{
+    char temp[4];
+    this->toBECS(num, temp);
+    return std::string(temp, sizeof(temp));
+}
+
+std::string ZEndianUtility::toBigEndianStdStringFromFloat64(const double &num) const
+{
+    char temp[8];
+    this->toBECS(num, temp);
+    return std::string(temp, sizeof(temp));
+}
+
+#ifdef ZYXCBA_HAS_INT128
+std::string ZEndianUtility::toBigEndianStdStringFromInt128(const zint128 &num) const
+{
+    char temp[16];
+    this->toBECS(num, temp);
+    return std::string(temp, sizeof(temp));
+}
+
+std::string ZEndianUtility::toBigEndianStdStringFromUInt128(const zuint128 &num) const
+{
+    char temp[16];
+    this->toBECS(num, temp);
+    return std::string(temp, sizeof(temp));
+}
+#endif
+
+std::string ZEndianUtility::toLittleEndianStdStringFromInt8(const char &num) const
+{
+    char temp[1];
+    this->toLECS(num, temp);
+    return std::string(temp, sizeof(temp));
+}
+
+std::string ZEndianUtility::toLittleEndianStdStringFromInt16(const short &num) const
+{
+    char temp[2];
+    this->toLECS(num, temp);
+    return std::string(temp, sizeof(temp));
+}
+
+std::string ZEndianUtility::toLittleEndianStdStringFromInt32(const int &num) const
+{
+    char temp[4];
+    this->toLECS(num, temp);
+    return std::string(temp, sizeof(temp));
+}
+
+std::string ZEndianUtility::toLittleEndianStdStringFromInt64(const long long &num) const
+{
+    char temp[8];
+    this->toLECS(num, temp);
+    return std::string(temp, sizeof(temp));
+}
+
+std::string ZEndianUtility::toLittleEndianStdStringFromFloat32(const float &num) const
+{
+    char temp[4];
+    this->toLECS(num, temp);
+    return std::string(temp, sizeof(temp));
+}
+
+std::string ZEndianUtility::toLittleEndianStdStringFromFloat64(const double &num) const
+{
+    char temp[8];
+    this->toLECS(num, temp);
+    return std::string(temp, sizeof(temp));
+}
+
+#ifdef ZYXCBA_HAS_INT128
+std::string ZEndianUtility::toLittleEndianStdStringFromInt128(const zint128 &num) const
+{
+    char temp[16];
+    this->toLECS(num, temp);
+    return std::string(temp, sizeof(temp));
+}
+
+std::string ZEndianUtility::toLittleEndianStdStringFromUInt128(const zuint128 &num) const
+{
+    char temp[16];
+    this->toLECS(num, temp);
+    return std::string(temp, sizeof(temp));
 }
+#endif
 
 char ZEndianUtility::toInt8FromBigEndianStdString(const std::string &numstr) const
 {
@@ -261,10 +985,7 @@ short ZEndianUtility::toInt16FromBigEndianStdString(const std::string &numstr) c
 unsigned short ZEndianUtility::toUInt16FromBigEndianStdString(const std::string &numstr) const
 {
     assert(numstr.length()==2);
-    unsigned short r;
-    std::memcpy(&r,numstr.data(),2);
-    if(this->m_isLittleEndian) r = this->byteSwapUInt16(r);
-    return r;
+    return load_be<unsigned short>(numstr.data());
 }
 
 int ZEndianUtility::toInt32FromBigEndianStdString(const std::string &numstr) const
@@ -275,10 +996,7 @@ int ZEndianUtility::toInt32FromBigEndianStdString(const std::string &numstr) con
 unsigned int ZEndianUtility::toUInt32FromBigEndianStdString(const std::string &numstr) const
 {
     assert(numstr.length()==4);
-    unsigned int r;
-    std::memcpy(&r,numstr.data(),4);
-    if(this->m_isLittleEndian) r = this->byteSwapUInt32(r);
-    return r;
+    return load_be<unsigned int>(numstr.data());
 }
 
 long long ZEndianUtility::toInt64FromBigEndianStdString(const std::string &numstr) const
@@ -289,42 +1007,282 @@ long long ZEndianUtility::toInt64FromBigEndianStdString(const std::string &numst
 unsigned long long ZEndianUtility::toUInt64FromBigEndianStdString(const std::string &numstr) const
 {
     assert(numstr.length()==8);
-    unsigned long long r;
-    std::memcpy(&r,numstr.data(),8);
-    if(this->m_isLittleEndian) r = this->byteSwapUInt64(r);
-    return r;
+    return load_be<unsigned long long>(numstr.data());
+}
+
+float ZEndianUtility::toFloat32FromBigEndianStdString(const std::string &numstr) const
+{
+    assert(numstr.length()==4);
+    return load_be<float>(numstr.data());
+}
+
+double ZEndianUtility::toFloat64FromBigEndianStdString(const std::string &numstr) const
+{
+    assert(numstr.length()==8);
+    return load_be<double>(numstr.data());
+}
+
+#ifdef ZYXCBA_HAS_INT128
+zint128 ZEndianUtility::toInt128FromBigEndianStdString(const std::string &numstr) const
+{
+    assert(numstr.length()==16);
+    return load_be<zint128>(numstr.data());
+}
+
+zuint128 ZEndianUtility::toUInt128FromBigEndianStdString(const std::string &numstr) const
+{
+    assert(numstr.length()==16);
+    return load_be<zuint128>(numstr.data());
+}
+#endif
+
+char *ZEndianUtility::toBigEndianCharStringFromUInt8(const unsigned char &num, char *destination) const
+{
+    return this->toBECS(num, destination);
+}
+
+char *ZEndianUtility::toBigEndianCharStringFromUInt16(const unsigned short &num, char *destination) const
+{
+    return this->toBECS(num, destination);
+}
+
+char *ZEndianUtility::toBigEndianCharStringFromUInt32(const unsigned int &num, char *destination) const
+{
+    return this->toBECS(num, destination);
+}
+
+char *ZEndianUtility::toBigEndianCharStringFromUInt64(const unsigned long long &num, char *destination) const
+{
+    return this->toBECS(num, destination);
+}
+
+char *ZEndianUtility::toLittleEndianCharStringFromUInt8(const unsigned char &num, char *destination) const
+{
+    return this->toLECS(num, destination);
+}
+
+char *ZEndianUtility::toLittleEndianCharStringFromUInt16(const unsigned short &num, char *destination) const
+{
+    return this->toLECS(num, destination);
+}
+
+char *ZEndianUtility::toLittleEndianCharStringFromUInt32(const unsigned int &num, char *destination) const
+{
+    return this->toLECS(num, destination);
+}
+
+char *ZEndianUtility::toLittleEndianCharStringFromUInt64(const unsigned long long &num, char *destination) const
+{
+    return this->toLECS(num, destination);
+}
+
+char *ZEndianUtility::toBigEndianCharStringFromInt8(const char &num, char *destination) const
+{
+    return this->toBECS(num, destination);
+}
+
+char *ZEndianUtility::toBigEndianCharStringFromInt16(const short &num, char *destination) const
+{
+    return this->toBECS(num, destination);
+}
+
+char *ZEndianUtility::toBigEndianCharStringFromInt32(const int &num, char *destination) const
+{
+    return this->toBECS(num, destination);
+}
+
+char *ZEndianUtility::toBigEndianCharStringFromInt64(const long long &num, char *destination) const
+{
+    return this->toBECS(num, destination);
+}
+
+char *ZEndianUtility::toBigEndianCharStringFromFloat32(const float &num, char *destination) const
+{
+    return this->toBECS(num, destination);
+}
+
+char *ZEndianUtility::toBigEndianCharStringFromFloat64(const double &num, char *destination) const
+{
+    return this->toBECS(num, destination);
 }
 
+#ifdef ZYXCBA_HAS_INT128
+char *ZEndianUtility::toBigEndianCharStringFromInt128(const zint128 &num, char *destination) const
+{
+    return this->toBECS(num, destination);
+}
+
+char *ZEndianUtility::toBigEndianCharStringFromUInt128(const zuint128 &num, char *destination) const
+{
+    return this->toBECS(num, destination);
+}
+#endif
+
+char *ZEndianUtility::toLittleEndianCharStringFromInt8(const char &num, char *destination) const
+{
+    return this->toLECS(num, destination);
+}
+
+char *ZEndianUtility::toLittleEndianCharStringFromInt16(const short &num, char *destination) const
+{
+    return this->toLECS(num, destination);
+}
+
+char *ZEndianUtility::toLittleEndianCharStringFromInt32(const int &num, char *destination) const
+{
+    return this->toLECS(num, destination);
+}
+
+char *ZEndianUtility::toLittleEndianCharStringFromInt64(const long long &num, char *destination) const
+{
+    return this->toLECS(num, destination);
+}
+
+char *ZEndianUtility::toLittleEndianCharStringFromFloat32(const float &num, char *destination) const
+{
+    return this->toLECS(num, destination);
+}
+
+char *ZEndianUtility::toLittleEndianCharStringFromFloat64(const double &num, char *destination) const
+{
+    return this->toLECS(num, destination);
+}
+
+#ifdef ZYXCBA_HAS_INT128
+char *ZEndianUtility::toLittleEndianCharStringFromInt128(const zint128 &num, char *destination) const
+{
+    return this->toLECS(num, destination);
+}
+
+char *ZEndianUtility::toLittleEndianCharStringFromUInt128(const zuint128 &num, char *destination) const
+{
+    return this->toLECS(num, destination);
+}
+#endif
+
 unsigned char ZEndianUtility::toUInt8FromBigEndianCharString(const char *numstr) const
 {
-    unsigned char r;
-    std::memcpy(&r,numstr,1);
-    return r;
+    return load_be<unsigned char>(numstr);
 }
 
 unsigned short ZEndianUtility::toUInt16FromBigEndianCharString(const char *numstr) const
 {
-    unsigned short r;
-    std::memcpy(&r,numstr,2);
-    if(this->m_isLittleEndian) r = this->byteSwapUInt16(r);
-    return r;
+    return load_be<unsigned short>(numstr);
 }
 
 unsigned int ZEndianUtility::toUInt32FromBigEndianCharString(const char *numstr) const
 {
-    unsigned int r;
-    std::memcpy(&r,numstr,4);
-    if(this->m_isLittleEndian) r = this->byteSwapUInt32(r);
-    return r;
+    return load_be<unsigned int>(numstr);
 }
 
 unsigned long long ZEndianUtility::toUInt64FromBigEndianCharString(const char *numstr) const
 {
-    unsigned long long r;
-    std::memcpy(&r,numstr,8);
-    if(this->m_isLittleEndian) r = this->byteSwapUInt64(r);
-    return r;
+    return load_be<unsigned long long>(numstr);
+}
+
+char ZEndianUtility::toInt8FromBigEndianCharString(const char *numstr) const
+{
+    return load_be<char>(numstr);
+}
+
+short ZEndianUtility::toInt16FromBigEndianCharString(const char *numstr) const
+{
+    return load_be<short>(numstr);
+}
+
+int ZEndianUtility::toInt32FromBigEndianCharString(const char *numstr) const
+{
+    return load_be<int>(numstr);
+}
+
+long long ZEndianUtility::toInt64FromBigEndianCharString(const char *numstr) const
+{
+    return load_be<long long>(numstr);
+}
+
+float ZEndianUtility::toFloat32FromBigEndianCharString(const char *numstr) const
+{
+    return load_be<float>(numstr);
+}
+
+double ZEndianUtility::toFloat64FromBigEndianCharString(const char *numstr) const
+{
+    return load_be<double>(numstr);
+}
+
+#ifdef ZYXCBA_HAS_INT128
+zint128 ZEndianUtility::toInt128FromBigEndianCharString(const char *numstr) const
+{
+    return load_be<zint128>(numstr);
+}
+
+zuint128 ZEndianUtility::toUInt128FromBigEndianCharString(const char *numstr) const
+{
+    return load_be<zuint128>(numstr);
+}
+#endif
+
+unsigned char ZEndianUtility::toUInt8FromLittleEndianCharString(const char *numstr) const
+{
+    return load_le<unsigned char>(numstr);
+}
+
+unsigned short ZEndianUtility::toUInt16FromLittleEndianCharString(const char *numstr) const
+{
+    return load_le<unsigned short>(numstr);
+}
+
+unsigned int ZEndianUtility::toUInt32FromLittleEndianCharString(const char *numstr) const
+{
+    return load_le<unsigned int>(numstr);
+}
+
+unsigned long long ZEndianUtility::toUInt64FromLittleEndianCharString(const char *numstr) const
+{
+    return load_le<unsigned long long>(numstr);
+}
+
+char ZEndianUtility::toInt8FromLittleEndianCharString(const char *numstr) const
+{
+    return load_le<char>(numstr);
+}
+
+short ZEndianUtility::toInt16FromLittleEndianCharString(const char *numstr) const
+{
+    return load_le<short>(numstr);
+}
+
+int ZEndianUtility::toInt32FromLittleEndianCharString(const char *numstr) const
+{
+    return load_le<int>(numstr);
+}
+
+long long ZEndianUtility::toInt64FromLittleEndianCharString(const char *numstr) const
+{
+    return load_le<long long>(numstr);
+}
+
+float ZEndianUtility::toFloat32FromLittleEndianCharString(const char *numstr) const
+{
+    return load_le<float>(numstr);
+}
+
+double ZEndianUtility::toFloat64FromLittleEndianCharString(const char *numstr) const
+{
+    return load_le<double>(numstr);
+}
+
+#ifdef ZYXCBA_HAS_INT128
+zint128 ZEndianUtility::toInt128FromLittleEndianCharString(const char *numstr) const
+{
+    return load_le<zint128>(numstr);
+}
+
+zuint128 ZEndianUtility::toUInt128FromLittleEndianCharString(const char *numstr) const
+{
+    return load_le<zuint128>(numstr);
 }
+#endif
 
 char ZEndianUtility::toInt8FromLittleEndianStdString(const std::string &numstr) const
 {
@@ -338,6 +1296,32 @@ unsigned char ZEndianUtility::toUInt8FromLittleEndianStdString(const std::string
     return static_cast<unsigned char>(numstr.at(0));
 }
 
+float ZEndianUtility::toFloat32FromLittleEndianStdString(const std::string &numstr) const
+{
+    assert(numstr.length()==4);
+    return load_le<float>(numstr.data());
+}
+
+double ZEndianUtility::toFloat64FromLittleEndianStdString(const std::string &numstr) const
+{
+    assert(numstr.length()==8);
+    return load_le<double>(numstr.data());
+}
+
+#ifdef ZYXCBA_HAS_INT128
+zint128 ZEndianUtility::toInt128FromLittleEndianStdString(const std::string &numstr) const
+{
+    assert(numstr.length()==16);
+    return load_le<zint128>(numstr.data());
+}
+
+zuint128 ZEndianUtility::toUInt128FromLittleEndianStdString(const std::string &numstr) const
+{
+    assert(numstr.length()==16);
+    return load_le<zuint128>(numstr.data());
+}
+#endif
+
 short ZEndianUtility::toInt16FromLittleEndianStdString(const std::string &numstr) const
 {
     return static_cast<short>(this->toUInt16FromLittleEndianStdString(numstr));
@@ -346,10 +1330,7 @@ short ZEndianUtility::toInt16FromLittleEndianStdString(const std::string &numstr
 unsigned short ZEndianUtility::toUInt16FromLittleEndianStdString(const std::string &numstr) const
 {
     assert(numstr.length()==2);
-    unsigned short r;
-    std::memcpy(&r,numstr.data(),2);
-    if(!this->m_isLittleEndian) r = this->byteSwapUInt16(r);
-    return r;
+    return load_le<unsigned short>(numstr.data());
 }
 
 int ZEndianUtility::toInt32FromLittleEndianStdString(const std::string &numstr) const
@@ -360,10 +1341,7 @@ int ZEndianUtility::toInt32FromLittleEndianStdString(const std::string &numstr)
 unsigned int ZEndianUtility::toUInt32FromLittleEndianStdString(const std::string &numstr) const
 {
     assert(numstr.length()==4);
-    unsigned int r;
-    std::memcpy(&r,numstr.data(),4);
-    if(!this->m_isLittleEndian) r = this->byteSwapUInt32(r);
-    return r;
+    return load_le<unsigned int>(numstr.data());
 }
 
 long long ZEndianUtility::toInt64FromLittleEndianStdString(const std::string &numstr) const
@@ -374,10 +1352,7 @@ long long ZEndianUtility::toInt64FromLittleEndianStdString(const std::string &nu
 unsigned long long ZEndianUtility::toUInt64FromLittleEndianStdString(const std::string &numstr) const
 {
     assert(numstr.length()==8);
-    unsigned long long r;
-    std::memcpy(&r,numstr.data(),8);
-    if(!this->m_isLittleEndian) r = this->byteSwapUInt64(r);
-    return r;
+    return load_le<unsigned long long>(numstr.data());
 }
 
 unsigned char ZEndianUtility::byteSwapInt8(const char &num) const
@@ -407,31 +1382,59 @@ unsigned char ZEndianUtility::byteSwapUInt8(const unsigned char &num) const
 
 unsigned short ZEndianUtility::byteSwapUInt16(const unsigned short &num) const
 {
-    return static_cast<unsigned short>( 0
-                                        | ((num & 0x00ff) << 8)
-                                        | ((num & 0xff00) >> 8) );
+    return byte_swap(num);
 }
 
 unsigned int ZEndianUtility::byteSwapUInt32(const unsigned int &num) const
 {
-    return 0
-            | ((num & 0x000000ff) << 24)
-            | ((num & 0x0000ff00) << 8)
-            | ((num & 0x00ff0000) >> 8)
-            | ((num & 0xff000000) >> 24);
+    return byte_swap(num);
 }
 
 unsigned long long ZEndianUtility::byteSwapUInt64(const unsigned long long &num) const
 {
-    return 0
-            | ((num & 0x00000000000000ffULL) << 56)
-            | ((num & 0x000000000000ff00ULL) << 40)
-            | ((num & 0x0000000000ff0000ULL) << 24)
-            | ((num & 0x00000000ff000000ULL) << 8)
-            | ((num & 0x000000ff00000000ULL) >> 8)
-            | ((num & 0x0000ff0000000000ULL) >> 24)
-            | ((num & 0x00ff000000000000ULL) >> 40)
-            | ((num & 0xff00000000000000ULL) >> 56);
+    return byte_swap(num);
+}
+
+#ifdef ZYXCBA_HAS_INT128
+zint128 ZEndianUtility::byteSwapInt128(const zint128 &num) const
+{
+    return byte_swap(num);
+}
+
+zuint128 ZEndianUtility::byteSwapUInt128(const zuint128 &num) const
+{
+    return byte_swap(num);
+}
+#endif
+
+void ZEndianUtility::byteSwapArray(unsigned short *destination, const unsigned short *source, const std::size_t &count) const
+{
+    ZBulkByteSwap::swapBytes(ZBulkByteSwap::activeKernel(), destination, source, count, sizeof(unsigned short));
+}
+
+void ZEndianUtility::byteSwapArray(unsigned int *destination, const unsigned int *source, const std::size_t &count) const
+{
+    ZBulkByteSwap::swapBytes(ZBulkByteSwap::activeKernel(), destination, source, count, sizeof(unsigned int));
+}
+
+void ZEndianUtility::byteSwapArray(unsigned long long *destination, const unsigned long long *source, const std::size_t &count) const
+{
+    ZBulkByteSwap::swapBytes(ZBulkByteSwap::activeKernel(), destination, source, count, sizeof(unsigned long long));
+}
+
+void ZEndianUtility::byteSwapArray(unsigned short *data, const std::size_t &count) const
+{
+    this->byteSwapArray(data, data, count);
+}
+
+void ZEndianUtility::byteSwapArray(unsigned int *data, const std::size_t &count) const
+{
+    this->byteSwapArray(data, data, count);
+}
+
+void ZEndianUtility::byteSwapArray(unsigned long long *data, const std::size_t &count) const
+{
+    this->byteSwapArray(data, data, count);
 }
 
 }
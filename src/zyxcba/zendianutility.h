@@ -36,19 +36,22 @@
 #include <cstring>
 #include <iostream>
 
+#include "zendian.h"
+
 namespace zyxcba {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief The ZEndianUtility class
 ///
-/// ZEndianUtility is useful to determine endianess about the cpu on runtime and some
-/// necessary methods for byte ordering and manipulation.
+/// ZEndianUtility is useful to determine endianess about the cpu and some necessary methods
+/// for byte ordering and manipulation. The methods forward to the constexpr primitives of
+/// zendian.h, which resolve the byte order at compile time.
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 class ZEndianUtility
 {
 public:
     explicit ZEndianUtility();
-    virtual ~ZEndianUtility();
+    ~ZEndianUtility();
 
     bool isBigEndian() const;
     bool isLittleEndian() const;
@@ -71,11 +74,158 @@ public:
     std::string toLESS(const unsigned int &num) const;
     std::string toLESS(const unsigned long long &num) const;
 
+    std::string toBESS(const char &num) const;
+    std::string toBESS(const short &num) const;
+    std::string toBESS(const int &num) const;
+    std::string toBESS(const long long &num) const;
+    std::string toBESS(const float &num) const;
+    std::string toBESS(const double &num) const;
+#ifdef ZYXCBA_HAS_INT128
+    std::string toBESS(const zint128 &num) const;
+    std::string toBESS(const zuint128 &num) const;
+#endif
+
+    std::string toLESS(const char &num) const;
+    std::string toLESS(const short &num) const;
+    std::string toLESS(const int &num) const;
+    std::string toLESS(const long long &num) const;
+    std::string toLESS(const float &num) const;
+    std::string toLESS(const double &num) const;
+#ifdef ZYXCBA_HAS_INT128
+    std::string toLESS(const zint128 &num) const;
+    std::string toLESS(const zuint128 &num) const;
+#endif
+
+    /* store into a caller buffer and return the position after the written bytes */
+    char *toBECS(const unsigned char &num, char *destination) const;
+    char *toBECS(const unsigned short &num, char *destination) const;
+    char *toBECS(const unsigned int &num, char *destination) const;
+    char *toBECS(const unsigned long long &num, char *destination) const;
+
+    char *toLECS(const unsigned char &num, char *destination) const;
+    char *toLECS(const unsigned short &num, char *destination) const;
+    char *toLECS(const unsigned int &num, char *destination) const;
+    char *toLECS(const unsigned long long &num, char *destination) const;
+
+    char *toBECS(const char &num, char *destination) const;
+    char *toBECS(const short &num, char *destination) const;
+    char *toBECS(const int &num, char *destination) const;
+    char *toBECS(const long long &num, char *destination) const;
+    char *toBECS(const float &num, char *destination) const;
+    char *toBECS(const double &num, char *destination) const;
+#ifdef ZYXCBA_HAS_INT128
+    char *toBECS(const zint128 &num, char *destination) const;
+    char *toBECS(const zuint128 &num, char *destination) const;
+#endif
+
+    char *toLECS(const char &num, char *destination) const;
+    char *toLECS(const short &num, char *destination) const;
+    char *toLECS(const int &num, char *destination) const;
+    char *toLECS(const long long &num, char *destination) const;
+    char *toLECS(const float &num, char *destination) const;
+    char *toLECS(const double &num, char *destination) const;
+#ifdef ZYXCBA_HAS_INT128
+    char *toLECS(const zint128 &num, char *destination) const;
+    char *toLECS(const zuint128 &num, char *destination) const;
+#endif
+
+    /* bounded variants, return nullptr without writing when the value does not fit before end */
+    char *toBECS(const unsigned char &num, char *destination, const char *end) const;
+    char *toBECS(const unsigned short &num, char *destination, const char *end) const;
+    char *toBECS(const unsigned int &num, char *destination, const char *end) const;
+    char *toBECS(const unsigned long long &num, char *destination, const char *end) const;
+
+    char *toLECS(const unsigned char &num, char *destination, const char *end) const;
+    char *toLECS(const unsigned short &num, char *destination, const char *end) const;
+    char *toLECS(const unsigned int &num, char *destination, const char *end) const;
+    char *toLECS(const unsigned long long &num, char *destination, const char *end) const;
+
+    char *toBECS(const char &num, char *destination, const char *end) const;
+    char *toBECS(const short &num, char *destination, const char *end) const;
+    char *toBECS(const int &num, char *destination, const char *end) const;
+    char *toBECS(const long long &num, char *destination, const char *end) const;
+    char *toBECS(const float &num, char *destination, const char *end) const;
+    char *toBECS(const double &num, char *destination, const char *end) const;
+#ifdef ZYXCBA_HAS_INT128
+    char *toBECS(const zint128 &num, char *destination, const char *end) const;
+    char *toBECS(const zuint128 &num, char *destination, const char *end) const;
+#endif
+
+    char *toLECS(const char &num, char *destination, const char *end) const;
+    char *toLECS(const short &num, char *destination, const char *end) const;
+    char *toLECS(const int &num, char *destination, const char *end) const;
+    char *toLECS(const long long &num, char *destination, const char *end) const;
+    char *toLECS(const float &num, char *destination, const char *end) const;
+    char *toLECS(const double &num, char *destination, const char *end) const;
+#ifdef ZYXCBA_HAS_INT128
+    char *toLECS(const zint128 &num, char *destination, const char *end) const;
+    char *toLECS(const zuint128 &num, char *destination, const char *end) const;
+#endif
+
+    /* append to a buffer that is reused across calls */
+    void appendBESS(std::string &buffer, const unsigned char &num) const;
+    void appendBESS(std::string &buffer, const unsigned short &num) const;
+    void appendBESS(std::string &buffer, const unsigned int &num) const;
+    void appendBESS(std::string &buffer, const unsigned long long &num) const;
+
+    void appendLESS(std::string &buffer, const unsigned char &num) const;
+    void appendLESS(std::string &buffer, const unsigned short &num) const;
+    void appendLESS(std::string &buffer, const unsigned int &num) const;
+    void appendLESS(std::string &buffer, const unsigned long long &num) const;
+
+    void appendBESS(std::string &buffer, const char &num) const;
+    void appendBESS(std::string &buffer, const short &num) const;
+    void appendBESS(std::string &buffer, const int &num) const;
+    void appendBESS(std::string &buffer, const long long &num) const;
+    void appendBESS(std::string &buffer, const float &num) const;
+    void appendBESS(std::string &buffer, const double &num) const;
+#ifdef ZYXCBA_HAS_INT128
+    void appendBESS(std::string &buffer, const zint128 &num) const;
+    void appendBESS(std::string &buffer, const zuint128 &num) const;
+#endif
+
+    void appendLESS(std::string &buffer, const char &num) const;
+    void appendLESS(std::string &buffer, const short &num) const;
+    void appendLESS(std::string &buffer, const int &num) const;
+    void appendLESS(std::string &buffer, const long long &num) const;
+    void appendLESS(std::string &buffer, const float &num) const;
+    void appendLESS(std::string &buffer, const double &num) const;
+#ifdef ZYXCBA_HAS_INT128
+    void appendLESS(std::string &buffer, const zint128 &num) const;
+    void appendLESS(std::string &buffer, const zuint128 &num) const;
+#endif
+
     unsigned char toUInt8FromBESS(const std::string &numstr) const;
     unsigned short toUInt16FromBESS(const std::string &numstr) const;
     unsigned int toUInt32FromBESS(const std::string &numstr) const;
     unsigned long long toUInt64FromBESS(const std::string &numstr) const;
 
+    char toInt8FromBESS(const std::string &numstr) const;
+    short toInt16FromBESS(const std::string &numstr) const;
+    int toInt32FromBESS(const std::string &numstr) const;
+    long long toInt64FromBESS(const std::string &numstr) const;
+    float toFloat32FromBESS(const std::string &numstr) const;
+    double toFloat64FromBESS(const std::string &numstr) const;
+#ifdef ZYXCBA_HAS_INT128
+    zint128 toInt128FromBESS(const std::string &numstr) const;
+    zuint128 toUInt128FromBESS(const std::string &numstr) const;
+#endif
+
+    unsigned char toUInt8FromLESS(const std::string &numstr) const;
+    unsigned short toUInt16FromLESS(const std::string &numstr) const;
+    unsigned int toUInt32FromLESS(const std::string &numstr) const;
+    unsigned long long toUInt64FromLESS(const std::string &numstr) const;
+    char toInt8FromLESS(const std::string &numstr) const;
+    short toInt16FromLESS(const std::string &numstr) const;
+    int toInt32FromLESS(const std::string &numstr) const;
+    long long toInt64FromLESS(const std::string &numstr) const;
+    float toFloat32FromLESS(const std::string &numstr) const;
+    double toFloat64FromLESS(const std::string &numstr) const;
+#ifdef ZYXCBA_HAS_INT128
+    zint128 toInt128FromLESS(const std::string &numstr) const;
+    zuint128 toUInt128FromLESS(const std::string &numstr) const;
+#endif
+
     std::string toBigEndianStdStringFromUInt8(const unsigned char &num) const;
     std::string toBigEndianStdStringFromUInt16(const unsigned short &num) const;
     std::string toBigEndianStdStringFromUInt32(const unsigned int &num) const;
@@ -86,6 +236,28 @@ public:
     std::string toLittleEndianStdStringFromUInt32(const unsigned int &num) const;
     std::string toLittleEndianStdStringFromUInt64(const unsigned long long &num) const;
 
+    std::string toBigEndianStdStringFromInt8(const char &num) const;
+    std::string toBigEndianStdStringFromInt16(const short &num) const;
+    std::string toBigEndianStdStringFromInt32(const int &num) const;
+    std::string toBigEndianStdStringFromInt64(const long long &num) const;
+    std::string toBigEndianStdStringFromFloat32(const float &num) const;
+    std::string toBigEndianStdStringFromFloat64(const double &num) const;
+#ifdef ZYXCBA_HAS_INT128
+    std::string toBigEndianStdStringFromInt128(const zint128 &num) const;
+    std::string toBigEndianStdStringFromUInt128(const zuint128 &num) const;
+#endif
+
+    std::string toLittleEndianStdStringFromInt8(const char &num) const;
+    std::string toLittleEndianStdStringFromInt16(const short &num) const;
+    std::string toLittleEndianStdStringFromInt32(const int &num) const;
+    std::string toLittleEndianStdStringFromInt64(const long long &num) const;
+    std::string toLittleEndianStdStringFromFloat32(const float &num) const;
+    std::string toLittleEndianStdStringFromFloat64(const double &num) const;
+#ifdef ZYXCBA_HAS_INT128
+    std::string toLittleEndianStdStringFromInt128(const zint128 &num) const;
+    std::string toLittleEndianStdStringFromUInt128(const zuint128 &num) const;
+#endif
+
     char toInt8FromBigEndianStdString(const std::string &numstr) const;
     short toInt16FromBigEndianStdString(const std::string &numstr) const;
     int toInt32FromBigEndianStdString(const std::string &numstr) const;
@@ -96,11 +268,76 @@ public:
     unsigned int toUInt32FromBigEndianStdString(const std::string &numstr) const;
     unsigned long long toUInt64FromBigEndianStdString(const std::string &numstr) const;
 
+    float toFloat32FromBigEndianStdString(const std::string &numstr) const;
+    double toFloat64FromBigEndianStdString(const std::string &numstr) const;
+#ifdef ZYXCBA_HAS_INT128
+    zint128 toInt128FromBigEndianStdString(const std::string &numstr) const;
+    zuint128 toUInt128FromBigEndianStdString(const std::string &numstr) const;
+#endif
+
+    char *toBigEndianCharStringFromUInt8(const unsigned char &num, char *destination) const;
+    char *toBigEndianCharStringFromUInt16(const unsigned short &num, char *destination) const;
+    char *toBigEndianCharStringFromUInt32(const unsigned int &num, char *destination) const;
+    char *toBigEndianCharStringFromUInt64(const unsigned long long &num, char *destination) const;
+
+    char *toLittleEndianCharStringFromUInt8(const unsigned char &num, char *destination) const;
+    char *toLittleEndianCharStringFromUInt16(const unsigned short &num, char *destination) const;
+    char *toLittleEndianCharStringFromUInt32(const unsigned int &num, char *destination) const;
+    char *toLittleEndianCharStringFromUInt64(const unsigned long long &num, char *destination) const;
+
+    char *toBigEndianCharStringFromInt8(const char &num, char *destination) const;
+    char *toBigEndianCharStringFromInt16(const short &num, char *destination) const;
+    char *toBigEndianCharStringFromInt32(const int &num, char *destination) const;
+    char *toBigEndianCharStringFromInt64(const long long &num, char *destination) const;
+    char *toBigEndianCharStringFromFloat32(const float &num, char *destination) const;
+    char *toBigEndianCharStringFromFloat64(const double &num, char *destination) const;
+#ifdef ZYXCBA_HAS_INT128
+    char *toBigEndianCharStringFromInt128(const zint128 &num, char *destination) const;
+    char *toBigEndianCharStringFromUInt128(const zuint128 &num, char *destination) const;
+#endif
+
+    char *toLittleEndianCharStringFromInt8(const char &num, char *destination) const;
+    char *toLittleEndianCharStringFromInt16(const short &num, char *destination) const;
+    char *toLittleEndianCharStringFromInt32(const int &num, char *destination) const;
+    char *toLittleEndianCharStringFromInt64(const long long &num, char *destination) const;
+    char *toLittleEndianCharStringFromFloat32(const float &num, char *destination) const;
+    char *toLittleEndianCharStringFromFloat64(const double &num, char *destination) const;
+#ifdef ZYXCBA_HAS_INT128
+    char *toLittleEndianCharStringFromInt128(const zint128 &num, char *destination) const;
+    char *toLittleEndianCharStringFromUInt128(const zuint128 &num, char *destination) const;
+#endif
+
     unsigned char toUInt8FromBigEndianCharString(const char *numstr) const;
     unsigned short toUInt16FromBigEndianCharString(const char *numstr) const;
     unsigned int toUInt32FromBigEndianCharString(const char *numstr) const;
     unsigned long long toUInt64FromBigEndianCharString(const char *numstr) const;
 
+    char toInt8FromBigEndianCharString(const char *numstr) const;
+    short toInt16FromBigEndianCharString(const char *numstr) const;
+    int toInt32FromBigEndianCharString(const char *numstr) const;
+    long long toInt64FromBigEndianCharString(const char *numstr) const;
+    float toFloat32FromBigEndianCharString(const char *numstr) const;
+    double toFloat64FromBigEndianCharString(const char *numstr) const;
+#ifdef ZYXCBA_HAS_INT128
+    zint128 toInt128FromBigEndianCharString(const char *numstr) const;
+    zuint128 toUInt128FromBigEndianCharString(const char *numstr) const;
+#endif
+
+    unsigned char toUInt8FromLittleEndianCharString(const char *numstr) const;
+    unsigned short toUInt16FromLittleEndianCharString(const char *numstr) const;
+    unsigned int toUInt32FromLittleEndianCharString(const char *numstr) const;
+    unsigned long long toUInt64FromLittleEndianCharString(const char *numstr) const;
+    char toInt8FromLittleEndianCharString(const char *numstr) const;
+    short toInt16FromLittleEndianCharString(const char *numstr) const;
+    int toInt32FromLittleEndianCharString(const char *numstr) const;
+    long long toInt64FromLittleEndianCharString(const char *numstr) const;
+    float toFloat32FromLittleEndianCharString(const char *numstr) const;
+    double toFloat64FromLittleEndianCharString(const char *numstr) const;
+#ifdef ZYXCBA_HAS_INT128
+    zint128 toInt128FromLittleEndianCharString(const char *numstr) const;
+    zuint128 toUInt128FromLittleEndianCharString(const char *numstr) const;
+#endif
+
 
     char toInt8FromLittleEndianStdString(const std::string &numstr) const;
     short toInt16FromLittleEndianStdString(const std::string &numstr) const;
@@ -112,6 +349,13 @@ public:
     unsigned short toUInt16FromLittleEndianStdString(const std::string &numstr) const;
     unsigned char toUInt8FromLittleEndianStdString(const std::string &numstr) const;
 
+    float toFloat32FromLittleEndianStdString(const std::string &numstr) const;
+    double toFloat64FromLittleEndianStdString(const std::string &numstr) const;
+#ifdef ZYXCBA_HAS_INT128
+    zint128 toInt128FromLittleEndianStdString(const std::string &numstr) const;
+    zuint128 toUInt128FromLittleEndianStdString(const std::string &numstr) const;
+#endif
+
 
     unsigned char byteSwapInt8(const char &num) const;
     unsigned short byteSwapInt16(const short &num) const;
@@ -123,7 +367,26 @@ public:
     unsigned int byteSwapUInt32(const unsigned int &num) const;
     unsigned long long byteSwapUInt64(const unsigned long long &num) const;
 
+#ifdef ZYXCBA_HAS_INT128
+    zint128 byteSwapInt128(const zint128 &num) const;
+    zuint128 byteSwapUInt128(const zuint128 &num) const;
+#endif
+
+    /* bulk variants, see ZBulkByteSwap */
+    void byteSwapArray(unsigned short *destination, const unsigned short *source, const std::size_t &count) const;
+    void byteSwapArray(unsigned int *destination, const unsigned int *source, const std::size_t &count) const;
+    void byteSwapArray(unsigned long long *destination, const unsigned long long *source, const std::size_t &count) const;
+
+    void byteSwapArray(unsigned short *data, const std::size_t &count) const;
+    void byteSwapArray(unsigned int *data, const std::size_t &count) const;
+    void byteSwapArray(unsigned long long *data, const std::size_t &count) const;
+
 private:
+    template<typename T>
+    static char *storeBigEndian(const T &num, char *destination, const char *end);
+    template<typename T>
+    static char *storeLittleEndian(const T &num, char *destination, const char *end);
+
     bool m_isLittleEndian;
 };
 
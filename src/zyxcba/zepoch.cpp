@@ -0,0 +1,205 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "zepoch.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace zyxcba {
+
+namespace {
+
+const std::size_t CacheLineSize = 64;
+
+/* one per thread that ever entered, reused after the thread ends and never freed, padded on
+ * both sides so no two slots share a cache line whatever the allocator alignment
+ */
+struct ZEpochSlot
+{
+    ZEpochSlot(): epoch(0), used(true), next(nullptr) {}
+
+    char before[CacheLineSize];
+    std::atomic<std::uint64_t> epoch;
+    std::atomic<bool> used;
+    ZEpochSlot *next;
+    char after[CacheLineSize];
+};
+
+struct ZRetired
+{
+    void *object;
+    ZEpoch::ZDeleter deleter;
+    std::uint64_t epoch;
+};
+
+std::atomic<std::uint64_t> g_epoch(1);
+std::atomic<ZEpochSlot*> g_slots(nullptr);
+
+std::mutex &retiredMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<ZRetired> &retiredObjects()
+{
+    static std::vector<ZRetired> objects;
+    return objects;
+}
+
+ZEpochSlot *acquireSlot()
+{
+    for(ZEpochSlot *slot = g_slots.load(std::memory_order_acquire); slot != nullptr; slot = slot->next)
+    {
+        bool expected = false;
+        if(!slot->used.load(std::memory_order_relaxed) && slot->used.compare_exchange_strong(expected, true)) return slot;
+    }
+
+    ZEpochSlot *slot = new ZEpochSlot();
+    ZEpochSlot *head = g_slots.load(std::memory_order_relaxed);
+    do
+    {
+        slot->next = head;
+    }
+    while(!g_slots.compare_exchange_weak(head, slot, std::memory_order_release, std::memory_order_relaxed));
+    return slot;
+}
+
+class ZEpochThread
+{
+public:
+    ZEpochThread(): m_slot(nullptr), m_depth(0) {}
+
+    ~ZEpochThread()
+    {
+        if(this->m_slot == nullptr) return;
+        this->m_slot->epoch.store(0, std::memory_order_release);
+        this->m_slot->used.store(false, std::memory_order_release);
+    }
+
+    void enter()
+    {
+        if(this->m_depth++ != 0) return;
+        if(this->m_slot == nullptr) this->m_slot = acquireSlot();
+
+        /* the fence orders the announcement before every read of the shared structure, a
+         * writer scanning the slots either sees it or unlinked before those reads happen
+         */
+        this->m_slot->epoch.store(g_epoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    void leave()
+    {
+        if(--this->m_depth != 0) return;
+        this->m_slot->epoch.store(0, std::memory_order_release);
+    }
+
+private:
+    ZEpochSlot *m_slot;
+    unsigned m_depth;
+};
+
+thread_local ZEpochThread t_epoch;
+
+}
+
+void ZEpoch::enter()
+{
+    t_epoch.enter();
+}
+
+void ZEpoch::leave()
+{
+    t_epoch.leave();
+}
+
+void ZEpoch::retire(void *object, ZDeleter deleter)
+{
+    /* readers announcing the new epoch entered after the object was unlinked */
+    ZRetired retired;
+    retired.object = object;
+    retired.deleter = deleter;
+    retired.epoch = g_epoch.fetch_add(1, std::memory_order_seq_cst);
+
+    std::lock_guard<std::mutex> lock(retiredMutex());
+    retiredObjects().push_back(retired);
+}
+
+std::size_t ZEpoch::reclaim()
+{
+    std::vector<ZRetired> ready;
+    {
+        std::lock_guard<std::mutex> lock(retiredMutex());
+        std::vector<ZRetired> &objects = retiredObjects();
+        if(objects.empty()) return 0;
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::uint64_t oldest = UINT64_MAX;
+        for(ZEpochSlot *slot = g_slots.load(std::memory_order_acquire); slot != nullptr; slot = slot->next)
+        {
+            std::uint64_t epoch = slot->epoch.load(std::memory_order_acquire);
+            if(epoch != 0 && epoch < oldest) oldest = epoch;
+        }
+
+        /* an object retired at epoch e is safe once every active reader announced a later one */
+        std::size_t kept = 0;
+        for(std::size_t index = 0; index < objects.size(); ++index)
+        {
+            if(objects[index].epoch < oldest) ready.push_back(objects[index]);
+            else objects[kept++] = objects[index];
+        }
+        objects.resize(kept);
+    }
+
+    for(const ZRetired &retired : ready)
+    {
+        retired.deleter(retired.object);
+    }
+    return ready.size();
+}
+
+std::size_t ZEpoch::pending()
+{
+    std::lock_guard<std::mutex> lock(retiredMutex());
+    return retiredObjects().size();
+}
+
+std::uint64_t ZEpoch::currentEpoch()
+{
+    return g_epoch.load(std::memory_order_relaxed);
+}
+
+}
@@ -0,0 +1,105 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef ZEPOCH_H
+#define ZEPOCH_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZEpoch class
+///
+/// ZEpoch is a process wide epoch based reclamation domain. Readers of a shared structure wrap
+/// their access in a ZEpochGuard, which only stores the current epoch into a slot owned by the
+/// calling thread, so entering and leaving never writes a cache line another reader uses.
+/// Writers unlink an object first and then retire it. A retired object is deleted by a later
+/// reclaim() once no reader which might still see it is inside a guard.
+///
+/// Guards nest and pointers read under a guard must not be used after it ends. Nothing ever
+/// waits for readers, objects a reader may still hold simply stay until a later reclaim().
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZEpoch
+{
+public:
+    typedef void (*ZDeleter)(void *object);
+
+    static void enter();
+    static void leave();
+
+    /* object must already be unreachable for readers entering from now on */
+    static void retire(void *object, ZDeleter deleter);
+
+    template<typename T>
+    static void retire(T *object)
+    {
+        ZEpoch::retire(object, &ZEpoch::deleteObject<T>);
+    }
+
+    /* deletes the retired objects no reader can hold any more and returns how many */
+    static std::size_t reclaim();
+
+    /* number of retired objects waiting for reclamation */
+    static std::size_t pending();
+
+    static std::uint64_t currentEpoch();
+
+private:
+    template<typename T>
+    static void deleteObject(void *object)
+    {
+        delete static_cast<T*>(object);
+    }
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZEpochGuard class
+///
+/// Keeps the calling thread inside a ZEpoch read section for its lifetime.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZEpochGuard
+{
+public:
+    ZEpochGuard() { ZEpoch::enter(); }
+    ~ZEpochGuard() { ZEpoch::leave(); }
+
+    ZEpochGuard(const ZEpochGuard &) = delete;
+    ZEpochGuard &operator=(const ZEpochGuard &) = delete;
+};
+
+}
+
+#endif // ZEPOCH_H
@@ -0,0 +1,477 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "zhash.h"
+#include "zcpu.h"
+#include "zendian.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define ZYXCBA_HASH_X86 1
+#include <immintrin.h>
+#endif
+
+namespace zyxcba {
+
+namespace {
+
+const std::uint64_t Prime32_1 = 0x9E3779B1U;
+const std::uint64_t Prime32_2 = 0x85EBCA77U;
+const std::uint64_t Prime32_3 = 0xC2B2AE3DU;
+const std::uint64_t Prime64_1 = 0x9E3779B185EBCA87ULL;
+const std::uint64_t Prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+const std::uint64_t Prime64_3 = 0x165667B19E3779F9ULL;
+const std::uint64_t Prime64_4 = 0x85EBCA77C2B2AE63ULL;
+const std::uint64_t Prime64_5 = 0x27D4EB2F165667C5ULL;
+
+const std::size_t SecretSize = 192;
+const std::size_t StripeSize = 64;
+const std::size_t SecretConsumeRate = 8;
+const std::size_t StripesPerBlock = (SecretSize - StripeSize) / SecretConsumeRate;
+const std::size_t BlockSize = StripeSize * StripesPerBlock;
+const std::size_t MidSizeMax = 240;
+
+/* splitmix64 output seeded with Prime64_1 */
+const unsigned char DefaultSecret[SecretSize] = {
+    0x94, 0x3e, 0x94, 0xb4, 0x1e, 0xf2, 0x9f, 0x8c, 0x4c, 0x25, 0x91, 0x09,
+    0xd8, 0xcf, 0x9b, 0x52, 0x6e, 0x5e, 0x1b, 0x93, 0x6d, 0xeb, 0xb8, 0x12,
+    0x21, 0xcc, 0x1f, 0x0c, 0x5d, 0x0c, 0xc5, 0xce, 0xa1, 0x1c, 0xef, 0x26,
+    0x6e, 0x79, 0xf5, 0x31, 0x82, 0xff, 0x1d, 0xd9, 0x5a, 0x0e, 0xad, 0x6f,
+    0x33, 0x54, 0x40, 0xf5, 0xc6, 0x22, 0x1c, 0x06, 0xa1, 0x86, 0x78, 0xe3,
+    0x3b, 0xed, 0xeb, 0xac, 0xa6, 0x13, 0x27, 0x5a, 0x48, 0xe8, 0x81, 0x0d,
+    0x8c, 0x23, 0xfd, 0xf1, 0xf8, 0x00, 0xe6, 0xa3, 0x8e, 0x5f, 0xe5, 0x79,
+    0xc7, 0x82, 0x13, 0xef, 0x40, 0x5d, 0x88, 0x60, 0xff, 0x41, 0x2c, 0xfe,
+    0xb2, 0x4b, 0xc3, 0xda, 0x26, 0xb8, 0xcb, 0x94, 0xf6, 0x31, 0xa7, 0x24,
+    0x87, 0x42, 0x02, 0xb5, 0x15, 0x27, 0xb7, 0x20, 0x95, 0xc2, 0xbe, 0xd0,
+    0x80, 0xbd, 0xfe, 0xac, 0x7c, 0x5f, 0x33, 0x81, 0x08, 0x1d, 0xbd, 0xba,
+    0xaa, 0xe0, 0x4b, 0xe3, 0x1a, 0x43, 0xf8, 0x7e, 0x4d, 0x6b, 0xc8, 0x25,
+    0x7e, 0xfb, 0x1f, 0x46, 0x2a, 0x2b, 0x9c, 0x88, 0x7e, 0x97, 0x0b, 0x19,
+    0xe6, 0x0f, 0x81, 0x6a, 0x40, 0x83, 0x05, 0xf2, 0xa4, 0x7b, 0x4c, 0xa2,
+    0x86, 0x0f, 0x35, 0x02, 0x87, 0x10, 0x5c, 0xba, 0x56, 0x68, 0x1c, 0x8e,
+    0xd6, 0xef, 0xb2, 0x73, 0x0a, 0x45, 0xee, 0x63, 0xc2, 0xd9, 0x39, 0xc5
+};
+
+struct ZSecret
+{
+    unsigned char bytes[SecretSize];
+};
+
+typedef void (*ZHashLongFunction)(std::uint64_t *accumulators, const unsigned char *data, const std::size_t &size,
+                                  const unsigned char *secret);
+
+std::uint64_t read64(const unsigned char *data)
+{
+    return load_le<std::uint64_t>(data);
+}
+
+std::uint32_t read32(const unsigned char *data)
+{
+    return load_le<std::uint32_t>(data);
+}
+
+std::uint64_t rotateLeft(const std::uint64_t &value, const unsigned &bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+std::uint64_t multiplyFold(const std::uint64_t &lhs, const std::uint64_t &rhs)
+{
+#ifdef ZYXCBA_HAS_INT128
+    const zuint128 product = static_cast<zuint128>(lhs) * rhs;
+    return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+    const std::uint64_t lowLow = (lhs & 0xffffffffU) * (rhs & 0xffffffffU);
+    const std::uint64_t highLow = (lhs >> 32) * (rhs & 0xffffffffU);
+    const std::uint64_t lowHigh = (lhs & 0xffffffffU) * (rhs >> 32);
+    const std::uint64_t highHigh = (lhs >> 32) * (rhs >> 32);
+    const std::uint64_t cross = (lowLow >> 32) + (highLow & 0xffffffffU) + lowHigh;
+    const std::uint64_t high = (highLow >> 32) + (cross >> 32) + highHigh;
+    const std::uint64_t low = (cross << 32) | (lowLow & 0xffffffffU);
+    return low ^ high;
+#endif
+}
+
+std::uint64_t avalanche(std::uint64_t value)
+{
+    value ^= value >> 37;
+    value *= 0x165667919E3779F9ULL;
+    return value ^ (value >> 32);
+}
+
+std::uint64_t avalanche64(std::uint64_t value)
+{
+    value ^= value >> 33;
+    value *= Prime64_2;
+    value ^= value >> 29;
+    value *= Prime64_3;
+    return value ^ (value >> 32);
+}
+
+std::uint64_t rrmxmx(std::uint64_t value, const std::size_t &size)
+{
+    value ^= rotateLeft(value, 49) ^ rotateLeft(value, 24);
+    value *= 0x9FB21C651E98DF25ULL;
+    value ^= (value >> 35) + size;
+    value *= 0x9FB21C651E98DF25ULL;
+    return value ^ (value >> 28);
+}
+
+std::uint64_t mix16(const unsigned char *data, const unsigned char *secret, const std::uint64_t &seed)
+{
+    return multiplyFold(read64(data) ^ (read64(secret) + seed), read64(data + 8) ^ (read64(secret + 8) - seed));
+}
+
+std::uint64_t hashUpTo16(const unsigned char *data, const std::size_t &size, const unsigned char *secret, std::uint64_t seed)
+{
+    if(size > 8)
+    {
+        const std::uint64_t low = read64(data) ^ ((read64(secret + 24) ^ read64(secret + 32)) + seed);
+        const std::uint64_t high = read64(data + size - 8) ^ ((read64(secret + 40) ^ read64(secret + 48)) - seed);
+        return avalanche(size + byte_swap(low) + high + multiplyFold(low, high));
+    }
+    if(size >= 4)
+    {
+        seed ^= static_cast<std::uint64_t>(byte_swap(static_cast<std::uint32_t>(seed))) << 32;
+        const std::uint64_t value = read32(data + size - 4) + (static_cast<std::uint64_t>(read32(data)) << 32);
+        return rrmxmx(value ^ ((read64(secret + 8) ^ read64(secret + 16)) - seed), size);
+    }
+    if(size > 0)
+    {
+        const std::uint32_t combined = (static_cast<std::uint32_t>(data[0]) << 16) | (static_cast<std::uint32_t>(data[size >> 1]) << 24)
+                | static_cast<std::uint32_t>(data[size - 1]) | (static_cast<std::uint32_t>(size) << 8);
+        return avalanche64(combined ^ ((read32(secret) ^ read32(secret + 4)) + seed));
+    }
+    return avalanche64(seed ^ read64(secret + 56) ^ read64(secret + 64));
+}
+
+std::uint64_t hashUpTo128(const unsigned char *data, const std::size_t &size, const unsigned char *secret, const std::uint64_t &seed)
+{
+    std::uint64_t accumulator = size * Prime64_1;
+    if(size > 32)
+    {
+        if(size > 64)
+        {
+            if(size > 96)
+            {
+                accumulator += mix16(data + 48, secret + 96, seed);
+                accumulator += mix16(data + size - 64, secret + 112, seed);
+            }
+            accumulator += mix16(data + 32, secret + 64, seed);
+            accumulator += mix16(data + size - 48, secret + 80, seed);
+        }
+        accumulator += mix16(data + 16, secret + 32, seed);
+        accumulator += mix16(data + size - 32, secret + 48, seed);
+    }
+    accumulator += mix16(data, secret, seed);
+    accumulator += mix16(data + size - 16, secret + 16, seed);
+    return avalanche(accumulator);
+}
+
+std::uint64_t hashUpTo240(const unsigned char *data, const std::size_t &size, const unsigned char *secret, const std::uint64_t &seed)
+{
+    const std::size_t rounds = size / 16;
+    std::uint64_t accumulator = size * Prime64_1;
+    for(std::size_t index = 0; index < 8; ++index)
+    {
+        accumulator += mix16(data + 16 * index, secret + 16 * index, seed);
+    }
+    accumulator = avalanche(accumulator);
+
+    for(std::size_t index = 8; index < rounds; ++index)
+    {
+        accumulator += mix16(data + 16 * index, secret + 16 * (index - 8) + 3, seed);
+    }
+    accumulator += mix16(data + size - 16, secret + SecretSize - 17, seed);
+    return avalanche(accumulator);
+}
+
+std::uint64_t hashShort(const unsigned char *data, const std::size_t &size, const std::uint64_t &seed)
+{
+    if(size <= 16) return hashUpTo16(data, size, DefaultSecret, seed);
+    if(size <= 128) return hashUpTo128(data, size, DefaultSecret, seed);
+    return hashUpTo240(data, size, DefaultSecret, seed);
+}
+
+void accumulateScalar(std::uint64_t *accumulators, const unsigned char *data, const unsigned char *secret)
+{
+    for(std::size_t index = 0; index < 8; ++index)
+    {
+        const std::uint64_t value = read64(data + 8 * index);
+        const std::uint64_t keyed = value ^ read64(secret + 8 * index);
+        accumulators[index ^ 1] += value;
+        accumulators[index] += (keyed & 0xffffffffU) * (keyed >> 32);
+    }
+}
+
+void scrambleScalar(std::uint64_t *accumulators, const unsigned char *secret)
+{
+    for(std::size_t index = 0; index < 8; ++index)
+    {
+        std::uint64_t accumulator = accumulators[index];
+        accumulator ^= accumulator >> 47;
+        accumulator ^= read64(secret + 8 * index);
+        accumulators[index] = accumulator * Prime32_1;
+    }
+}
+
+/* full blocks of sixteen stripes are followed by a scramble, the tail ends with the last
+ * stripe of the input, which may overlap the previous one
+ */
+void hashLongScalar(std::uint64_t *accumulators, const unsigned char *data, const std::size_t &size, const unsigned char *secret)
+{
+    const std::size_t blocks = (size - 1) / BlockSize;
+    for(std::size_t block = 0; block < blocks; ++block)
+    {
+        for(std::size_t stripe = 0; stripe < StripesPerBlock; ++stripe)
+        {
+            accumulateScalar(accumulators, data + block * BlockSize + stripe * StripeSize, secret + stripe * SecretConsumeRate);
+        }
+        scrambleScalar(accumulators, secret + SecretSize - StripeSize);
+    }
+
+    const std::size_t stripes = ((size - 1) - BlockSize * blocks) / StripeSize;
+    for(std::size_t stripe = 0; stripe < stripes; ++stripe)
+    {
+        accumulateScalar(accumulators, data + blocks * BlockSize + stripe * StripeSize, secret + stripe * SecretConsumeRate);
+    }
+    accumulateScalar(accumulators, data + size - StripeSize, secret + SecretSize - StripeSize - 7);
+}
+
+#ifdef ZYXCBA_HASH_X86
+
+__attribute__((target("avx2")))
+inline void accumulateAVX2(__m256i *state, const unsigned char *data, const unsigned char *secret)
+{
+    for(std::size_t lane = 0; lane < 2; ++lane)
+    {
+        const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32 * lane));
+        const __m256i keyed = _mm256_xor_si256(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret + 32 * lane)));
+        const __m256i product = _mm256_mul_epu32(keyed, _mm256_srli_epi64(keyed, 32));
+        const __m256i swapped = _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+        state[lane] = _mm256_add_epi64(product, _mm256_add_epi64(state[lane], swapped));
+    }
+}
+
+__attribute__((target("avx2")))
+inline void scrambleAVX2(__m256i *state, const unsigned char *secret)
+{
+    const __m256i prime = _mm256_set1_epi32(static_cast<int>(Prime32_1));
+    for(std::size_t lane = 0; lane < 2; ++lane)
+    {
+        __m256i value = _mm256_xor_si256(state[lane], _mm256_srli_epi64(state[lane], 47));
+        value = _mm256_xor_si256(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret + 32 * lane)));
+        const __m256i low = _mm256_mul_epu32(value, prime);
+        const __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(value, 32), prime);
+        state[lane] = _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+    }
+}
+
+__attribute__((target("avx2")))
+void hashLongAVX2(std::uint64_t *accumulators, const unsigned char *data, const std::size_t &size, const unsigned char *secret)
+{
+    __m256i state[2];
+    state[0] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulators));
+    state[1] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulators + 4));
+
+    const std::size_t blocks = (size - 1) / BlockSize;
+    for(std::size_t block = 0; block < blocks; ++block)
+    {
+        for(std::size_t stripe = 0; stripe < StripesPerBlock; ++stripe)
+        {
+            accumulateAVX2(state, data + block * BlockSize + stripe * StripeSize, secret + stripe * SecretConsumeRate);
+        }
+        scrambleAVX2(state, secret + SecretSize - StripeSize);
+    }
+
+    const std::size_t stripes = ((size - 1) - BlockSize * blocks) / StripeSize;
+    for(std::size_t stripe = 0; stripe < stripes; ++stripe)
+    {
+        accumulateAVX2(state, data + blocks * BlockSize + stripe * StripeSize, secret + stripe * SecretConsumeRate);
+    }
+    accumulateAVX2(state, data + size - StripeSize, secret + SecretSize - StripeSize - 7);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(accumulators), state[0]);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(accumulators + 4), state[1]);
+}
+
+/* the zero masked forms avoid the _mm512_undefined_epi32() passthrough, which gcc 12 reports as
+ * an uninitialized read
+ */
+const __mmask8 AllLanes = 0xff;
+
+__attribute__((target("avx512f,avx512dq")))
+inline __m512i accumulateAVX512(const __m512i &state, const unsigned char *data, const unsigned char *secret)
+{
+    const __m512i value = _mm512_loadu_si512(data);
+    const __m512i keyed = _mm512_xor_si512(value, _mm512_loadu_si512(secret));
+    const __m512i product = _mm512_maskz_mul_epu32(AllLanes, keyed, _mm512_maskz_srli_epi64(AllLanes, keyed, 32));
+    const __m512i swapped = _mm512_maskz_shuffle_epi32(0xffff, value, static_cast<_MM_PERM_ENUM>(_MM_SHUFFLE(1, 0, 3, 2)));
+    return _mm512_add_epi64(product, _mm512_add_epi64(state, swapped));
+}
+
+__attribute__((target("avx512f,avx512dq")))
+void hashLongAVX512(std::uint64_t *accumulators, const unsigned char *data, const std::size_t &size, const unsigned char *secret)
+{
+    __m512i state = _mm512_loadu_si512(accumulators);
+    const __m512i prime = _mm512_set1_epi64(static_cast<long long>(Prime32_1));
+    const __m512i scrambleKey = _mm512_loadu_si512(secret + SecretSize - StripeSize);
+
+    const std::size_t blocks = (size - 1) / BlockSize;
+    for(std::size_t block = 0; block < blocks; ++block)
+    {
+        for(std::size_t stripe = 0; stripe < StripesPerBlock; ++stripe)
+        {
+            state = accumulateAVX512(state, data + block * BlockSize + stripe * StripeSize, secret + stripe * SecretConsumeRate);
+        }
+        state = _mm512_xor_si512(state, _mm512_maskz_srli_epi64(AllLanes, state, 47));
+        state = _mm512_maskz_mullo_epi64(AllLanes, _mm512_xor_si512(state, scrambleKey), prime);
+    }
+
+    const std::size_t stripes = ((size - 1) - BlockSize * blocks) / StripeSize;
+    for(std::size_t stripe = 0; stripe < stripes; ++stripe)
+    {
+        state = accumulateAVX512(state, data + blocks * BlockSize + stripe * StripeSize, secret + stripe * SecretConsumeRate);
+    }
+    state = accumulateAVX512(state, data + size - StripeSize, secret + SecretSize - StripeSize - 7);
+
+    _mm512_storeu_si512(accumulators, state);
+}
+
+#endif
+
+ZHashLongFunction hashLongFunction()
+{
+    static const ZHashLongFunction function = ZCpuDispatch<ZHashLongFunction>(&hashLongScalar)
+#ifdef ZYXCBA_HASH_X86
+            .add(ZCpuLevel::AVX2, &hashLongAVX2)
+            .add(ZCpuLevel::AVX512, &hashLongAVX512)
+#endif
+            .resolve();
+    return function;
+}
+
+/* a seeded secret keeps the long kernels free of per stripe seed arithmetic */
+void seedSecret(ZSecret &secret, const std::uint64_t &seed)
+{
+    for(std::size_t index = 0; index < SecretSize; index += 16)
+    {
+        store_le<std::uint64_t>(secret.bytes + index, read64(DefaultSecret + index) + seed);
+        store_le<std::uint64_t>(secret.bytes + index + 8, read64(DefaultSecret + index + 8) - seed);
+    }
+}
+
+std::uint64_t mergeAccumulators(const std::uint64_t *accumulators, const unsigned char *secret, std::uint64_t result)
+{
+    for(std::size_t index = 0; index < 4; ++index)
+    {
+        result += multiplyFold(accumulators[2 * index] ^ read64(secret + 16 * index),
+                               accumulators[2 * index + 1] ^ read64(secret + 16 * index + 8));
+    }
+    return avalanche(result);
+}
+
+void hashLong(std::uint64_t *accumulators, const unsigned char *data, const std::size_t &size, const std::uint64_t &seed,
+              const ZHashLongFunction &function, const unsigned char *&secret, ZSecret &seeded)
+{
+    const std::uint64_t initial[8] = {Prime32_3, Prime64_1, Prime64_2, Prime64_3, Prime64_4, Prime32_2, Prime64_5, Prime32_1};
+    for(std::size_t index = 0; index < 8; ++index)
+    {
+        accumulators[index] = initial[index];
+    }
+
+    secret = DefaultSecret;
+    if(seed != 0)
+    {
+        seedSecret(seeded, seed);
+        secret = seeded.bytes;
+    }
+    function(accumulators, data, size, secret);
+}
+
+std::uint64_t hash64With(const void *data, const std::size_t &size, const std::uint64_t &seed, const ZHashLongFunction &function)
+{
+    const unsigned char *bytes = static_cast<const unsigned char*>(data);
+    if(size <= MidSizeMax)
+    {
+        return hashShort(bytes, size, seed);
+    }
+
+    std::uint64_t accumulators[8];
+    const unsigned char *secret;
+    ZSecret seeded;
+    hashLong(accumulators, bytes, size, seed, function, secret, seeded);
+    return mergeAccumulators(accumulators, secret + 11, size * Prime64_1);
+}
+
+}
+
+std::uint64_t ZHash::hash64(const void *data, const std::size_t &size, const std::uint64_t &seed)
+{
+    return hash64With(data, size, seed, hashLongFunction());
+}
+
+std::uint64_t ZHash::hash64Scalar(const void *data, const std::size_t &size, const std::uint64_t &seed)
+{
+    return hash64With(data, size, seed, &hashLongScalar);
+}
+
+ZHash128 ZHash::hash128(const void *data, const std::size_t &size, const std::uint64_t &seed)
+{
+    const unsigned char *bytes = static_cast<const unsigned char*>(data);
+    ZHash128 result;
+    if(size <= MidSizeMax)
+    {
+        /* the high half is a second evaluation keyed by a seed derived from the first */
+        result.low = hashShort(bytes, size, seed);
+        result.high = hashShort(bytes, size, ~seed ^ Prime64_4) ^ rotateLeft(result.low, 29);
+        return result;
+    }
+
+    std::uint64_t accumulators[8];
+    const unsigned char *secret;
+    ZSecret seeded;
+    hashLong(accumulators, bytes, size, seed, hashLongFunction(), secret, seeded);
+    result.low = mergeAccumulators(accumulators, secret + 11, size * Prime64_1);
+    result.high = mergeAccumulators(accumulators, secret + SecretSize - StripeSize - 11, ~(size * Prime64_2));
+    return result;
+}
+
+std::uint64_t ZHash::combine(const std::uint64_t &first, const std::uint64_t &second)
+{
+    return avalanche(rotateLeft(first, 23) * Prime64_1 + (second ^ Prime64_2));
+}
+
+std::uint64_t ZHash::mix(std::uint64_t value)
+{
+    return avalanche64(value);
+}
+
+}
@@ -0,0 +1,84 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef ZHASH_H
+#define ZHASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZHash128 struct
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct ZHash128
+{
+    std::uint64_t low;
+    std::uint64_t high;
+
+    bool operator==(const ZHash128 &other) const { return this->low == other.low && this->high == other.high; }
+    bool operator!=(const ZHash128 &other) const { return !this->operator==(other); }
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZHash class
+///
+/// ZHash is a fast non-cryptographic 64 and 128 bit hash built like xxHash3. Inputs up to 16
+/// bytes are hashed with a few overlapping loads, inputs up to 240 bytes with 16 byte
+/// multiply-fold rounds against a secret, and longer inputs with eight 64 bit accumulators over
+/// 64 byte stripes, which have AVX2 and AVX-512 kernels selected through ZCpuDispatch.
+///
+/// The results are stable across platforms and processes, but they are not the xxHash3
+/// values. Every kernel produces the same result.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZHash
+{
+public:
+    static std::uint64_t hash64(const void *data, const std::size_t &size, const std::uint64_t &seed = 0);
+    static ZHash128 hash128(const void *data, const std::size_t &size, const std::uint64_t &seed = 0);
+
+    /* hashes inputs longer than 240 bytes with the scalar kernel regardless of the cpu */
+    static std::uint64_t hash64Scalar(const void *data, const std::size_t &size, const std::uint64_t &seed = 0);
+
+    /* an order dependent combination of two hashes */
+    static std::uint64_t combine(const std::uint64_t &first, const std::uint64_t &second);
+
+    /* a bijective finalizer which spreads every input bit over the result */
+    static std::uint64_t mix(std::uint64_t value);
+};
+
+}
+
+#endif // ZHASH_H
@@ -0,0 +1,505 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef ZHASHMAP_H
+#define ZHASHMAP_H
+
+#include <new>
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <iterator>
+#include <functional>
+#include <type_traits>
+
+#include "ztype.h"
+#include "zarena.h"
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZHashMap class
+///
+/// ZHashMap is an open addressing hash map with linear probing and backward shift deletion.
+/// Keys, values and one control byte per slot live in three separate flat arrays, so a probe
+/// sequence only touches the control bytes and the keys. Iteration order is unspecified.
+/// The three arrays share a single block obtained from the byte allocator.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+         typename Allocator = ZArenaAllocator<char> >
+class ZHashMap
+{
+    template<bool Const>
+    class Iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::pair<const K&, typename std::conditional<Const, const V&, V&>::type> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef value_type reference;
+
+        class pointer
+        {
+        public:
+            explicit pointer(const value_type &value): m_value(value) {}
+            const value_type *operator->() const { return &this->m_value; }
+        private:
+            value_type m_value;
+        };
+
+        typedef typename std::conditional<Const, const ZHashMap*, ZHashMap*>::type MapPointer;
+
+        Iterator(): m_map(nullptr), m_slot(0) {}
+        Iterator(MapPointer map, std::size_t slot): m_map(map), m_slot(slot) { this->skipEmpty(); }
+
+        /* allow iterator to const_iterator conversion */
+        template<bool OtherConst, typename = typename std::enable_if<Const || !OtherConst>::type>
+        Iterator(const Iterator<OtherConst> &other): m_map(other.m_map), m_slot(other.m_slot) {}
+
+        const K &key() const { return this->m_map->m_keys[this->m_slot]; }
+        typename std::conditional<Const, const V&, V&>::type value() const { return this->m_map->m_values[this->m_slot]; }
+
+        reference operator*() const { return reference(this->key(), this->value()); }
+        pointer operator->() const { return pointer(**this); }
+
+        Iterator &operator++()
+        {
+            ++this->m_slot;
+            this->skipEmpty();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator r(*this);
+            ++(*this);
+            return r;
+        }
+
+        bool operator==(const Iterator &other) const { return this->m_slot == other.m_slot; }
+        bool operator!=(const Iterator &other) const { return this->m_slot != other.m_slot; }
+
+    private:
+        friend class ZHashMap;
+        template<bool> friend class Iterator;
+
+        void skipEmpty()
+        {
+            while(this->m_slot < this->m_map->m_capacity && this->m_map->m_control[this->m_slot] == Empty)
+            {
+                ++this->m_slot;
+            }
+        }
+
+        MapPointer m_map;
+        std::size_t m_slot;
+    };
+
+public:
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef std::size_t size_type;
+    typedef Allocator allocator_type;
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+
+    ZHashMap():
+        m_control(nullptr),
+        m_keys(nullptr),
+        m_values(nullptr),
+        m_size(0),
+        m_capacity(0)
+    {
+
+    }
+
+    explicit ZHashMap(const Allocator &allocator):
+        m_control(nullptr),
+        m_keys(nullptr),
+        m_values(nullptr),
+        m_size(0),
+        m_capacity(0),
+        m_allocator(allocator)
+    {
+
+    }
+
+    ZHashMap(const ZHashMap &other):
+        ZHashMap(other, other.m_allocator.select_on_container_copy_construction())
+    {
+
+    }
+
+    ZHashMap(const ZHashMap &other, const Allocator &allocator):
+        ZHashMap(allocator)
+    {
+        this->reserve(other.m_size);
+        for(const_iterator it = other.begin(); it != other.end(); ++it) this->emplace(it.key(), it.value());
+    }
+
+    ZHashMap(ZHashMap &&other) noexcept:
+        ZHashMap(other.m_allocator)
+    {
+        this->swap(other);
+    }
+
+    ZHashMap(ZHashMap &&other, const Allocator &allocator):
+        ZHashMap(allocator)
+    {
+        if(this->m_allocator == other.m_allocator)
+        {
+            this->swap(other);
+            return;
+        }
+
+        /* different memory sources, the entries have to move one by one */
+        this->reserve(other.m_size);
+        for(std::size_t slot = 0; slot < other.m_capacity; ++slot)
+        {
+            if(other.m_control[slot] == Empty) continue;
+            this->emplace(std::move(other.m_keys[slot]), std::move(other.m_values[slot]));
+        }
+        other.clear();
+    }
+
+    ~ZHashMap()
+    {
+        this->clear();
+        this->deallocate();
+    }
+
+    ZHashMap &operator=(const ZHashMap &other)
+    {
+        if(this != &other)
+        {
+            /* the allocator is not propagated, the copy lands in our own memory source */
+            ZHashMap temp(other, this->m_allocator);
+            this->swap(temp);
+        }
+        return *this;
+    }
+
+    ZHashMap &operator=(ZHashMap &&other)
+    {
+        if(this != &other)
+        {
+            ZHashMap temp(std::move(other), this->m_allocator);
+            this->swap(temp);
+        }
+        return *this;
+    }
+
+    void swap(ZHashMap &other) noexcept
+    {
+        std::swap(this->m_control, other.m_control);
+        std::swap(this->m_keys, other.m_keys);
+        std::swap(this->m_values, other.m_values);
+        std::swap(this->m_size, other.m_size);
+        std::swap(this->m_capacity, other.m_capacity);
+        std::swap(this->m_allocator, other.m_allocator);
+    }
+
+    allocator_type get_allocator() const { return this->m_allocator; }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, this->m_capacity); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, this->m_capacity); }
+    const_iterator cbegin() const { return this->begin(); }
+    const_iterator cend() const { return this->end(); }
+
+    bool empty() const { return this->m_size == 0; }
+    size_type size() const { return this->m_size; }
+    size_type capacity() const { return this->m_capacity; }
+
+    void clear()
+    {
+        for(std::size_t slot = 0; slot < this->m_capacity; ++slot)
+        {
+            if(this->m_control[slot] == Empty) continue;
+            this->m_keys[slot].~K();
+            this->m_values[slot].~V();
+            this->m_control[slot] = Empty;
+        }
+        this->m_size = 0;
+    }
+
+    void reserve(size_type count)
+    {
+        if(count == 0) return;
+
+        /* keep the load factor at or below 7/8 */
+        size_type capacity = this->m_capacity ? this->m_capacity : 8;
+        while(count > capacity - capacity / 8) capacity *= 2;
+        if(capacity != this->m_capacity) this->rehash(capacity);
+    }
+
+    iterator find(const K &key)
+    {
+        return iterator(this, this->findSlot(key));
+    }
+
+    const_iterator find(const K &key) const
+    {
+        return const_iterator(this, this->findSlot(key));
+    }
+
+    size_type count(const K &key) const
+    {
+        return this->findSlot(key) != this->m_capacity ? 1 : 0;
+    }
+
+    V &operator[](const K &key)
+    {
+        return this->emplace(key).first.value();
+    }
+
+    template<typename KArg, typename... VArgs>
+    std::pair<iterator,bool> emplace(KArg &&key, VArgs&&... args)
+    {
+        return this->emplaceKey(K(std::forward<KArg>(key)), std::forward<VArgs>(args)...);
+    }
+
+    template<typename... VArgs>
+    std::pair<iterator,bool> emplace(const K &key, VArgs&&... args)
+    {
+        return this->emplaceKey(key, std::forward<VArgs>(args)...);
+    }
+
+    template<typename... VArgs>
+    std::pair<iterator,bool> emplace(K &&key, VArgs&&... args)
+    {
+        return this->emplaceKey(std::move(key), std::forward<VArgs>(args)...);
+    }
+
+    size_type erase(const K &key)
+    {
+        std::size_t slot = this->findSlot(key);
+        if(slot == this->m_capacity) return 0;
+
+        this->m_keys[slot].~K();
+        this->m_values[slot].~V();
+        this->m_control[slot] = Empty;
+        --this->m_size;
+
+        /* backward shift deletion keeps every probe sequence free of holes without tombstones */
+        std::size_t mask = this->m_capacity - 1;
+        std::size_t hole = slot;
+        std::size_t next = (slot + 1) & mask;
+        while(this->m_control[next] != Empty)
+        {
+            std::size_t home = ZHashMap::mix(this->m_hash(this->m_keys[next])) & mask;
+            if(((next - home) & mask) >= ((next - hole) & mask))
+            {
+                this->relocate(next, hole);
+                hole = next;
+            }
+            next = (next + 1) & mask;
+        }
+        return 1;
+    }
+
+private:
+    static const std::uint8_t Empty = 0;
+
+    static std::size_t mix(std::size_t hash)
+    {
+        /* std::hash is the identity for integers in common implementations, spread the bits */
+        std::uint64_t h = static_cast<std::uint64_t>(hash);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+
+    static std::uint8_t fragment(std::size_t hash)
+    {
+        return static_cast<std::uint8_t>((hash >> (sizeof(std::size_t) * 8 - 7)) | 0x80);
+    }
+
+    template<typename KArg, typename... VArgs>
+    std::pair<iterator,bool> emplaceKey(KArg &&key, VArgs&&... args)
+    {
+        /* the map does not overwrite existing entries, like std::map::emplace */
+        std::size_t hash = ZHashMap::mix(this->m_hash(key));
+        if(this->m_capacity)
+        {
+            std::size_t slot = this->findSlot(key, hash);
+            if(slot != this->m_capacity) return std::make_pair(iterator(this, slot), false);
+        }
+
+        if(this->m_size + 1 > this->m_capacity - this->m_capacity / 8)
+        {
+            /* the arguments may refer to our own entries, build the entry before growing */
+            K ownKey(std::forward<KArg>(key));
+            V value(std::forward<VArgs>(args)...);
+            this->reserve(this->m_size + 1);
+            return this->place(hash, std::move(ownKey), std::move(value));
+        }
+
+        return this->place(hash, std::forward<KArg>(key), std::forward<VArgs>(args)...);
+    }
+
+    template<typename KArg, typename... VArgs>
+    std::pair<iterator,bool> place(std::size_t hash, KArg &&key, VArgs&&... args)
+    {
+        std::size_t mask = this->m_capacity - 1;
+        std::size_t slot = hash & mask;
+        while(this->m_control[slot] != Empty) slot = (slot + 1) & mask;
+
+        new (this->m_keys + slot) K(std::forward<KArg>(key));
+        new (this->m_values + slot) V(std::forward<VArgs>(args)...);
+        this->m_control[slot] = ZHashMap::fragment(hash);
+        ++this->m_size;
+        return std::make_pair(iterator(this, slot), true);
+    }
+
+    std::size_t findSlot(const K &key) const
+    {
+        if(this->m_size == 0) return this->m_capacity;
+        return this->findSlot(key, ZHashMap::mix(this->m_hash(key)));
+    }
+
+    std::size_t findSlot(const K &key, std::size_t hash) const
+    {
+        std::size_t mask = this->m_capacity - 1;
+        std::uint8_t control = ZHashMap::fragment(hash);
+        for(std::size_t slot = hash & mask; this->m_control[slot] != Empty; slot = (slot + 1) & mask)
+        {
+            if(this->m_control[slot] == control && this->m_equal(this->m_keys[slot], key)) return slot;
+        }
+        return this->m_capacity;
+    }
+
+    void relocate(std::size_t from, std::size_t to)
+    {
+        ZHashMap::relocateOne(this->m_keys + from, this->m_keys + to);
+        ZHashMap::relocateOne(this->m_values + from, this->m_values + to);
+        this->m_control[to] = this->m_control[from];
+        this->m_control[from] = Empty;
+    }
+
+    template<typename T>
+    static void relocateOne(T *from, T *to)
+    {
+        if(is_trivially_relocatable<T>::value)
+        {
+            std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), sizeof(T));
+        }
+        else
+        {
+            new (to) T(std::move(*from));
+            from->~T();
+        }
+    }
+
+    static std::size_t alignUp(std::size_t offset, std::size_t alignment)
+    {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    static std::size_t keysOffset(std::size_t capacity)
+    {
+        return ZHashMap::alignUp(capacity, alignof(K));
+    }
+
+    static std::size_t valuesOffset(std::size_t capacity)
+    {
+        return ZHashMap::alignUp(ZHashMap::keysOffset(capacity) + capacity * sizeof(K), alignof(V));
+    }
+
+    static std::size_t blockSize(std::size_t capacity)
+    {
+        return ZHashMap::valuesOffset(capacity) + capacity * sizeof(V);
+    }
+
+    void deallocate()
+    {
+        if(this->m_control)
+        {
+            this->m_allocator.deallocate(reinterpret_cast<char*>(this->m_control), ZHashMap::blockSize(this->m_capacity));
+        }
+    }
+
+    void rehash(std::size_t capacity)
+    {
+        static_assert(alignof(K) <= alignof(std::max_align_t) && alignof(V) <= alignof(std::max_align_t),
+                      "ZHashMap does not support over-aligned types");
+
+        /* the three arrays share one allocation, allocators hand out max_align_t aligned blocks */
+        std::size_t keysOffset = ZHashMap::keysOffset(capacity);
+        std::size_t valuesOffset = ZHashMap::valuesOffset(capacity);
+        char *block = this->m_allocator.allocate(ZHashMap::blockSize(capacity));
+
+        std::uint8_t *control = reinterpret_cast<std::uint8_t*>(block);
+        K *keys = reinterpret_cast<K*>(block + keysOffset);
+        V *values = reinterpret_cast<V*>(block + valuesOffset);
+        std::memset(control, Empty, capacity);
+
+        std::size_t mask = capacity - 1;
+        for(std::size_t slot = 0; slot < this->m_capacity; ++slot)
+        {
+            if(this->m_control[slot] == Empty) continue;
+
+            std::size_t target = ZHashMap::mix(this->m_hash(this->m_keys[slot])) & mask;
+            while(control[target] != Empty) target = (target + 1) & mask;
+
+            ZHashMap::relocateOne(this->m_keys + slot, keys + target);
+            ZHashMap::relocateOne(this->m_values + slot, values + target);
+            control[target] = this->m_control[slot];
+        }
+
+        this->deallocate();
+        this->m_control = control;
+        this->m_keys = keys;
+        this->m_values = values;
+        this->m_capacity = capacity;
+    }
+
+    std::uint8_t *m_control;
+    K *m_keys;
+    V *m_values;
+    std::size_t m_size;
+    std::size_t m_capacity;
+    Hash m_hash;
+    KeyEqual m_equal;
+    Allocator m_allocator;
+};
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
+const std::uint8_t ZHashMap<K,V,Hash,KeyEqual,Allocator>::Empty;
+
+}
+
+#endif // ZHASHMAP_H
@@ -29,26 +29,941 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+
+
 #include "znestedmap.h"
 
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <utility>
+
+#include "zhash.h"
+
 namespace zyxcba {
 
-ZNestedMap::ZNestedMap()
+namespace {
+
+/* children tables start small, most configuration levels have a handful of keys */
+const std::uint32_t InitialChildCapacity = 4;
+
+const std::uint32_t InitialSegmentCapacity = 16;
+
+/* map generations and segment table serials come from one process wide sequence, so a value
+ * identifies a single map state or table no matter which map it was taken from
+ */
+std::atomic<std::uint64_t> stampSequence(1);
+
+inline std::uint64_t nextStamp()
+{
+    return stampSequence.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline const char *segmentEnd(const char *begin, const char *end, const char &separator)
+{
+    const void *found = std::memchr(begin, separator, static_cast<std::size_t>(end - begin));
+    return found ? static_cast<const char*>(found) : end;
+}
+
+inline std::uint64_t segmentHash(const char *key, const std::size_t &keySize)
+{
+    return ZHash::hash64(key, keySize);
+}
+
+bool isValidPath(const ZStringView &path, const char &separator)
+{
+    if(path.empty()) return false;
+
+    const char *begin = path.begin();
+    const char *end = path.end();
+    for(;;)
+    {
+        const char *last = segmentEnd(begin, end, separator);
+        std::size_t size = static_cast<std::size_t>(last - begin);
+        if(size == 0 || size > std::numeric_limits<std::uint32_t>::max()) return false;
+        if(last == end) return true;
+        begin = last + 1;
+    }
+}
+
+}
+
+ZPath::ZPath():
+    m_table(0),
+    m_cached(false),
+    m_node(nullptr),
+    m_generation(0)
+{
+
+}
+
+bool ZPath::isValid() const
+{
+    return !this->m_segments.empty();
+}
+
+bool ZPath::isCached() const
+{
+    return this->m_cached;
+}
+
+std::size_t ZPath::depth() const
 {
+    return this->m_segments.size();
+}
+
+ZStringView ZPath::path() const
+{
+    return ZStringView(this->m_path);
+}
+
+const char ZNestedMap::DefaultSeparator;
+
+struct ZNestedMap::ZSlot
+{
+    std::uint64_t hash;
+    ZNode *node;
+};
+
+/* the segment name is stored right behind the node, in the same allocation */
+struct ZNestedMap::ZNode
+{
+    ZNode(): slots(nullptr), childCount(0), capacity(0), keySize(0), segment(0), hasValue(false) {}
+
+    char *key() { return reinterpret_cast<char*>(this + 1); }
+    const char *key() const { return reinterpret_cast<const char*>(this + 1); }
+
+    ZVariant value;
+    ZSlot *slots;
+    std::uint32_t childCount;
+    std::uint32_t capacity;
+    std::uint32_t keySize;
+    std::uint32_t segment;
+    bool hasValue;
+};
+
+/* interned segment names, an id is the index of the entry */
+struct ZNestedMap::ZSegmentTable
+{
+    struct ZEntry
+    {
+        std::uint64_t hash;
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    ZSegmentTable(): serial(nextStamp()) {}
+
+    /* a copy is a different table, its ids drift apart from the original once both intern */
+    ZSegmentTable(const ZSegmentTable &other):
+        entries(other.entries),
+        slots(other.slots),
+        bytes(other.bytes),
+        serial(nextStamp())
+    {
+
+    }
+
+    std::uint32_t intern(const char *key, const std::size_t &size, const std::uint64_t &hash)
+    {
+        if((this->entries.size() + 1) * 4 > this->slots.size() * 3) this->grow();
 
-#ifdef ZYXCBA_DEBUG
-    std::cout << "ZNestedMap::ZNestedMap()"<<std::endl;
-#endif
+        std::size_t mask = this->slots.size() - 1;
+        std::size_t slot = hash & mask;
+        for(; this->slots[slot] != 0; slot = (slot + 1) & mask)
+        {
+            const ZEntry &entry = this->entries[this->slots[slot] - 1];
+            if(entry.hash == hash && entry.size == size && std::memcmp(this->bytes.data() + entry.offset, key, size) == 0)
+            {
+                return this->slots[slot] - 1;
+            }
+        }
+
+        ZEntry entry;
+        entry.hash = hash;
+        entry.offset = this->bytes.size();
+        entry.size = size;
+        this->bytes.append(key, size);
+        this->entries.push_back(entry);
+
+        /* slots hold id + 1, zero marks an empty slot */
+        this->slots[slot] = static_cast<std::uint32_t>(this->entries.size());
+        return this->slots[slot] - 1;
+    }
+
+    void grow()
+    {
+        std::vector<std::uint32_t> grown(this->slots.empty() ? InitialSegmentCapacity : this->slots.size() * 2, 0);
+        std::size_t mask = grown.size() - 1;
+        for(std::size_t id = 0; id < this->entries.size(); ++id)
+        {
+            std::size_t slot = this->entries[id].hash & mask;
+            while(grown[slot] != 0) slot = (slot + 1) & mask;
+            grown[slot] = static_cast<std::uint32_t>(id + 1);
+        }
+        this->slots.swap(grown);
+    }
+
+    std::vector<ZEntry> entries;
+    std::vector<std::uint32_t> slots;
+    std::string bytes;
+    std::uint64_t serial;
+};
+
+ZNestedMap::ZNestedMap(const char &separator, const ZNestedMapStorage &storage):
+    m_root(nullptr),
+    m_size(0),
+    m_separator(separator),
+    m_generation(nextStamp()),
+    m_segments(nullptr),
+    m_storage(storage)
+{
 
 }
 
 ZNestedMap::~ZNestedMap()
 {
+    this->clear();
+    delete this->m_segments;
+}
+
+ZNestedMap::ZNestedMap(const ZNestedMap &other):
+    m_root(nullptr),
+    m_size(other.m_size),
+    m_separator(other.m_separator),
+    m_generation(nextStamp()),
+    m_segments(other.m_segments ? new ZSegmentTable(*other.m_segments) : nullptr),
+    m_storage(other.m_storage),
+    m_radix(other.m_radix)
+{
+    if(other.m_root == nullptr) return;
+
+    try
+    {
+        this->m_root = ZNestedMap::cloneNode(other.m_root);
+    }
+    catch(...)
+    {
+        delete this->m_segments;
+        throw;
+    }
+}
+
+ZNestedMap::ZNestedMap(ZNestedMap &&other) noexcept:
+    m_root(other.m_root),
+    m_size(other.m_size),
+    m_separator(other.m_separator),
+    m_generation(nextStamp()),
+    m_segments(other.m_segments),
+    m_storage(other.m_storage),
+    m_radix(std::move(other.m_radix))
+{
+    other.m_root = nullptr;
+    other.m_size = 0;
+    other.m_segments = nullptr;
+    other.advanceGeneration();
+}
+
+ZNestedMap &ZNestedMap::operator=(const ZNestedMap &other)
+{
+    if(this != &other)
+    {
+        ZNestedMap temp(other);
+        this->swap(temp);
+    }
+    return *this;
+}
+
+ZNestedMap &ZNestedMap::operator=(ZNestedMap &&other) noexcept
+{
+    if(this != &other)
+    {
+        ZNestedMap temp(std::move(other));
+        this->swap(temp);
+    }
+    return *this;
+}
+
+void ZNestedMap::swap(ZNestedMap &other) noexcept
+{
+    std::swap(this->m_root, other.m_root);
+    std::swap(this->m_size, other.m_size);
+    std::swap(this->m_separator, other.m_separator);
+    std::swap(this->m_segments, other.m_segments);
+    std::swap(this->m_storage, other.m_storage);
+    this->m_radix.swap(other.m_radix);
+    this->advanceGeneration();
+    other.advanceGeneration();
+}
+
+bool ZNestedMap::set(const ZStringView &path, const ZVariant &value)
+{
+    ZVariant *slot = this->valueSlot(path);
+    if(slot == nullptr) return false;
+
+    *slot = value;
+    return true;
+}
+
+bool ZNestedMap::set(const ZStringView &path, ZVariant &&value)
+{
+    ZVariant *slot = this->valueSlot(path);
+    if(slot == nullptr) return false;
+
+    *slot = std::move(value);
+    return true;
+}
+
+bool ZNestedMap::set(const ZPath &path, const ZVariant &value)
+{
+    ZVariant *slot = this->valueSlot(path);
+    if(slot == nullptr) return false;
+
+    *slot = value;
+    return true;
+}
+
+bool ZNestedMap::set(const ZPath &path, ZVariant &&value)
+{
+    ZVariant *slot = this->valueSlot(path);
+    if(slot == nullptr) return false;
+
+    *slot = std::move(value);
+    return true;
+}
+
+const ZVariant *ZNestedMap::find(const ZStringView &path) const
+{
+    return this->findValue(path);
+}
+
+ZVariant *ZNestedMap::find(const ZStringView &path)
+{
+    return this->findValue(path);
+}
+
+ZVariant ZNestedMap::get(const ZStringView &path, const ZVariant &defaultValue) const
+{
+    const ZVariant *value = this->find(path);
+    return value ? *value : defaultValue;
+}
+
+const ZVariant *ZNestedMap::find(const ZPath &path) const
+{
+    return this->findValue(path);
+}
+
+ZVariant *ZNestedMap::find(const ZPath &path)
+{
+    return this->findValue(path);
+}
+
+ZVariant ZNestedMap::get(const ZPath &path, const ZVariant &defaultValue) const
+{
+    const ZVariant *value = this->find(path);
+    return value ? *value : defaultValue;
+}
+
+bool ZNestedMap::contains(const ZStringView &path) const
+{
+    return this->find(path) != nullptr;
+}
+
+bool ZNestedMap::contains(const ZPath &path) const
+{
+    return this->find(path) != nullptr;
+}
+
+ZPath ZNestedMap::compile(const ZStringView &path, const bool &cached) const
+{
+    ZPath result;
+    if(!isValidPath(path, this->m_separator) || path.size() > std::numeric_limits<std::uint32_t>::max()) return result;
+
+    /* the radix tree is keyed by the whole path, there is nothing to intern */
+    ZSegmentTable *table = this->m_storage == ZNestedMapStorage::HashLevels ? this->segmentTable() : nullptr;
+    result.m_path = path.toString();
+    result.m_table = table ? table->serial : 0;
+    result.m_cached = cached;
+
+    const char *begin = path.begin();
+    const char *end = path.end();
+    for(;;)
+    {
+        const char *last = segmentEnd(begin, end, this->m_separator);
+        ZPath::ZSegment segment;
+        segment.size = static_cast<std::uint32_t>(last - begin);
+        segment.offset = static_cast<std::uint32_t>(begin - path.begin());
+        segment.hash = segmentHash(begin, segment.size);
+        segment.id = table ? table->intern(begin, segment.size, segment.hash) : 0;
+        result.m_segments.push_back(segment);
+
+        if(last == end) return result;
+        begin = last + 1;
+    }
+}
+
+std::size_t ZNestedMap::childCount(const ZStringView &path) const
+{
+    if(this->m_storage == ZNestedMapStorage::HashLevels)
+    {
+        const ZNode *node = this->findNode(path);
+        return node ? node->childCount : 0;
+    }
+
+    /* the keys below path come in order, so equal next segments are adjacent */
+    std::string prefix(path.data(), path.size());
+    if(!prefix.empty()) prefix.push_back(this->m_separator);
+
+    std::size_t count = 0;
+    std::string last;
+    const char separator = this->m_separator;
+    this->m_radix.scanPrefix(prefix, [&](const ZStringView &key, const ZVariant &) {
+        const char *begin = key.data() + prefix.size();
+        ZStringView segment(begin, static_cast<std::size_t>(segmentEnd(begin, key.end(), separator) - begin));
+        if(count == 0 || segment != ZStringView(last))
+        {
+            last.assign(segment.data(), segment.size());
+            ++count;
+        }
+        return true;
+    });
+    return count;
+}
+
+bool ZNestedMap::erase(const ZStringView &path)
+{
+    if(path.empty()) return false;
+
+    if(this->m_storage == ZNestedMapStorage::RadixTree)
+    {
+        std::string below(path.data(), path.size());
+        below.push_back(this->m_separator);
+        std::size_t removed = this->m_radix.erase(path) ? 1 : 0;
+        removed += this->m_radix.erasePrefix(below);
+        if(removed == 0) return false;
+
+        this->m_size = this->m_radix.size();
+        this->advanceGeneration();
+        return true;
+    }
+
+    bool emptied = false;
+    if(this->m_root == nullptr || !this->eraseBelow(this->m_root, path.begin(), path.end(), emptied)) return false;
+
+    this->advanceGeneration();
+    return true;
+}
+
+bool ZNestedMap::erase(const ZPath &path)
+{
+    /* removal is not on the hot path, the plain path is walked again */
+    return path.isValid() && this->erase(path.path());
+}
+
+bool ZNestedMap::forEach(const ZStringView &prefix, const ZVisitor &visitor) const
+{
+    if(this->m_storage == ZNestedMapStorage::RadixTree)
+    {
+        if(prefix.empty()) return this->m_radix.forEach(visitor);
+
+        const ZVariant *value = this->m_radix.find(prefix);
+        if(value && !visitor(prefix, *value)) return false;
+
+        std::string below(prefix.data(), prefix.size());
+        below.push_back(this->m_separator);
+        return this->m_radix.scanPrefix(below, visitor);
+    }
+
+    const ZNode *node = this->findNode(prefix);
+    if(node == nullptr) return true;
+
+    std::string path(prefix.data(), prefix.size());
+    return ZNestedMap::visit(node, path, this->m_separator, visitor);
+}
+
+bool ZNestedMap::scanPrefix(const ZStringView &prefix, const ZVisitor &visitor) const
+{
+    if(this->m_storage == ZNestedMapStorage::RadixTree) return this->m_radix.scanPrefix(prefix, visitor);
+
+    /* the complete segments lead to one node, the partial last one filters its children */
+    std::size_t split = prefix.size();
+    while(split != 0 && prefix[split - 1] != this->m_separator) --split;
+
+    ZStringView head(prefix.data(), split == 0 ? 0 : split - 1);
+    ZStringView tail(prefix.data() + split, prefix.size() - split);
+    if(split != 0 && head.empty()) return true;
+
+    const ZNode *node = this->findNode(head);
+    if(node == nullptr) return true;
+    return ZNestedMap::visitChildren(node, head, tail, this->m_separator, visitor);
+}
+
+std::size_t ZNestedMap::size() const
+{
+    return this->m_size;
+}
+
+bool ZNestedMap::empty() const
+{
+    return this->m_size == 0;
+}
+
+void ZNestedMap::clear()
+{
+    if(this->m_root) ZNestedMap::destroyNode(this->m_root);
+    this->m_root = nullptr;
+    this->m_radix.clear();
+    this->m_size = 0;
+    this->advanceGeneration();
+}
+
+char ZNestedMap::separator() const
+{
+    return this->m_separator;
+}
+
+ZNestedMapStorage ZNestedMap::storage() const
+{
+    return this->m_storage;
+}
+
+std::uint64_t ZNestedMap::generation() const
+{
+    return this->m_generation;
+}
+
+std::size_t ZNestedMap::segmentCount() const
+{
+    return this->m_segments ? this->m_segments->entries.size() : 0;
+}
+
+ZNestedMap::ZNode *ZNestedMap::createNode(const char *key, const std::size_t &keySize)
+{
+    void *memory = std::malloc(sizeof(ZNode) + keySize);
+    if(memory == nullptr) throw std::bad_alloc();
+
+    ZNode *node = new (memory) ZNode();
+    node->keySize = static_cast<std::uint32_t>(keySize);
+    if(keySize != 0) std::memcpy(node->key(), key, keySize);
+    return node;
+}
+
+void ZNestedMap::destroyNode(ZNode *node)
+{
+    for(std::uint32_t slot = 0; slot < node->capacity && node->childCount != 0; ++slot)
+    {
+        if(node->slots[slot].node == nullptr) continue;
+        ZNestedMap::destroyNode(node->slots[slot].node);
+        --node->childCount;
+    }
+    std::free(node->slots);
+    node->~ZNode();
+    std::free(node);
+}
+
+ZNestedMap::ZNode *ZNestedMap::cloneNode(const ZNode *node)
+{
+    ZNode *copy = ZNestedMap::createNode(node->key(), node->keySize);
+    copy->segment = node->segment;
+    try
+    {
+        copy->value = node->value;
+        copy->hasValue = node->hasValue;
+        if(node->capacity != 0)
+        {
+            /* the table keeps its layout, every stored hash stays valid */
+            copy->slots = static_cast<ZSlot*>(std::calloc(node->capacity, sizeof(ZSlot)));
+            if(copy->slots == nullptr) throw std::bad_alloc();
+            copy->capacity = node->capacity;
+        }
+
+        for(std::uint32_t slot = 0; slot < node->capacity; ++slot)
+        {
+            if(node->slots[slot].node == nullptr) continue;
+            copy->slots[slot].hash = node->slots[slot].hash;
+            copy->slots[slot].node = ZNestedMap::cloneNode(node->slots[slot].node);
+            ++copy->childCount;
+        }
+    }
+    catch(...)
+    {
+        ZNestedMap::destroyNode(copy);
+        throw;
+    }
+    return copy;
+}
+
+std::size_t ZNestedMap::findSlot(const ZNode *node, const char *key, const std::size_t &keySize, const std::uint64_t &hash)
+{
+    if(node->childCount == 0) return node->capacity;
+
+    std::size_t mask = node->capacity - 1;
+    for(std::size_t slot = hash & mask; node->slots[slot].node != nullptr; slot = (slot + 1) & mask)
+    {
+        const ZSlot &entry = node->slots[slot];
+        if(entry.hash == hash && entry.node->keySize == keySize && std::memcmp(entry.node->key(), key, keySize) == 0)
+        {
+            return slot;
+        }
+    }
+    return node->capacity;
+}
+
+std::size_t ZNestedMap::findSlot(const ZNode *node, const std::uint32_t &id, const std::uint64_t &hash)
+{
+    if(node->childCount == 0) return node->capacity;
 
-#ifdef ZYXCBA_DEBUG
-    std::cout << "ZNestedMap::~ZNestedMap()"<<std::endl;
-#endif
+    std::size_t mask = node->capacity - 1;
+    for(std::size_t slot = hash & mask; node->slots[slot].node != nullptr; slot = (slot + 1) & mask)
+    {
+        if(node->slots[slot].hash == hash && node->slots[slot].node->segment == id) return slot;
+    }
+    return node->capacity;
+}
+
+ZNestedMap::ZNode *ZNestedMap::insertChild(ZNode *node, const char *key, const std::size_t &keySize, const std::uint64_t &hash,
+                                           const std::uint32_t &id)
+{
+    /* keep the load factor at or below 3/4 */
+    if((node->childCount + 1) * 4 > node->capacity * 3) ZNestedMap::growChildren(node);
+
+    std::size_t mask = node->capacity - 1;
+    std::size_t slot = hash & mask;
+    while(node->slots[slot].node != nullptr) slot = (slot + 1) & mask;
+
+    node->slots[slot].node = ZNestedMap::createNode(key, keySize);
+    node->slots[slot].node->segment = id;
+    node->slots[slot].hash = hash;
+    ++node->childCount;
+    return node->slots[slot].node;
+}
+
+void ZNestedMap::removeChild(ZNode *node, const std::size_t &slot)
+{
+    ZNestedMap::destroyNode(node->slots[slot].node);
+    node->slots[slot].node = nullptr;
+    --node->childCount;
+
+    if(node->childCount == 0)
+    {
+        std::free(node->slots);
+        node->slots = nullptr;
+        node->capacity = 0;
+        return;
+    }
 
+    /* backward shift deletion, the same scheme as ZHashMap */
+    std::size_t mask = node->capacity - 1;
+    std::size_t hole = slot;
+    std::size_t next = (slot + 1) & mask;
+    while(node->slots[next].node != nullptr)
+    {
+        std::size_t home = node->slots[next].hash & mask;
+        if(((next - home) & mask) >= ((next - hole) & mask))
+        {
+            node->slots[hole] = node->slots[next];
+            node->slots[next].node = nullptr;
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+}
+
+void ZNestedMap::growChildren(ZNode *node)
+{
+    std::uint32_t capacity = node->capacity ? node->capacity * 2 : InitialChildCapacity;
+    ZSlot *slots = static_cast<ZSlot*>(std::calloc(capacity, sizeof(ZSlot)));
+    if(slots == nullptr) throw std::bad_alloc();
+
+    std::size_t mask = capacity - 1;
+    for(std::uint32_t index = 0; index < node->capacity; ++index)
+    {
+        if(node->slots[index].node == nullptr) continue;
+        std::size_t slot = node->slots[index].hash & mask;
+        while(slots[slot].node != nullptr) slot = (slot + 1) & mask;
+        slots[slot] = node->slots[index];
+    }
+
+    std::free(node->slots);
+    node->slots = slots;
+    node->capacity = capacity;
+}
+
+std::size_t ZNestedMap::countValues(const ZNode *node)
+{
+    std::size_t count = node->hasValue ? 1 : 0;
+    for(std::uint32_t slot = 0; slot < node->capacity; ++slot)
+    {
+        if(node->slots[slot].node) count += ZNestedMap::countValues(node->slots[slot].node);
+    }
+    return count;
+}
+
+bool ZNestedMap::visit(const ZNode *node, std::string &path, const char &separator, const ZVisitor &visitor)
+{
+    if(node->hasValue && !visitor(ZStringView(path), node->value)) return false;
+
+    const std::size_t mark = path.size();
+    for(std::uint32_t slot = 0; slot < node->capacity; ++slot)
+    {
+        const ZNode *child = node->slots[slot].node;
+        if(child == nullptr) continue;
+
+        if(mark != 0) path.push_back(separator);
+        path.append(child->key(), child->keySize);
+        bool proceed = ZNestedMap::visit(child, path, separator, visitor);
+        path.resize(mark);
+        if(!proceed) return false;
+    }
+    return true;
+}
+
+bool ZNestedMap::visitChildren(const ZNode *node, const ZStringView &head, const ZStringView &tail,
+                               const char &separator, const ZVisitor &visitor)
+{
+    std::string path(head.data(), head.size());
+    if(!path.empty()) path.push_back(separator);
+    const std::size_t mark = path.size();
+
+    for(std::uint32_t slot = 0; slot < node->capacity; ++slot)
+    {
+        const ZNode *child = node->slots[slot].node;
+        if(child == nullptr || child->keySize < tail.size()) continue;
+        if(!tail.empty() && std::memcmp(child->key(), tail.data(), tail.size()) != 0) continue;
+
+        path.append(child->key(), child->keySize);
+        if(!ZNestedMap::visit(child, path, separator, visitor)) return false;
+        path.resize(mark);
+    }
+    return true;
+}
+
+bool ZNestedMap::eraseBelow(ZNode *node, const char *begin, const char *end, bool &emptied)
+{
+    const char *last = segmentEnd(begin, end, this->m_separator);
+    std::size_t keySize = static_cast<std::size_t>(last - begin);
+    if(keySize == 0) return false;
+
+    std::size_t slot = ZNestedMap::findSlot(node, begin, keySize, segmentHash(begin, keySize));
+    if(slot == node->capacity) return false;
+
+    if(last == end)
+    {
+        this->m_size -= ZNestedMap::countValues(node->slots[slot].node);
+        ZNestedMap::removeChild(node, slot);
+    }
+    else
+    {
+        /* levels left without a value and without children are dropped on the way back */
+        bool childEmptied = false;
+        if(!this->eraseBelow(node->slots[slot].node, last + 1, end, childEmptied)) return false;
+        if(childEmptied) ZNestedMap::removeChild(node, slot);
+    }
+
+    emptied = !node->hasValue && node->childCount == 0;
+    return true;
+}
+
+ZNestedMap::ZNode *ZNestedMap::findNode(const ZStringView &path) const
+{
+    ZNode *node = this->m_root;
+    if(node == nullptr || path.empty()) return node;
+
+    const char *begin = path.begin();
+    const char *end = path.end();
+    for(;;)
+    {
+        const char *last = segmentEnd(begin, end, this->m_separator);
+        std::size_t keySize = static_cast<std::size_t>(last - begin);
+        if(keySize == 0) return nullptr;
+
+        std::size_t slot = ZNestedMap::findSlot(node, begin, keySize, segmentHash(begin, keySize));
+        if(slot == node->capacity) return nullptr;
+
+        node = node->slots[slot].node;
+        if(last == end) return node;
+        begin = last + 1;
+    }
+}
+
+ZNestedMap::ZNode *ZNestedMap::createPath(const ZStringView &path)
+{
+    /* validated up front so a bad path never leaves empty levels behind */
+    if(!isValidPath(path, this->m_separator)) return nullptr;
+    if(this->m_root == nullptr) this->m_root = ZNestedMap::createNode(nullptr, 0);
+
+    ZNode *node = this->m_root;
+    const char *begin = path.begin();
+    const char *end = path.end();
+    for(;;)
+    {
+        const char *last = segmentEnd(begin, end, this->m_separator);
+        std::size_t keySize = static_cast<std::size_t>(last - begin);
+        std::uint64_t hash = segmentHash(begin, keySize);
+
+        std::size_t slot = ZNestedMap::findSlot(node, begin, keySize, hash);
+        if(slot != node->capacity)
+        {
+            node = node->slots[slot].node;
+        }
+        else
+        {
+            std::uint32_t id = this->segmentTable()->intern(begin, keySize, hash);
+            node = ZNestedMap::insertChild(node, begin, keySize, hash, id);
+        }
+        if(last == end) return node;
+        begin = last + 1;
+    }
+}
+
+ZNestedMap::ZNode *ZNestedMap::findNode(const ZPath &path) const
+{
+    if(this->m_root == nullptr || path.m_segments.empty()) return nullptr;
+    if(path.m_cached && path.m_generation == this->m_generation) return static_cast<ZNode*>(path.m_node);
+
+    /* ids only mean something in the table the path was compiled against */
+    const bool interned = this->m_segments && this->m_segments->serial == path.m_table;
+
+    ZNode *node = this->m_root;
+    for(const ZPath::ZSegment &segment : path.m_segments)
+    {
+        std::size_t slot = interned ? ZNestedMap::findSlot(node, segment.id, segment.hash)
+                                    : ZNestedMap::findSlot(node, path.m_path.data() + segment.offset, segment.size, segment.hash);
+        if(slot == node->capacity) return nullptr;
+        node = node->slots[slot].node;
+    }
+
+    if(path.m_cached)
+    {
+        path.m_node = node;
+        path.m_generation = this->m_generation;
+    }
+    return node;
+}
+
+ZNestedMap::ZNode *ZNestedMap::createPath(const ZPath &path)
+{
+    if(path.m_segments.empty()) return nullptr;
+    if(path.m_cached && path.m_generation == this->m_generation) return static_cast<ZNode*>(path.m_node);
+    if(this->m_root == nullptr) this->m_root = ZNestedMap::createNode(nullptr, 0);
+
+    ZSegmentTable *table = this->segmentTable();
+    const bool interned = table->serial == path.m_table;
+
+    ZNode *node = this->m_root;
+    for(const ZPath::ZSegment &segment : path.m_segments)
+    {
+        const char *key = path.m_path.data() + segment.offset;
+        std::size_t slot = interned ? ZNestedMap::findSlot(node, segment.id, segment.hash)
+                                    : ZNestedMap::findSlot(node, key, segment.size, segment.hash);
+        if(slot != node->capacity)
+        {
+            node = node->slots[slot].node;
+            continue;
+        }
+
+        std::uint32_t id = interned ? segment.id : table->intern(key, segment.size, segment.hash);
+        node = ZNestedMap::insertChild(node, key, segment.size, segment.hash, id);
+    }
+
+    if(path.m_cached)
+    {
+        path.m_node = node;
+        path.m_generation = this->m_generation;
+    }
+    return node;
+}
+
+ZVariant *ZNestedMap::findValue(const ZStringView &path) const
+{
+    if(this->m_storage == ZNestedMapStorage::RadixTree) return const_cast<ZVariant*>(this->m_radix.find(path));
+
+    ZNode *node = path.empty() ? nullptr : this->findNode(path);
+    return node && node->hasValue ? &node->value : nullptr;
+}
+
+ZVariant *ZNestedMap::findValue(const ZPath &path) const
+{
+    if(this->m_storage == ZNestedMapStorage::HashLevels)
+    {
+        ZNode *node = this->findNode(path);
+        return node && node->hasValue ? &node->value : nullptr;
+    }
+
+    /* radix handles cache the value itself, leaves never move while their key lives */
+    if(!path.isValid()) return nullptr;
+    if(path.m_cached && path.m_generation == this->m_generation) return static_cast<ZVariant*>(path.m_node);
+
+    ZVariant *value = const_cast<ZVariant*>(this->m_radix.find(path.path()));
+    if(value && path.m_cached)
+    {
+        path.m_node = value;
+        path.m_generation = this->m_generation;
+    }
+    return value;
+}
+
+ZVariant *ZNestedMap::valueSlot(const ZStringView &path)
+{
+    if(this->m_storage == ZNestedMapStorage::RadixTree)
+    {
+        if(!isValidPath(path, this->m_separator)) return nullptr;
+
+        ZVariant *value = &this->m_radix[path];
+        this->m_size = this->m_radix.size();
+        return value;
+    }
+
+    ZNode *node = this->createPath(path);
+    if(node == nullptr) return nullptr;
+
+    if(!node->hasValue)
+    {
+        node->hasValue = true;
+        ++this->m_size;
+    }
+    return &node->value;
+}
+
+ZVariant *ZNestedMap::valueSlot(const ZPath &path)
+{
+    if(this->m_storage == ZNestedMapStorage::HashLevels)
+    {
+        ZNode *node = this->createPath(path);
+        if(node == nullptr) return nullptr;
+
+        if(!node->hasValue)
+        {
+            node->hasValue = true;
+            ++this->m_size;
+        }
+        return &node->value;
+    }
+
+    if(!path.isValid()) return nullptr;
+    if(path.m_cached && path.m_generation == this->m_generation) return static_cast<ZVariant*>(path.m_node);
+
+    ZVariant *value = &this->m_radix[path.path()];
+    this->m_size = this->m_radix.size();
+    if(path.m_cached)
+    {
+        path.m_node = value;
+        path.m_generation = this->m_generation;
+    }
+    return value;
+}
+
+ZNestedMap::ZSegmentTable *ZNestedMap::segmentTable() const
+{
+    if(this->m_segments == nullptr) this->m_segments = new ZSegmentTable();
+    return this->m_segments;
+}
+
+void ZNestedMap::advanceGeneration()
+{
+    this->m_generation = nextStamp();
 }
 
 }
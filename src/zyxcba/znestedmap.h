@@ -29,24 +29,212 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+
+
 #ifndef ZNESTEDMAP_H
 #define ZNESTEDMAP_H
 
-#include <cstdio>
-#include <cstring>
-#include <iostream>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "zradixtree.h"
+#include "zstringview.h"
+#include "zvariant.h"
 
 namespace zyxcba {
 
+class ZNestedMap;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZNestedMapStorage enum
+///
+/// HashLevels keeps one node with a hash table of children per path segment. RadixTree keeps
+/// the full paths in a ZRadixTree, which stores shared prefixes once, iterates in order and
+/// scans arbitrary key prefixes.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+enum class ZNestedMapStorage : std::uint8_t
+{
+    HashLevels,
+    RadixTree
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZPath class
+///
+/// ZPath is a path compiled by ZNestedMap::compile(). The path is split once, every segment is
+/// hashed and resolved to the integer id it has in the segment table of the map, so a lookup
+/// through a ZPath only compares integers on the way down. A cached handle also remembers the
+/// node it reached last, which stays valid until the map removes anything. Used with a map it
+/// was not compiled for, a ZPath still works and falls back to comparing the segment bytes.
+/// With RadixTree storage a ZPath keeps the whole key and caches the value it found.
+///
+/// The cache is updated by const lookups. A cached ZPath must not be shared between threads,
+/// give each thread its own copy.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZPath
+{
+public:
+    ZPath();
+
+    bool isValid() const;
+    bool isCached() const;
+    std::size_t depth() const;
+    ZStringView path() const;
+
+private:
+    friend class ZNestedMap;
+
+    struct ZSegment
+    {
+        std::uint64_t hash;
+        std::uint32_t id;
+        std::uint32_t offset;
+        std::uint32_t size;
+    };
+
+    std::string m_path;
+    std::vector<ZSegment> m_segments;
+    std::uint64_t m_table;
+    bool m_cached;
+    mutable void *m_node;
+    mutable std::uint64_t m_generation;
+};
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief The ZNestedMap class
 ///
+/// ZNestedMap is a hierarchical key/value store addressed by separator delimited paths such as
+/// "server.http.port". Every path segment is a node holding an optional value and a small open
+/// addressing table of its children. A lookup hashes each segment in place and walks one node
+/// per level, so it costs O(depth) and never builds a key object. A path may hold a value and
+/// children at the same time. Empty paths and empty segments are rejected. The order in which
+/// a subtree is visited is unspecified.
+///
+/// With ZNestedMapStorage::RadixTree the whole paths are keys of a ZRadixTree instead. Deep
+/// hierarchies with long shared prefixes take less memory, forEach() and scanPrefix() visit in
+/// byte order, and childCount() has to walk the subtree.
+///
+/// Paths which are looked up over and over can be compiled into a ZPath once. The segment names
+/// are interned in a table owned by the map, ids are never reused while the map lives. Every
+/// change that may free a node moves the map to a new generation, which drops the node cached
+/// in the handles.
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 class ZNestedMap
 {
 public:
-    explicit ZNestedMap();
-    virtual ~ZNestedMap();
+    /* receives the full path and the value of an entry, returns false to stop the walk */
+    typedef std::function<bool(const ZStringView &path, const ZVariant &value)> ZVisitor;
+
+    static const char DefaultSeparator = '.';
+
+    explicit ZNestedMap(const char &separator = DefaultSeparator,
+                        const ZNestedMapStorage &storage = ZNestedMapStorage::HashLevels);
+    ~ZNestedMap();
+
+    ZNestedMap(const ZNestedMap &other);
+    ZNestedMap(ZNestedMap &&other) noexcept;
+    ZNestedMap &operator=(const ZNestedMap &other);
+    ZNestedMap &operator=(ZNestedMap &&other) noexcept;
+
+    void swap(ZNestedMap &other) noexcept;
+
+    /* stores value at path, creating the intermediate levels, returns false for an invalid path */
+    bool set(const ZStringView &path, const ZVariant &value);
+    bool set(const ZStringView &path, ZVariant &&value);
+    bool set(const ZPath &path, const ZVariant &value);
+    bool set(const ZPath &path, ZVariant &&value);
+
+    /* returns nullptr when no value is stored at path */
+    const ZVariant *find(const ZStringView &path) const;
+    ZVariant *find(const ZStringView &path);
+    const ZVariant *find(const ZPath &path) const;
+    ZVariant *find(const ZPath &path);
+
+    ZVariant get(const ZStringView &path, const ZVariant &defaultValue = ZVariant()) const;
+    ZVariant get(const ZPath &path, const ZVariant &defaultValue = ZVariant()) const;
+    bool contains(const ZStringView &path) const;
+    bool contains(const ZPath &path) const;
+
+    /* splits and interns path, the result is invalid when path is */
+    ZPath compile(const ZStringView &path, const bool &cached = true) const;
+
+    /* number of direct children below path, the empty path names the top level */
+    std::size_t childCount(const ZStringView &path) const;
+
+    /* removes the value at path together with everything below it */
+    bool erase(const ZStringView &path);
+    bool erase(const ZPath &path);
+
+    /* visits every value at or below prefix, the empty prefix visits the whole map, returns
+     * false when the visitor stopped the walk
+     */
+    bool forEach(const ZStringView &prefix, const ZVisitor &visitor) const;
+
+    /* visits every value whose path starts with the raw bytes of prefix, which need not end on
+     * a segment boundary, "tenants/4" matches "tenants/4" and "tenants/42/users"
+     */
+    bool scanPrefix(const ZStringView &prefix, const ZVisitor &visitor) const;
+
+    /* number of stored values */
+    std::size_t size() const;
+    bool empty() const;
+    void clear();
+
+    char separator() const;
+    ZNestedMapStorage storage() const;
+
+    /* changes whenever a node may have been freed, unique across all maps */
+    std::uint64_t generation() const;
+
+    /* number of distinct segment names interned so far */
+    std::size_t segmentCount() const;
+
+private:
+    struct ZNode;
+    struct ZSlot;
+    struct ZSegmentTable;
+
+    static ZNode *createNode(const char *key, const std::size_t &keySize);
+    static void destroyNode(ZNode *node);
+    static ZNode *cloneNode(const ZNode *node);
+
+    static std::size_t findSlot(const ZNode *node, const char *key, const std::size_t &keySize, const std::uint64_t &hash);
+    static std::size_t findSlot(const ZNode *node, const std::uint32_t &id, const std::uint64_t &hash);
+    static ZNode *insertChild(ZNode *node, const char *key, const std::size_t &keySize, const std::uint64_t &hash,
+                              const std::uint32_t &id);
+    static void removeChild(ZNode *node, const std::size_t &slot);
+    static void growChildren(ZNode *node);
+
+    static std::size_t countValues(const ZNode *node);
+    static bool visit(const ZNode *node, std::string &path, const char &separator, const ZVisitor &visitor);
+    static bool visitChildren(const ZNode *node, const ZStringView &head, const ZStringView &tail,
+                              const char &separator, const ZVisitor &visitor);
+
+    bool eraseBelow(ZNode *node, const char *begin, const char *end, bool &emptied);
+    ZNode *findNode(const ZStringView &path) const;
+    ZNode *createPath(const ZStringView &path);
+    ZNode *findNode(const ZPath &path) const;
+    ZNode *createPath(const ZPath &path);
+    ZVariant *findValue(const ZStringView &path) const;
+    ZVariant *findValue(const ZPath &path) const;
+    ZVariant *valueSlot(const ZStringView &path);
+    ZVariant *valueSlot(const ZPath &path);
+    ZSegmentTable *segmentTable() const;
+    void advanceGeneration();
+
+    ZNode *m_root;
+    std::size_t m_size;
+    char m_separator;
+    std::uint64_t m_generation;
+    mutable ZSegmentTable *m_segments;
+    ZNestedMapStorage m_storage;
+    ZRadixTree m_radix;
 };
 
 }
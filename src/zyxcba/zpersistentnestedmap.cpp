@@ -0,0 +1,885 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "zpersistentnestedmap.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <utility>
+
+#include "zhash.h"
+
+namespace zyxcba {
+
+namespace {
+
+/* every trie level indexes four bits of the segment hash, a wider level makes lookups no
+ * faster on large maps but copies more siblings on every update
+ */
+const std::uint32_t TrieBits = 4;
+const std::uint32_t TrieMask = (1u << TrieBits) - 1;
+const std::uint32_t HashBits = 64;
+
+inline const char *segmentEnd(const char *begin, const char *end, const char &separator)
+{
+    const void *found = std::memchr(begin, separator, static_cast<std::size_t>(end - begin));
+    return found ? static_cast<const char*>(found) : end;
+}
+
+inline std::uint64_t segmentHash(const char *key, const std::size_t &keySize)
+{
+    return ZHash::hash64(key, keySize);
+}
+
+bool isValidPath(const ZStringView &path, const char &separator)
+{
+    if(path.empty()) return false;
+
+    const char *begin = path.begin();
+    const char *end = path.end();
+    for(;;)
+    {
+        const char *last = segmentEnd(begin, end, separator);
+        std::size_t size = static_cast<std::size_t>(last - begin);
+        if(size == 0 || size > std::numeric_limits<std::uint32_t>::max()) return false;
+        if(last == end) return true;
+        begin = last + 1;
+    }
+}
+
+inline std::uint32_t trieBit(const std::uint64_t &hash, const std::uint32_t &shift)
+{
+    return 1u << static_cast<std::uint32_t>((hash >> shift) & TrieMask);
+}
+
+inline std::uint32_t bitCount(std::uint32_t bits)
+{
+    bits = bits - ((bits >> 1) & 0x55555555u);
+    bits = (bits & 0x33333333u) + ((bits >> 2) & 0x33333333u);
+    return (((bits + (bits >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+}
+
+}
+
+struct ZPersistentNestedMap::ZValue
+{
+    explicit ZValue(const ZVariant &stored): references(1), value(stored) {}
+
+    mutable std::atomic<std::size_t> references;
+    ZVariant value;
+};
+
+/* a child node or a deeper trie, the lowest pointer bit marks a trie */
+struct ZPersistentNestedMap::ZEntry
+{
+    static ZEntry fromNode(const std::uint64_t &hash, const ZNode *node)
+    {
+        ZEntry entry;
+        entry.hash = hash;
+        entry.pointer = reinterpret_cast<std::uintptr_t>(node);
+        return entry;
+    }
+
+    static ZEntry fromTrie(const ZTrie *trie)
+    {
+        ZEntry entry;
+        entry.hash = 0;
+        entry.pointer = reinterpret_cast<std::uintptr_t>(trie) | 1u;
+        return entry;
+    }
+
+    bool isTrie() const { return (this->pointer & 1u) != 0; }
+    const ZNode *node() const { return reinterpret_cast<const ZNode*>(this->pointer); }
+    const ZTrie *trie() const { return reinterpret_cast<const ZTrie*>(this->pointer & ~static_cast<std::uintptr_t>(1u)); }
+
+    std::uint64_t hash;
+    std::uintptr_t pointer;
+};
+
+/* the entries follow the header in the same allocation, a trie below the last hash bits holds
+ * colliding entries as a plain list
+ */
+struct ZPersistentNestedMap::ZTrie
+{
+    ZTrie(const std::uint32_t &level, const std::uint32_t &size): references(1), shift(level), bitmap(0), count(size) {}
+
+    ZEntry *entries() { return reinterpret_cast<ZEntry*>(this + 1); }
+    const ZEntry *entries() const { return reinterpret_cast<const ZEntry*>(this + 1); }
+
+    bool isCollision() const { return this->shift >= HashBits; }
+
+    std::uint32_t position(const std::uint32_t &bit) const { return bitCount(this->bitmap & (bit - 1)); }
+
+    mutable std::atomic<std::uint32_t> references;
+    std::uint32_t shift;
+    std::uint32_t bitmap;
+    std::uint32_t count;
+};
+
+/* one path segment, the segment name follows the header in the same allocation */
+struct ZPersistentNestedMap::ZNode
+{
+    ZNode(): references(1), value(nullptr), children(nullptr), count(0), childCount(0), keySize(0) {}
+
+    char *key() { return reinterpret_cast<char*>(this + 1); }
+    const char *key() const { return reinterpret_cast<const char*>(this + 1); }
+
+    bool hasKey(const char *name, const std::size_t &nameSize) const
+    {
+        return this->keySize == nameSize && std::memcmp(this->key(), name, nameSize) == 0;
+    }
+
+    mutable std::atomic<std::size_t> references;
+    const ZValue *value;
+    const ZTrie *children;
+
+    /* values stored in this subtree, this node included */
+    std::size_t count;
+    std::uint32_t childCount;
+    std::uint32_t keySize;
+};
+
+ZPersistentNestedMap::ZPersistentNestedMap(const char &separator):
+    m_root(nullptr),
+    m_separator(separator)
+{
+
+}
+
+ZPersistentNestedMap::ZPersistentNestedMap(const ZNestedMap &map):
+    m_root(nullptr),
+    m_separator(map.separator())
+{
+    map.forEach(ZStringView(), [this](const ZStringView &path, const ZVariant &value) {
+        *this = std::move(*this).set(path, value);
+        return true;
+    });
+}
+
+ZPersistentNestedMap::ZPersistentNestedMap(const ZNode *root, const char &separator):
+    m_root(root),
+    m_separator(separator)
+{
+
+}
+
+ZPersistentNestedMap::~ZPersistentNestedMap()
+{
+    ZPersistentNestedMap::release(this->m_root);
+}
+
+ZPersistentNestedMap::ZPersistentNestedMap(const ZPersistentNestedMap &other):
+    m_root(ZPersistentNestedMap::retain(other.m_root)),
+    m_separator(other.m_separator)
+{
+
+}
+
+ZPersistentNestedMap::ZPersistentNestedMap(ZPersistentNestedMap &&other) noexcept:
+    m_root(other.m_root),
+    m_separator(other.m_separator)
+{
+    other.m_root = nullptr;
+}
+
+ZPersistentNestedMap &ZPersistentNestedMap::operator=(const ZPersistentNestedMap &other)
+{
+    const ZNode *root = ZPersistentNestedMap::retain(other.m_root);
+    ZPersistentNestedMap::release(this->m_root);
+    this->m_root = root;
+    this->m_separator = other.m_separator;
+    return *this;
+}
+
+ZPersistentNestedMap &ZPersistentNestedMap::operator=(ZPersistentNestedMap &&other) noexcept
+{
+    this->swap(other);
+    return *this;
+}
+
+void ZPersistentNestedMap::swap(ZPersistentNestedMap &other) noexcept
+{
+    std::swap(this->m_root, other.m_root);
+    std::swap(this->m_separator, other.m_separator);
+}
+
+ZPersistentNestedMap ZPersistentNestedMap::set(const ZStringView &path, const ZVariant &value) const &
+{
+    if(!isValidPath(path, this->m_separator)) return *this;
+
+    const ZNode *root = ZPersistentNestedMap::assignPath(this->m_root, nullptr, 0, path.begin(), path.end(),
+                                                         this->m_separator, value, false);
+    return ZPersistentNestedMap(root, this->m_separator);
+}
+
+ZPersistentNestedMap ZPersistentNestedMap::set(const ZStringView &path, const ZVariant &value) &&
+{
+    if(!isValidPath(path, this->m_separator)) return std::move(*this);
+
+    const ZNode *root = ZPersistentNestedMap::assignPath(this->m_root, nullptr, 0, path.begin(), path.end(),
+                                                         this->m_separator, value, true);
+    ZPersistentNestedMap::release(this->m_root);
+    this->m_root = nullptr;
+    return ZPersistentNestedMap(root, this->m_separator);
+}
+
+ZPersistentNestedMap ZPersistentNestedMap::erase(const ZStringView &path) const
+{
+    if(this->m_root == nullptr || path.empty()) return *this;
+
+    bool found = false;
+    const ZNode *root = ZPersistentNestedMap::erasePath(this->m_root, path.begin(), path.end(), this->m_separator, found);
+    if(!found) return *this;
+
+    return ZPersistentNestedMap(root, this->m_separator);
+}
+
+const ZVariant *ZPersistentNestedMap::find(const ZStringView &path) const
+{
+    const ZNode *node = path.empty() ? nullptr : this->findNode(path);
+    return node && node->value ? &node->value->value : nullptr;
+}
+
+ZVariant ZPersistentNestedMap::get(const ZStringView &path, const ZVariant &defaultValue) const
+{
+    const ZVariant *value = this->find(path);
+    return value ? *value : defaultValue;
+}
+
+bool ZPersistentNestedMap::contains(const ZStringView &path) const
+{
+    return this->find(path) != nullptr;
+}
+
+std::size_t ZPersistentNestedMap::childCount(const ZStringView &path) const
+{
+    const ZNode *node = this->findNode(path);
+    return node ? node->childCount : 0;
+}
+
+bool ZPersistentNestedMap::forEach(const ZStringView &prefix, const ZVisitor &visitor) const
+{
+    const ZNode *node = this->findNode(prefix);
+    if(node == nullptr) return true;
+
+    std::string path(prefix.data(), prefix.size());
+    return ZPersistentNestedMap::visit(node, path, this->m_separator, visitor);
+}
+
+std::size_t ZPersistentNestedMap::size() const
+{
+    return this->m_root ? this->m_root->count : 0;
+}
+
+bool ZPersistentNestedMap::empty() const
+{
+    return this->size() == 0;
+}
+
+char ZPersistentNestedMap::separator() const
+{
+    return this->m_separator;
+}
+
+bool ZPersistentNestedMap::isSharedWith(const ZPersistentNestedMap &other) const
+{
+    return this->m_root == other.m_root && this->m_separator == other.m_separator;
+}
+
+const ZPersistentNestedMap::ZNode *ZPersistentNestedMap::retain(const ZNode *node)
+{
+    if(node) node->references.fetch_add(1, std::memory_order_relaxed);
+    return node;
+}
+
+const ZPersistentNestedMap::ZTrie *ZPersistentNestedMap::retain(const ZTrie *trie)
+{
+    if(trie) trie->references.fetch_add(1, std::memory_order_relaxed);
+    return trie;
+}
+
+const ZPersistentNestedMap::ZValue *ZPersistentNestedMap::retain(const ZValue *value)
+{
+    if(value) value->references.fetch_add(1, std::memory_order_relaxed);
+    return value;
+}
+
+void ZPersistentNestedMap::release(const ZNode *node)
+{
+    if(node == nullptr || node->references.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+    ZPersistentNestedMap::release(node->value);
+    ZPersistentNestedMap::release(node->children);
+    node->~ZNode();
+    std::free(const_cast<ZNode*>(node));
+}
+
+void ZPersistentNestedMap::release(const ZTrie *trie)
+{
+    if(trie == nullptr || trie->references.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+    for(std::uint32_t index = 0; index < trie->count; ++index)
+    {
+        const ZEntry &entry = trie->entries()[index];
+        if(entry.isTrie()) ZPersistentNestedMap::release(entry.trie());
+        else ZPersistentNestedMap::release(entry.node());
+    }
+    trie->~ZTrie();
+    std::free(const_cast<ZTrie*>(trie));
+}
+
+void ZPersistentNestedMap::release(const ZValue *value)
+{
+    if(value && value->references.fetch_sub(1, std::memory_order_acq_rel) == 1) delete value;
+}
+
+ZPersistentNestedMap::ZNode *ZPersistentNestedMap::createNode(const char *key, const std::size_t &keySize)
+{
+    void *memory = std::malloc(sizeof(ZNode) + keySize);
+    if(memory == nullptr) throw std::bad_alloc();
+
+    ZNode *node = new (memory) ZNode();
+    node->keySize = static_cast<std::uint32_t>(keySize);
+    if(keySize != 0) std::memcpy(node->key(), key, keySize);
+    return node;
+}
+
+ZPersistentNestedMap::ZTrie *ZPersistentNestedMap::createTrie(const std::uint32_t &shift, const std::uint32_t &count)
+{
+    void *memory = std::malloc(sizeof(ZTrie) + count * sizeof(ZEntry));
+    if(memory == nullptr) throw std::bad_alloc();
+
+    return new (memory) ZTrie(shift, count);
+}
+
+const ZPersistentNestedMap::ZNode *ZPersistentNestedMap::findChild(const ZTrie *trie, const char *key, const std::size_t &keySize,
+                                                                   const std::uint64_t &hash)
+{
+    while(trie)
+    {
+        if(trie->isCollision())
+        {
+            for(std::uint32_t index = 0; index < trie->count; ++index)
+            {
+                const ZEntry &entry = trie->entries()[index];
+                if(entry.hash == hash && entry.node()->hasKey(key, keySize)) return entry.node();
+            }
+            return nullptr;
+        }
+
+        const std::uint32_t bit = trieBit(hash, trie->shift);
+        if((trie->bitmap & bit) == 0) return nullptr;
+
+        const ZEntry &entry = trie->entries()[trie->position(bit)];
+        if(entry.isTrie())
+        {
+            trie = entry.trie();
+            continue;
+        }
+        return entry.hash == hash && entry.node()->hasKey(key, keySize) ? entry.node() : nullptr;
+    }
+    return nullptr;
+}
+
+const ZPersistentNestedMap::ZTrie *ZPersistentNestedMap::insertChild(const ZTrie *trie, const std::uint64_t &hash, const ZNode *child)
+{
+    /* returns a copy of trie holding child, which replaces an entry with the same name, the
+     * child is retained and not adopted
+     */
+    const ZEntry added = ZEntry::fromNode(hash, child);
+    if(trie == nullptr)
+    {
+        ZTrie *copy = ZPersistentNestedMap::createTrie(0, 1);
+        copy->bitmap = trieBit(hash, 0);
+        copy->entries()[0] = added;
+        ZPersistentNestedMap::retain(child);
+        return copy;
+    }
+
+    std::uint32_t position = trie->count;
+    ZEntry replacement = added;
+    std::uint32_t bitmap = trie->bitmap;
+    if(trie->isCollision())
+    {
+        for(std::uint32_t index = 0; index < trie->count; ++index)
+        {
+            const ZEntry &entry = trie->entries()[index];
+            if(entry.hash == hash && entry.node()->hasKey(child->key(), child->keySize)) position = index;
+        }
+    }
+    else
+    {
+        const std::uint32_t bit = trieBit(hash, trie->shift);
+        position = trie->position(bit);
+        if((trie->bitmap & bit) == 0)
+        {
+            bitmap |= bit;
+
+            /* a new entry, the ones after it move up by one */
+            ZTrie *copy = ZPersistentNestedMap::createTrie(trie->shift, trie->count + 1);
+            copy->bitmap = bitmap;
+            for(std::uint32_t index = 0, target = 0; index < trie->count; ++index, ++target)
+            {
+                if(index == position) copy->entries()[target++] = added;
+                copy->entries()[target] = trie->entries()[index];
+            }
+            if(position == trie->count) copy->entries()[position] = added;
+
+            for(std::uint32_t index = 0; index < copy->count; ++index)
+            {
+                const ZEntry &entry = copy->entries()[index];
+                if(entry.isTrie()) ZPersistentNestedMap::retain(entry.trie());
+                else ZPersistentNestedMap::retain(entry.node());
+            }
+            return copy;
+        }
+
+        const ZEntry &existing = trie->entries()[position];
+        if(existing.isTrie())
+        {
+            replacement = ZEntry::fromTrie(ZPersistentNestedMap::insertChild(existing.trie(), hash, child));
+        }
+        else if(existing.hash != hash || !existing.node()->hasKey(child->key(), child->keySize))
+        {
+            replacement = ZEntry::fromTrie(ZPersistentNestedMap::mergeChildren(trie->shift + TrieBits, existing, added));
+        }
+        else
+        {
+            ZPersistentNestedMap::retain(child);
+        }
+    }
+
+    /* the collision list grows by one when the name was not found in it */
+    const bool append = position == trie->count;
+    if(trie->isCollision()) ZPersistentNestedMap::retain(child);
+
+    ZTrie *copy = nullptr;
+    try
+    {
+        copy = ZPersistentNestedMap::createTrie(trie->shift, trie->count + (append ? 1 : 0));
+    }
+    catch(...)
+    {
+        if(replacement.isTrie()) ZPersistentNestedMap::release(replacement.trie());
+        else ZPersistentNestedMap::release(replacement.node());
+        throw;
+    }
+
+    copy->bitmap = bitmap;
+    for(std::uint32_t index = 0; index < trie->count; ++index)
+    {
+        if(index == position) continue;
+
+        const ZEntry &entry = trie->entries()[index];
+        copy->entries()[index] = entry;
+        if(entry.isTrie()) ZPersistentNestedMap::retain(entry.trie());
+        else ZPersistentNestedMap::retain(entry.node());
+    }
+    copy->entries()[position] = replacement;
+    return copy;
+}
+
+const ZPersistentNestedMap::ZTrie *ZPersistentNestedMap::removeChild(const ZTrie *trie, const char *key, const std::size_t &keySize,
+                                                                     const std::uint64_t &hash)
+{
+    /* returns a copy of trie without the named child, which must be present, or nullptr when
+     * nothing is left, a trie left with a single child is folded into its parent
+     */
+    std::uint32_t position = 0;
+    std::uint32_t bitmap = trie->bitmap;
+    if(trie->isCollision())
+    {
+        while(!trie->entries()[position].node()->hasKey(key, keySize)) ++position;
+    }
+    else
+    {
+        const std::uint32_t bit = trieBit(hash, trie->shift);
+        position = trie->position(bit);
+
+        const ZEntry &existing = trie->entries()[position];
+        if(existing.isTrie())
+        {
+            const ZTrie *nested = ZPersistentNestedMap::removeChild(existing.trie(), key, keySize, hash);
+            if(nested)
+            {
+                ZEntry replacement = ZEntry::fromTrie(nested);
+                if(nested->count == 1 && !nested->entries()[0].isTrie())
+                {
+                    replacement = nested->entries()[0];
+                    ZPersistentNestedMap::retain(replacement.node());
+                    ZPersistentNestedMap::release(nested);
+                }
+
+                ZTrie *copy = nullptr;
+                try
+                {
+                    copy = ZPersistentNestedMap::createTrie(trie->shift, trie->count);
+                }
+                catch(...)
+                {
+                    if(replacement.isTrie()) ZPersistentNestedMap::release(replacement.trie());
+                    else ZPersistentNestedMap::release(replacement.node());
+                    throw;
+                }
+
+                copy->bitmap = bitmap;
+                for(std::uint32_t index = 0; index < trie->count; ++index)
+                {
+                    if(index == position) continue;
+
+                    const ZEntry &entry = trie->entries()[index];
+                    copy->entries()[index] = entry;
+                    if(entry.isTrie()) ZPersistentNestedMap::retain(entry.trie());
+                    else ZPersistentNestedMap::retain(entry.node());
+                }
+                copy->entries()[position] = replacement;
+                return copy;
+            }
+        }
+        bitmap &= ~bit;
+    }
+
+    if(trie->count == 1) return nullptr;
+
+    ZTrie *copy = ZPersistentNestedMap::createTrie(trie->shift, trie->count - 1);
+    copy->bitmap = bitmap;
+    for(std::uint32_t index = 0, target = 0; index < trie->count; ++index)
+    {
+        if(index == position) continue;
+
+        const ZEntry &entry = trie->entries()[index];
+        copy->entries()[target++] = entry;
+        if(entry.isTrie()) ZPersistentNestedMap::retain(entry.trie());
+        else ZPersistentNestedMap::retain(entry.node());
+    }
+    return copy;
+}
+
+ZPersistentNestedMap::ZEntry *ZPersistentNestedMap::ownedEntry(const ZTrie *trie, const char *key, const std::size_t &keySize,
+                                                                const std::uint64_t &hash)
+{
+    /* the entry of the named child when every trie on the way is referenced once, only then it
+     * can be changed in place
+     */
+    while(trie && trie->references.load(std::memory_order_acquire) == 1)
+    {
+        ZEntry *entries = const_cast<ZTrie*>(trie)->entries();
+        if(trie->isCollision())
+        {
+            for(std::uint32_t index = 0; index < trie->count; ++index)
+            {
+                if(entries[index].hash == hash && entries[index].node()->hasKey(key, keySize)) return &entries[index];
+            }
+            return nullptr;
+        }
+
+        const std::uint32_t bit = trieBit(hash, trie->shift);
+        if((trie->bitmap & bit) == 0) return nullptr;
+
+        ZEntry &entry = entries[trie->position(bit)];
+        if(entry.isTrie())
+        {
+            trie = entry.trie();
+            continue;
+        }
+        return entry.hash == hash && entry.node()->hasKey(key, keySize) ? &entry : nullptr;
+    }
+    return nullptr;
+}
+
+const ZPersistentNestedMap::ZTrie *ZPersistentNestedMap::mergeChildren(const std::uint32_t &shift, const ZEntry &first,
+                                                                       const ZEntry &second)
+{
+    /* two different names which shared a slot above, the result retains both */
+    if(shift >= HashBits)
+    {
+        ZTrie *trie = ZPersistentNestedMap::createTrie(shift, 2);
+        trie->entries()[0] = first;
+        trie->entries()[1] = second;
+        ZPersistentNestedMap::retain(first.node());
+        ZPersistentNestedMap::retain(second.node());
+        return trie;
+    }
+
+    const std::uint32_t firstBit = trieBit(first.hash, shift);
+    const std::uint32_t secondBit = trieBit(second.hash, shift);
+    if(firstBit == secondBit)
+    {
+        const ZTrie *nested = ZPersistentNestedMap::mergeChildren(shift + TrieBits, first, second);
+        ZTrie *trie = nullptr;
+        try
+        {
+            trie = ZPersistentNestedMap::createTrie(shift, 1);
+        }
+        catch(...)
+        {
+            ZPersistentNestedMap::release(nested);
+            throw;
+        }
+        trie->bitmap = firstBit;
+        trie->entries()[0] = ZEntry::fromTrie(nested);
+        return trie;
+    }
+
+    ZTrie *trie = ZPersistentNestedMap::createTrie(shift, 2);
+    trie->bitmap = firstBit | secondBit;
+    trie->entries()[firstBit < secondBit ? 0 : 1] = first;
+    trie->entries()[firstBit < secondBit ? 1 : 0] = second;
+    ZPersistentNestedMap::retain(first.node());
+    ZPersistentNestedMap::retain(second.node());
+    return trie;
+}
+
+bool ZPersistentNestedMap::visitChildren(const ZTrie *trie, std::string &path, const char &separator, const ZVisitor &visitor)
+{
+    const std::size_t mark = path.size();
+    for(std::uint32_t index = 0; index < trie->count; ++index)
+    {
+        const ZEntry &entry = trie->entries()[index];
+        if(entry.isTrie())
+        {
+            if(!ZPersistentNestedMap::visitChildren(entry.trie(), path, separator, visitor)) return false;
+            continue;
+        }
+
+        if(mark != 0) path.push_back(separator);
+        path.append(entry.node()->key(), entry.node()->keySize);
+        bool proceed = ZPersistentNestedMap::visit(entry.node(), path, separator, visitor);
+        path.resize(mark);
+        if(!proceed) return false;
+    }
+    return true;
+}
+
+bool ZPersistentNestedMap::visit(const ZNode *node, std::string &path, const char &separator, const ZVisitor &visitor)
+{
+    if(node->value && !visitor(ZStringView(path), node->value->value)) return false;
+
+    return node->children == nullptr || ZPersistentNestedMap::visitChildren(node->children, path, separator, visitor);
+}
+
+const ZPersistentNestedMap::ZNode *ZPersistentNestedMap::assignPath(const ZNode *node, const char *key, const std::size_t &keySize,
+                                                                    const char *begin, const char *end, const char &separator,
+                                                                    const ZVariant &value, const bool &owned)
+{
+    /* returns node, which may be nullptr, with value stored at the rest of the path, owned tells
+     * that no other version reaches node through its ancestors, a node referenced once is then
+     * changed in place and returned with one more reference, any other node is copied
+     */
+    const bool inPlace = owned && node && node->references.load(std::memory_order_acquire) == 1;
+    if(begin == end)
+    {
+        if(inPlace)
+        {
+            ZNode *target = const_cast<ZNode*>(node);
+            if(node->value && node->value->references.load(std::memory_order_acquire) == 1)
+            {
+                const_cast<ZValue*>(node->value)->value = value;
+            }
+            else
+            {
+                const ZValue *stored = new ZValue(value);
+                if(node->value == nullptr) ++target->count;
+                ZPersistentNestedMap::release(node->value);
+                target->value = stored;
+            }
+            return ZPersistentNestedMap::retain(node);
+        }
+
+        ZValue *stored = new ZValue(value);
+        ZNode *copy = nullptr;
+        try
+        {
+            copy = ZPersistentNestedMap::createNode(key, keySize);
+        }
+        catch(...)
+        {
+            ZPersistentNestedMap::release(stored);
+            throw;
+        }
+
+        copy->value = stored;
+        if(node)
+        {
+            copy->children = ZPersistentNestedMap::retain(node->children);
+            copy->childCount = node->childCount;
+            copy->count = node->count - (node->value ? 1 : 0);
+        }
+        ++copy->count;
+        return copy;
+    }
+
+    const char *last = segmentEnd(begin, end, separator);
+    const std::size_t childKeySize = static_cast<std::size_t>(last - begin);
+    const std::uint64_t hash = segmentHash(begin, childKeySize);
+    const ZNode *child = node ? ZPersistentNestedMap::findChild(node->children, begin, childKeySize, hash) : nullptr;
+    ZEntry *entry = inPlace && child ? ZPersistentNestedMap::ownedEntry(node->children, begin, childKeySize, hash) : nullptr;
+    const std::size_t childCount = child ? child->count : 0;
+
+    const ZNode *childCopy = ZPersistentNestedMap::assignPath(child, begin, childKeySize, last == end ? end : last + 1, end,
+                                                              separator, value, entry != nullptr);
+    const std::size_t count = (node ? node->count : 0) - childCount + childCopy->count;
+    if(inPlace)
+    {
+        ZNode *target = const_cast<ZNode*>(node);
+        if(entry)
+        {
+            /* the entry keeps its reference when the child was changed in place */
+            if(childCopy == child) ZPersistentNestedMap::release(childCopy);
+            else entry->pointer = reinterpret_cast<std::uintptr_t>(childCopy);
+            if(childCopy != child) ZPersistentNestedMap::release(child);
+        }
+        else
+        {
+            const ZTrie *children = nullptr;
+            try
+            {
+                children = ZPersistentNestedMap::insertChild(node->children, hash, childCopy);
+            }
+            catch(...)
+            {
+                ZPersistentNestedMap::release(childCopy);
+                throw;
+            }
+            ZPersistentNestedMap::release(childCopy);
+            ZPersistentNestedMap::release(node->children);
+            target->children = children;
+            if(child == nullptr) ++target->childCount;
+        }
+        target->count = count;
+        return ZPersistentNestedMap::retain(node);
+    }
+
+    const ZTrie *children = nullptr;
+    ZNode *copy = nullptr;
+    try
+    {
+        children = ZPersistentNestedMap::insertChild(node ? node->children : nullptr, hash, childCopy);
+        copy = ZPersistentNestedMap::createNode(key, keySize);
+    }
+    catch(...)
+    {
+        ZPersistentNestedMap::release(children);
+        ZPersistentNestedMap::release(childCopy);
+        throw;
+    }
+
+    copy->value = node ? ZPersistentNestedMap::retain(node->value) : nullptr;
+    copy->children = children;
+    copy->childCount = (node ? node->childCount : 0) + (child ? 0 : 1);
+    copy->count = count;
+
+    ZPersistentNestedMap::release(childCopy);
+    return copy;
+}
+
+const ZPersistentNestedMap::ZNode *ZPersistentNestedMap::erasePath(const ZNode *node, const char *begin, const char *end,
+                                                                   const char &separator, bool &found)
+{
+    /* returns a copy of node without the rest of the path, or nullptr when the copy would hold
+     * neither a value nor children, found tells whether the path was there at all
+     */
+    const char *last = segmentEnd(begin, end, separator);
+    const std::size_t childKeySize = static_cast<std::size_t>(last - begin);
+    const std::uint64_t hash = segmentHash(begin, childKeySize);
+    const ZNode *child = ZPersistentNestedMap::findChild(node->children, begin, childKeySize, hash);
+    if(child == nullptr)
+    {
+        found = false;
+        return nullptr;
+    }
+
+    const ZNode *childCopy = nullptr;
+    if(last != end)
+    {
+        childCopy = ZPersistentNestedMap::erasePath(child, last + 1, end, separator, found);
+        if(!found) return nullptr;
+    }
+    found = true;
+
+    const ZTrie *children = nullptr;
+    try
+    {
+        if(childCopy) children = ZPersistentNestedMap::insertChild(node->children, hash, childCopy);
+        else children = ZPersistentNestedMap::removeChild(node->children, begin, childKeySize, hash);
+    }
+    catch(...)
+    {
+        ZPersistentNestedMap::release(childCopy);
+        throw;
+    }
+
+    const std::size_t count = node->count - child->count + (childCopy ? childCopy->count : 0);
+    ZPersistentNestedMap::release(childCopy);
+    if(node->value == nullptr && children == nullptr) return nullptr;
+
+    ZNode *copy = nullptr;
+    try
+    {
+        copy = ZPersistentNestedMap::createNode(node->key(), node->keySize);
+    }
+    catch(...)
+    {
+        ZPersistentNestedMap::release(children);
+        throw;
+    }
+
+    copy->value = ZPersistentNestedMap::retain(node->value);
+    copy->children = children;
+    copy->childCount = node->childCount - (childCopy ? 0 : 1);
+    copy->count = count;
+    return copy;
+}
+
+const ZPersistentNestedMap::ZNode *ZPersistentNestedMap::findNode(const ZStringView &path) const
+{
+    const ZNode *node = this->m_root;
+    if(node == nullptr || path.empty()) return node;
+
+    const char *begin = path.begin();
+    const char *end = path.end();
+    for(;;)
+    {
+        const char *last = segmentEnd(begin, end, this->m_separator);
+        std::size_t keySize = static_cast<std::size_t>(last - begin);
+        if(keySize == 0) return nullptr;
+
+        node = ZPersistentNestedMap::findChild(node->children, begin, keySize, segmentHash(begin, keySize));
+        if(node == nullptr || last == end) return node;
+        begin = last + 1;
+    }
+}
+
+}
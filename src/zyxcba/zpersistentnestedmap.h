@@ -0,0 +1,158 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef ZPERSISTENTNESTEDMAP_H
+#define ZPERSISTENTNESTEDMAP_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "znestedmap.h"
+#include "zstringview.h"
+#include "zvariant.h"
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZPersistentNestedMap class
+///
+/// ZPersistentNestedMap is an immutable version of a ZNestedMap. It uses the same path syntax,
+/// but set() and erase() leave the map alone and return a new version. The new version copies
+/// only the nodes on the changed path and shares everything else with the old one, so an update
+/// costs a few small copies per path segment instead of a copy of the map. Copying a version is
+/// O(1) and takes a snapshot which later updates cannot change.
+///
+/// Every level keeps its children in a hash array mapped trie. Each trie node indexes 4 bits of
+/// the segment hash through a bitmap and stores only the entries that are present. Nodes,
+/// tries and values are reference counted and freed when the last version using them goes
+/// away. Stored values are shared between versions and never copied by an update.
+///
+/// A writer that keeps a head version and moves it through set(), as in
+/// head = std::move(head).set(path, value), only copies what a snapshot taken since still
+/// holds. Nodes referenced by that head alone are updated in place.
+///
+/// Reference counts are atomic, so versions may be copied and read by several threads at once.
+/// A single ZPersistentNestedMap object must still not be assigned while another thread uses it.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZPersistentNestedMap
+{
+public:
+    typedef ZNestedMap::ZVisitor ZVisitor;
+
+    explicit ZPersistentNestedMap(const char &separator = ZNestedMap::DefaultSeparator);
+    explicit ZPersistentNestedMap(const ZNestedMap &map);
+    ~ZPersistentNestedMap();
+
+    /* copies share the root, a copy is a snapshot */
+    ZPersistentNestedMap(const ZPersistentNestedMap &other);
+    ZPersistentNestedMap(ZPersistentNestedMap &&other) noexcept;
+    ZPersistentNestedMap &operator=(const ZPersistentNestedMap &other);
+    ZPersistentNestedMap &operator=(ZPersistentNestedMap &&other) noexcept;
+
+    void swap(ZPersistentNestedMap &other) noexcept;
+
+    /* returns the version with value stored at path, an invalid path returns this version, on
+     * an rvalue the nodes no other version holds are updated in place instead of copied
+     */
+    ZPersistentNestedMap set(const ZStringView &path, const ZVariant &value) const &;
+    ZPersistentNestedMap set(const ZStringView &path, const ZVariant &value) &&;
+
+    /* returns the version without path and everything below it */
+    ZPersistentNestedMap erase(const ZStringView &path) const;
+
+    /* returns nullptr when no value is stored at path, the pointer lives as long as a version
+     * holding it does
+     */
+    const ZVariant *find(const ZStringView &path) const;
+    ZVariant get(const ZStringView &path, const ZVariant &defaultValue = ZVariant()) const;
+    bool contains(const ZStringView &path) const;
+
+    /* number of direct children below path, the empty path names the top level */
+    std::size_t childCount(const ZStringView &path) const;
+
+    /* visits every value at or below prefix, the empty prefix visits the whole map, returns
+     * false when the visitor stopped the walk
+     */
+    bool forEach(const ZStringView &prefix, const ZVisitor &visitor) const;
+
+    /* number of stored values */
+    std::size_t size() const;
+    bool empty() const;
+
+    char separator() const;
+
+    /* true when both hold the very same version, which is cheaper than comparing the content */
+    bool isSharedWith(const ZPersistentNestedMap &other) const;
+
+private:
+    struct ZValue;
+    struct ZEntry;
+    struct ZTrie;
+    struct ZNode;
+
+    ZPersistentNestedMap(const ZNode *root, const char &separator);
+
+    static const ZNode *retain(const ZNode *node);
+    static const ZTrie *retain(const ZTrie *trie);
+    static const ZValue *retain(const ZValue *value);
+    static void release(const ZNode *node);
+    static void release(const ZTrie *trie);
+    static void release(const ZValue *value);
+
+    static ZNode *createNode(const char *key, const std::size_t &keySize);
+    static ZTrie *createTrie(const std::uint32_t &shift, const std::uint32_t &count);
+
+    static const ZNode *findChild(const ZTrie *trie, const char *key, const std::size_t &keySize, const std::uint64_t &hash);
+    static const ZTrie *insertChild(const ZTrie *trie, const std::uint64_t &hash, const ZNode *child);
+    static const ZTrie *removeChild(const ZTrie *trie, const char *key, const std::size_t &keySize, const std::uint64_t &hash);
+    static ZEntry *ownedEntry(const ZTrie *trie, const char *key, const std::size_t &keySize, const std::uint64_t &hash);
+    static const ZTrie *mergeChildren(const std::uint32_t &shift, const ZEntry &first, const ZEntry &second);
+    static bool visitChildren(const ZTrie *trie, std::string &path, const char &separator, const ZVisitor &visitor);
+    static bool visit(const ZNode *node, std::string &path, const char &separator, const ZVisitor &visitor);
+
+    static const ZNode *assignPath(const ZNode *node, const char *key, const std::size_t &keySize, const char *begin,
+                                   const char *end, const char &separator, const ZVariant &value, const bool &owned);
+    static const ZNode *erasePath(const ZNode *node, const char *begin, const char *end, const char &separator,
+                                  bool &found);
+
+    const ZNode *findNode(const ZStringView &path) const;
+
+    const ZNode *m_root;
+    char m_separator;
+};
+
+}
+
+#endif // ZPERSISTENTNESTEDMAP_H
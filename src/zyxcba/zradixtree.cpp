@@ -0,0 +1,1200 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "zradixtree.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__SSE2__)
+#define ZYXCBA_RADIX_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace zyxcba {
+
+namespace {
+
+enum ZRadixNodeType : std::uint8_t
+{
+    Node4Type,
+    Node16Type,
+    Node48Type,
+    Node256Type
+};
+
+/* below these counts a node moves down to the next smaller size, with some slack so a node
+ * at the boundary does not flip back and forth
+ */
+const std::size_t Node256ShrinkCount = 37;
+const std::size_t Node48ShrinkCount = 12;
+const std::size_t Node16ShrinkCount = 3;
+
+inline bool isLeafRef(const std::uintptr_t &ref)
+{
+    return (ref & 1) != 0;
+}
+
+}
+
+const std::size_t ZRadixTree::MaxInlinePrefix;
+
+/* the key is stored right behind the leaf, in the same allocation */
+struct ZRadixTree::ZLeaf
+{
+    ZLeaf(): keySize(0) {}
+
+    static ZLeaf *fromRef(const ZRef &ref) { return reinterpret_cast<ZLeaf*>(ref & ~static_cast<ZRef>(1)); }
+    ZRef toRef() const { return reinterpret_cast<ZRef>(this) | 1; }
+
+    char *key() { return reinterpret_cast<char*>(this + 1); }
+    const char *key() const { return reinterpret_cast<const char*>(this + 1); }
+
+    bool matches(const char *other, const std::size_t &otherSize) const
+    {
+        return this->keySize == otherSize && (otherSize == 0 || std::memcmp(this->key(), other, otherSize) == 0);
+    }
+
+    bool startsWith(const char *prefix, const std::size_t &prefixSize) const
+    {
+        return this->keySize >= prefixSize && (prefixSize == 0 || std::memcmp(this->key(), prefix, prefixSize) == 0);
+    }
+
+    ZVariant value;
+    std::size_t keySize;
+};
+
+struct ZRadixTree::ZInner
+{
+    explicit ZInner(const std::uint8_t &nodeType): type(nodeType), count(0), prefixLength(0), terminal(nullptr) {}
+
+    static ZInner *fromRef(const ZRef &ref) { return reinterpret_cast<ZInner*>(ref); }
+    ZRef toRef() const { return reinterpret_cast<ZRef>(this); }
+
+    /* takes over everything but the children */
+    void copyHeader(const ZInner &other)
+    {
+        this->count = other.count;
+        this->prefixLength = other.prefixLength;
+        std::memcpy(this->prefix, other.prefix, MaxInlinePrefix);
+        this->terminal = other.terminal;
+    }
+
+    static void destroy(ZInner *node);
+
+    std::uint8_t type;
+    std::uint16_t count;
+    std::uint32_t prefixLength;
+    std::uint8_t prefix[MaxInlinePrefix];
+    ZLeaf *terminal;
+};
+
+struct ZRadixTree::ZNode4: public ZInner
+{
+    ZNode4(): ZInner(Node4Type)
+    {
+        std::memset(this->keys, 0, sizeof(this->keys));
+        std::memset(this->children, 0, sizeof(this->children));
+    }
+
+    std::uint8_t keys[4];
+    ZRef children[4];
+};
+
+struct ZRadixTree::ZNode16: public ZInner
+{
+    ZNode16(): ZInner(Node16Type)
+    {
+        std::memset(this->keys, 0, sizeof(this->keys));
+        std::memset(this->children, 0, sizeof(this->children));
+    }
+
+    std::uint8_t keys[16];
+    ZRef children[16];
+};
+
+struct ZRadixTree::ZNode48: public ZInner
+{
+    ZNode48(): ZInner(Node48Type)
+    {
+        std::memset(this->index, 0, sizeof(this->index));
+        std::memset(this->children, 0, sizeof(this->children));
+    }
+
+    /* slot + 1 of the child for every byte, zero when there is none */
+    std::uint8_t index[256];
+    ZRef children[48];
+};
+
+struct ZRadixTree::ZNode256: public ZInner
+{
+    ZNode256(): ZInner(Node256Type)
+    {
+        std::memset(this->children, 0, sizeof(this->children));
+    }
+
+    ZRef children[256];
+};
+
+void ZRadixTree::ZInner::destroy(ZInner *node)
+{
+    switch(node->type)
+    {
+    case Node4Type: delete static_cast<ZNode4*>(node); break;
+    case Node16Type: delete static_cast<ZNode16*>(node); break;
+    case Node48Type: delete static_cast<ZNode48*>(node); break;
+    default: delete static_cast<ZNode256*>(node); break;
+    }
+}
+
+ZRadixTree::ZRadixTree():
+    m_root(0),
+    m_size(0)
+{
+
+}
+
+ZRadixTree::~ZRadixTree()
+{
+    this->clear();
+}
+
+ZRadixTree::ZRadixTree(const ZRadixTree &other):
+    m_root(ZRadixTree::cloneRef(other.m_root)),
+    m_size(other.m_size)
+{
+
+}
+
+ZRadixTree::ZRadixTree(ZRadixTree &&other) noexcept:
+    m_root(other.m_root),
+    m_size(other.m_size)
+{
+    other.m_root = 0;
+    other.m_size = 0;
+}
+
+ZRadixTree &ZRadixTree::operator=(const ZRadixTree &other)
+{
+    if(this != &other)
+    {
+        ZRadixTree temp(other);
+        this->swap(temp);
+    }
+    return *this;
+}
+
+ZRadixTree &ZRadixTree::operator=(ZRadixTree &&other) noexcept
+{
+    if(this != &other)
+    {
+        ZRadixTree temp(std::move(other));
+        this->swap(temp);
+    }
+    return *this;
+}
+
+void ZRadixTree::swap(ZRadixTree &other) noexcept
+{
+    std::swap(this->m_root, other.m_root);
+    std::swap(this->m_size, other.m_size);
+}
+
+bool ZRadixTree::insert(const ZStringView &key, const ZVariant &value)
+{
+    bool inserted = false;
+    this->insertLeaf(key.data(), key.size(), inserted)->value = value;
+    return inserted;
+}
+
+bool ZRadixTree::insert(const ZStringView &key, ZVariant &&value)
+{
+    bool inserted = false;
+    this->insertLeaf(key.data(), key.size(), inserted)->value = std::move(value);
+    return inserted;
+}
+
+ZVariant &ZRadixTree::operator[](const ZStringView &key)
+{
+    bool inserted = false;
+    return this->insertLeaf(key.data(), key.size(), inserted)->value;
+}
+
+const ZVariant *ZRadixTree::find(const ZStringView &key) const
+{
+    const ZLeaf *leaf = this->findLeaf(key.data(), key.size());
+    return leaf ? &leaf->value : nullptr;
+}
+
+ZVariant *ZRadixTree::find(const ZStringView &key)
+{
+    ZLeaf *leaf = this->findLeaf(key.data(), key.size());
+    return leaf ? &leaf->value : nullptr;
+}
+
+bool ZRadixTree::contains(const ZStringView &key) const
+{
+    return this->findLeaf(key.data(), key.size()) != nullptr;
+}
+
+bool ZRadixTree::erase(const ZStringView &key)
+{
+    return this->eraseFrom(this->m_root, key.data(), key.size(), 0);
+}
+
+std::size_t ZRadixTree::erasePrefix(const ZStringView &prefix)
+{
+    return this->erasePrefixFrom(this->m_root, prefix.data(), prefix.size(), 0);
+}
+
+bool ZRadixTree::forEach(const ZVisitor &visitor) const
+{
+    return this->m_root == 0 || ZRadixTree::visit(this->m_root, visitor);
+}
+
+bool ZRadixTree::scanPrefix(const ZStringView &prefix, const ZVisitor &visitor) const
+{
+    const char *key = prefix.data();
+    const std::size_t keySize = prefix.size();
+
+    ZRef ref = this->m_root;
+    std::size_t depth = 0;
+    while(ref != 0)
+    {
+        if(isLeafRef(ref))
+        {
+            const ZLeaf *leaf = ZLeaf::fromRef(ref);
+            return !leaf->startsWith(key, keySize) || visitor(ZStringView(leaf->key(), leaf->keySize), leaf->value);
+        }
+
+        /* below this point every key shares the whole prefix */
+        if(depth == keySize) return ZRadixTree::visit(ref, visitor);
+
+        ZInner *node = ZInner::fromRef(ref);
+        if(node->prefixLength)
+        {
+            std::size_t matched = ZRadixTree::prefixMismatch(node, key, keySize, depth);
+            if(matched < std::min<std::size_t>(node->prefixLength, keySize - depth)) return true;
+            if(keySize - depth <= node->prefixLength) return ZRadixTree::visit(ref, visitor);
+            depth += node->prefixLength;
+        }
+
+        ZRef *child = ZRadixTree::findChild(node, static_cast<std::uint8_t>(key[depth]));
+        if(child == nullptr) return true;
+        ref = *child;
+        ++depth;
+    }
+    return true;
+}
+
+std::size_t ZRadixTree::size() const
+{
+    return this->m_size;
+}
+
+bool ZRadixTree::empty() const
+{
+    return this->m_size == 0;
+}
+
+void ZRadixTree::clear()
+{
+    ZRadixTree::destroyRef(this->m_root);
+    this->m_root = 0;
+    this->m_size = 0;
+}
+
+std::size_t ZRadixTree::memoryUsage() const
+{
+    return this->m_root ? ZRadixTree::memoryOf(this->m_root) : 0;
+}
+
+ZRadixTree::ZLeaf *ZRadixTree::createLeaf(const char *key, const std::size_t &keySize)
+{
+    void *memory = std::malloc(sizeof(ZLeaf) + keySize);
+    if(memory == nullptr) throw std::bad_alloc();
+
+    ZLeaf *leaf = new (memory) ZLeaf();
+    leaf->keySize = keySize;
+    if(keySize != 0) std::memcpy(leaf->key(), key, keySize);
+    return leaf;
+}
+
+void ZRadixTree::destroyLeaf(ZLeaf *leaf)
+{
+    leaf->~ZLeaf();
+    std::free(leaf);
+}
+
+std::size_t ZRadixTree::destroyRef(const ZRef &ref)
+{
+    if(ref == 0) return 0;
+    if(isLeafRef(ref))
+    {
+        ZRadixTree::destroyLeaf(ZLeaf::fromRef(ref));
+        return 1;
+    }
+
+    ZInner *node = ZInner::fromRef(ref);
+    std::size_t count = 0;
+    if(node->terminal)
+    {
+        ZRadixTree::destroyLeaf(node->terminal);
+        ++count;
+    }
+
+    switch(node->type)
+    {
+    case Node4Type:
+        for(std::size_t index = 0; index < node->count; ++index) count += ZRadixTree::destroyRef(static_cast<ZNode4*>(node)->children[index]);
+        break;
+    case Node16Type:
+        for(std::size_t index = 0; index < node->count; ++index) count += ZRadixTree::destroyRef(static_cast<ZNode16*>(node)->children[index]);
+        break;
+    case Node48Type:
+        for(std::size_t index = 0; index < 48; ++index) count += ZRadixTree::destroyRef(static_cast<ZNode48*>(node)->children[index]);
+        break;
+    default:
+        for(std::size_t index = 0; index < 256; ++index) count += ZRadixTree::destroyRef(static_cast<ZNode256*>(node)->children[index]);
+        break;
+    }
+
+    ZInner::destroy(node);
+    return count;
+}
+
+ZRadixTree::ZRef ZRadixTree::cloneRef(const ZRef &ref)
+{
+    if(ref == 0) return 0;
+    if(isLeafRef(ref))
+    {
+        const ZLeaf *leaf = ZLeaf::fromRef(ref);
+        ZLeaf *copy = ZRadixTree::createLeaf(leaf->key(), leaf->keySize);
+        try
+        {
+            copy->value = leaf->value;
+        }
+        catch(...)
+        {
+            ZRadixTree::destroyLeaf(copy);
+            throw;
+        }
+        return copy->toRef();
+    }
+
+    /* the copy is filled in place, a failure part way leaves a node destroyRef can take apart */
+    const ZInner *node = ZInner::fromRef(ref);
+    ZInner *copy = nullptr;
+    switch(node->type)
+    {
+    case Node4Type: copy = new ZNode4(); break;
+    case Node16Type: copy = new ZNode16(); break;
+    case Node48Type: copy = new ZNode48(); break;
+    default: copy = new ZNode256(); break;
+    }
+    copy->prefixLength = node->prefixLength;
+    std::memcpy(copy->prefix, node->prefix, MaxInlinePrefix);
+
+    try
+    {
+        if(node->terminal) copy->terminal = ZLeaf::fromRef(ZRadixTree::cloneRef(node->terminal->toRef()));
+
+        switch(node->type)
+        {
+        case Node4Type:
+        {
+            const ZNode4 *from = static_cast<const ZNode4*>(node);
+            ZNode4 *to = static_cast<ZNode4*>(copy);
+            for(; to->count < from->count; ++to->count)
+            {
+                to->keys[to->count] = from->keys[to->count];
+                to->children[to->count] = ZRadixTree::cloneRef(from->children[to->count]);
+            }
+            break;
+        }
+        case Node16Type:
+        {
+            const ZNode16 *from = static_cast<const ZNode16*>(node);
+            ZNode16 *to = static_cast<ZNode16*>(copy);
+            for(; to->count < from->count; ++to->count)
+            {
+                to->keys[to->count] = from->keys[to->count];
+                to->children[to->count] = ZRadixTree::cloneRef(from->children[to->count]);
+            }
+            break;
+        }
+        case Node48Type:
+        {
+            const ZNode48 *from = static_cast<const ZNode48*>(node);
+            ZNode48 *to = static_cast<ZNode48*>(copy);
+            std::memcpy(to->index, from->index, sizeof(to->index));
+            for(std::size_t index = 0; index < 48; ++index)
+            {
+                to->children[index] = ZRadixTree::cloneRef(from->children[index]);
+            }
+            to->count = from->count;
+            break;
+        }
+        default:
+        {
+            const ZNode256 *from = static_cast<const ZNode256*>(node);
+            ZNode256 *to = static_cast<ZNode256*>(copy);
+            for(std::size_t index = 0; index < 256; ++index)
+            {
+                to->children[index] = ZRadixTree::cloneRef(from->children[index]);
+            }
+            to->count = from->count;
+            break;
+        }
+        }
+    }
+    catch(...)
+    {
+        ZRadixTree::destroyRef(copy->toRef());
+        throw;
+    }
+    return copy->toRef();
+}
+
+ZRadixTree::ZRef *ZRadixTree::findChild(ZInner *node, const std::uint8_t &byte)
+{
+    switch(node->type)
+    {
+    case Node4Type:
+    {
+        ZNode4 *n = static_cast<ZNode4*>(node);
+        for(std::size_t index = 0; index < n->count; ++index)
+        {
+            if(n->keys[index] == byte) return &n->children[index];
+        }
+        return nullptr;
+    }
+    case Node16Type:
+    {
+        ZNode16 *n = static_cast<ZNode16*>(node);
+#ifdef ZYXCBA_RADIX_SSE2
+        /* compare all sixteen keys at once, the bits past count are masked off */
+        __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(n->keys));
+        __m128i equal = _mm_cmpeq_epi8(keys, _mm_set1_epi8(static_cast<char>(byte)));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(equal)) & ((1u << n->count) - 1);
+        return mask ? &n->children[__builtin_ctz(mask)] : nullptr;
+#else
+        for(std::size_t index = 0; index < n->count; ++index)
+        {
+            if(n->keys[index] == byte) return &n->children[index];
+        }
+        return nullptr;
+#endif
+    }
+    case Node48Type:
+    {
+        ZNode48 *n = static_cast<ZNode48*>(node);
+        return n->index[byte] ? &n->children[n->index[byte] - 1] : nullptr;
+    }
+    default:
+    {
+        ZNode256 *n = static_cast<ZNode256*>(node);
+        return n->children[byte] ? &n->children[byte] : nullptr;
+    }
+    }
+}
+
+void ZRadixTree::addChild(ZRef &ref, ZInner *node, const std::uint8_t &byte, const ZRef &child)
+{
+    switch(node->type)
+    {
+    case Node4Type:
+    {
+        ZNode4 *n = static_cast<ZNode4*>(node);
+        if(n->count < 4)
+        {
+            /* the small nodes keep their keys sorted for ordered iteration */
+            std::size_t position = 0;
+            while(position < n->count && n->keys[position] < byte) ++position;
+            std::memmove(n->keys + position + 1, n->keys + position, n->count - position);
+            std::memmove(n->children + position + 1, n->children + position, (n->count - position) * sizeof(ZRef));
+            n->keys[position] = byte;
+            n->children[position] = child;
+            ++n->count;
+            return;
+        }
+
+        ZNode16 *grown = new ZNode16();
+        grown->copyHeader(*n);
+        std::memcpy(grown->keys, n->keys, n->count);
+        std::memcpy(grown->children, n->children, n->count * sizeof(ZRef));
+        ref = grown->toRef();
+        delete n;
+        ZRadixTree::addChild(ref, grown, byte, child);
+        return;
+    }
+    case Node16Type:
+    {
+        ZNode16 *n = static_cast<ZNode16*>(node);
+        if(n->count < 16)
+        {
+            std::size_t position = 0;
+            while(position < n->count && n->keys[position] < byte) ++position;
+            std::memmove(n->keys + position + 1, n->keys + position, n->count - position);
+            std::memmove(n->children + position + 1, n->children + position, (n->count - position) * sizeof(ZRef));
+            n->keys[position] = byte;
+            n->children[position] = child;
+            ++n->count;
+            return;
+        }
+
+        ZNode48 *grown = new ZNode48();
+        grown->copyHeader(*n);
+        for(std::size_t index = 0; index < n->count; ++index)
+        {
+            grown->index[n->keys[index]] = static_cast<std::uint8_t>(index + 1);
+            grown->children[index] = n->children[index];
+        }
+        ref = grown->toRef();
+        delete n;
+        ZRadixTree::addChild(ref, grown, byte, child);
+        return;
+    }
+    case Node48Type:
+    {
+        ZNode48 *n = static_cast<ZNode48*>(node);
+        if(n->count < 48)
+        {
+            std::size_t position = 0;
+            while(n->children[position] != 0) ++position;
+            n->children[position] = child;
+            n->index[byte] = static_cast<std::uint8_t>(position + 1);
+            ++n->count;
+            return;
+        }
+
+        ZNode256 *grown = new ZNode256();
+        grown->copyHeader(*n);
+        for(std::size_t index = 0; index < 256; ++index)
+        {
+            if(n->index[index]) grown->children[index] = n->children[n->index[index] - 1];
+        }
+        ref = grown->toRef();
+        delete n;
+        ZRadixTree::addChild(ref, grown, byte, child);
+        return;
+    }
+    default:
+    {
+        ZNode256 *n = static_cast<ZNode256*>(node);
+        n->children[byte] = child;
+        ++n->count;
+        return;
+    }
+    }
+}
+
+void ZRadixTree::removeChild(ZInner *node, const std::uint8_t &byte)
+{
+    switch(node->type)
+    {
+    case Node4Type:
+    {
+        ZNode4 *n = static_cast<ZNode4*>(node);
+        std::size_t position = 0;
+        while(n->keys[position] != byte) ++position;
+        std::memmove(n->keys + position, n->keys + position + 1, n->count - position - 1);
+        std::memmove(n->children + position, n->children + position + 1, (n->count - position - 1) * sizeof(ZRef));
+        --n->count;
+        n->children[n->count] = 0;
+        return;
+    }
+    case Node16Type:
+    {
+        ZNode16 *n = static_cast<ZNode16*>(node);
+        std::size_t position = 0;
+        while(n->keys[position] != byte) ++position;
+        std::memmove(n->keys + position, n->keys + position + 1, n->count - position - 1);
+        std::memmove(n->children + position, n->children + position + 1, (n->count - position - 1) * sizeof(ZRef));
+        --n->count;
+        n->children[n->count] = 0;
+        return;
+    }
+    case Node48Type:
+    {
+        ZNode48 *n = static_cast<ZNode48*>(node);
+        n->children[n->index[byte] - 1] = 0;
+        n->index[byte] = 0;
+        --n->count;
+        return;
+    }
+    default:
+    {
+        ZNode256 *n = static_cast<ZNode256*>(node);
+        n->children[byte] = 0;
+        --n->count;
+        return;
+    }
+    }
+}
+
+void ZRadixTree::normalize(ZRef &ref)
+{
+    ZInner *node = ZInner::fromRef(ref);
+
+    /* a node without children is replaced by its terminal leaf */
+    if(node->count == 0)
+    {
+        ref = node->terminal ? node->terminal->toRef() : 0;
+        ZInner::destroy(node);
+        return;
+    }
+
+    /* a single child is pulled up, its prefix absorbs ours and the branch byte */
+    if(node->count == 1 && node->terminal == nullptr && node->type == Node4Type)
+    {
+        ZNode4 *n = static_cast<ZNode4*>(node);
+        ZRef child = n->children[0];
+        if(!isLeafRef(child))
+        {
+            ZInner *inner = ZInner::fromRef(child);
+            std::size_t length = n->prefixLength;
+            if(length < MaxInlinePrefix) n->prefix[length++] = n->keys[0];
+            if(length < MaxInlinePrefix)
+            {
+                std::size_t taken = std::min<std::size_t>(inner->prefixLength, MaxInlinePrefix - length);
+                std::memcpy(n->prefix + length, inner->prefix, taken);
+                length += taken;
+            }
+            std::memcpy(inner->prefix, n->prefix, std::min(length, MaxInlinePrefix));
+            inner->prefixLength += n->prefixLength + 1;
+        }
+        ref = child;
+        delete n;
+        return;
+    }
+
+    switch(node->type)
+    {
+    case Node16Type:
+    {
+        ZNode16 *n = static_cast<ZNode16*>(node);
+        if(n->count > Node16ShrinkCount) return;
+
+        ZNode4 *shrunk = new ZNode4();
+        shrunk->copyHeader(*n);
+        std::memcpy(shrunk->keys, n->keys, n->count);
+        std::memcpy(shrunk->children, n->children, n->count * sizeof(ZRef));
+        ref = shrunk->toRef();
+        delete n;
+        return;
+    }
+    case Node48Type:
+    {
+        ZNode48 *n = static_cast<ZNode48*>(node);
+        if(n->count > Node48ShrinkCount) return;
+
+        ZNode16 *shrunk = new ZNode16();
+        shrunk->copyHeader(*n);
+        std::size_t position = 0;
+        for(std::size_t index = 0; index < 256; ++index)
+        {
+            if(n->index[index] == 0) continue;
+            shrunk->keys[position] = static_cast<std::uint8_t>(index);
+            shrunk->children[position] = n->children[n->index[index] - 1];
+            ++position;
+        }
+        ref = shrunk->toRef();
+        delete n;
+        return;
+    }
+    case Node256Type:
+    {
+        ZNode256 *n = static_cast<ZNode256*>(node);
+        if(n->count > Node256ShrinkCount) return;
+
+        ZNode48 *shrunk = new ZNode48();
+        shrunk->copyHeader(*n);
+        std::size_t position = 0;
+        for(std::size_t index = 0; index < 256; ++index)
+        {
+            if(n->children[index] == 0) continue;
+            shrunk->index[index] = static_cast<std::uint8_t>(position + 1);
+            shrunk->children[position] = n->children[index];
+            ++position;
+        }
+        ref = shrunk->toRef();
+        delete n;
+        return;
+    }
+    default:
+        return;
+    }
+}
+
+const ZRadixTree::ZLeaf *ZRadixTree::minimumLeaf(const ZRef &ref)
+{
+    ZRef current = ref;
+    while(!isLeafRef(current))
+    {
+        const ZInner *node = ZInner::fromRef(current);
+        if(node->terminal) return node->terminal;
+
+        switch(node->type)
+        {
+        case Node4Type:
+            current = static_cast<const ZNode4*>(node)->children[0];
+            break;
+        case Node16Type:
+            current = static_cast<const ZNode16*>(node)->children[0];
+            break;
+        case Node48Type:
+        {
+            const ZNode48 *n = static_cast<const ZNode48*>(node);
+            std::size_t index = 0;
+            while(n->index[index] == 0) ++index;
+            current = n->children[n->index[index] - 1];
+            break;
+        }
+        default:
+        {
+            const ZNode256 *n = static_cast<const ZNode256*>(node);
+            std::size_t index = 0;
+            while(n->children[index] == 0) ++index;
+            current = n->children[index];
+            break;
+        }
+        }
+    }
+    return ZLeaf::fromRef(current);
+}
+
+std::size_t ZRadixTree::prefixMismatch(const ZInner *node, const char *key, const std::size_t &keySize, const std::size_t &depth)
+{
+    const std::uint8_t *bytes = reinterpret_cast<const std::uint8_t*>(key);
+    std::size_t limit = std::min(std::min<std::size_t>(node->prefixLength, MaxInlinePrefix), keySize - depth);
+    std::size_t index = 0;
+    for(; index < limit; ++index)
+    {
+        if(node->prefix[index] != bytes[depth + index]) return index;
+    }
+
+    /* the bytes past the inline part are read from any leaf below, they all share them */
+    if(node->prefixLength > MaxInlinePrefix)
+    {
+        const ZLeaf *leaf = ZRadixTree::minimumLeaf(node->toRef());
+        limit = std::min<std::size_t>(node->prefixLength, std::min(leaf->keySize, keySize) - depth);
+        for(; index < limit; ++index)
+        {
+            if(leaf->key()[depth + index] != key[depth + index]) return index;
+        }
+    }
+    return index;
+}
+
+std::size_t ZRadixTree::checkInlinePrefix(const ZInner *node, const char *key, const std::size_t &keySize, const std::size_t &depth)
+{
+    const std::uint8_t *bytes = reinterpret_cast<const std::uint8_t*>(key);
+    std::size_t limit = std::min(std::min<std::size_t>(node->prefixLength, MaxInlinePrefix), keySize - depth);
+    std::size_t index = 0;
+    while(index < limit && node->prefix[index] == bytes[depth + index]) ++index;
+    return index;
+}
+
+ZRadixTree::ZLeaf *ZRadixTree::insertLeaf(const char *key, const std::size_t &keySize, bool &inserted)
+{
+    ZRef *ref = &this->m_root;
+    std::size_t depth = 0;
+    for(;;)
+    {
+        if(*ref == 0)
+        {
+            ZLeaf *leaf = ZRadixTree::createLeaf(key, keySize);
+            *ref = leaf->toRef();
+            ++this->m_size;
+            inserted = true;
+            return leaf;
+        }
+
+        if(isLeafRef(*ref))
+        {
+            ZLeaf *existing = ZLeaf::fromRef(*ref);
+            if(existing->matches(key, keySize))
+            {
+                inserted = false;
+                return existing;
+            }
+
+            /* two keys meet, a node takes their common bytes as prefix and branches after it */
+            std::size_t limit = std::min(existing->keySize, keySize);
+            std::size_t end = depth;
+            while(end < limit && existing->key()[end] == key[end]) ++end;
+
+            ZNode4 *node = new ZNode4();
+            ZLeaf *leaf = nullptr;
+            try
+            {
+                leaf = ZRadixTree::createLeaf(key, keySize);
+            }
+            catch(...)
+            {
+                delete node;
+                throw;
+            }
+            node->prefixLength = static_cast<std::uint32_t>(end - depth);
+            std::memcpy(node->prefix, key + depth, std::min<std::size_t>(end - depth, MaxInlinePrefix));
+
+            ZRef nodeRef = node->toRef();
+            if(existing->keySize == end) node->terminal = existing;
+            else ZRadixTree::addChild(nodeRef, node, static_cast<std::uint8_t>(existing->key()[end]), existing->toRef());
+            if(keySize == end) node->terminal = leaf;
+            else ZRadixTree::addChild(nodeRef, node, static_cast<std::uint8_t>(key[end]), leaf->toRef());
+
+            *ref = nodeRef;
+            ++this->m_size;
+            inserted = true;
+            return leaf;
+        }
+
+        ZInner *node = ZInner::fromRef(*ref);
+        if(node->prefixLength)
+        {
+            std::size_t matched = ZRadixTree::prefixMismatch(node, key, keySize, depth);
+            if(matched < node->prefixLength)
+            {
+                /* the key leaves the prefix part way, split the prefix at that byte */
+                ZNode4 *parent = new ZNode4();
+                ZLeaf *leaf = nullptr;
+                try
+                {
+                    leaf = ZRadixTree::createLeaf(key, keySize);
+                }
+                catch(...)
+                {
+                    delete parent;
+                    throw;
+                }
+                parent->prefixLength = static_cast<std::uint32_t>(matched);
+                std::memcpy(parent->prefix, key + depth, std::min<std::size_t>(matched, MaxInlinePrefix));
+
+                std::uint8_t branch = 0;
+                if(node->prefixLength <= MaxInlinePrefix)
+                {
+                    branch = node->prefix[matched];
+                    node->prefixLength -= static_cast<std::uint32_t>(matched + 1);
+                    std::memmove(node->prefix, node->prefix + matched + 1, std::min<std::size_t>(node->prefixLength, MaxInlinePrefix));
+                }
+                else
+                {
+                    const ZLeaf *minimum = ZRadixTree::minimumLeaf(*ref);
+                    branch = static_cast<std::uint8_t>(minimum->key()[depth + matched]);
+                    node->prefixLength -= static_cast<std::uint32_t>(matched + 1);
+                    std::memcpy(node->prefix, minimum->key() + depth + matched + 1, std::min<std::size_t>(node->prefixLength, MaxInlinePrefix));
+                }
+
+                ZRef parentRef = parent->toRef();
+                ZRadixTree::addChild(parentRef, parent, branch, *ref);
+                if(keySize == depth + matched) parent->terminal = leaf;
+                else ZRadixTree::addChild(parentRef, parent, static_cast<std::uint8_t>(key[depth + matched]), leaf->toRef());
+
+                *ref = parentRef;
+                ++this->m_size;
+                inserted = true;
+                return leaf;
+            }
+            depth += node->prefixLength;
+        }
+
+        if(depth == keySize)
+        {
+            if(node->terminal == nullptr)
+            {
+                node->terminal = ZRadixTree::createLeaf(key, keySize);
+                ++this->m_size;
+                inserted = true;
+            }
+            else
+            {
+                inserted = false;
+            }
+            return node->terminal;
+        }
+
+        const std::uint8_t byte = static_cast<std::uint8_t>(key[depth]);
+        ZRef *child = ZRadixTree::findChild(node, byte);
+        if(child)
+        {
+            ref = child;
+            ++depth;
+            continue;
+        }
+
+        ZLeaf *leaf = ZRadixTree::createLeaf(key, keySize);
+        try
+        {
+            ZRadixTree::addChild(*ref, node, byte, leaf->toRef());
+        }
+        catch(...)
+        {
+            ZRadixTree::destroyLeaf(leaf);
+            throw;
+        }
+        ++this->m_size;
+        inserted = true;
+        return leaf;
+    }
+}
+
+ZRadixTree::ZLeaf *ZRadixTree::findLeaf(const char *key, const std::size_t &keySize) const
+{
+    ZRef ref = this->m_root;
+    std::size_t depth = 0;
+    while(ref != 0)
+    {
+        if(isLeafRef(ref))
+        {
+            ZLeaf *leaf = ZLeaf::fromRef(ref);
+            return leaf->matches(key, keySize) ? leaf : nullptr;
+        }
+
+        /* only the inline prefix bytes are checked on the way, the leaf compares the whole key */
+        ZInner *node = ZInner::fromRef(ref);
+        if(node->prefixLength)
+        {
+            if(ZRadixTree::checkInlinePrefix(node, key, keySize, depth) != std::min<std::size_t>(node->prefixLength, MaxInlinePrefix)) return nullptr;
+            depth += node->prefixLength;
+            if(depth > keySize) return nullptr;
+        }
+
+        if(depth == keySize)
+        {
+            return node->terminal && node->terminal->matches(key, keySize) ? node->terminal : nullptr;
+        }
+
+        ZRef *child = ZRadixTree::findChild(node, static_cast<std::uint8_t>(key[depth]));
+        if(child == nullptr) return nullptr;
+        ref = *child;
+        ++depth;
+    }
+    return nullptr;
+}
+
+bool ZRadixTree::eraseFrom(ZRef &ref, const char *key, const std::size_t &keySize, std::size_t depth)
+{
+    if(ref == 0) return false;
+    if(isLeafRef(ref))
+    {
+        ZLeaf *leaf = ZLeaf::fromRef(ref);
+        if(!leaf->matches(key, keySize)) return false;
+
+        ZRadixTree::destroyLeaf(leaf);
+        ref = 0;
+        --this->m_size;
+        return true;
+    }
+
+    ZInner *node = ZInner::fromRef(ref);
+    if(node->prefixLength)
+    {
+        if(ZRadixTree::checkInlinePrefix(node, key, keySize, depth) != std::min<std::size_t>(node->prefixLength, MaxInlinePrefix)) return false;
+        depth += node->prefixLength;
+        if(depth > keySize) return false;
+    }
+
+    if(depth == keySize)
+    {
+        if(node->terminal == nullptr || !node->terminal->matches(key, keySize)) return false;
+
+        ZRadixTree::destroyLeaf(node->terminal);
+        node->terminal = nullptr;
+        --this->m_size;
+        ZRadixTree::normalize(ref);
+        return true;
+    }
+
+    const std::uint8_t byte = static_cast<std::uint8_t>(key[depth]);
+    ZRef *child = ZRadixTree::findChild(node, byte);
+    if(child == nullptr || !this->eraseFrom(*child, key, keySize, depth + 1)) return false;
+
+    if(*child == 0)
+    {
+        ZRadixTree::removeChild(node, byte);
+        ZRadixTree::normalize(ref);
+    }
+    return true;
+}
+
+std::size_t ZRadixTree::erasePrefixFrom(ZRef &ref, const char *key, const std::size_t &keySize, std::size_t depth)
+{
+    if(ref == 0) return 0;
+    if(isLeafRef(ref))
+    {
+        ZLeaf *leaf = ZLeaf::fromRef(ref);
+        if(!leaf->startsWith(key, keySize)) return 0;
+
+        ZRadixTree::destroyLeaf(leaf);
+        ref = 0;
+        --this->m_size;
+        return 1;
+    }
+
+    /* the whole prefix is compared, a subtree is only dropped when every key in it matches */
+    ZInner *node = ZInner::fromRef(ref);
+    bool whole = depth == keySize;
+    if(!whole && node->prefixLength)
+    {
+        std::size_t matched = ZRadixTree::prefixMismatch(node, key, keySize, depth);
+        if(matched < std::min<std::size_t>(node->prefixLength, keySize - depth)) return 0;
+        whole = keySize - depth <= node->prefixLength;
+        depth += node->prefixLength;
+    }
+
+    if(whole)
+    {
+        std::size_t removed = ZRadixTree::destroyRef(ref);
+        ref = 0;
+        this->m_size -= removed;
+        return removed;
+    }
+
+    const std::uint8_t byte = static_cast<std::uint8_t>(key[depth]);
+    ZRef *child = ZRadixTree::findChild(node, byte);
+    if(child == nullptr) return 0;
+
+    std::size_t removed = this->erasePrefixFrom(*child, key, keySize, depth + 1);
+    if(removed && *child == 0)
+    {
+        ZRadixTree::removeChild(node, byte);
+        ZRadixTree::normalize(ref);
+    }
+    return removed;
+}
+
+bool ZRadixTree::visit(const ZRef &ref, const ZVisitor &visitor)
+{
+    if(isLeafRef(ref))
+    {
+        const ZLeaf *leaf = ZLeaf::fromRef(ref);
+        return visitor(ZStringView(leaf->key(), leaf->keySize), leaf->value);
+    }
+
+    /* the terminal key is a prefix of everything below, it comes first */
+    const ZInner *node = ZInner::fromRef(ref);
+    if(node->terminal && !visitor(ZStringView(node->terminal->key(), node->terminal->keySize), node->terminal->value)) return false;
+
+    switch(node->type)
+    {
+    case Node4Type:
+    {
+        const ZNode4 *n = static_cast<const ZNode4*>(node);
+        for(std::size_t index = 0; index < n->count; ++index)
+        {
+            if(!ZRadixTree::visit(n->children[index], visitor)) return false;
+        }
+        return true;
+    }
+    case Node16Type:
+    {
+        const ZNode16 *n = static_cast<const ZNode16*>(node);
+        for(std::size_t index = 0; index < n->count; ++index)
+        {
+            if(!ZRadixTree::visit(n->children[index], visitor)) return false;
+        }
+        return true;
+    }
+    case Node48Type:
+    {
+        const ZNode48 *n = static_cast<const ZNode48*>(node);
+        for(std::size_t index = 0; index < 256; ++index)
+        {
+            if(n->index[index] && !ZRadixTree::visit(n->children[n->index[index] - 1], visitor)) return false;
+        }
+        return true;
+    }
+    default:
+    {
+        const ZNode256 *n = static_cast<const ZNode256*>(node);
+        for(std::size_t index = 0; index < 256; ++index)
+        {
+            if(n->children[index] && !ZRadixTree::visit(n->children[index], visitor)) return false;
+        }
+        return true;
+    }
+    }
+}
+
+std::size_t ZRadixTree::memoryOf(const ZRef &ref)
+{
+    if(isLeafRef(ref)) return sizeof(ZLeaf) + ZLeaf::fromRef(ref)->keySize;
+
+    const ZInner *node = ZInner::fromRef(ref);
+    std::size_t bytes = node->terminal ? sizeof(ZLeaf) + node->terminal->keySize : 0;
+    switch(node->type)
+    {
+    case Node4Type:
+    {
+        const ZNode4 *n = static_cast<const ZNode4*>(node);
+        bytes += sizeof(ZNode4);
+        for(std::size_t index = 0; index < n->count; ++index) bytes += ZRadixTree::memoryOf(n->children[index]);
+        break;
+    }
+    case Node16Type:
+    {
+        const ZNode16 *n = static_cast<const ZNode16*>(node);
+        bytes += sizeof(ZNode16);
+        for(std::size_t index = 0; index < n->count; ++index) bytes += ZRadixTree::memoryOf(n->children[index]);
+        break;
+    }
+    case Node48Type:
+    {
+        const ZNode48 *n = static_cast<const ZNode48*>(node);
+        bytes += sizeof(ZNode48);
+        for(std::size_t index = 0; index < 48; ++index)
+        {
+            if(n->children[index]) bytes += ZRadixTree::memoryOf(n->children[index]);
+        }
+        break;
+    }
+    default:
+    {
+        const ZNode256 *n = static_cast<const ZNode256*>(node);
+        bytes += sizeof(ZNode256);
+        for(std::size_t index = 0; index < 256; ++index)
+        {
+            if(n->children[index]) bytes += ZRadixTree::memoryOf(n->children[index]);
+        }
+        break;
+    }
+    }
+    return bytes;
+}
+
+}
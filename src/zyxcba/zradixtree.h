@@ -0,0 +1,145 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef ZRADIXTREE_H
+#define ZRADIXTREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "zstringview.h"
+#include "zvariant.h"
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZRadixTree class
+///
+/// ZRadixTree is an adaptive radix tree mapping byte string keys to ZVariant values. Inner nodes
+/// branch on one key byte and come in four sizes, 4, 16, 48 and 256 children, growing and
+/// shrinking with their fan-out. Node16 is searched with SSE2 where available. Runs of bytes
+/// shared by a whole subtree are collapsed into the node prefix, of which the first bytes are
+/// kept inline and the rest is checked against a leaf. A key that is a prefix of other keys is
+/// stored as the terminal leaf of the node where it ends, so no key terminator is reserved.
+///
+/// Iteration is in lexicographic byte order. A prefix scan descends once and then only visits
+/// the matching subtree. Value pointers stay valid until their key or the tree is removed.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZRadixTree
+{
+public:
+    /* receives every key and value in order, returns false to stop the walk */
+    typedef std::function<bool(const ZStringView &key, const ZVariant &value)> ZVisitor;
+
+    static const std::size_t MaxInlinePrefix = 8;
+
+    ZRadixTree();
+    ~ZRadixTree();
+
+    ZRadixTree(const ZRadixTree &other);
+    ZRadixTree(ZRadixTree &&other) noexcept;
+    ZRadixTree &operator=(const ZRadixTree &other);
+    ZRadixTree &operator=(ZRadixTree &&other) noexcept;
+
+    void swap(ZRadixTree &other) noexcept;
+
+    /* returns false when the key existed and only its value was replaced */
+    bool insert(const ZStringView &key, const ZVariant &value);
+    bool insert(const ZStringView &key, ZVariant &&value);
+
+    /* returns the value stored for key, creating a None value when the key is new */
+    ZVariant &operator[](const ZStringView &key);
+
+    const ZVariant *find(const ZStringView &key) const;
+    ZVariant *find(const ZStringView &key);
+    bool contains(const ZStringView &key) const;
+
+    bool erase(const ZStringView &key);
+
+    /* removes every key starting with prefix and returns how many were removed */
+    std::size_t erasePrefix(const ZStringView &prefix);
+
+    /* visits every key in order, returns false when the visitor stopped the walk */
+    bool forEach(const ZVisitor &visitor) const;
+
+    /* visits the keys starting with prefix in order */
+    bool scanPrefix(const ZStringView &prefix, const ZVisitor &visitor) const;
+
+    std::size_t size() const;
+    bool empty() const;
+    void clear();
+
+    /* bytes held by the nodes and leaves, without what the values own */
+    std::size_t memoryUsage() const;
+
+private:
+    struct ZLeaf;
+    struct ZInner;
+    struct ZNode4;
+    struct ZNode16;
+    struct ZNode48;
+    struct ZNode256;
+
+    /* a child reference, leaves are tagged in the lowest bit */
+    typedef std::uintptr_t ZRef;
+
+    static ZLeaf *createLeaf(const char *key, const std::size_t &keySize);
+    static void destroyLeaf(ZLeaf *leaf);
+    static std::size_t destroyRef(const ZRef &ref);
+    static ZRef cloneRef(const ZRef &ref);
+
+    static ZRef *findChild(ZInner *node, const std::uint8_t &byte);
+    static void addChild(ZRef &ref, ZInner *node, const std::uint8_t &byte, const ZRef &child);
+    static void removeChild(ZInner *node, const std::uint8_t &byte);
+    static void normalize(ZRef &ref);
+
+    static const ZLeaf *minimumLeaf(const ZRef &ref);
+    static std::size_t prefixMismatch(const ZInner *node, const char *key, const std::size_t &keySize, const std::size_t &depth);
+    static std::size_t checkInlinePrefix(const ZInner *node, const char *key, const std::size_t &keySize, const std::size_t &depth);
+
+    ZLeaf *insertLeaf(const char *key, const std::size_t &keySize, bool &inserted);
+    ZLeaf *findLeaf(const char *key, const std::size_t &keySize) const;
+    bool eraseFrom(ZRef &ref, const char *key, const std::size_t &keySize, std::size_t depth);
+    std::size_t erasePrefixFrom(ZRef &ref, const char *key, const std::size_t &keySize, std::size_t depth);
+
+    static bool visit(const ZRef &ref, const ZVisitor &visitor);
+    static std::size_t memoryOf(const ZRef &ref);
+
+    ZRef m_root;
+    std::size_t m_size;
+};
+
+}
+
+#endif // ZRADIXTREE_H
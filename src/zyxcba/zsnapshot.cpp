@@ -0,0 +1,761 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "zsnapshot.h"
+#include "zvariantserializer.h"
+#include "zendianutility.h"
+
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace zyxcba {
+
+const std::uint32_t ZSnapshot::Version;
+const std::uint64_t ZSnapshot::PageSize;
+
+namespace {
+
+const char SnapshotMagic[8] = {'Z', 'Y', 'X', 'S', 'N', 'A', 'P', '\0'};
+const std::uint8_t LittleEndianOrder = 1;
+const std::uint8_t BigEndianOrder = 2;
+
+/* container nodes start with the type tag padded to 8 bytes, then the entry count */
+const std::uint64_t ContainerHeaderSize = 16;
+
+std::uint8_t hostByteOrder()
+{
+    return ZEndianUtility().isLittleEndian() ? LittleEndianOrder : BigEndianOrder;
+}
+
+bool isContainerType(const ZVariantType &variantType)
+{
+    return variantType >= ZVariantType::List && variantType <= ZVariantType::IntegerHashMap;
+}
+
+std::uint64_t entryWords(const ZVariantType &variantType)
+{
+    return variantType == ZVariantType::List ? 1 : 2;
+}
+
+class ZSnapshotWriter
+{
+public:
+    static const std::size_t BufferSize = 1 << 20;
+
+    explicit ZSnapshotWriter(std::FILE *file):
+        m_file(file),
+        m_position(0),
+        m_failed(false)
+    {
+        this->m_buffer.reserve(BufferSize);
+    }
+
+    void append(const char *data, const std::size_t &size)
+    {
+        if(this->m_buffer.size() + size > BufferSize) this->flush();
+
+        if(size >= BufferSize)
+        {
+            if(std::fwrite(data, 1, size, this->m_file) != size) this->m_failed = true;
+        }
+        else
+        {
+            this->m_buffer.insert(this->m_buffer.end(), data, data + size);
+        }
+        this->m_position += size;
+    }
+
+    void pad(const std::uint64_t &alignment)
+    {
+        static const char zeros[ZSnapshot::PageSize] = {};
+        std::uint64_t size = (alignment - this->m_position % alignment) % alignment;
+        this->append(zeros, static_cast<std::size_t>(size));
+    }
+
+    bool flush()
+    {
+        if(!this->m_buffer.empty())
+        {
+            if(std::fwrite(this->m_buffer.data(), 1, this->m_buffer.size(), this->m_file) != this->m_buffer.size())
+            {
+                this->m_failed = true;
+            }
+            this->m_buffer.clear();
+        }
+        return !this->m_failed;
+    }
+
+    std::uint64_t position() const { return this->m_position; }
+
+private:
+    std::FILE *m_file;
+    std::vector<char> m_buffer;
+    std::uint64_t m_position;
+    bool m_failed;
+};
+
+std::uint64_t writeContainer(ZSnapshotWriter &writer, const ZVariantType &variantType,
+                             const std::uint64_t &count, const std::vector<std::uint64_t> &entries)
+{
+    writer.pad(8);
+    std::uint64_t offset = writer.position() - ZSnapshot::PageSize;
+
+    char header[8] = {static_cast<char>(variantType)};
+    writer.append(header, sizeof(header));
+    writer.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    if(!entries.empty()) writer.append(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(std::uint64_t));
+    return offset;
+}
+
+std::uint64_t writeNode(ZSnapshotWriter &writer, const ZVariant &variant)
+{
+    std::vector<std::uint64_t> entries;
+
+    switch (variant.variantType())
+    {
+    case ZVariantType::List:
+    {
+        const ZVariantList &list = variant.getList();
+        entries.reserve(list.size());
+        for(const ZVariant &value : list) entries.push_back(writeNode(writer, value));
+        return writeContainer(writer, ZVariantType::List, list.size(), entries);
+    }
+    case ZVariantType::Map:
+    {
+        const ZVariantMap &map = variant.getMap();
+        entries.reserve(map.size() * 2);
+        for(const auto &entry : map)
+        {
+            entries.push_back(writeNode(writer, entry.first));
+            entries.push_back(writeNode(writer, entry.second));
+        }
+        return writeContainer(writer, ZVariantType::Map, map.size(), entries);
+    }
+    case ZVariantType::IntegerVariantMap:
+    {
+        const ZIntegerVariantMap &map = variant.getIntegerVariantMap();
+        entries.reserve(map.size() * 2);
+        for(const auto &entry : map)
+        {
+            entries.push_back(entry.first);
+            entries.push_back(writeNode(writer, entry.second));
+        }
+        return writeContainer(writer, ZVariantType::IntegerVariantMap, map.size(), entries);
+    }
+    case ZVariantType::HashMap:
+    {
+        /* hash map entries are stored sorted as well, so every map is searched the same way */
+        const ZVariantHashMap &map = variant.getHashMap();
+        std::vector<std::pair<const ZVariant*, const ZVariant*> > sorted;
+        sorted.reserve(map.size());
+        for(auto it = map.cbegin(); it != map.cend(); ++it) sorted.push_back(std::make_pair(&it.key(), &it.value()));
+        std::sort(sorted.begin(), sorted.end(), [](const std::pair<const ZVariant*, const ZVariant*> &a,
+                                                   const std::pair<const ZVariant*, const ZVariant*> &b) {
+            return a.first->compare(*b.first) < 0;
+        });
+
+        entries.reserve(map.size() * 2);
+        for(const auto &entry : sorted)
+        {
+            entries.push_back(writeNode(writer, *entry.first));
+            entries.push_back(writeNode(writer, *entry.second));
+        }
+        return writeContainer(writer, ZVariantType::HashMap, map.size(), entries);
+    }
+    case ZVariantType::IntegerHashMap:
+    {
+        const ZIntegerVariantHashMap &map = variant.getIntegerHashMap();
+        std::vector<std::pair<std::uint64_t, const ZVariant*> > sorted;
+        sorted.reserve(map.size());
+        for(auto it = map.cbegin(); it != map.cend(); ++it) sorted.push_back(std::make_pair(it.key(), &it.value()));
+        std::sort(sorted.begin(), sorted.end(), [](const std::pair<std::uint64_t, const ZVariant*> &a,
+                                                   const std::pair<std::uint64_t, const ZVariant*> &b) {
+            return a.first < b.first;
+        });
+
+        entries.reserve(map.size() * 2);
+        for(const auto &entry : sorted)
+        {
+            entries.push_back(entry.first);
+            entries.push_back(writeNode(writer, *entry.second));
+        }
+        return writeContainer(writer, ZVariantType::IntegerHashMap, map.size(), entries);
+    }
+    default:
+    {
+        std::uint64_t offset = writer.position() - ZSnapshot::PageSize;
+        ZVariantSerializer::serialize(variant, writer);
+        return offset;
+    }
+    }
+}
+
+}
+
+ZSnapshotView::ZSnapshotView():
+    m_data(nullptr),
+    m_size(0),
+    m_offset(0)
+{
+
+}
+
+ZSnapshotView::ZSnapshotView(const char *data, const std::uint64_t &size, const std::uint64_t &offset):
+    m_data(data),
+    m_size(size),
+    m_offset(offset)
+{
+
+}
+
+ZVariantType ZSnapshotView::variantType() const
+{
+    if(this->m_data == nullptr || this->m_offset >= this->m_size) return ZVariantType::None;
+
+    std::uint8_t tag = static_cast<std::uint8_t>(this->m_data[this->m_offset]);
+    if(tag > static_cast<std::uint8_t>(ZVariantType::Float64Array)) return ZVariantType::None;
+    return static_cast<ZVariantType>(tag);
+}
+
+std::string ZSnapshotView::variantTypeString() const
+{
+    return ZVariant::variantTypeName(this->variantType());
+}
+
+bool ZSnapshotView::isValid() const
+{
+    return !this->isNone();
+}
+
+bool ZSnapshotView::isNone() const
+{
+    return this->variantType() == ZVariantType::None;
+}
+
+bool ZSnapshotView::isBool() const
+{
+    return this->variantType() == ZVariantType::Bool;
+}
+
+bool ZSnapshotView::isNumber() const
+{
+    return this->leaf().isNumber();
+}
+
+bool ZSnapshotView::isString() const
+{
+    return this->variantType() == ZVariantType::String;
+}
+
+bool ZSnapshotView::isList() const
+{
+    return this->variantType() == ZVariantType::List;
+}
+
+bool ZSnapshotView::isMap() const
+{
+    return this->variantType() == ZVariantType::Map;
+}
+
+bool ZSnapshotView::isIntegerVariantMap() const
+{
+    return this->variantType() == ZVariantType::IntegerVariantMap;
+}
+
+bool ZSnapshotView::isHashMap() const
+{
+    return this->variantType() == ZVariantType::HashMap;
+}
+
+bool ZSnapshotView::isIntegerHashMap() const
+{
+    return this->variantType() == ZVariantType::IntegerHashMap;
+}
+
+bool ZSnapshotView::isArray() const
+{
+    return this->leaf().isArray();
+}
+
+bool ZSnapshotView::getBool() const
+{
+    return this->leaf().getBool();
+}
+
+std::int8_t ZSnapshotView::getInt8() const
+{
+    return this->leaf().getInt8();
+}
+
+std::int16_t ZSnapshotView::getInt16() const
+{
+    return this->leaf().getInt16();
+}
+
+std::int32_t ZSnapshotView::getInt32() const
+{
+    return this->leaf().getInt32();
+}
+
+std::int64_t ZSnapshotView::getInt64() const
+{
+    return this->leaf().getInt64();
+}
+
+std::uint8_t ZSnapshotView::getUInt8() const
+{
+    return this->leaf().getUInt8();
+}
+
+std::uint16_t ZSnapshotView::getUInt16() const
+{
+    return this->leaf().getUInt16();
+}
+
+std::uint32_t ZSnapshotView::getUInt32() const
+{
+    return this->leaf().getUInt32();
+}
+
+std::uint64_t ZSnapshotView::getUInt64() const
+{
+    return this->leaf().getUInt64();
+}
+
+zfloat32 ZSnapshotView::getFloat32() const
+{
+    return this->leaf().getFloat32();
+}
+
+zfloat64 ZSnapshotView::getFloat64() const
+{
+    return this->leaf().getFloat64();
+}
+
+zfloat64 ZSnapshotView::getNumber() const
+{
+    return this->leaf().getNumber();
+}
+
+std::uint64_t ZSnapshotView::getLength() const
+{
+    if(!this->isContainer()) return this->leaf().getLength();
+
+    std::uint64_t count;
+    return this->table(entryWords(this->variantType()), count) ? count : 0;
+}
+
+ZStringView ZSnapshotView::getString() const
+{
+    return this->leaf().getString();
+}
+
+ZStringView ZSnapshotView::getArrayBytes() const
+{
+    return this->leaf().getArrayBytes();
+}
+
+zfloat64 ZSnapshotView::numberAt(const std::uint64_t &index) const
+{
+    return this->leaf().numberAt(index);
+}
+
+ZSnapshotView ZSnapshotView::at(const std::uint64_t &index) const
+{
+    std::uint64_t count;
+    const std::uint64_t *entries = this->isList() ? this->table(1, count) : nullptr;
+    if(entries == nullptr || index >= count) return ZSnapshotView();
+    return this->node(entries[index]);
+}
+
+ZSnapshotView ZSnapshotView::keyAt(const std::uint64_t &index) const
+{
+    std::uint64_t count;
+    ZVariantType variantType = this->variantType();
+    if(variantType != ZVariantType::Map && variantType != ZVariantType::HashMap) return ZSnapshotView();
+
+    const std::uint64_t *entries = this->table(2, count);
+    if(entries == nullptr || index >= count) return ZSnapshotView();
+    return this->node(entries[index * 2]);
+}
+
+ZSnapshotView ZSnapshotView::valueAt(const std::uint64_t &index) const
+{
+    std::uint64_t count;
+    const std::uint64_t *entries = this->isContainer() && !this->isList() ? this->table(2, count) : nullptr;
+    if(entries == nullptr || index >= count) return ZSnapshotView();
+    return this->node(entries[index * 2 + 1]);
+}
+
+std::uint64_t ZSnapshotView::integerKeyAt(const std::uint64_t &index) const
+{
+    std::uint64_t count;
+    ZVariantType variantType = this->variantType();
+    if(variantType != ZVariantType::IntegerVariantMap && variantType != ZVariantType::IntegerHashMap) return 0;
+
+    const std::uint64_t *entries = this->table(2, count);
+    if(entries == nullptr || index >= count) return 0;
+    return entries[index * 2];
+}
+
+template<typename Compare>
+ZSnapshotView ZSnapshotView::search(Compare compareKey) const
+{
+    std::uint64_t count;
+    ZVariantType variantType = this->variantType();
+    if(variantType != ZVariantType::Map && variantType != ZVariantType::HashMap) return ZSnapshotView();
+
+    const std::uint64_t *entries = this->table(2, count);
+    if(entries == nullptr) return ZSnapshotView();
+
+    std::uint64_t low = 0;
+    std::uint64_t high = count;
+    while(low < high)
+    {
+        std::uint64_t middle = low + (high - low) / 2;
+        int r = compareKey(this->node(entries[middle * 2]));
+        if(r == 0) return this->node(entries[middle * 2 + 1]);
+        if(r < 0) low = middle + 1;
+        else high = middle;
+    }
+    return ZSnapshotView();
+}
+
+ZSnapshotView ZSnapshotView::find(const ZStringView &key) const
+{
+    return this->search([&key](const ZSnapshotView &candidate) { return candidate.compareKey(key); });
+}
+
+ZSnapshotView ZSnapshotView::find(const char *key) const
+{
+    return this->find(ZStringView(key));
+}
+
+ZSnapshotView ZSnapshotView::find(const std::string &key) const
+{
+    return this->find(ZStringView(key));
+}
+
+ZSnapshotView ZSnapshotView::find(const std::uint64_t &key) const
+{
+    std::uint64_t count;
+    ZVariantType variantType = this->variantType();
+    if(variantType != ZVariantType::IntegerVariantMap && variantType != ZVariantType::IntegerHashMap) return ZSnapshotView();
+
+    const std::uint64_t *entries = this->table(2, count);
+    if(entries == nullptr) return ZSnapshotView();
+
+    std::uint64_t low = 0;
+    std::uint64_t high = count;
+    while(low < high)
+    {
+        std::uint64_t middle = low + (high - low) / 2;
+        std::uint64_t candidate = entries[middle * 2];
+        if(candidate == key) return this->node(entries[middle * 2 + 1]);
+        if(candidate < key) low = middle + 1;
+        else high = middle;
+    }
+    return ZSnapshotView();
+}
+
+ZSnapshotView ZSnapshotView::find(const ZVariant &key) const
+{
+    if(key.isString()) return this->find(ZStringView(key.getString()));
+    return this->search([&key](const ZSnapshotView &candidate) { return candidate.compareKey(key); });
+}
+
+bool ZSnapshotView::toVariant(ZVariant &variant) const
+{
+    return this->toVariant(variant, 0);
+}
+
+bool ZSnapshotView::toVariant(ZVariant &variant, const std::size_t &depth) const
+{
+    variant.makeInvalid();
+    if(!this->isContainer()) return this->leaf().toVariant(variant);
+    if(depth >= ZVariantSerializer::MaxDepth) return false;
+
+    std::uint64_t count;
+    ZVariantType variantType = this->variantType();
+    const std::uint64_t *entries = this->table(entryWords(variantType), count);
+    if(entries == nullptr) return false;
+
+    switch (variantType)
+    {
+    case ZVariantType::List:
+        variant.setList();
+        variant.reserveList(count);
+        break;
+    case ZVariantType::Map:
+        variant.setMap();
+        break;
+    case ZVariantType::IntegerVariantMap:
+        variant.setIntVarMap();
+        break;
+    case ZVariantType::HashMap:
+        variant.setHashMap();
+        variant.reserveHashMap(count);
+        break;
+    default:
+        variant.setIntegerHashMap();
+        variant.reserveIntegerHashMap(count);
+        break;
+    }
+
+    for(std::uint64_t i = 0; i < count; ++i)
+    {
+        ZVariant key;
+        ZVariant value;
+        bool ok = true;
+
+        switch (variantType)
+        {
+        case ZVariantType::List:
+            ok = this->node(entries[i]).toVariant(value, depth + 1) && variant.addToList(std::move(value));
+            break;
+        case ZVariantType::Map:
+            ok = this->node(entries[i * 2]).toVariant(key, depth + 1) && this->node(entries[i * 2 + 1]).toVariant(value, depth + 1)
+                    && variant.addToMap(std::move(key), std::move(value));
+            break;
+        case ZVariantType::IntegerVariantMap:
+            ok = this->node(entries[i * 2 + 1]).toVariant(value, depth + 1) && variant.addToIntVarMap(entries[i * 2], std::move(value));
+            break;
+        case ZVariantType::HashMap:
+            ok = this->node(entries[i * 2]).toVariant(key, depth + 1) && this->node(entries[i * 2 + 1]).toVariant(value, depth + 1)
+                    && variant.addToHashMap(std::move(key), std::move(value));
+            break;
+        default:
+            ok = this->node(entries[i * 2 + 1]).toVariant(value, depth + 1) && variant.addToIntegerHashMap(entries[i * 2], std::move(value));
+            break;
+        }
+
+        if(!ok)
+        {
+            variant.makeInvalid();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ZSnapshotView::isContainer() const
+{
+    return isContainerType(this->variantType());
+}
+
+ZVariantView ZSnapshotView::leaf() const
+{
+    if(this->isContainer() || this->m_offset >= this->m_size) return ZVariantView();
+    return ZVariantView(this->m_data + this->m_offset, static_cast<std::size_t>(this->m_size - this->m_offset));
+}
+
+const std::uint64_t *ZSnapshotView::table(const std::uint64_t &entrySize, std::uint64_t &count) const
+{
+    if(this->m_offset % 8 != 0 || this->m_size - this->m_offset < ContainerHeaderSize) return nullptr;
+
+    std::memcpy(&count, this->m_data + this->m_offset + 8, sizeof(count));
+    std::uint64_t available = (this->m_size - this->m_offset - ContainerHeaderSize) / (entrySize * 8);
+    if(count > available) return nullptr;
+
+    return reinterpret_cast<const std::uint64_t*>(this->m_data + this->m_offset + ContainerHeaderSize);
+}
+
+ZSnapshotView ZSnapshotView::node(const std::uint64_t &offset) const
+{
+    /* children always precede their parent, which also rules out cycles in a corrupt file */
+    if(offset >= this->m_offset) return ZSnapshotView();
+    return ZSnapshotView(this->m_data, this->m_size, offset);
+}
+
+int ZSnapshotView::compareKey(const ZStringView &key) const
+{
+    ZVariantType variantType = this->variantType();
+    if(variantType != ZVariantType::String) return variantType < ZVariantType::String ? -1 : 1;
+    return this->getString().compare(key);
+}
+
+int ZSnapshotView::compareKey(const ZVariant &key) const
+{
+    if(key.isString()) return this->compareKey(ZStringView(key.getString()));
+
+    ZVariantType variantType = this->variantType();
+    if(variantType != key.variantType()) return variantType < key.variantType() ? -1 : 1;
+
+    ZVariant candidate;
+    this->toVariant(candidate);
+    return candidate.compare(key);
+}
+
+ZSnapshot::ZSnapshot():
+    m_mapping(nullptr),
+    m_mappingSize(0)
+{
+    std::memset(&this->m_header, 0, sizeof(this->m_header));
+}
+
+ZSnapshot::~ZSnapshot()
+{
+    this->close();
+}
+
+bool ZSnapshot::write(const ZVariant &variant, const std::string &path)
+{
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    if(file == nullptr) return false;
+
+    /* the header page is written last, once the root offset is known */
+    ZSnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+
+    ZSnapshotWriter writer(file);
+    writer.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    writer.pad(PageSize);
+
+    std::memcpy(header.magic, SnapshotMagic, sizeof(header.magic));
+    header.version = Version;
+    header.byteOrder = hostByteOrder();
+    header.pageSize = PageSize;
+    header.dataOffset = PageSize;
+    header.rootOffset = writeNode(writer, variant);
+    header.dataSize = writer.position() - PageSize;
+    writer.pad(PageSize);
+
+    bool ok = writer.flush()
+            && std::fseek(file, 0, SEEK_SET) == 0
+            && std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = std::fclose(file) == 0 && ok;
+
+    if(!ok) std::remove(path.c_str());
+    return ok;
+}
+
+bool ZSnapshot::open(const std::string &path)
+{
+    this->close();
+
+#ifdef _WIN32
+    std::ifstream file(path.c_str(), std::ios::binary | std::ios::ate);
+    if(!file) return false;
+
+    std::streamoff size = file.tellg();
+    if(size < static_cast<std::streamoff>(PageSize)) return false;
+
+    /* no mmap here, read the file into memory instead */
+    char *data = new char[static_cast<std::size_t>(size)];
+    file.seekg(0);
+    if(!file.read(data, size))
+    {
+        delete [] data;
+        return false;
+    }
+    this->m_mapping = data;
+    this->m_mappingSize = static_cast<std::uint64_t>(size);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+
+    struct stat status;
+    if(::fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(PageSize))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void *mapping = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(mapping == MAP_FAILED) return false;
+
+    /* lookups jump around the file, read ahead would only inflate the resident set */
+    ::madvise(mapping, static_cast<std::size_t>(status.st_size), MADV_RANDOM);
+
+    this->m_mapping = static_cast<const char*>(mapping);
+    this->m_mappingSize = static_cast<std::uint64_t>(status.st_size);
+#endif
+
+    std::memcpy(&this->m_header, this->m_mapping, sizeof(this->m_header));
+    const ZSnapshotHeader &header = this->m_header;
+    bool valid = std::memcmp(header.magic, SnapshotMagic, sizeof(header.magic)) == 0
+            && header.version == Version
+            && header.byteOrder == hostByteOrder()
+            && header.dataOffset % PageSize == 0
+            && header.dataOffset >= PageSize
+            && header.dataOffset <= this->m_mappingSize
+            && header.dataSize <= this->m_mappingSize - header.dataOffset
+            && header.rootOffset < header.dataSize;
+
+    if(!valid) this->close();
+    return valid;
+}
+
+void ZSnapshot::close()
+{
+    if(this->m_mapping != nullptr)
+    {
+#ifdef _WIN32
+        delete [] this->m_mapping;
+#else
+        ::munmap(const_cast<char*>(this->m_mapping), static_cast<std::size_t>(this->m_mappingSize));
+#endif
+    }
+
+    this->m_mapping = nullptr;
+    this->m_mappingSize = 0;
+    std::memset(&this->m_header, 0, sizeof(this->m_header));
+}
+
+bool ZSnapshot::isOpen() const
+{
+    return this->m_mapping != nullptr;
+}
+
+ZSnapshotView ZSnapshot::root() const
+{
+    if(this->m_mapping == nullptr) return ZSnapshotView();
+
+    return ZSnapshotView(this->m_mapping + this->m_header.dataOffset, this->m_header.dataSize, this->m_header.rootOffset);
+}
+
+std::uint64_t ZSnapshot::fileSize() const
+{
+    return this->m_mappingSize;
+}
+
+}
@@ -0,0 +1,186 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ZSNAPSHOT_H
+#define ZSNAPSHOT_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+#include "zvariant.h"
+#include "zvariantview.h"
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZSnapshotHeader struct
+///
+/// First page of a snapshot file. Integers are stored in the byte order of the writer, which is
+/// recorded in byteOrder, readers refuse files of the other byte order.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct ZSnapshotHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint8_t byteOrder;
+    std::uint8_t reserved[3];
+    std::uint64_t pageSize;
+    std::uint64_t dataOffset;
+    std::uint64_t dataSize;
+    std::uint64_t rootOffset;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZSnapshotView class
+///
+/// ZSnapshotView reads one node of an opened snapshot in place. Scalars and strings use the
+/// ZVariantSerializer encoding, containers carry an offset table instead, so indexed access
+/// is O(1) and key lookup is a binary search over entries sorted by ZVariant::compare order.
+/// Offsets are checked before use, a corrupt file reads as None or zero.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZSnapshotView
+{
+public:
+    ZSnapshotView();
+
+    ZVariantType variantType() const;
+    std::string variantTypeString() const;
+
+    bool isValid() const;
+    bool isNone() const;
+    bool isBool() const;
+    bool isNumber() const;
+    bool isString() const;
+    bool isList() const;
+    bool isMap() const;
+    bool isIntegerVariantMap() const;
+    bool isHashMap() const;
+    bool isIntegerHashMap() const;
+    bool isArray() const;
+
+    bool getBool() const;
+    std::int8_t getInt8() const;
+    std::int16_t getInt16() const;
+    std::int32_t getInt32() const;
+    std::int64_t getInt64() const;
+
+    std::uint8_t getUInt8() const;
+    std::uint16_t getUInt16() const;
+    std::uint32_t getUInt32() const;
+    std::uint64_t getUInt64() const;
+
+    zfloat32 getFloat32() const;
+    zfloat64 getFloat64() const;
+
+    zfloat64 getNumber() const;
+    std::uint64_t getLength() const;
+
+    ZStringView getString() const;
+    ZStringView getArrayBytes() const;
+    zfloat64 numberAt(const std::uint64_t &index) const;
+
+    ZSnapshotView at(const std::uint64_t &index) const;
+    ZSnapshotView keyAt(const std::uint64_t &index) const;
+    ZSnapshotView valueAt(const std::uint64_t &index) const;
+    std::uint64_t integerKeyAt(const std::uint64_t &index) const;
+
+    ZSnapshotView find(const ZStringView &key) const;
+    ZSnapshotView find(const char *key) const;
+    ZSnapshotView find(const std::string &key) const;
+    ZSnapshotView find(const std::uint64_t &key) const;
+    ZSnapshotView find(const ZVariant &key) const;
+
+    bool toVariant(ZVariant &variant) const;
+
+private:
+    friend class ZSnapshot;
+
+    ZSnapshotView(const char *data, const std::uint64_t &size, const std::uint64_t &offset);
+
+    bool toVariant(ZVariant &variant, const std::size_t &depth) const;
+    bool isContainer() const;
+    ZVariantView leaf() const;
+    const std::uint64_t *table(const std::uint64_t &entrySize, std::uint64_t &count) const;
+    ZSnapshotView node(const std::uint64_t &offset) const;
+
+    int compareKey(const ZStringView &key) const;
+    int compareKey(const ZVariant &key) const;
+
+    template<typename Compare>
+    ZSnapshotView search(Compare compareKey) const;
+
+    const char *m_data;
+    std::uint64_t m_size;
+    std::uint64_t m_offset;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZSnapshot class
+///
+/// ZSnapshot stores a ZVariant tree in a file that is memory mapped for reading, so lookups
+/// can start right after open() and only the pages that are touched become resident.
+///
+/// The file is a header page followed by a page aligned data section holding the nodes.
+/// Children are written before their parents, the root offset is kept in the header.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZSnapshot
+{
+public:
+    static const std::uint32_t Version = 1;
+    static const std::uint64_t PageSize = 4096;
+
+    explicit ZSnapshot();
+    ~ZSnapshot();
+
+    ZSnapshot(const ZSnapshot &) = delete;
+    ZSnapshot &operator=(const ZSnapshot &) = delete;
+
+    static bool write(const ZVariant &variant, const std::string &path);
+
+    bool open(const std::string &path);
+    void close();
+    bool isOpen() const;
+
+    ZSnapshotView root() const;
+    std::uint64_t fileSize() const;
+
+private:
+    const char *m_mapping;
+    std::uint64_t m_mappingSize;
+    ZSnapshotHeader m_header;
+};
+
+}
+
+#endif // ZSNAPSHOT_H
@@ -0,0 +1,96 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef ZSTRINGVIEW_H
+#define ZSTRINGVIEW_H
+
+#include <string>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZStringView class
+///
+/// ZStringView is a non-owning reference to a range of characters, a minimal stand-in for
+/// std::string_view which is not available in C++11.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZStringView
+{
+public:
+    ZStringView(): m_data(nullptr), m_size(0) {}
+    ZStringView(const char *data, const std::size_t &size): m_data(data), m_size(size) {}
+    ZStringView(const char *data): m_data(data), m_size(std::strlen(data)) {}
+    ZStringView(const std::string &value): m_data(value.data()), m_size(value.size()) {}
+
+    const char *data() const { return this->m_data; }
+    std::size_t size() const { return this->m_size; }
+    std::size_t length() const { return this->m_size; }
+    bool empty() const { return this->m_size == 0; }
+
+    const char *begin() const { return this->m_data; }
+    const char *end() const { return this->m_data + this->m_size; }
+    char operator[](const std::size_t &index) const { return this->m_data[index]; }
+
+    std::string toString() const { return std::string(this->m_data, this->m_size); }
+
+    int compare(const ZStringView &other) const
+    {
+        std::size_t size = this->m_size < other.m_size ? this->m_size : other.m_size;
+        int r = size ? std::memcmp(this->m_data, other.m_data, size) : 0;
+        if(r != 0) return r < 0 ? -1 : 1;
+        return this->m_size < other.m_size ? -1 : (this->m_size > other.m_size ? 1 : 0);
+    }
+
+    bool operator==(const ZStringView &other) const
+    {
+        return this->m_size == other.m_size && (this->m_size == 0 || std::memcmp(this->m_data, other.m_data, this->m_size) == 0);
+    }
+
+    bool operator!=(const ZStringView &other) const { return !this->operator==(other); }
+    bool operator<(const ZStringView &other) const { return this->compare(other) < 0; }
+
+    friend std::ostream &operator<<(std::ostream &os, const ZStringView &view)
+    {
+        return os.write(view.m_data, static_cast<std::streamsize>(view.m_size));
+    }
+
+private:
+    const char *m_data;
+    std::size_t m_size;
+};
+
+}
+
+#endif // ZSTRINGVIEW_H
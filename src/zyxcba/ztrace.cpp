@@ -0,0 +1,200 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "ztrace.h"
+#include "zvariant.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace zyxcba {
+
+namespace {
+
+const std::size_t EventCount = static_cast<std::size_t>(ZTraceEvent::EventCount);
+
+/* zero initialized as objects with static storage duration */
+std::atomic<std::uint64_t> g_counters[EventCount][ZTrace::VariantTypeCount];
+
+class ZTraceRing
+{
+public:
+    ZTraceRing():
+        m_records(nullptr),
+        m_head(0)
+    {
+
+    }
+
+    ~ZTraceRing()
+    {
+        delete [] this->m_records;
+    }
+
+    void push(const ZTraceRecord &record)
+    {
+        /* only the owning thread ever touches its ring */
+        if(this->m_records == nullptr) this->m_records = new ZTraceRecord[ZTrace::RingCapacity];
+        this->m_records[this->m_head % ZTrace::RingCapacity] = record;
+        ++this->m_head;
+    }
+
+    std::size_t copy(ZTraceRecord *records, const std::size_t &maxRecords) const
+    {
+        std::uint64_t available = this->m_head < ZTrace::RingCapacity ? this->m_head : ZTrace::RingCapacity;
+        std::size_t count = available < maxRecords ? static_cast<std::size_t>(available) : maxRecords;
+
+        /* oldest first */
+        std::uint64_t first = this->m_head - count;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            records[i] = this->m_records[(first + i) % ZTrace::RingCapacity];
+        }
+        return count;
+    }
+
+    void clear()
+    {
+        this->m_head = 0;
+    }
+
+private:
+    ZTraceRecord *m_records;
+    std::uint64_t m_head;
+};
+
+thread_local ZTraceRing t_ring;
+
+}
+
+const std::size_t ZTrace::RingCapacity;
+const std::size_t ZTrace::VariantTypeCount;
+
+void ZTrace::record(const ZTraceLevel &level, const ZTraceEvent &event, const ZVariantType &variantType)
+{
+    std::size_t typeIndex = static_cast<std::size_t>(variantType) % VariantTypeCount;
+    g_counters[static_cast<std::size_t>(event)][typeIndex].fetch_add(1, std::memory_order_relaxed);
+
+    ZTraceRecord record;
+    record.timestamp = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    record.level = level;
+    record.event = event;
+    record.variantType = variantType;
+    t_ring.push(record);
+}
+
+std::uint64_t ZTrace::counter(const ZTraceEvent &event, const ZVariantType &variantType)
+{
+    std::size_t typeIndex = static_cast<std::size_t>(variantType) % VariantTypeCount;
+    return g_counters[static_cast<std::size_t>(event)][typeIndex].load(std::memory_order_relaxed);
+}
+
+void ZTrace::resetCounters()
+{
+    for(std::size_t event = 0; event < EventCount; ++event)
+    {
+        for(std::size_t type = 0; type < VariantTypeCount; ++type)
+        {
+            g_counters[event][type].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+std::size_t ZTrace::threadEvents(ZTraceRecord *records, const std::size_t &maxRecords)
+{
+    return t_ring.copy(records, maxRecords);
+}
+
+void ZTrace::clearThreadEvents()
+{
+    t_ring.clear();
+}
+
+void ZTrace::dumpCounters(std::ostream &os)
+{
+    for(std::size_t type = 0; type < VariantTypeCount; ++type)
+    {
+        bool printed = false;
+        for(std::size_t event = 0; event < EventCount; ++event)
+        {
+            std::uint64_t value = g_counters[event][type].load(std::memory_order_relaxed);
+            if(value == 0) continue;
+
+            if(!printed)
+            {
+                os << ZVariant::variantTypeName(static_cast<ZVariantType>(type)) << ":";
+                printed = true;
+            }
+            os << " " << ZTrace::eventName(static_cast<ZTraceEvent>(event)) << "=" << value;
+        }
+        if(printed) os << "\n";
+    }
+}
+
+void ZTrace::dumpThreadEvents(std::ostream &os)
+{
+    ZTraceRecord *records = new ZTraceRecord[RingCapacity];
+    std::size_t count = ZTrace::threadEvents(records, RingCapacity);
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        os << records[i].timestamp << " "
+           << ZTrace::eventName(records[i].event) << " "
+           << ZVariant::variantTypeName(records[i].variantType) << "\n";
+    }
+    delete [] records;
+}
+
+const char *ZTrace::eventName(const ZTraceEvent &event)
+{
+    switch (event) {
+    case ZTraceEvent::Construct:
+        return "Construct";
+    case ZTraceEvent::Copy:
+        return "Copy";
+    case ZTraceEvent::Move:
+        return "Move";
+    case ZTraceEvent::CopyAssign:
+        return "CopyAssign";
+    case ZTraceEvent::MoveAssign:
+        return "MoveAssign";
+    case ZTraceEvent::Destroy:
+        return "Destroy";
+    case ZTraceEvent::Allocate:
+        return "Allocate";
+    case ZTraceEvent::Compare:
+        return "Compare";
+    default:
+        return "Unknown";
+    }
+}
+
+}
@@ -0,0 +1,140 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef ZTRACE_H
+#define ZTRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/* The trace level is fixed at compile time. Events above it compile to nothing.
+ * Defining ZYXCBA_DEBUG keeps its historical meaning and enables every level.
+ */
+#ifndef ZYXCBA_TRACE_LEVEL
+#ifdef ZYXCBA_DEBUG
+#define ZYXCBA_TRACE_LEVEL 4
+#else
+#define ZYXCBA_TRACE_LEVEL 0
+#endif
+#endif
+
+#define ZYXCBA_TRACE(level, event, variantType) \
+    do { \
+        if(static_cast<int>(level) <= ZYXCBA_TRACE_LEVEL) \
+        { \
+            ::zyxcba::ZTrace::record((level), (event), (variantType)); \
+        } \
+    } while(0)
+
+namespace zyxcba {
+
+enum class ZVariantType : std::uint8_t;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZTraceLevel enum
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+enum class ZTraceLevel : std::uint8_t
+{
+    None,
+    Error,
+    Warning,
+    Info,
+    Debug
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZTraceEvent enum
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+enum class ZTraceEvent : std::uint8_t
+{
+    Construct,
+    Copy,
+    Move,
+    CopyAssign,
+    MoveAssign,
+    Destroy,
+    Allocate,
+    Compare,
+
+    EventCount
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZTraceRecord struct
+///
+/// One entry of the per-thread trace ring buffer.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct ZTraceRecord
+{
+    std::uint64_t timestamp;
+    ZTraceLevel level;
+    ZTraceEvent event;
+    ZVariantType variantType;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZTrace class
+///
+/// ZTrace collects trace events emitted through ZYXCBA_TRACE. Every thread appends to its own
+/// fixed size ring buffer without locking, and per ZVariantType counters of every event are kept
+/// for the whole process. Both can be dumped on demand.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZTrace
+{
+public:
+    static const std::size_t RingCapacity = 4096;
+    static const std::size_t VariantTypeCount = 32;
+
+    static void record(const ZTraceLevel &level, const ZTraceEvent &event, const ZVariantType &variantType);
+
+    static std::uint64_t counter(const ZTraceEvent &event, const ZVariantType &variantType);
+    static void resetCounters();
+
+    static std::size_t threadEvents(ZTraceRecord *records, const std::size_t &maxRecords);
+    static void clearThreadEvents();
+
+    static void dumpCounters(std::ostream &os);
+    static void dumpThreadEvents(std::ostream &os);
+
+    static const char *eventName(const ZTraceEvent &event);
+};
+
+}
+
+#endif // ZTRACE_H
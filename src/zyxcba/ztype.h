@@ -32,6 +32,8 @@
 #ifndef ZTYPE_H
 #define ZTYPE_H
 
+#include <type_traits>
+
 namespace zyxcba {
 
 
@@ -47,6 +49,26 @@ namespace zyxcba {
 typedef float zfloat32;
 typedef double zfloat64;
 
+#if defined(__SIZEOF_INT128__)
+#define ZYXCBA_HAS_INT128 1
+__extension__ typedef __int128 zint128;
+__extension__ typedef unsigned __int128 zuint128;
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The is_trivially_relocatable trait
+///
+/// A type is trivially relocatable when moving an object to a new address and ending the
+/// lifetime of the source can be done with a plain memory copy. The library's containers use
+/// this trait to grow with bulk memory moves instead of per element move and destroy.
+/// Specialize it for types which own their resources only through pointers.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+struct is_trivially_relocatable : std::integral_constant<bool, std::is_trivially_copyable<T>::value>
+{
+};
+
 }
 
 #endif // ZTYPE_H
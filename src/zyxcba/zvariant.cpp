@@ -31,9 +31,109 @@
 
 
 #include "zvariant.h"
+#include "zendian.h"
+#include "zhash.h"
 
 namespace zyxcba {
 
+namespace {
+
+/* the typed array variant type holding elements of T */
+template<typename T>
+struct ZArrayVariantType;
+
+template<>
+struct ZArrayVariantType<std::int32_t>
+{
+    static ZVariantType type() { return ZVariantType::Int32Array; }
+};
+
+template<>
+struct ZArrayVariantType<std::int64_t>
+{
+    static ZVariantType type() { return ZVariantType::Int64Array; }
+};
+
+template<>
+struct ZArrayVariantType<std::uint8_t>
+{
+    static ZVariantType type() { return ZVariantType::UInt8Array; }
+};
+
+template<>
+struct ZArrayVariantType<zfloat32>
+{
+    static ZVariantType type() { return ZVariantType::Float32Array; }
+};
+
+template<>
+struct ZArrayVariantType<zfloat64>
+{
+    static ZVariantType type() { return ZVariantType::Float64Array; }
+};
+
+}
+
+template<>
+ZVariantPayload<ZInt32Array> *&ZVariant::arrayPayload<std::int32_t>()
+{
+    return this->m_int32Array;
+}
+
+template<>
+const ZVariantPayload<ZInt32Array> *ZVariant::arrayPayload<std::int32_t>() const
+{
+    return this->m_int32Array;
+}
+
+template<>
+ZVariantPayload<ZInt64Array> *&ZVariant::arrayPayload<std::int64_t>()
+{
+    return this->m_int64Array;
+}
+
+template<>
+const ZVariantPayload<ZInt64Array> *ZVariant::arrayPayload<std::int64_t>() const
+{
+    return this->m_int64Array;
+}
+
+template<>
+ZVariantPayload<ZUInt8Array> *&ZVariant::arrayPayload<std::uint8_t>()
+{
+    return this->m_uint8Array;
+}
+
+template<>
+const ZVariantPayload<ZUInt8Array> *ZVariant::arrayPayload<std::uint8_t>() const
+{
+    return this->m_uint8Array;
+}
+
+template<>
+ZVariantPayload<ZFloat32Array> *&ZVariant::arrayPayload<zfloat32>()
+{
+    return this->m_float32Array;
+}
+
+template<>
+const ZVariantPayload<ZFloat32Array> *ZVariant::arrayPayload<zfloat32>() const
+{
+    return this->m_float32Array;
+}
+
+template<>
+ZVariantPayload<ZFloat64Array> *&ZVariant::arrayPayload<zfloat64>()
+{
+    return this->m_float64Array;
+}
+
+template<>
+const ZVariantPayload<ZFloat64Array> *ZVariant::arrayPayload<zfloat64>() const
+{
+    return this->m_float64Array;
+}
+
 ZVariant::ZVariant():
     m_variantType(ZVariantType::None)
 {
@@ -41,388 +141,352 @@ ZVariant::ZVariant():
 }
 
 ZVariant::ZVariant(const bool &param):
-    m_variantType(ZVariantType::Bool),
-    m_bool(param)
+    m_bool(param),
+    m_variantType(ZVariantType::Bool)
 {
 
 }
 
 ZVariant::ZVariant(const std::int8_t &param):
-    m_variantType(ZVariantType::Int8),
-    m_int8(param)
+    m_int8(param),
+    m_variantType(ZVariantType::Int8)
 {
 
 }
 
 ZVariant::ZVariant(const std::int16_t &param):
-    m_variantType(ZVariantType::Int16),
-    m_int16(param)
+    m_int16(param),
+    m_variantType(ZVariantType::Int16)
 {
 
 }
 
 ZVariant::ZVariant(const std::int32_t &param):
-    m_variantType(ZVariantType::Int32),
-    m_int32(param)
+    m_int32(param),
+    m_variantType(ZVariantType::Int32)
 {
 
 }
 
 ZVariant::ZVariant(const std::int64_t &param):
-    m_variantType(ZVariantType::Int64),
-    m_int64(param)
+    m_int64(param),
+    m_variantType(ZVariantType::Int64)
 {
 
 }
 
 ZVariant::ZVariant(const std::uint8_t &param):
-    m_variantType(ZVariantType::UInt8),
-    m_uint8(param)
+    m_uint8(param),
+    m_variantType(ZVariantType::UInt8)
 {
 
 }
 
 ZVariant::ZVariant(const std::uint16_t &param):
-    m_variantType(ZVariantType::UInt16),
-    m_uint16(param)
+    m_uint16(param),
+    m_variantType(ZVariantType::UInt16)
 {
 
 }
 
 ZVariant::ZVariant(const std::uint32_t &param):
-    m_variantType(ZVariantType::UInt32),
-    m_uint32(param)
+    m_uint32(param),
+    m_variantType(ZVariantType::UInt32)
 {
 
 }
 
 ZVariant::ZVariant(const std::uint64_t &param):
-    m_variantType(ZVariantType::UInt64),
-    m_uint64(param)
+    m_uint64(param),
+    m_variantType(ZVariantType::UInt64)
 {
 
 }
 
 ZVariant::ZVariant(const zfloat32 &param):
-    m_variantType(ZVariantType::Float32),
-    m_float32(param)
+    m_float32(param),
+    m_variantType(ZVariantType::Float32)
 {
 
 }
 
 ZVariant::ZVariant(const zfloat64 &param):
-    m_variantType(ZVariantType::Float64),
-    m_float64(param)
+    m_float64(param),
+    m_variantType(ZVariantType::Float64)
 {
 
 }
 
 ZVariant::ZVariant(const std::string &param):
-    m_variantType(ZVariantType::String),
-    m_string(param)
+    m_string(newPayload<std::string>(ZVariantType::String, param)),
+    m_variantType(ZVariantType::String)
 {
-
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
 }
 
-ZVariant::ZVariant(const std::string &&param):
-    m_variantType(ZVariantType::String),
-    m_string(std::move(param))
+ZVariant::ZVariant(std::string &&param):
+    m_string(newPayload<std::string>(ZVariantType::String, std::move(param))),
+    m_variantType(ZVariantType::String)
 {
-
-#ifdef ZYXCBA_DEBUG
-    std::cout<<"Moving string..."<<std::endl;
-#endif
-
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
 }
 
 ZVariant::ZVariant(const char *param):
-    m_variantType(ZVariantType::String),
-    m_string(std::move(param))
+    m_string(newPayload<std::string>(ZVariantType::String, param)),
+    m_variantType(ZVariantType::String)
 {
-#ifdef ZYXCBA_DEBUG
-    std::cout<<"Moving Char string..."<<std::endl;
-#endif
-
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
 }
 
 ZVariant::ZVariant(const ZVariantList &param):
+    m_list(newPayload<ZVariantList>(ZVariantType::List, param)),
     m_variantType(ZVariantType::List)
 {
-    std::copy(param.begin(), param.end(), back_inserter(this->m_list));
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
 }
 
 ZVariant::ZVariant(const ZVariantMap &param):
+    m_map(newPayload<ZVariantMap>(ZVariantType::Map, param)),
     m_variantType(ZVariantType::Map)
 {
-    this->m_map.insert(param.begin(),param.end());
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
 }
 
 ZVariant::ZVariant(const ZIntegerVariantMap &param):
+    m_integerVariantMap(newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap, param)),
     m_variantType(ZVariantType::IntegerVariantMap)
 {
-    this->m_integerVariantMap.insert(param.begin(),param.end());
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
 }
 
-ZVariant::ZVariant(const ZVariant &other):
-    m_variantType(other.m_variantType)
+ZVariant::ZVariant(ZVariantList &&param):
+    m_list(newPayload<ZVariantList>(ZVariantType::List, std::move(param))),
+    m_variantType(ZVariantType::List)
 {
-#ifdef ZYXCBA_DEBUG
-    std::cout<<"Constructor Copying... "<<this->variantTypeString()<<std::endl;
-#endif
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
+}
 
-    switch (m_variantType) {
-    case ZVariantType::Bool:
-        this->m_bool = other.m_bool;
-        break;
-    case ZVariantType::Int8:
-        this->m_int8 = other.m_int8;
-        break;
+ZVariant::ZVariant(ZVariantMap &&param):
+    m_map(newPayload<ZVariantMap>(ZVariantType::Map, std::move(param))),
+    m_variantType(ZVariantType::Map)
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
+}
 
-    case ZVariantType::Int16:
-        this->m_int16 = other.m_int16;
-        break;
+ZVariant::ZVariant(ZIntegerVariantMap &&param):
+    m_integerVariantMap(newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap, std::move(param))),
+    m_variantType(ZVariantType::IntegerVariantMap)
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
+}
 
-    case ZVariantType::Int32:
-        this->m_int32 = other.m_int32;
-        break;
+ZVariant::ZVariant(const ZVariantHashMap &param):
+    m_hashMap(newPayload<ZVariantHashMap>(ZVariantType::HashMap, param)),
+    m_variantType(ZVariantType::HashMap)
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
+}
 
-    case ZVariantType::Int64:
-        this->m_int64 = other.m_int64;
-        break;
+ZVariant::ZVariant(const ZIntegerVariantHashMap &param):
+    m_integerHashMap(newPayload<ZIntegerVariantHashMap>(ZVariantType::IntegerHashMap, param)),
+    m_variantType(ZVariantType::IntegerHashMap)
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
+}
 
-    case ZVariantType::UInt8:
-        this->m_uint8 = other.m_uint8;
-        break;
+ZVariant::ZVariant(ZVariantHashMap &&param):
+    m_hashMap(newPayload<ZVariantHashMap>(ZVariantType::HashMap, std::move(param))),
+    m_variantType(ZVariantType::HashMap)
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
+}
 
-    case ZVariantType::UInt16:
-        this->m_uint16 = other.m_uint16;
-        break;
+ZVariant::ZVariant(ZIntegerVariantHashMap &&param):
+    m_integerHashMap(newPayload<ZIntegerVariantHashMap>(ZVariantType::IntegerHashMap, std::move(param))),
+    m_variantType(ZVariantType::IntegerHashMap)
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
+}
 
-    case ZVariantType::UInt32:
-        this->m_uint32 = other.m_uint32;
-        break;
+ZVariant::ZVariant(const ZInt32Array &param):
+    m_int32Array(newPayload<ZInt32Array>(ZVariantType::Int32Array, param)),
+    m_variantType(ZVariantType::Int32Array)
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
+}
 
-    case ZVariantType::UInt64:
-        this->m_uint64 = other.m_uint64;
-        break;
+ZVariant::ZVariant(const ZInt64Array &param):
+    m_int64Array(newPayload<ZInt64Array>(ZVariantType::Int64Array, param)),
+    m_variantType(ZVariantType::Int64Array)
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
+}
 
-    case ZVariantType::Float32:
-        this->m_float32 = other.m_float32;
-        break;
+ZVariant::ZVariant(const ZUInt8Array &param):
+    m_uint8Array(newPayload<ZUInt8Array>(ZVariantType::UInt8Array, param)),
+    m_variantType(ZVariantType::UInt8Array)
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
+}
 
-    case ZVariantType::Float64:
-        this->m_float64 = other.m_float64;
-        break;
+ZVariant::ZVariant(const ZFloat32Array &param):
+    m_float32Array(newPayload<ZFloat32Array>(ZVariantType::Float32Array, param)),
+    m_variantType(ZVariantType::Float32Array)
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
+}
 
-    case ZVariantType::String:
-        this->m_string = other.m_string;
-        break;
+ZVariant::ZVariant(const ZFloat64Array &param):
+    m_float64Array(newPayload<ZFloat64Array>(ZVariantType::Float64Array, param)),
+    m_variantType(ZVariantType::Float64Array)
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
+}
 
-    case ZVariantType::List:
-        this->m_list.clear();
-        std::copy(other.m_list.begin(), other.m_list.end(), back_inserter(this->m_list));
-        break;
-    case ZVariantType::Map:
-        this->m_map.clear();
-        this->m_map.insert(other.m_map.begin(),other.m_map.end());
-        break;
-    case ZVariantType::IntegerVariantMap:
-        this->m_integerVariantMap.clear();
-        this->m_integerVariantMap.insert(other.m_integerVariantMap.begin(),other.m_integerVariantMap.end());
-        break;
-    default:
-        m_variantType = ZVariantType::None;
-        break;
-    }
+ZVariant::ZVariant(ZInt32Array &&param):
+    m_int32Array(newPayload<ZInt32Array>(ZVariantType::Int32Array, std::move(param))),
+    m_variantType(ZVariantType::Int32Array)
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
+}
 
+ZVariant::ZVariant(ZInt64Array &&param):
+    m_int64Array(newPayload<ZInt64Array>(ZVariantType::Int64Array, std::move(param))),
+    m_variantType(ZVariantType::Int64Array)
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
 }
 
-ZVariant::ZVariant(const ZVariant &&other):
-    m_variantType(other.m_variantType)
-{
-#ifdef ZYXCBA_DEBUG
-    std::cout<<"Constructor Moving const ZVariant..."<<std::endl;
-#endif
-
-    if(this != &other)
-    {
-        switch (m_variantType) {
-        case ZVariantType::Bool:
-            this->m_bool = std::move(other.m_bool);
-            break;
-        case ZVariantType::Int8:
-            this->m_int8 = std::move(other.m_int8);
-            break;
-
-        case ZVariantType::Int16:
-            this->m_int16 = std::move(other.m_int16);
-            break;
-
-        case ZVariantType::Int32:
-            this->m_int32 = std::move(other.m_int32);
-            break;
-
-        case ZVariantType::Int64:
-            this->m_int64 = std::move(other.m_int64);
-            break;
-
-        case ZVariantType::UInt8:
-            this->m_uint8 = std::move(other.m_uint8);
-            break;
-
-        case ZVariantType::UInt16:
-            this->m_uint16 = std::move(other.m_uint16);
-            break;
-
-        case ZVariantType::UInt32:
-            this->m_uint32 = std::move(other.m_uint32);
-            break;
-
-        case ZVariantType::UInt64:
-            this->m_uint64 = std::move(other.m_uint64);
-            break;
-
-        case ZVariantType::Float32:
-            this->m_float32 = std::move(other.m_float32);
-            break;
-
-        case ZVariantType::Float64:
-            this->m_float64 = std::move(other.m_float64);
-            break;
-
-        case ZVariantType::String:
-            this->m_string = std::move(other.m_string);
-            break;
-
-        case ZVariantType::List:
-            //this->m_list.clear();
-            //this->m_list.reserve(other.m_list.size());
-            this->m_list = std::move(other.m_list);
-            //std::copy(other.m_list.begin(), other.m_list.end(), back_inserter(this->m_list));
-            break;
-        case ZVariantType::Map:
-            //this->m_map.clear();
-            this->m_map = std::move(other.m_map);
-            //this->m_map.insert(other.m_map.begin(),other.m_map.end());
-            break;
-        case ZVariantType::IntegerVariantMap:
-            //this->m_integerVariantMap.clear();
-            this->m_integerVariantMap = std::move(other.m_integerVariantMap);
-            //this->m_integerVariantMap.insert(other.m_integerVariantMap.begin(),other.m_integerVariantMap.end());
-            break;
-        default:
-            m_variantType = ZVariantType::None;
-            break;
-        }
-    }
+ZVariant::ZVariant(ZUInt8Array &&param):
+    m_uint8Array(newPayload<ZUInt8Array>(ZVariantType::UInt8Array, std::move(param))),
+    m_variantType(ZVariantType::UInt8Array)
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
+}
 
-    //other.makeInvalid();
+ZVariant::ZVariant(ZFloat32Array &&param):
+    m_float32Array(newPayload<ZFloat32Array>(ZVariantType::Float32Array, std::move(param))),
+    m_variantType(ZVariantType::Float32Array)
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
 }
 
-ZVariant::ZVariant(ZVariant &&rhs)
+ZVariant::ZVariant(ZFloat64Array &&param):
+    m_float64Array(newPayload<ZFloat64Array>(ZVariantType::Float64Array, std::move(param))),
+    m_variantType(ZVariantType::Float64Array)
 {
-#ifdef ZYXCBA_DEBUG
-    std::cout<<"Constructor Moving ZVariant ..."<<std::endl;
-#endif
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Construct, this->m_variantType);
+}
 
-    if(this != &rhs)
-    {
-        this->makeInvalid();
-        this->m_variantType = rhs.m_variantType;
-
-        switch (rhs.m_variantType) {
-        case ZVariantType::Bool:
-            this->m_bool = std::move(rhs.m_bool);
-            break;
-        case ZVariantType::Int8:
-            this->m_int8 = std::move(rhs.m_int8);
-            break;
-
-        case ZVariantType::Int16:
-            this->m_int16 = std::move(rhs.m_int16);
-            break;
-
-        case ZVariantType::Int32:
-            this->m_int32 = std::move(rhs.m_int32);
-            break;
-
-        case ZVariantType::Int64:
-            this->m_int64 = std::move(rhs.m_int64);
-            break;
-
-        case ZVariantType::UInt8:
-            this->m_uint8 = std::move(rhs.m_uint8);
-            break;
-
-        case ZVariantType::UInt16:
-            this->m_uint16 = std::move(rhs.m_uint16);
-            break;
-
-        case ZVariantType::UInt32:
-            this->m_uint32 = std::move(rhs.m_uint32);
-            break;
-
-        case ZVariantType::UInt64:
-            this->m_uint64 = std::move(rhs.m_uint64);
-            break;
-
-        case ZVariantType::Float32:
-            this->m_float32 = std::move(rhs.m_float32);
-            break;
-
-        case ZVariantType::Float64:
-            this->m_float64 = std::move(rhs.m_float64);
-            break;
-
-        case ZVariantType::String:
-            this->m_string = std::move(rhs.m_string);
-            break;
-
-        case ZVariantType::List:
-            //this->m_list.clear();
-            //this->m_list.reserve(other.m_list.size());
-            this->m_list = std::move(rhs.m_list);
-            break;
-        case ZVariantType::Map:
-            //this->m_map.clear();
-            this->m_map = std::move(rhs.m_map);
-            break;
-        case ZVariantType::IntegerVariantMap:
-            //this->m_integerVariantMap.clear();
-            this->m_integerVariantMap = std::move(rhs.m_integerVariantMap);
-            break;
-        default:
-            m_variantType = ZVariantType::None;
-            break;
-        }
+ZVariant::ZVariant(const ZVariant &other):
+    m_variantType(ZVariantType::None)
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Copy, other.m_variantType);
 
-        rhs.makeInvalid();
-    }
+    this->copyPayload(other);
+}
+
+ZVariant::ZVariant(ZVariant &&rhs) noexcept:
+    m_uint64(rhs.m_uint64),
+    m_variantType(rhs.m_variantType)
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Move, rhs.m_variantType);
+
+    /* the payload slot is copied as a whole, so the heap payload now belongs to this object */
+    rhs.m_variantType = ZVariantType::None;
 }
 
 
 ZVariant::~ZVariant()
 {
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Destroy, this->m_variantType);
+    this->destroyPayload();
+}
 
-#ifdef ZYXCBA_DEBUG
-    std::cout<<"ZVariant::~ZVariant()"<<std::endl;
-#endif
-
-    if(this->m_variantType == ZVariantType::Map)
-    {
-        this->m_map.clear();
-    }
-    else if(this->m_variantType == ZVariantType::List){
-        this->m_list.clear();
-    }
-    else if(this->m_variantType == ZVariantType::IntegerVariantMap)
-    {
-        this->m_integerVariantMap.clear();
+void ZVariant::destroyPayload()
+{
+    switch (m_variantType) {
+    case ZVariantType::String:
+        deletePayload(this->m_string);
+        break;
+    case ZVariantType::List:
+        deletePayload(this->m_list);
+        break;
+    case ZVariantType::Map:
+        deletePayload(this->m_map);
+        break;
+    case ZVariantType::IntegerVariantMap:
+        deletePayload(this->m_integerVariantMap);
+        break;
+    case ZVariantType::HashMap:
+        deletePayload(this->m_hashMap);
+        break;
+    case ZVariantType::IntegerHashMap:
+        deletePayload(this->m_integerHashMap);
+        break;
+    case ZVariantType::Int32Array:
+        deletePayload(this->m_int32Array);
+        break;
+    case ZVariantType::Int64Array:
+        deletePayload(this->m_int64Array);
+        break;
+    case ZVariantType::UInt8Array:
+        deletePayload(this->m_uint8Array);
+        break;
+    case ZVariantType::Float32Array:
+        deletePayload(this->m_float32Array);
+        break;
+    case ZVariantType::Float64Array:
+        deletePayload(this->m_float64Array);
+        break;
+    default:
+        break;
     }
-    else if(this->m_variantType == ZVariantType::String)
-    {
-        this->m_string.clear();
+}
+
+void ZVariant::copyPayload(const ZVariant &other)
+{
+    switch (other.m_variantType) {
+    case ZVariantType::String:
+        this->m_string = newPayload<std::string>(ZVariantType::String, other.m_string->value);
+        break;
+    case ZVariantType::List:
+        this->m_list = newPayload<ZVariantList>(ZVariantType::List, other.m_list->value);
+        break;
+    case ZVariantType::Map:
+        this->m_map = newPayload<ZVariantMap>(ZVariantType::Map, other.m_map->value);
+        break;
+    case ZVariantType::IntegerVariantMap:
+        this->m_integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap, other.m_integerVariantMap->value);
+        break;
+    case ZVariantType::HashMap:
+        this->m_hashMap = newPayload<ZVariantHashMap>(ZVariantType::HashMap, other.m_hashMap->value);
+        break;
+    case ZVariantType::IntegerHashMap:
+        this->m_integerHashMap = newPayload<ZIntegerVariantHashMap>(ZVariantType::IntegerHashMap, other.m_integerHashMap->value);
+        break;
+    case ZVariantType::Int32Array:
+        this->m_int32Array = newPayload<ZInt32Array>(ZVariantType::Int32Array, other.m_int32Array->value);
+        break;
+    case ZVariantType::Int64Array:
+        this->m_int64Array = newPayload<ZInt64Array>(ZVariantType::Int64Array, other.m_int64Array->value);
+        break;
+    case ZVariantType::UInt8Array:
+        this->m_uint8Array = newPayload<ZUInt8Array>(ZVariantType::UInt8Array, other.m_uint8Array->value);
+        break;
+    case ZVariantType::Float32Array:
+        this->m_float32Array = newPayload<ZFloat32Array>(ZVariantType::Float32Array, other.m_float32Array->value);
+        break;
+    case ZVariantType::Float64Array:
+        this->m_float64Array = newPayload<ZFloat64Array>(ZVariantType::Float64Array, other.m_float64Array->value);
+        break;
+    default:
+        /* scalars share the slot, copying the widest member copies any of them */
+        this->m_uint64 = other.m_uint64;
+        break;
     }
+
+    this->m_variantType = other.m_variantType;
 }
 
 ZVariantType ZVariant::variantType() const
@@ -432,7 +496,12 @@ ZVariantType ZVariant::variantType() const
 
 std::string ZVariant::variantTypeString() const
 {
-    switch (m_variantType) {
+    return ZVariant::variantTypeName(this->m_variantType);
+}
+
+std::string ZVariant::variantTypeName(const ZVariantType &variantType)
+{
+    switch (variantType) {
     case ZVariantType::Bool:
         return std::string("Bool");
 
@@ -473,6 +542,21 @@ std::string ZVariant::variantTypeString() const
         return std::string("Map");
     case ZVariantType::IntegerVariantMap:
         return std::string("IntegerVariantMap");
+    case ZVariantType::HashMap:
+        return std::string("HashMap");
+    case ZVariantType::IntegerHashMap:
+        return std::string("IntegerHashMap");
+
+    case ZVariantType::Int32Array:
+        return std::string("Int32Array");
+    case ZVariantType::Int64Array:
+        return std::string("Int64Array");
+    case ZVariantType::UInt8Array:
+        return std::string("UInt8Array");
+    case ZVariantType::Float32Array:
+        return std::string("Float32Array");
+    case ZVariantType::Float64Array:
+        return std::string("Float64Array");
 
     default:
         return std::string("None");
@@ -583,36 +667,107 @@ bool ZVariant::isMap() const
     return this->m_variantType == ZVariantType::Map;
 }
 
+bool ZVariant::isHashMap() const
+{
+    return this->m_variantType == ZVariantType::HashMap;
+}
+
+bool ZVariant::isIntegerHashMap() const
+{
+    return this->m_variantType == ZVariantType::IntegerHashMap;
+}
+
+bool ZVariant::isArray() const
+{
+    return this->m_variantType >= ZVariantType::Int32Array && this->m_variantType <= ZVariantType::Float64Array;
+}
+
+bool ZVariant::isInt32Array() const
+{
+    return this->m_variantType == ZVariantType::Int32Array;
+}
+
+bool ZVariant::isInt64Array() const
+{
+    return this->m_variantType == ZVariantType::Int64Array;
+}
+
+bool ZVariant::isUInt8Array() const
+{
+    return this->m_variantType == ZVariantType::UInt8Array;
+}
+
+bool ZVariant::isFloat32Array() const
+{
+    return this->m_variantType == ZVariantType::Float32Array;
+}
+
+bool ZVariant::isFloat64Array() const
+{
+    return this->m_variantType == ZVariantType::Float64Array;
+}
+
 std::uint64_t ZVariant::mapLength() const
 {
-    if(this->isMap()) return this->m_map.size();
+    if(this->isMap()) return this->m_map->value.size();
     return 0;
 }
 
 std::uint64_t ZVariant::listLength() const
 {
-    if(this->isList()) return this->m_list.size();
+    if(this->isList()) return this->m_list->value.size();
     return 0;
 }
 
 std::uint64_t ZVariant::stringLength() const
 {
-    if(this->isString()) return this->m_string.size();
+    if(this->isString()) return this->m_string->value.size();
     return 0;
 }
 
 std::uint64_t ZVariant::intVarMapLength() const
 {
-    if(this->isIntegerVariantMap()) return this->m_integerVariantMap.size();
+    if(this->isIntegerVariantMap()) return this->m_integerVariantMap->value.size();
     return 0;
 }
 
 std::uint64_t ZVariant::integerVariantMapLength() const
 {
-    if(this->isIntegerVariantMap()) return this->m_integerVariantMap.size();
+    if(this->isIntegerVariantMap()) return this->m_integerVariantMap->value.size();
+    return 0;
+}
+
+std::uint64_t ZVariant::hashMapLength() const
+{
+    if(this->isHashMap()) return this->m_hashMap->value.size();
+    return 0;
+}
+
+std::uint64_t ZVariant::integerHashMapLength() const
+{
+    if(this->isIntegerHashMap()) return this->m_integerHashMap->value.size();
     return 0;
 }
 
+std::uint64_t ZVariant::arrayLength() const
+{
+    switch (m_variantType)
+    {
+    case ZVariantType::Int32Array:
+        return this->m_int32Array->value.size();
+    case ZVariantType::Int64Array:
+        return this->m_int64Array->value.size();
+    case ZVariantType::UInt8Array:
+        return this->m_uint8Array->value.size();
+    case ZVariantType::Float32Array:
+        return this->m_float32Array->value.size();
+    case ZVariantType::Float64Array:
+        return this->m_float64Array->value.size();
+    default:
+        return 0;
+    }
+}
+
 bool ZVariant::getBool() const
 {
     if(!this->isBool()) return false;
@@ -714,13 +869,23 @@ std::uint64_t ZVariant::getLength() const
     switch (m_variantType)
     {
     case ZVariantType::String:
-        return this->m_string.length();
+        return this->m_string->value.length();
     case ZVariantType::List:
-        return this->m_list.size();
+        return this->m_list->value.size();
     case ZVariantType::Map:
-        return this->m_map.size();
+        return this->m_map->value.size();
     case ZVariantType::IntegerVariantMap:
-        return this->m_integerVariantMap.size();
+        return this->m_integerVariantMap->value.size();
+    case ZVariantType::HashMap:
+        return this->m_hashMap->value.size();
+    case ZVariantType::IntegerHashMap:
+        return this->m_integerHashMap->value.size();
+    case ZVariantType::Int32Array:
+    case ZVariantType::Int64Array:
+    case ZVariantType::UInt8Array:
+    case ZVariantType::Float32Array:
+    case ZVariantType::Float64Array:
+        return this->arrayLength();
     default:
         return 0;
     }
@@ -728,193 +893,520 @@ std::uint64_t ZVariant::getLength() const
 
 const std::string &ZVariant::getString() const
 {
-    return this->m_string;
+    static const std::string empty;
+    if(!this->isString()) return empty;
+    return this->m_string->value;
 }
 
 const ZVariantList &ZVariant::getList() const
 {
-    return this->m_list;
+    static const ZVariantList empty;
+    if(!this->isList()) return empty;
+    return this->m_list->value;
 }
 
 const ZVariantMap &ZVariant::getMap() const
 {
-    return this->m_map;
+    static const ZVariantMap empty;
+    if(!this->isMap()) return empty;
+    return this->m_map->value;
 }
 
 const ZIntegerVariantMap &ZVariant::getIntVarMap() const
 {
-    return this->m_integerVariantMap;
+    return this->getIntegerVariantMap();
 }
 
 const ZIntegerVariantMap &ZVariant::getIntegerVariantMap() const
 {
-    return this->m_integerVariantMap;
+    static const ZIntegerVariantMap empty;
+    if(!this->isIntegerVariantMap()) return empty;
+    return this->m_integerVariantMap->value;
 }
 
-void ZVariant::makeInvalid()
+const ZVariantHashMap &ZVariant::getHashMap() const
 {
-    if(this->m_variantType == ZVariantType::String)
-    {
-        this->m_string.clear();
-    }
-    else if(this->m_variantType == ZVariantType::List)
-    {
-        this->m_list.clear();
-    }
-    else if(this->m_variantType == ZVariantType::Map)
-    {
-        this->m_map.clear();
-    }
-    else if(this->m_variantType == ZVariantType::IntegerVariantMap)
-    {
-        this->m_integerVariantMap.clear();
-    }
-    else
-    {
-        this->m_int8 = 0;
-    }
-
-    this->m_variantType = ZVariantType::None;
+    static const ZVariantHashMap empty;
+    if(!this->isHashMap()) return empty;
+    return this->m_hashMap->value;
 }
 
-void ZVariant::setBool(const bool &param)
+const ZIntegerVariantHashMap &ZVariant::getIntegerHashMap() const
 {
-    this->clear();
-    this->m_variantType = ZVariantType::Bool;
-    this->m_bool = param;
+    static const ZIntegerVariantHashMap empty;
+    if(!this->isIntegerHashMap()) return empty;
+    return this->m_integerHashMap->value;
 }
 
-void ZVariant::setInt8(const std::int8_t &param)
+const ZInt32Array &ZVariant::getInt32Array() const
 {
-    this->clear();
-    this->m_variantType = ZVariantType::Int8;
-    this->m_int8 = param;
+    static const ZInt32Array empty;
+    if(!this->isInt32Array()) return empty;
+    return this->m_int32Array->value;
 }
 
-void ZVariant::setInt16(const std::int16_t &param)
+const ZInt64Array &ZVariant::getInt64Array() const
 {
-    this->clear();
-    this->m_variantType = ZVariantType::Int16;
-    this->m_int16 = param;
+    static const ZInt64Array empty;
+    if(!this->isInt64Array()) return empty;
+    return this->m_int64Array->value;
 }
 
-void ZVariant::setInt32(const std::int32_t &param)
+const ZUInt8Array &ZVariant::getUInt8Array() const
 {
-    this->clear();
-    this->m_variantType = ZVariantType::Int32;
-    this->m_int32 = param;
+    static const ZUInt8Array empty;
+    if(!this->isUInt8Array()) return empty;
+    return this->m_uint8Array->value;
 }
 
-void ZVariant::setInt64(const std::int64_t &param)
+const ZFloat32Array &ZVariant::getFloat32Array() const
 {
-    this->clear();
-    this->m_variantType = ZVariantType::Int64;
-    this->m_int64 = param;
+    static const ZFloat32Array empty;
+    if(!this->isFloat32Array()) return empty;
+    return this->m_float32Array->value;
+}
+
+const ZFloat64Array &ZVariant::getFloat64Array() const
+{
+    static const ZFloat64Array empty;
+    if(!this->isFloat64Array()) return empty;
+    return this->m_float64Array->value;
+}
+
+const void *ZVariant::arrayData() const
+{
+    switch (m_variantType)
+    {
+    case ZVariantType::Int32Array:
+        return this->m_int32Array->value.data();
+    case ZVariantType::Int64Array:
+        return this->m_int64Array->value.data();
+    case ZVariantType::UInt8Array:
+        return this->m_uint8Array->value.data();
+    case ZVariantType::Float32Array:
+        return this->m_float32Array->value.data();
+    case ZVariantType::Float64Array:
+        return this->m_float64Array->value.data();
+    default:
+        return nullptr;
+    }
+}
+
+ZVariantType ZVariant::arrayElementType(const ZVariantType &arrayType)
+{
+    switch (arrayType)
+    {
+    case ZVariantType::Int32Array:
+        return ZVariantType::Int32;
+    case ZVariantType::Int64Array:
+        return ZVariantType::Int64;
+    case ZVariantType::UInt8Array:
+        return ZVariantType::UInt8;
+    case ZVariantType::Float32Array:
+        return ZVariantType::Float32;
+    case ZVariantType::Float64Array:
+        return ZVariantType::Float64;
+    default:
+        return ZVariantType::None;
+    }
+}
+
+std::size_t ZVariant::arrayElementSize(const ZVariantType &arrayType)
+{
+    switch (arrayType)
+    {
+    case ZVariantType::Int32Array:
+    case ZVariantType::Float32Array:
+        return 4;
+    case ZVariantType::Int64Array:
+    case ZVariantType::Float64Array:
+        return 8;
+    case ZVariantType::UInt8Array:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+void ZVariant::makeInvalid()
+{
+    this->destroyPayload();
+    this->m_uint64 = 0;
+    this->m_variantType = ZVariantType::None;
+}
+
+void ZVariant::setBool(const bool &param)
+{
+    this->destroyPayload();
+    this->m_variantType = ZVariantType::Bool;
+    this->m_bool = param;
+}
+
+void ZVariant::setInt8(const std::int8_t &param)
+{
+    this->destroyPayload();
+    this->m_variantType = ZVariantType::Int8;
+    this->m_int8 = param;
+}
+
+void ZVariant::setInt16(const std::int16_t &param)
+{
+    this->destroyPayload();
+    this->m_variantType = ZVariantType::Int16;
+    this->m_int16 = param;
+}
+
+void ZVariant::setInt32(const std::int32_t &param)
+{
+    this->destroyPayload();
+    this->m_variantType = ZVariantType::Int32;
+    this->m_int32 = param;
+}
+
+void ZVariant::setInt64(const std::int64_t &param)
+{
+    this->destroyPayload();
+    this->m_variantType = ZVariantType::Int64;
+    this->m_int64 = param;
 }
 
 void ZVariant::setUInt8(const std::uint8_t &param)
 {
-    this->clear();
+    this->destroyPayload();
     this->m_variantType = ZVariantType::UInt8;
     this->m_uint8 = param;
 }
 
 void ZVariant::setUInt16(const std::uint16_t &param)
 {
-    this->clear();
+    this->destroyPayload();
     this->m_variantType = ZVariantType::UInt16;
     this->m_uint16 = param;
 }
 
 void ZVariant::setUInt32(const std::uint32_t &param)
 {
-    this->clear();
+    this->destroyPayload();
     this->m_variantType = ZVariantType::UInt32;
     this->m_uint32 = param;
 }
 
 void ZVariant::setUInt64(const std::uint64_t &param)
 {
-    this->clear();
+    this->destroyPayload();
     this->m_variantType = ZVariantType::UInt64;
     this->m_uint64 = param;
 }
 
 void ZVariant::setFloat32(const zfloat32 &param)
 {
-    this->clear();
+    this->destroyPayload();
     this->m_variantType = ZVariantType::Float32;
     this->m_float32 = param;
 }
 
 void ZVariant::setFloat64(const zfloat64 &param)
 {
-    this->clear();
+    this->destroyPayload();
     this->m_variantType = ZVariantType::Float64;
     this->m_float64 = param;
 }
 
 void ZVariant::setString(const std::string &param)
 {
+    if(this->isString())
+    {
+        this->m_string->mutate().assign(param);
+        return;
+    }
+
+    this->destroyPayload();
+    this->m_string = newPayload<std::string>(ZVariantType::String, param);
+    this->m_variantType = ZVariantType::String;
+}
+
+void ZVariant::setString(std::string &&param)
+{
+    if(this->isString())
+    {
+        this->m_string->mutate() = std::move(param);
+        return;
+    }
+
+    this->destroyPayload();
+    this->m_string = newPayload<std::string>(ZVariantType::String, std::move(param));
     this->m_variantType = ZVariantType::String;
-    this->m_string = param;
-    this->m_int8 = 0;
 }
 
 void ZVariant::setList()
 {
+    if(this->isList())
+    {
+        this->m_list->mutate().clear();
+        return;
+    }
+
+    this->destroyPayload();
+    this->m_list = newPayload<ZVariantList>(ZVariantType::List);
     this->m_variantType = ZVariantType::List;
-    this->m_list.clear();
-    this->m_int8 = 0;
 }
 
 void ZVariant::setList(const ZVariantList &param)
 {
+    if(this->isList())
+    {
+        this->m_list->mutate() = param;
+        return;
+    }
+
+    this->destroyPayload();
+    this->m_list = newPayload<ZVariantList>(ZVariantType::List, param);
     this->m_variantType = ZVariantType::List;
-    this->m_list.clear();
-    this->m_int8 = 0;
+}
 
-    std::copy(param.begin(), param.end(), back_inserter(this->m_list));
+void ZVariant::setList(ZVariantList &&param)
+{
+    /* param may be our own list, so build the new payload before releasing the old one */
+    ZVariantPayload<ZVariantList> *list = newPayload<ZVariantList>(ZVariantType::List, std::move(param));
+    this->destroyPayload();
+    this->m_list = list;
+    this->m_variantType = ZVariantType::List;
 }
 
 void ZVariant::setMap()
 {
+    if(this->isMap())
+    {
+        this->m_map->mutate().clear();
+        return;
+    }
+
+    this->destroyPayload();
+    this->m_map = newPayload<ZVariantMap>(ZVariantType::Map);
     this->m_variantType = ZVariantType::Map;
-    this->m_map.clear();
-    this->m_int8 = 0;
 }
 
 void ZVariant::setMap(const ZVariantMap &param)
 {
+    if(this->isMap())
+    {
+        this->m_map->mutate() = param;
+        return;
+    }
+
+    this->destroyPayload();
+    this->m_map = newPayload<ZVariantMap>(ZVariantType::Map, param);
     this->m_variantType = ZVariantType::Map;
-    this->m_map.clear();
-    this->m_int8 = 0;
+}
 
-    this->m_map.insert(param.begin(),param.end());
+void ZVariant::setMap(ZVariantMap &&param)
+{
+    ZVariantPayload<ZVariantMap> *map = newPayload<ZVariantMap>(ZVariantType::Map, std::move(param));
+    this->destroyPayload();
+    this->m_map = map;
+    this->m_variantType = ZVariantType::Map;
 }
 
 void ZVariant::setIntVarMap()
 {
+    if(this->isIntegerVariantMap())
+    {
+        this->m_integerVariantMap->mutate().clear();
+        return;
+    }
+
+    this->destroyPayload();
+    this->m_integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap);
     this->m_variantType = ZVariantType::IntegerVariantMap;
-    this->m_integerVariantMap.clear();
-    this->m_int8 = 0;
 }
 
 void ZVariant::setIntVarMap(const ZIntegerVariantMap &param)
 {
-    this->m_variantType = ZVariantType::IntegerVariantMap;
-    this->m_integerVariantMap.clear();
-    this->m_int8 = 0;
-    this->m_integerVariantMap.insert(param.begin(),param.end());
+    this->setIntegerVariantMap(param);
 }
 
 void ZVariant::setIntegerVariantMap(const ZIntegerVariantMap &param)
 {
+    if(this->isIntegerVariantMap())
+    {
+        this->m_integerVariantMap->mutate() = param;
+        return;
+    }
+
+    this->destroyPayload();
+    this->m_integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap, param);
+    this->m_variantType = ZVariantType::IntegerVariantMap;
+}
+
+void ZVariant::setIntegerVariantMap(ZIntegerVariantMap &&param)
+{
+    ZVariantPayload<ZIntegerVariantMap> *integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap, std::move(param));
+    this->destroyPayload();
+    this->m_integerVariantMap = integerVariantMap;
     this->m_variantType = ZVariantType::IntegerVariantMap;
-    this->m_integerVariantMap.clear();
-    this->m_int8 = 0;
+}
+
+void ZVariant::setHashMap()
+{
+    if(this->isHashMap())
+    {
+        this->m_hashMap->mutate().clear();
+        return;
+    }
 
-    this->m_integerVariantMap.insert(param.begin(),param.end());
+    this->destroyPayload();
+    this->m_hashMap = newPayload<ZVariantHashMap>(ZVariantType::HashMap);
+    this->m_variantType = ZVariantType::HashMap;
+}
+
+void ZVariant::setHashMap(const ZVariantHashMap &param)
+{
+    ZVariantPayload<ZVariantHashMap> *hashMap = newPayload<ZVariantHashMap>(ZVariantType::HashMap, param);
+    this->destroyPayload();
+    this->m_hashMap = hashMap;
+    this->m_variantType = ZVariantType::HashMap;
+}
+
+void ZVariant::setHashMap(ZVariantHashMap &&param)
+{
+    ZVariantPayload<ZVariantHashMap> *hashMap = newPayload<ZVariantHashMap>(ZVariantType::HashMap, std::move(param));
+    this->destroyPayload();
+    this->m_hashMap = hashMap;
+    this->m_variantType = ZVariantType::HashMap;
+}
+
+void ZVariant::setIntegerHashMap()
+{
+    if(this->isIntegerHashMap())
+    {
+        this->m_integerHashMap->mutate().clear();
+        return;
+    }
+
+    this->destroyPayload();
+    this->m_integerHashMap = newPayload<ZIntegerVariantHashMap>(ZVariantType::IntegerHashMap);
+    this->m_variantType = ZVariantType::IntegerHashMap;
+}
+
+void ZVariant::setIntegerHashMap(const ZIntegerVariantHashMap &param)
+{
+    ZVariantPayload<ZIntegerVariantHashMap> *integerHashMap = newPayload<ZIntegerVariantHashMap>(ZVariantType::IntegerHashMap, param);
+    this->destroyPayload();
+    this->m_integerHashMap = integerHashMap;
+    this->m_variantType = ZVariantType::IntegerHashMap;
+}
+
+void ZVariant::setIntegerHashMap(ZIntegerVariantHashMap &&param)
+{
+    ZVariantPayload<ZIntegerVariantHashMap> *integerHashMap = newPayload<ZIntegerVariantHashMap>(ZVariantType::IntegerHashMap, std::move(param));
+    this->destroyPayload();
+    this->m_integerHashMap = integerHashMap;
+    this->m_variantType = ZVariantType::IntegerHashMap;
+}
+
+void ZVariant::setInt32Array()
+{
+    if(this->isInt32Array())
+    {
+        this->m_int32Array->mutate().clear();
+        return;
+    }
+
+    this->setArray<std::int32_t>();
+}
+
+void ZVariant::setInt32Array(const ZInt32Array &param)
+{
+    this->setArray<std::int32_t>(param);
+}
+
+void ZVariant::setInt32Array(ZInt32Array &&param)
+{
+    this->setArray<std::int32_t>(std::move(param));
+}
+
+void ZVariant::setInt64Array()
+{
+    if(this->isInt64Array())
+    {
+        this->m_int64Array->mutate().clear();
+        return;
+    }
+
+    this->setArray<std::int64_t>();
+}
+
+void ZVariant::setInt64Array(const ZInt64Array &param)
+{
+    this->setArray<std::int64_t>(param);
+}
+
+void ZVariant::setInt64Array(ZInt64Array &&param)
+{
+    this->setArray<std::int64_t>(std::move(param));
+}
+
+void ZVariant::setUInt8Array()
+{
+    if(this->isUInt8Array())
+    {
+        this->m_uint8Array->mutate().clear();
+        return;
+    }
+
+    this->setArray<std::uint8_t>();
+}
+
+void ZVariant::setUInt8Array(const ZUInt8Array &param)
+{
+    this->setArray<std::uint8_t>(param);
+}
+
+void ZVariant::setUInt8Array(ZUInt8Array &&param)
+{
+    this->setArray<std::uint8_t>(std::move(param));
+}
+
+void ZVariant::setFloat32Array()
+{
+    if(this->isFloat32Array())
+    {
+        this->m_float32Array->mutate().clear();
+        return;
+    }
+
+    this->setArray<zfloat32>();
+}
+
+void ZVariant::setFloat32Array(const ZFloat32Array &param)
+{
+    this->setArray<zfloat32>(param);
+}
+
+void ZVariant::setFloat32Array(ZFloat32Array &&param)
+{
+    this->setArray<zfloat32>(std::move(param));
+}
+
+void ZVariant::setFloat64Array()
+{
+    if(this->isFloat64Array())
+    {
+        this->m_float64Array->mutate().clear();
+        return;
+    }
+
+    this->setArray<zfloat64>();
+}
+
+void ZVariant::setFloat64Array(const ZFloat64Array &param)
+{
+    this->setArray<zfloat64>(param);
+}
+
+void ZVariant::setFloat64Array(ZFloat64Array &&param)
+{
+    this->setArray<zfloat64>(std::move(param));
 }
 
 void ZVariant::setValue(const bool &param)
@@ -992,21 +1484,140 @@ void ZVariant::setValue(const ZIntegerVariantMap &param)
     return this->setIntegerVariantMap(param);
 }
 
+void ZVariant::setValue(const ZVariantHashMap &param)
+{
+    this->setHashMap(param);
+}
+
+void ZVariant::setValue(const ZIntegerVariantHashMap &param)
+{
+    this->setIntegerHashMap(param);
+}
+
+void ZVariant::setValue(const ZInt32Array &param)
+{
+    this->setInt32Array(param);
+}
+
+void ZVariant::setValue(const ZInt64Array &param)
+{
+    this->setInt64Array(param);
+}
+
+void ZVariant::setValue(const ZUInt8Array &param)
+{
+    this->setUInt8Array(param);
+}
+
+void ZVariant::setValue(const ZFloat32Array &param)
+{
+    this->setFloat32Array(param);
+}
+
+void ZVariant::setValue(const ZFloat64Array &param)
+{
+    this->setFloat64Array(param);
+}
+
 void ZVariant::reserveList(const std::uint64_t &length)
 {
-    this->m_list.reserve(length);
+    if(this->m_variantType == ZVariantType::None)
+    {
+        this->m_list = newPayload<ZVariantList>(ZVariantType::List);
+        this->m_variantType = ZVariantType::List;
+    }
+
+    switch (m_variantType)
+    {
+    case ZVariantType::List:
+        this->m_list->value.reserve(length);
+        break;
+    case ZVariantType::Int32Array:
+        this->m_int32Array->value.reserve(length);
+        break;
+    case ZVariantType::Int64Array:
+        this->m_int64Array->value.reserve(length);
+        break;
+    case ZVariantType::UInt8Array:
+        this->m_uint8Array->value.reserve(length);
+        break;
+    case ZVariantType::Float32Array:
+        this->m_float32Array->value.reserve(length);
+        break;
+    case ZVariantType::Float64Array:
+        this->m_float64Array->value.reserve(length);
+        break;
+    default:
+        break;
+    }
+}
+
+void ZVariant::reserveHashMap(const std::uint64_t &length)
+{
+    if(this->m_variantType == ZVariantType::None)
+    {
+        this->m_hashMap = newPayload<ZVariantHashMap>(ZVariantType::HashMap);
+        this->m_variantType = ZVariantType::HashMap;
+    }
+
+    if(this->isHashMap()) this->m_hashMap->value.reserve(length);
+}
+
+void ZVariant::reserveIntegerHashMap(const std::uint64_t &length)
+{
+    if(this->m_variantType == ZVariantType::None)
+    {
+        this->m_integerHashMap = newPayload<ZIntegerVariantHashMap>(ZVariantType::IntegerHashMap);
+        this->m_variantType = ZVariantType::IntegerHashMap;
+    }
+
+    if(this->isIntegerHashMap()) this->m_integerHashMap->value.reserve(length);
 }
 
 bool ZVariant::addToList(const ZVariant &value)
 {
+    if(this->isArray())
+    {
+        /* a value of the element type stays packed, anything else turns the array into a list */
+        if(this->addVariantToArray(value)) return true;
+        this->convertToList();
+    }
+
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_list = newPayload<ZVariantList>(ZVariantType::List);
         this->m_variantType = ZVariantType::List;
     }
 
     if(this->m_variantType == ZVariantType::List)
     {
-        this->m_list.push_back(value);
+        this->m_list->mutate().push_back(value);
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+bool ZVariant::addToList(ZVariant &&value)
+{
+    if(this->isArray())
+    {
+        /* a value of the element type stays packed, anything else turns the array into a list */
+        if(this->addVariantToArray(value)) return true;
+        this->convertToList();
+    }
+
+    if(this->m_variantType == ZVariantType::None)
+    {
+        this->m_list = newPayload<ZVariantList>(ZVariantType::List);
+        this->m_variantType = ZVariantType::List;
+    }
+
+    if(this->m_variantType == ZVariantType::List)
+    {
+        this->m_list->mutate().push_back(std::move(value));
         return true;
     }
     else
@@ -1017,19 +1628,182 @@ bool ZVariant::addToList(const ZVariant &value)
 
 void ZVariant::clearList()
 {
-    this->m_list.clear();
+    if(this->isList()) this->m_list->mutate().clear();
+}
+
+bool ZVariant::addToArray(const std::int32_t &value)
+{
+    return this->pushArrayElement(value);
+}
+
+bool ZVariant::addToArray(const std::int64_t &value)
+{
+    return this->pushArrayElement(value);
+}
+
+bool ZVariant::addToArray(const std::uint8_t &value)
+{
+    return this->pushArrayElement(value);
+}
+
+bool ZVariant::addToArray(const zfloat32 &value)
+{
+    return this->pushArrayElement(value);
+}
+
+bool ZVariant::addToArray(const zfloat64 &value)
+{
+    return this->pushArrayElement(value);
+}
+
+bool ZVariant::appendToArray(const std::int32_t *values, const std::uint64_t &count)
+{
+    return this->appendArray(values, count);
+}
+
+bool ZVariant::appendToArray(const std::int64_t *values, const std::uint64_t &count)
+{
+    return this->appendArray(values, count);
+}
+
+bool ZVariant::appendToArray(const std::uint8_t *values, const std::uint64_t &count)
+{
+    return this->appendArray(values, count);
+}
+
+bool ZVariant::appendToArray(const zfloat32 *values, const std::uint64_t &count)
+{
+    return this->appendArray(values, count);
+}
+
+bool ZVariant::appendToArray(const zfloat64 *values, const std::uint64_t &count)
+{
+    return this->appendArray(values, count);
+}
+
+namespace {
+
+template<typename T>
+void appendElements(ZVariantList &list, const ZVector<T> &array)
+{
+    list.reserve(array.size());
+    for(const T &value : array) list.emplace_back(value);
+}
+
+}
+
+void ZVariant::convertToList()
+{
+    if(!this->isArray()) return;
+
+    ZVariantPayload<ZVariantList> *list = newPayload<ZVariantList>(ZVariantType::List);
+    switch (m_variantType)
+    {
+    case ZVariantType::Int32Array:
+        appendElements(list->value, this->m_int32Array->value);
+        break;
+    case ZVariantType::Int64Array:
+        appendElements(list->value, this->m_int64Array->value);
+        break;
+    case ZVariantType::UInt8Array:
+        appendElements(list->value, this->m_uint8Array->value);
+        break;
+    case ZVariantType::Float32Array:
+        appendElements(list->value, this->m_float32Array->value);
+        break;
+    default:
+        appendElements(list->value, this->m_float64Array->value);
+        break;
+    }
+
+    this->destroyPayload();
+    this->m_list = list;
+    this->m_variantType = ZVariantType::List;
+}
+
+template<typename T, typename... Args>
+void ZVariant::setArray(Args&&... args)
+{
+    const ZVariantType arrayType = ZArrayVariantType<T>::type();
+    ZVariantPayload<ZVector<T> > *array = newPayload<ZVector<T> >(arrayType, std::forward<Args>(args)...);
+    this->destroyPayload();
+    this->arrayPayload<T>() = array;
+    this->m_variantType = arrayType;
+}
+
+/* a None variant becomes a typed array on its first element */
+template<typename T>
+bool ZVariant::pushArrayElement(const T &value)
+{
+    const ZVariantType arrayType = ZArrayVariantType<T>::type();
+    if(this->m_variantType == ZVariantType::None) this->setArray<T>();
+    if(this->m_variantType != arrayType) return false;
+
+    this->arrayPayload<T>()->mutate().push_back(value);
+    return true;
+}
+
+/* only an existing array of the element type stays packed, lists are never promoted */
+template<typename T>
+bool ZVariant::addPackedToList(const T &value)
+{
+    if(this->m_variantType == ZArrayVariantType<T>::type()) return this->pushArrayElement(value);
+    return this->addToList(ZVariant(value));
+}
+
+template<typename T>
+bool ZVariant::appendArray(const T *values, const std::uint64_t &count)
+{
+    const ZVariantType arrayType = ZArrayVariantType<T>::type();
+    if(this->m_variantType == ZVariantType::None) this->setArray<T>();
+    if(this->m_variantType != arrayType) return false;
+
+    ZVector<T> &array = this->arrayPayload<T>()->mutate();
+    const std::size_t size = array.size();
+
+    /* the values may be our own elements, find them again after growing */
+    const std::less<const T*> before;
+    const bool aliased = !before(values, array.data()) && before(values, array.data() + size);
+    const std::size_t aliasOffset = aliased ? static_cast<std::size_t>(values - array.data()) : 0;
+
+    array.resize(size + static_cast<std::size_t>(count));
+    if(aliased) values = array.data() + aliasOffset;
+    if(count > 0) std::memcpy(array.data() + size, values, static_cast<std::size_t>(count) * sizeof(T));
+    return true;
+}
+
+bool ZVariant::addVariantToArray(const ZVariant &value)
+{
+    if(arrayElementType(this->m_variantType) != value.m_variantType) return false;
+
+    switch (m_variantType)
+    {
+    case ZVariantType::Int32Array:
+        return this->pushArrayElement(value.m_int32);
+    case ZVariantType::Int64Array:
+        return this->pushArrayElement(value.m_int64);
+    case ZVariantType::UInt8Array:
+        return this->pushArrayElement(value.m_uint8);
+    case ZVariantType::Float32Array:
+        return this->pushArrayElement(value.m_float32);
+    case ZVariantType::Float64Array:
+        return this->pushArrayElement(value.m_float64);
+    default:
+        return false;
+    }
 }
 
 bool ZVariant::addToIntVarMap(const std::uint64_t &key, const bool &value)
 {
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap);
         this->m_variantType = ZVariantType::IntegerVariantMap;
     }
 
     if(this->m_variantType == ZVariantType::IntegerVariantMap)
     {
-        this->m_integerVariantMap.emplace(key,value);
+        this->m_integerVariantMap->mutate().emplace(key,value);
         //this->m_integerVariantMap.insert(std::pair<std::uint64_t,ZVariant>(key,value));
         return true;
     }
@@ -1043,12 +1817,13 @@ bool ZVariant::addToIntVarMap(const std::uint64_t &key, const std::int8_t &value
 {
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap);
         this->m_variantType = ZVariantType::IntegerVariantMap;
     }
 
     if(this->m_variantType == ZVariantType::IntegerVariantMap)
     {
-        this->m_integerVariantMap.emplace(key,value);
+        this->m_integerVariantMap->mutate().emplace(key,value);
         //this->m_integerVariantMap.insert(std::pair<std::uint64_t,ZVariant>(key,value));
         return true;
     }
@@ -1062,12 +1837,13 @@ bool ZVariant::addToIntVarMap(const std::uint64_t &key, const std::int16_t &valu
 {
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap);
         this->m_variantType = ZVariantType::IntegerVariantMap;
     }
 
     if(this->m_variantType == ZVariantType::IntegerVariantMap)
     {
-        this->m_integerVariantMap.emplace(key,value);
+        this->m_integerVariantMap->mutate().emplace(key,value);
         //this->m_integerVariantMap.insert(std::pair<std::uint64_t,ZVariant>(key,value));
         return true;
     }
@@ -1081,12 +1857,13 @@ bool ZVariant::addToIntVarMap(const std::uint64_t &key, const std::int32_t &valu
 {
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap);
         this->m_variantType = ZVariantType::IntegerVariantMap;
     }
 
     if(this->m_variantType == ZVariantType::IntegerVariantMap)
     {
-        this->m_integerVariantMap.emplace(key,value);
+        this->m_integerVariantMap->mutate().emplace(key,value);
         //this->m_integerVariantMap.insert(std::pair<std::uint64_t,ZVariant>(key,value));
         return true;
     }
@@ -1100,12 +1877,13 @@ bool ZVariant::addToIntVarMap(const std::uint64_t &key, const std::int64_t &valu
 {
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap);
         this->m_variantType = ZVariantType::IntegerVariantMap;
     }
 
     if(this->m_variantType == ZVariantType::IntegerVariantMap)
     {
-        this->m_integerVariantMap.emplace(key,value);
+        this->m_integerVariantMap->mutate().emplace(key,value);
         //this->m_integerVariantMap.insert(std::pair<std::uint64_t,ZVariant>(key,value));
         return true;
     }
@@ -1119,12 +1897,13 @@ bool ZVariant::addToIntVarMap(const std::uint64_t &key, const std::uint8_t &valu
 {
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap);
         this->m_variantType = ZVariantType::IntegerVariantMap;
     }
 
     if(this->m_variantType == ZVariantType::IntegerVariantMap)
     {
-        this->m_integerVariantMap.emplace(key,value);
+        this->m_integerVariantMap->mutate().emplace(key,value);
         //this->m_integerVariantMap.insert(std::pair<std::uint64_t,ZVariant>(key,value));
         return true;
     }
@@ -1138,12 +1917,13 @@ bool ZVariant::addToIntVarMap(const std::uint64_t &key, const std::uint16_t &val
 {
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap);
         this->m_variantType = ZVariantType::IntegerVariantMap;
     }
 
     if(this->m_variantType == ZVariantType::IntegerVariantMap)
     {
-        this->m_integerVariantMap.emplace(key,value);
+        this->m_integerVariantMap->mutate().emplace(key,value);
         //this->m_integerVariantMap.insert(std::pair<std::uint64_t,ZVariant>(key,value));
         return true;
     }
@@ -1157,12 +1937,13 @@ bool ZVariant::addToIntVarMap(const std::uint64_t &key, const std::uint32_t &val
 {
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap);
         this->m_variantType = ZVariantType::IntegerVariantMap;
     }
 
     if(this->m_variantType == ZVariantType::IntegerVariantMap)
     {
-        this->m_integerVariantMap.emplace(key,value);
+        this->m_integerVariantMap->mutate().emplace(key,value);
         //this->m_integerVariantMap.insert(std::pair<std::uint64_t,ZVariant>(key,value));
         return true;
     }
@@ -1176,12 +1957,13 @@ bool ZVariant::addToIntVarMap(const std::uint64_t &key, const std::uint64_t &val
 {
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap);
         this->m_variantType = ZVariantType::IntegerVariantMap;
     }
 
     if(this->m_variantType == ZVariantType::IntegerVariantMap)
     {
-        this->m_integerVariantMap.emplace(key,value);
+        this->m_integerVariantMap->mutate().emplace(key,value);
         //this->m_integerVariantMap.insert(std::pair<std::uint64_t,ZVariant>(key,value));
         return true;
     }
@@ -1195,12 +1977,13 @@ bool ZVariant::addToIntVarMap(const std::uint64_t &key, const zfloat32 &value)
 {
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap);
         this->m_variantType = ZVariantType::IntegerVariantMap;
     }
 
     if(this->m_variantType == ZVariantType::IntegerVariantMap)
     {
-        this->m_integerVariantMap.emplace(key,value);
+        this->m_integerVariantMap->mutate().emplace(key,value);
         //this->m_integerVariantMap.insert(std::pair<std::uint64_t,ZVariant>(key,value));
         return true;
     }
@@ -1214,12 +1997,13 @@ bool ZVariant::addToIntVarMap(const std::uint64_t &key, const zfloat64 &value)
 {
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap);
         this->m_variantType = ZVariantType::IntegerVariantMap;
     }
 
     if(this->m_variantType == ZVariantType::IntegerVariantMap)
     {
-        this->m_integerVariantMap.emplace(key,value);
+        this->m_integerVariantMap->mutate().emplace(key,value);
         //this->m_integerVariantMap.insert(std::pair<std::uint64_t,ZVariant>(key,value));
         return true;
     }
@@ -1233,12 +2017,13 @@ bool ZVariant::addToIntVarMap(const std::uint64_t &key, const std::string &value
 {
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap);
         this->m_variantType = ZVariantType::IntegerVariantMap;
     }
 
     if(this->m_variantType == ZVariantType::IntegerVariantMap)
     {
-        this->m_integerVariantMap.emplace(key,value);
+        this->m_integerVariantMap->mutate().emplace(key,value);
         //this->m_integerVariantMap.insert(std::pair<std::uint64_t,ZVariant>(key,value));
         return true;
     }
@@ -1252,12 +2037,13 @@ bool ZVariant::addToIntVarMap(const std::uint64_t &key, const char *value)
 {
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap);
         this->m_variantType = ZVariantType::IntegerVariantMap;
     }
 
     if(this->m_variantType == ZVariantType::IntegerVariantMap)
     {
-        this->m_integerVariantMap.emplace(key,value);
+        this->m_integerVariantMap->mutate().emplace(key,value);
         //this->m_integerVariantMap.insert(std::pair<std::uint64_t,ZVariant>(key,value));
         return true;
     }
@@ -1269,14 +2055,17 @@ bool ZVariant::addToIntVarMap(const std::uint64_t &key, const char *value)
 
 bool ZVariant::addToList(const bool &value)
 {
+    if(this->isArray()) this->convertToList();
+
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_list = newPayload<ZVariantList>(ZVariantType::List);
         this->m_variantType = ZVariantType::List;
     }
 
     if(this->m_variantType == ZVariantType::List)
     {
-        this->m_list.emplace_back(value);
+        this->m_list->mutate().emplace_back(value);
         return true;
     }
     else
@@ -1287,14 +2076,17 @@ bool ZVariant::addToList(const bool &value)
 
 bool ZVariant::addToList(const std::int8_t &value)
 {
+    if(this->isArray()) this->convertToList();
+
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_list = newPayload<ZVariantList>(ZVariantType::List);
         this->m_variantType = ZVariantType::List;
     }
 
     if(this->m_variantType == ZVariantType::List)
     {
-        this->m_list.emplace_back(value);
+        this->m_list->mutate().emplace_back(value);
         return true;
     }
     else
@@ -1305,14 +2097,17 @@ bool ZVariant::addToList(const std::int8_t &value)
 
 bool ZVariant::addToList(const std::int16_t &value)
 {
+    if(this->isArray()) this->convertToList();
+
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_list = newPayload<ZVariantList>(ZVariantType::List);
         this->m_variantType = ZVariantType::List;
     }
 
     if(this->m_variantType == ZVariantType::List)
     {
-        this->m_list.emplace_back(value);
+        this->m_list->mutate().emplace_back(value);
         return true;
     }
     else
@@ -1323,68 +2118,32 @@ bool ZVariant::addToList(const std::int16_t &value)
 
 bool ZVariant::addToList(const std::int32_t &value)
 {
-    if(this->m_variantType == ZVariantType::None)
-    {
-        this->m_variantType = ZVariantType::List;
-    }
-
-    if(this->m_variantType == ZVariantType::List)
-    {
-        this->m_list.emplace_back(value);
-        return true;
-    }
-    else
-    {
-        return false;
-    }
+    return this->addPackedToList(value);
 }
 
 bool ZVariant::addToList(const std::int64_t &value)
 {
-    if(this->m_variantType == ZVariantType::None)
-    {
-        this->m_variantType = ZVariantType::List;
-    }
-
-    if(this->m_variantType == ZVariantType::List)
-    {
-        this->m_list.emplace_back(value);
-        return true;
-    }
-    else
-    {
-        return false;
-    }
+    return this->addPackedToList(value);
 }
 
 bool ZVariant::addToList(const std::uint8_t &value)
 {
-    if(this->m_variantType == ZVariantType::None)
-    {
-        this->m_variantType = ZVariantType::List;
-    }
-
-    if(this->m_variantType == ZVariantType::List)
-    {
-        this->m_list.emplace_back(value);
-        return true;
-    }
-    else
-    {
-        return false;
-    }
+    return this->addPackedToList(value);
 }
 
 bool ZVariant::addToList(const std::uint16_t &value)
 {
+    if(this->isArray()) this->convertToList();
+
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_list = newPayload<ZVariantList>(ZVariantType::List);
         this->m_variantType = ZVariantType::List;
     }
 
     if(this->m_variantType == ZVariantType::List)
     {
-        this->m_list.emplace_back(value);
+        this->m_list->mutate().emplace_back(value);
         return true;
     }
     else
@@ -1395,14 +2154,17 @@ bool ZVariant::addToList(const std::uint16_t &value)
 
 bool ZVariant::addToList(const std::uint32_t &value)
 {
+    if(this->isArray()) this->convertToList();
+
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_list = newPayload<ZVariantList>(ZVariantType::List);
         this->m_variantType = ZVariantType::List;
     }
 
     if(this->m_variantType == ZVariantType::List)
     {
-        this->m_list.emplace_back(value);
+        this->m_list->mutate().emplace_back(value);
         return true;
     }
     else
@@ -1413,14 +2175,17 @@ bool ZVariant::addToList(const std::uint32_t &value)
 
 bool ZVariant::addToList(const std::uint64_t &value)
 {
+    if(this->isArray()) this->convertToList();
+
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_list = newPayload<ZVariantList>(ZVariantType::List);
         this->m_variantType = ZVariantType::List;
     }
 
     if(this->m_variantType == ZVariantType::List)
     {
-        this->m_list.emplace_back(value);
+        this->m_list->mutate().emplace_back(value);
         return true;
     }
     else
@@ -1431,32 +2196,27 @@ bool ZVariant::addToList(const std::uint64_t &value)
 
 bool ZVariant::addToList(const zfloat32 &value)
 {
-    if(this->m_variantType == ZVariantType::None)
-    {
-        this->m_variantType = ZVariantType::List;
-    }
-
-    if(this->m_variantType == ZVariantType::List)
-    {
-        this->m_list.emplace_back(value);
-        return true;
-    }
-    else
-    {
-        return false;
-    }
+    return this->addPackedToList(value);
 }
 
 bool ZVariant::addToList(const zfloat64 &value)
 {
+    return this->addPackedToList(value);
+}
+
+bool ZVariant::addToList(const std::string &value)
+{
+    if(this->isArray()) this->convertToList();
+
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_list = newPayload<ZVariantList>(ZVariantType::List);
         this->m_variantType = ZVariantType::List;
     }
 
     if(this->m_variantType == ZVariantType::List)
     {
-        this->m_list.emplace_back(value);
+        this->m_list->mutate().emplace_back(value);
         return true;
     }
     else
@@ -1465,16 +2225,19 @@ bool ZVariant::addToList(const zfloat64 &value)
     }
 }
 
-bool ZVariant::addToList(const std::string &value)
+bool ZVariant::addToList(const char *value)
 {
+    if(this->isArray()) this->convertToList();
+
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_list = newPayload<ZVariantList>(ZVariantType::List);
         this->m_variantType = ZVariantType::List;
     }
 
     if(this->m_variantType == ZVariantType::List)
     {
-        this->m_list.emplace_back(value);
+        this->m_list->mutate().emplace_back(value);
         return true;
     }
     else
@@ -1483,16 +2246,17 @@ bool ZVariant::addToList(const std::string &value)
     }
 }
 
-bool ZVariant::addToList(const char *value)
+bool ZVariant::addToIntVarMap(const std::uint64_t &key, const ZVariant &value)
 {
     if(this->m_variantType == ZVariantType::None)
     {
-        this->m_variantType = ZVariantType::List;
+        this->m_integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap);
+        this->m_variantType = ZVariantType::IntegerVariantMap;
     }
 
-    if(this->m_variantType == ZVariantType::List)
+    if(this->m_variantType == ZVariantType::IntegerVariantMap)
     {
-        this->m_list.emplace_back(value);
+        this->m_integerVariantMap->mutate().emplace(key,value);
         return true;
     }
     else
@@ -1501,16 +2265,17 @@ bool ZVariant::addToList(const char *value)
     }
 }
 
-bool ZVariant::addToIntVarMap(const std::uint64_t &key, const ZVariant &value)
+bool ZVariant::addToIntVarMap(const std::uint64_t &key, ZVariant &&value)
 {
     if(this->m_variantType == ZVariantType::None)
     {
+        this->m_integerVariantMap = newPayload<ZIntegerVariantMap>(ZVariantType::IntegerVariantMap);
         this->m_variantType = ZVariantType::IntegerVariantMap;
     }
 
     if(this->m_variantType == ZVariantType::IntegerVariantMap)
     {
-        this->m_integerVariantMap.emplace(key,value);
+        this->m_integerVariantMap->mutate().emplace(key,std::move(value));
         return true;
     }
     else
@@ -1523,19 +2288,31 @@ void ZVariant::clear()
 {
     if(this->m_variantType == ZVariantType::String)
     {
-        this->m_string.clear();
+        this->m_string->mutate().clear();
     }
     else if(this->m_variantType == ZVariantType::List)
     {
-        this->m_list.clear();
+        this->m_list->mutate().clear();
     }
     else if(this->m_variantType == ZVariantType::Map)
     {
-        this->m_map.clear();
+        this->m_map->mutate().clear();
     }
     else if(this->m_variantType == ZVariantType::IntegerVariantMap)
     {
-        this->m_integerVariantMap.clear();
+        this->m_integerVariantMap->mutate().clear();
+    }
+    else if(this->m_variantType == ZVariantType::HashMap)
+    {
+        this->m_hashMap->mutate().clear();
+    }
+    else if(this->m_variantType == ZVariantType::IntegerHashMap)
+    {
+        this->m_integerHashMap->mutate().clear();
+    }
+    else if(this->isArray())
+    {
+        this->clearArray();
     }
 }
 
@@ -1811,308 +2588,697 @@ void ZVariant::clear()
 
 void ZVariant::clearMap()
 {
-    this->m_map.clear();
+    if(this->isMap()) this->m_map->mutate().clear();
 }
 
 void ZVariant::clearIntVarMap()
 {
-    this->m_integerVariantMap.clear();
+    this->clearIntegerVariantMap();
 }
 
 void ZVariant::clearIntegerVariantMap()
 {
-    this->m_integerVariantMap.clear();
+    if(this->isIntegerVariantMap()) this->m_integerVariantMap->mutate().clear();
+}
+
+void ZVariant::clearHashMap()
+{
+    if(this->isHashMap()) this->m_hashMap->mutate().clear();
+}
+
+void ZVariant::clearIntegerHashMap()
+{
+    if(this->isIntegerHashMap()) this->m_integerHashMap->mutate().clear();
+}
+
+void ZVariant::clearArray()
+{
+    switch (m_variantType)
+    {
+    case ZVariantType::Int32Array:
+        this->m_int32Array->mutate().clear();
+        break;
+    case ZVariantType::Int64Array:
+        this->m_int64Array->mutate().clear();
+        break;
+    case ZVariantType::UInt8Array:
+        this->m_uint8Array->mutate().clear();
+        break;
+    case ZVariantType::Float32Array:
+        this->m_float32Array->mutate().clear();
+        break;
+    case ZVariantType::Float64Array:
+        this->m_float64Array->mutate().clear();
+        break;
+    default:
+        break;
+    }
 }
 
 bool ZVariant::operator<(const ZVariant &rhs) const
 {
-    if(this->isNumber())
+    return this->compare(rhs) < 0;
+}
+
+ZVariant &ZVariant::operator=(ZVariant &&rhs) noexcept
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::MoveAssign, rhs.m_variantType);
+
+    if(this != &rhs)
     {
-        return this->getNumber()<rhs.getNumber();
+        /* detach rhs first, it may live inside the payload we are about to destroy */
+        std::uint64_t slot = rhs.m_uint64;
+        ZVariantType variantType = rhs.m_variantType;
+        rhs.m_variantType = ZVariantType::None;
+
+        this->destroyPayload();
+        this->m_uint64 = slot;
+        this->m_variantType = variantType;
     }
-    else
+    return *this;
+}
+
+ZVariant &ZVariant::operator=(const ZVariant &rhs)
+{
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::CopyAssign, rhs.m_variantType);
+
+    if(this == &rhs) return *this;
+
+    if(this->isString() && rhs.isString())
     {
-        return this->getLength()<rhs.getLength();
+        /* reuse the existing string buffer */
+        this->m_string->mutate() = rhs.m_string->value;
+        return *this;
     }
+
+    /* copy before releasing our payload, rhs may be one of its elements */
+    ZVariant temp(rhs);
+    return this->operator=(std::move(temp));
 }
 
-ZVariant &ZVariant::operator=(ZVariant &&rhs)
+bool ZVariant::operator==(const ZVariant &rhs) const
 {
-#ifdef ZYXCBA_DEBUG
-    std::cout<<"Assignment Moving ZVariant..."<<std::endl;
-#endif
+    ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Compare, this->m_variantType);
 
-    if(this != &rhs)
+    if(this->m_variantType != rhs.m_variantType) return false;
+    if(this->cachedHashesDiffer(rhs)) return false;
+
+    switch (m_variantType)
+    {
+    case ZVariantType::String:
+        return this->m_string->value == rhs.m_string->value;
+    case ZVariantType::List:
+        return this->m_list->value == rhs.m_list->value;
+    case ZVariantType::Map:
+        return this->m_map->value == rhs.m_map->value;
+    case ZVariantType::IntegerVariantMap:
+        return this->m_integerVariantMap->value == rhs.m_integerVariantMap->value;
+
+    case ZVariantType::HashMap:
+    {
+        const ZVariantHashMap &lhsMap = this->m_hashMap->value;
+        const ZVariantHashMap &rhsMap = rhs.m_hashMap->value;
+        if(lhsMap.size() != rhsMap.size()) return false;
+        for(auto it = lhsMap.cbegin(); it != lhsMap.cend(); ++it)
+        {
+            auto found = rhsMap.find(it.key());
+            if(found == rhsMap.cend() || !(found.value() == it.value())) return false;
+        }
+        return true;
+    }
+    case ZVariantType::IntegerHashMap:
     {
-        this->makeInvalid();
-        this->m_variantType = rhs.m_variantType;
-
-        switch (rhs.m_variantType) {
-        case ZVariantType::Bool:
-            this->m_bool = std::move(rhs.m_bool);
-            break;
-        case ZVariantType::Int8:
-            this->m_int8 = std::move(rhs.m_int8);
-            break;
-
-        case ZVariantType::Int16:
-            this->m_int16 = std::move(rhs.m_int16);
-            break;
-
-        case ZVariantType::Int32:
-            this->m_int32 = std::move(rhs.m_int32);
-            break;
-
-        case ZVariantType::Int64:
-            this->m_int64 = std::move(rhs.m_int64);
-            break;
-
-        case ZVariantType::UInt8:
-            this->m_uint8 = std::move(rhs.m_uint8);
-            break;
-
-        case ZVariantType::UInt16:
-            this->m_uint16 = std::move(rhs.m_uint16);
-            break;
-
-        case ZVariantType::UInt32:
-            this->m_uint32 = std::move(rhs.m_uint32);
-            break;
-
-        case ZVariantType::UInt64:
-            this->m_uint64 = std::move(rhs.m_uint64);
-            break;
-
-        case ZVariantType::Float32:
-            this->m_float32 = std::move(rhs.m_float32);
-            break;
-
-        case ZVariantType::Float64:
-            this->m_float64 = std::move(rhs.m_float64);
-            break;
-
-        case ZVariantType::String:
-            this->m_string = std::move(rhs.m_string);
-            break;
-
-        case ZVariantType::List:
-            this->m_list = std::move(rhs.m_list);
-            break;
-        case ZVariantType::Map:
-            this->m_map = std::move(rhs.m_map);
-            break;
-        case ZVariantType::IntegerVariantMap:
-            this->m_integerVariantMap = std::move(rhs.m_integerVariantMap);
-            break;
-        default:
-            m_variantType = ZVariantType::None;
-            break;
+        const ZIntegerVariantHashMap &lhsMap = this->m_integerHashMap->value;
+        const ZIntegerVariantHashMap &rhsMap = rhs.m_integerHashMap->value;
+        if(lhsMap.size() != rhsMap.size()) return false;
+        for(auto it = lhsMap.cbegin(); it != lhsMap.cend(); ++it)
+        {
+            auto found = rhsMap.find(it.key());
+            if(found == rhsMap.cend() || !(found.value() == it.value())) return false;
         }
+        return true;
+    }
 
-        rhs.makeInvalid();
+    case ZVariantType::Int32Array:
+        return this->m_int32Array->value == rhs.m_int32Array->value;
+    case ZVariantType::Int64Array:
+        return this->m_int64Array->value == rhs.m_int64Array->value;
+    case ZVariantType::UInt8Array:
+        return this->m_uint8Array->value == rhs.m_uint8Array->value;
+
+    default:
+        /* scalars and float arrays, which follow the NaN and signed zero rules of compare() */
+        return this->compare(rhs) == 0;
     }
-    return *this;
 }
 
-ZVariant &ZVariant::operator=(const ZVariant &rhs)
+bool ZVariant::operator!=(const ZVariant &rhs) const
+{
+    return !operator==(rhs);
+}
+
+namespace {
+
+std::size_t hashCombine(std::size_t seed, std::size_t value)
+{
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+template<typename T>
+int compareValues(const T &lhs, const T &rhs)
 {
-#ifdef ZYXCBA_DEBUG
-    std::cout<<"Assignment Copying ..."<<std::endl;
-#endif
+    return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+}
 
-    this->m_variantType = rhs.m_variantType;
-    switch (m_variantType) {
+/* NaN sorts after every number and equals any other NaN, -0.0 equals 0.0 */
+template<typename T>
+int compareFloats(const T &lhs, const T &rhs)
+{
+    bool lhsNan = std::isnan(lhs);
+    bool rhsNan = std::isnan(rhs);
+    if(lhsNan || rhsNan) return compareValues(lhsNan, rhsNan);
+    return compareValues(lhs, rhs);
+}
+
+template<typename T>
+std::size_t hashFloat(const T &value)
+{
+    if(std::isnan(value)) return std::hash<T>()(std::numeric_limits<T>::quiet_NaN());
+    if(value == 0) return std::hash<T>()(0);
+    return std::hash<T>()(value);
+}
+
+/* leaves hash their little endian bytes keyed by the type, so equal values of different
+ * types differ and the result does not depend on the host byte order
+ */
+template<typename T>
+std::uint64_t contentHashValue(const ZVariantType &type, const T &value, const std::uint64_t &seed)
+{
+    unsigned char bytes[sizeof(T)];
+    store_le(bytes, value);
+    return ZHash::hash64(bytes, sizeof(bytes), seed + static_cast<std::uint64_t>(type));
+}
+
+template<typename T>
+T normalizeFloat(T value)
+{
+    if(std::isnan(value)) return std::numeric_limits<T>::quiet_NaN();
+    if(value == 0) return 0;
+    return value;
+}
+
+template<typename T>
+std::uint64_t contentHashFloat(const ZVariantType &type, const T &value, const std::uint64_t &seed)
+{
+    return contentHashValue(type, normalizeFloat(value), seed);
+}
+
+/* elements that hash the same as their raw little endian bytes, so a chunk of them can be
+ * hashed in place
+ */
+template<typename T>
+bool isCanonical(const T *values, const std::size_t &count, std::false_type)
+{
+    (void)values;
+    (void)count;
+    return isLittleEndianHost();
+}
+
+/* a float is canonical unless it is a zero or a NaN. With x its magnitude bits minus one, that
+ * is x < infinity: the top bit of x catches zeros and the top bit of x + bias catches NaNs. The
+ * fixed size blocks let the compiler vectorize the loop.
+ */
+template<typename T>
+bool isCanonical(const T *values, const std::size_t &count, std::true_type)
+{
+    typedef typename detail::ZBitsOf<T>::type Bits;
+    const std::size_t BlockSize = 16;
+    const Bits magnitudeMask = static_cast<Bits>(~Bits(0)) >> 1;
+    const T infinityValue = std::numeric_limits<T>::infinity();
+    Bits infinity;
+    std::memcpy(&infinity, &infinityValue, sizeof(infinity));
+    const Bits bias = static_cast<Bits>(magnitudeMask - infinity + 1);
+
+    Bits lanes[BlockSize] = {};
+    std::size_t i = 0;
+    for(; i + BlockSize <= count; i += BlockSize)
+    {
+        Bits bits[BlockSize];
+        std::memcpy(bits, values + i, sizeof(bits));
+        for(std::size_t j = 0; j < BlockSize; ++j)
+        {
+            const Bits x = static_cast<Bits>((bits[j] & magnitudeMask) - 1);
+            lanes[j] |= static_cast<Bits>(x | (x + bias));
+        }
+    }
+
+    Bits outside = 0;
+    for(; i < count; ++i)
+    {
+        Bits bits;
+        std::memcpy(&bits, values + i, sizeof(bits));
+        const Bits x = static_cast<Bits>((bits & magnitudeMask) - 1);
+        outside |= static_cast<Bits>(x | (x + bias));
+    }
+    for(std::size_t j = 0; j < BlockSize; ++j) outside |= lanes[j];
+
+    return isLittleEndianHost() && (outside >> (sizeof(Bits) * 8 - 1)) == 0;
+}
+
+/* arrays hash chunks of packed elements, floats normalized like contentHashFloat */
+template<typename T>
+std::uint64_t contentHashArray(const ZVariantType &type, const ZVector<T> &array, const std::uint64_t &seed)
+{
+    typedef typename std::is_floating_point<T>::type IsFloat;
+    const std::size_t chunkSize = 4096 / sizeof(T);
+    unsigned char buffer[4096];
+
+    std::uint64_t result = ZHash::combine(ZHash::mix(seed + static_cast<std::uint64_t>(type)), array.size());
+    for(std::size_t offset = 0; offset < array.size(); offset += chunkSize)
+    {
+        const std::size_t count = std::min(chunkSize, array.size() - offset);
+        const T *values = array.data() + offset;
+        const void *bytes = values;
+        if(!isCanonical(values, count, IsFloat()))
+        {
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                store_le(buffer + i * sizeof(T), IsFloat::value ? normalizeFloat(values[i]) : values[i]);
+            }
+            bytes = buffer;
+        }
+        result = ZHash::combine(result, ZHash::hash64(bytes, count * sizeof(T), seed));
+    }
+    return result;
+}
+
+template<typename Iterator, typename Compare>
+int compareRanges(Iterator first1, Iterator last1, Iterator first2, Iterator last2, Compare compareElement)
+{
+    for(; first1 != last1 && first2 != last2; ++first1, ++first2)
+    {
+        int r = compareElement(*first1, *first2);
+        if(r != 0) return r;
+    }
+    if(first1 == last1) return first2 == last2 ? 0 : -1;
+    return 1;
+}
+
+template<typename T, typename Compare>
+int compareArrays(const ZVector<T> &lhs, const ZVector<T> &rhs, Compare compareElement)
+{
+    return compareRanges(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend(), compareElement);
+}
+
+int compareVariants(const ZVariant &lhs, const ZVariant &rhs)
+{
+    return lhs.compare(rhs);
+}
+
+int compareVariantEntries(const std::pair<const ZVariant, ZVariant> &lhs, const std::pair<const ZVariant, ZVariant> &rhs)
+{
+    int r = lhs.first.compare(rhs.first);
+    return r != 0 ? r : lhs.second.compare(rhs.second);
+}
+
+int compareIntegerEntries(const std::pair<const std::uint64_t, ZVariant> &lhs, const std::pair<const std::uint64_t, ZVariant> &rhs)
+{
+    int r = compareValues(lhs.first, rhs.first);
+    return r != 0 ? r : lhs.second.compare(rhs.second);
+}
+
+int compareKeys(const ZVariant &lhs, const ZVariant &rhs)
+{
+    return lhs.compare(rhs);
+}
+
+int compareKeys(const std::uint64_t &lhs, const std::uint64_t &rhs)
+{
+    return compareValues(lhs, rhs);
+}
+
+/* the entry with the smallest key above the key of after, the first one for the end iterator */
+template<typename Map>
+typename Map::const_iterator nextByKey(const Map &map, const typename Map::const_iterator &after)
+{
+    typename Map::const_iterator next = map.cend();
+    for(auto it = map.cbegin(); it != map.cend(); ++it)
+    {
+        if(after != map.cend() && compareKeys(it.key(), after.key()) <= 0) continue;
+        if(next == map.cend() || compareKeys(it.key(), next.key()) < 0) next = it;
+    }
+    return next;
+}
+
+/* hash maps have no order of their own, they are ordered by their entries sorted by key. This
+ * is only reached for maps of equal size and equal hash, which are equal unless the hashes
+ * collide, so equality is settled by lookups first. A real collision walks both maps in key
+ * order without allocating, at O(n^2).
+ */
+template<typename Map>
+int compareHashMaps(const Map &lhs, const Map &rhs)
+{
+    bool equal = true;
+    for(auto it = lhs.cbegin(); equal && it != lhs.cend(); ++it)
+    {
+        auto found = rhs.find(it.key());
+        equal = found != rhs.cend() && found.value().compare(it.value()) == 0;
+    }
+    if(equal) return 0;
+
+    typename Map::const_iterator left = lhs.cend();
+    typename Map::const_iterator right = rhs.cend();
+    for(;;)
+    {
+        left = nextByKey(lhs, left);
+        right = nextByKey(rhs, right);
+        if(left == lhs.cend() || right == rhs.cend())
+        {
+            if(left == lhs.cend()) return right == rhs.cend() ? 0 : -1;
+            return 1;
+        }
+
+        int r = compareKeys(left.key(), right.key());
+        if(r == 0) r = left.value().compare(right.value());
+        if(r != 0) return r;
+    }
+}
+
+}
+
+int ZVariant::compare(const ZVariant &other) const
+{
+    /* variants of different types are ordered by the rank of their type */
+    if(this->m_variantType != other.m_variantType)
+    {
+        return compareValues(static_cast<std::uint8_t>(this->m_variantType), static_cast<std::uint8_t>(other.m_variantType));
+    }
+
+    switch (m_variantType)
+    {
+    case ZVariantType::None:
+        return 0;
     case ZVariantType::Bool:
-        this->m_bool = rhs.m_bool;
-        break;
+        return compareValues(this->m_bool, other.m_bool);
     case ZVariantType::Int8:
-        this->m_int8 = rhs.m_int8;
-        break;
-
+        return compareValues(this->m_int8, other.m_int8);
     case ZVariantType::Int16:
-        this->m_int16 = rhs.m_int16;
-        break;
-
+        return compareValues(this->m_int16, other.m_int16);
     case ZVariantType::Int32:
-        this->m_int32 = rhs.m_int32;
-        break;
-
+        return compareValues(this->m_int32, other.m_int32);
     case ZVariantType::Int64:
-        this->m_int64 = rhs.m_int64;
-        break;
-
+        return compareValues(this->m_int64, other.m_int64);
     case ZVariantType::UInt8:
-        this->m_uint8 = rhs.m_uint8;
-        break;
-
+        return compareValues(this->m_uint8, other.m_uint8);
     case ZVariantType::UInt16:
-        this->m_uint16 = rhs.m_uint16;
-        break;
-
+        return compareValues(this->m_uint16, other.m_uint16);
     case ZVariantType::UInt32:
-        this->m_uint32 = rhs.m_uint32;
-        break;
-
+        return compareValues(this->m_uint32, other.m_uint32);
     case ZVariantType::UInt64:
-        this->m_uint64 = rhs.m_uint64;
-        break;
-
+        return compareValues(this->m_uint64, other.m_uint64);
     case ZVariantType::Float32:
-        this->m_float32 = rhs.m_float32;
-        break;
-
+        return compareFloats(this->m_float32, other.m_float32);
     case ZVariantType::Float64:
-        this->m_float64 = rhs.m_float64;
-        break;
+        return compareFloats(this->m_float64, other.m_float64);
 
     case ZVariantType::String:
-        this->m_string = rhs.m_string;
-        break;
+    {
+        if(this->m_string == other.m_string) return 0;
+        int r = this->m_string->value.compare(other.m_string->value);
+        return r < 0 ? -1 : (r > 0 ? 1 : 0);
+    }
+    case ZVariantType::List:
+        return compareRanges(this->m_list->value.cbegin(), this->m_list->value.cend(),
+                             other.m_list->value.cbegin(), other.m_list->value.cend(), compareVariants);
+    case ZVariantType::Map:
+        return compareRanges(this->m_map->value.cbegin(), this->m_map->value.cend(),
+                             other.m_map->value.cbegin(), other.m_map->value.cend(), compareVariantEntries);
+    case ZVariantType::IntegerVariantMap:
+        return compareRanges(this->m_integerVariantMap->value.cbegin(), this->m_integerVariantMap->value.cend(),
+                             other.m_integerVariantMap->value.cbegin(), other.m_integerVariantMap->value.cend(),
+                             compareIntegerEntries);
+
+    case ZVariantType::HashMap:
+    {
+        int r = compareValues(this->m_hashMap->value.size(), other.m_hashMap->value.size());
+        if(r == 0) r = compareValues(this->hash(), other.hash());
+        if(r == 0) r = compareHashMaps(this->m_hashMap->value, other.m_hashMap->value);
+        return r;
+    }
+    case ZVariantType::IntegerHashMap:
+    {
+        int r = compareValues(this->m_integerHashMap->value.size(), other.m_integerHashMap->value.size());
+        if(r == 0) r = compareValues(this->hash(), other.hash());
+        if(r == 0) r = compareHashMaps(this->m_integerHashMap->value, other.m_integerHashMap->value);
+        return r;
+    }
+
+    case ZVariantType::Int32Array:
+        return compareArrays(this->m_int32Array->value, other.m_int32Array->value, compareValues<std::int32_t>);
+    case ZVariantType::Int64Array:
+        return compareArrays(this->m_int64Array->value, other.m_int64Array->value, compareValues<std::int64_t>);
+    case ZVariantType::UInt8Array:
+        return compareArrays(this->m_uint8Array->value, other.m_uint8Array->value, compareValues<std::uint8_t>);
+    case ZVariantType::Float32Array:
+        return compareArrays(this->m_float32Array->value, other.m_float32Array->value, compareFloats<zfloat32>);
+    case ZVariantType::Float64Array:
+        return compareArrays(this->m_float64Array->value, other.m_float64Array->value, compareFloats<zfloat64>);
+
+    default:
+        return 0;
+    }
+}
 
+std::atomic<std::size_t> *ZVariant::payloadHash() const
+{
+    switch (m_variantType) {
+    case ZVariantType::String:
+        return &this->m_string->hash;
     case ZVariantType::List:
-        this->m_list.clear();
-        std::copy(rhs.m_list.begin(), rhs.m_list.end(), back_inserter(this->m_list));
-        break;
+        return &this->m_list->hash;
     case ZVariantType::Map:
-        this->m_map.clear();
-        this->m_map.insert(rhs.m_map.begin(),rhs.m_map.end());
-        break;
+        return &this->m_map->hash;
     case ZVariantType::IntegerVariantMap:
-        this->m_integerVariantMap.clear();
-        this->m_integerVariantMap.insert(rhs.m_integerVariantMap.begin(),rhs.m_integerVariantMap.end());
-        break;
+        return &this->m_integerVariantMap->hash;
+    case ZVariantType::HashMap:
+        return &this->m_hashMap->hash;
+    case ZVariantType::IntegerHashMap:
+        return &this->m_integerHashMap->hash;
+    case ZVariantType::Int32Array:
+        return &this->m_int32Array->hash;
+    case ZVariantType::Int64Array:
+        return &this->m_int64Array->hash;
+    case ZVariantType::UInt8Array:
+        return &this->m_uint8Array->hash;
+    case ZVariantType::Float32Array:
+        return &this->m_float32Array->hash;
+    case ZVariantType::Float64Array:
+        return &this->m_float64Array->hash;
     default:
-        break;
+        return nullptr;
     }
+}
 
-    return *this;
+bool ZVariant::cachedHashesDiffer(const ZVariant &other) const
+{
+    std::atomic<std::size_t> *lhs = this->payloadHash();
+    std::atomic<std::size_t> *rhs = other.payloadHash();
+    if(lhs == nullptr || rhs == nullptr) return false;
+
+    std::size_t lhsHash = lhs->load(std::memory_order_relaxed);
+    std::size_t rhsHash = rhs->load(std::memory_order_relaxed);
+    return lhsHash != 0 && rhsHash != 0 && lhsHash != rhsHash;
 }
 
-ZVariant &ZVariant::operator=(const ZVariant &&rhs)
+std::size_t ZVariant::hash() const
 {
-#ifdef ZYXCBA_DEBUG
-    std::cout<<"Assignment Moving const ZVariant ..."<<std::endl;
-#endif
+    /* strings and containers keep their hash until they are modified */
+    std::atomic<std::size_t> *cache = this->payloadHash();
+    if(cache == nullptr) return this->computeHash();
 
-    if(this != &rhs)
+    std::size_t h = cache->load(std::memory_order_relaxed);
+    if(h == 0)
+    {
+        h = this->computeHash();
+        if(h == 0) h = 1;
+        cache->store(h, std::memory_order_relaxed);
+    }
+    return h;
+}
+
+std::size_t ZVariant::computeHash() const
+{
+    std::size_t seed = std::hash<std::uint8_t>()(static_cast<std::uint8_t>(this->m_variantType));
+
+    switch (m_variantType)
     {
-        m_variantType = rhs.m_variantType;
-        switch (m_variantType) {
-        case ZVariantType::Bool:
-            this->m_bool = std::move(rhs.m_bool);
-            break;
-        case ZVariantType::Int8:
-            this->m_int8 = std::move(rhs.m_int8);
-            break;
-
-        case ZVariantType::Int16:
-            this->m_int16 = std::move(rhs.m_int16);
-            break;
-
-        case ZVariantType::Int32:
-            this->m_int32 = std::move(rhs.m_int32);
-            break;
-
-        case ZVariantType::Int64:
-            this->m_int64 = std::move(rhs.m_int64);
-            break;
-
-        case ZVariantType::UInt8:
-            this->m_uint8 = std::move(rhs.m_uint8);
-            break;
-
-        case ZVariantType::UInt16:
-            this->m_uint16 = std::move(rhs.m_uint16);
-            break;
-
-        case ZVariantType::UInt32:
-            this->m_uint32 = std::move(rhs.m_uint32);
-            break;
-
-        case ZVariantType::UInt64:
-            this->m_uint64 = std::move(rhs.m_uint64);
-            break;
-
-        case ZVariantType::Float32:
-            this->m_float32 = std::move(rhs.m_float32);
-            break;
-
-        case ZVariantType::Float64:
-            this->m_float64 = std::move(rhs.m_float64);
-            break;
-
-        case ZVariantType::String:
-            this->m_string = std::move(rhs.m_string);
-            break;
-
-        case ZVariantType::List:
-            this->m_list = std::move(rhs.m_list);
-            break;
-        case ZVariantType::Map:
-            this->m_map = std::move(rhs.m_map);
-            break;
-        case ZVariantType::IntegerVariantMap:
-            this->m_integerVariantMap = std::move(rhs.m_integerVariantMap);
-            break;
-        default:
-            m_variantType = ZVariantType::None;
-            break;
+    case ZVariantType::None:
+        return seed;
+    case ZVariantType::Bool:
+        return hashCombine(seed, std::hash<bool>()(this->m_bool));
+    case ZVariantType::Int8:
+        return hashCombine(seed, std::hash<std::int8_t>()(this->m_int8));
+    case ZVariantType::Int16:
+        return hashCombine(seed, std::hash<std::int16_t>()(this->m_int16));
+    case ZVariantType::Int32:
+        return hashCombine(seed, std::hash<std::int32_t>()(this->m_int32));
+    case ZVariantType::Int64:
+        return hashCombine(seed, std::hash<std::int64_t>()(this->m_int64));
+    case ZVariantType::UInt8:
+        return hashCombine(seed, std::hash<std::uint8_t>()(this->m_uint8));
+    case ZVariantType::UInt16:
+        return hashCombine(seed, std::hash<std::uint16_t>()(this->m_uint16));
+    case ZVariantType::UInt32:
+        return hashCombine(seed, std::hash<std::uint32_t>()(this->m_uint32));
+    case ZVariantType::UInt64:
+        return hashCombine(seed, std::hash<std::uint64_t>()(this->m_uint64));
+    case ZVariantType::Float32:
+        return hashCombine(seed, hashFloat(this->m_float32));
+    case ZVariantType::Float64:
+        return hashCombine(seed, hashFloat(this->m_float64));
+    case ZVariantType::String:
+        return hashCombine(seed, std::hash<std::string>()(this->m_string->value));
+
+    case ZVariantType::List:
+        for(const ZVariant &value : this->m_list->value) seed = hashCombine(seed, value.hash());
+        return seed;
+    case ZVariantType::Map:
+        for(const auto &entry : this->m_map->value)
+        {
+            seed = hashCombine(hashCombine(seed, entry.first.hash()), entry.second.hash());
+        }
+        return seed;
+    case ZVariantType::IntegerVariantMap:
+        for(const auto &entry : this->m_integerVariantMap->value)
+        {
+            seed = hashCombine(hashCombine(seed, std::hash<std::uint64_t>()(entry.first)), entry.second.hash());
         }
+        return seed;
 
+    case ZVariantType::HashMap:
+    {
+        /* iteration order is unspecified, combine the entries with a commutative sum */
+        std::size_t sum = 0;
+        for(auto it = this->m_hashMap->value.cbegin(); it != this->m_hashMap->value.cend(); ++it)
+        {
+            sum += hashCombine(it.key().hash(), it.value().hash());
+        }
+        return hashCombine(seed, sum);
+    }
+    case ZVariantType::IntegerHashMap:
+    {
+        std::size_t sum = 0;
+        for(auto it = this->m_integerHashMap->value.cbegin(); it != this->m_integerHashMap->value.cend(); ++it)
+        {
+            sum += hashCombine(std::hash<std::uint64_t>()(it.key()), it.value().hash());
+        }
+        return hashCombine(seed, sum);
     }
 
-    return *this;
+    case ZVariantType::Int32Array:
+    case ZVariantType::Int64Array:
+    case ZVariantType::UInt8Array:
+    case ZVariantType::Float32Array:
+    case ZVariantType::Float64Array:
+        /* hashes the packed elements in bulk instead of one element at a time */
+        return hashCombine(seed, static_cast<std::size_t>(this->contentHash()));
+    default:
+        return seed;
+    }
 }
 
-bool ZVariant::operator==(const ZVariant &rhs)
+std::uint64_t ZVariant::contentHash(const std::uint64_t &seed) const
 {
-#ifdef ZYXCBA_DEBUG
-    std::cout<<"ZVariant::operator=="<<std::endl;
-#endif
-
-    if(this->m_variantType != rhs.m_variantType) return false;
+    const ZVariantType type = this->m_variantType;
 
-    switch (m_variantType)
+    switch (type)
     {
     case ZVariantType::None:
-        return true;
+        return ZHash::hash64(nullptr, 0, seed + static_cast<std::uint64_t>(type));
     case ZVariantType::Bool:
-        return this->m_bool == rhs.m_bool;
+        return contentHashValue(type, static_cast<std::uint8_t>(this->m_bool), seed);
     case ZVariantType::Int8:
-        return this->m_int8 == rhs.m_int8;
+        return contentHashValue(type, this->m_int8, seed);
     case ZVariantType::Int16:
-        return this->m_int16 == rhs.m_int16;
+        return contentHashValue(type, this->m_int16, seed);
     case ZVariantType::Int32:
-        return this->m_int32 == rhs.m_int32;
+        return contentHashValue(type, this->m_int32, seed);
     case ZVariantType::Int64:
-        return this->m_int64 == rhs.m_int64;
-
+        return contentHashValue(type, this->m_int64, seed);
     case ZVariantType::UInt8:
-        return this->m_uint8 == rhs.m_uint8;
+        return contentHashValue(type, this->m_uint8, seed);
     case ZVariantType::UInt16:
-        return this->m_uint16 == rhs.m_uint16;
+        return contentHashValue(type, this->m_uint16, seed);
     case ZVariantType::UInt32:
-        return this->m_uint32 == rhs.m_uint32;
+        return contentHashValue(type, this->m_uint32, seed);
     case ZVariantType::UInt64:
-        return this->m_uint64 == rhs.m_uint64;
-
+        return contentHashValue(type, this->m_uint64, seed);
     case ZVariantType::Float32:
-        return std::fabs(this->m_float32 - rhs.m_float32) < std::numeric_limits<zfloat32>::epsilon();
+        return contentHashFloat(type, this->m_float32, seed);
     case ZVariantType::Float64:
-        return std::fabs(this->m_float64 - rhs.m_float64) < std::numeric_limits<zfloat64>::epsilon();
-
+        return contentHashFloat(type, this->m_float64, seed);
     case ZVariantType::String:
-        return this->m_string == rhs.m_string;
+        return ZHash::hash64(this->m_string->value.data(), this->m_string->value.size(), seed + static_cast<std::uint64_t>(type));
+    case ZVariantType::Int32Array:
+        return contentHashArray(type, this->m_int32Array->value, seed);
+    case ZVariantType::Int64Array:
+        return contentHashArray(type, this->m_int64Array->value, seed);
+    case ZVariantType::UInt8Array:
+        return contentHashArray(type, this->m_uint8Array->value, seed);
+    case ZVariantType::Float32Array:
+        return contentHashArray(type, this->m_float32Array->value, seed);
+    case ZVariantType::Float64Array:
+        return contentHashArray(type, this->m_float64Array->value, seed);
     default:
         break;
     }
 
-    return false;
-}
+    /* containers start from their type and length so [] and {} or [[]] and [] differ */
+    std::uint64_t result = ZHash::mix(seed + static_cast<std::uint64_t>(type));
 
-bool ZVariant::operator!=(const ZVariant &rhs)
-{
-    return !operator==(rhs);
+    switch (type)
+    {
+    case ZVariantType::List:
+        result = ZHash::combine(result, this->m_list->value.size());
+        for(const ZVariant &value : this->m_list->value) result = ZHash::combine(result, value.contentHash(seed));
+        return result;
+    case ZVariantType::Map:
+        result = ZHash::combine(result, this->m_map->value.size());
+        for(const auto &entry : this->m_map->value)
+        {
+            result = ZHash::combine(ZHash::combine(result, entry.first.contentHash(seed)), entry.second.contentHash(seed));
+        }
+        return result;
+    case ZVariantType::IntegerVariantMap:
+        result = ZHash::combine(result, this->m_integerVariantMap->value.size());
+        for(const auto &entry : this->m_integerVariantMap->value)
+        {
+            result = ZHash::combine(ZHash::combine(result, ZHash::mix(entry.first)), entry.second.contentHash(seed));
+        }
+        return result;
+
+    case ZVariantType::HashMap:
+    {
+        /* iteration order is unspecified, combine the entries with a commutative sum */
+        std::uint64_t sum = 0;
+        for(auto it = this->m_hashMap->value.cbegin(); it != this->m_hashMap->value.cend(); ++it)
+        {
+            sum += ZHash::combine(it.key().contentHash(seed), it.value().contentHash(seed));
+        }
+        return ZHash::combine(ZHash::combine(result, this->m_hashMap->value.size()), sum);
+    }
+    case ZVariantType::IntegerHashMap:
+    {
+        std::uint64_t sum = 0;
+        for(auto it = this->m_integerHashMap->value.cbegin(); it != this->m_integerHashMap->value.cend(); ++it)
+        {
+            sum += ZHash::combine(ZHash::mix(it.key()), it.value().contentHash(seed));
+        }
+        return ZHash::combine(ZHash::combine(result, this->m_integerHashMap->value.size()), sum);
+    }
+    default:
+        return result;
+    }
 }
 
 }
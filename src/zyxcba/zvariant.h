@@ -33,30 +33,60 @@
 #define ZVARIANT_H
 
 #include <map>
+#include <atomic>
 #include <cmath>
 #include <vector>
+#include <algorithm>
+#include <utility>
 #include <limits>
+#include <string>
 #include <cstring>
 #include <cstdint>
 #include <ostream>
 #include <iostream>
 
 #include "ztype.h"
+#include "ztrace.h"
+#include "zarena.h"
+#include "zvector.h"
+#include "zhashmap.h"
 
 namespace zyxcba {
-
 class ZVariant;
-typedef std::vector<ZVariant> ZVariantList;
-typedef std::map<ZVariant,ZVariant> ZVariantMap;
-typedef std::map<std::uint64_t,ZVariant> ZIntVarMap;
-typedef std::map<std::uint64_t,ZVariant> ZIntegerVariantMap;
+}
+
+/* declared ahead of the class so ZHashMap<ZVariant,...> never sees the primary template */
+namespace std {
+template<>
+struct hash<zyxcba::ZVariant>
+{
+    std::size_t operator()(const zyxcba::ZVariant &variant) const;
+};
+}
+
+namespace zyxcba {
+
+typedef ZVector<ZVariant> ZVariantList;
+typedef std::map<ZVariant,ZVariant,std::less<ZVariant>,ZArenaAllocator<std::pair<const ZVariant,ZVariant> > > ZVariantMap;
+typedef std::map<std::uint64_t,ZVariant,std::less<std::uint64_t>,ZArenaAllocator<std::pair<const std::uint64_t,ZVariant> > > ZIntVarMap;
+typedef ZIntVarMap ZIntegerVariantMap;
+typedef ZHashMap<ZVariant,ZVariant> ZVariantHashMap;
+typedef ZHashMap<std::uint64_t,ZVariant> ZIntegerVariantHashMap;
+typedef ZVector<std::int32_t> ZInt32Array;
+typedef ZVector<std::int64_t> ZInt64Array;
+typedef ZVector<std::uint8_t> ZUInt8Array;
+typedef ZUInt8Array ZByteArray;
+typedef ZVector<zfloat32> ZFloat32Array;
+typedef ZVector<zfloat64> ZFloat64Array;
+typedef ZArena ZVariantArena;
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief The ZVariantType enum
 ///
+/// The typed arrays hold their elements packed and contiguous instead of one ZVariant each.
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-enum class ZVariantType
+enum class ZVariantType : std::uint8_t
 {
     None,
     Bool,
@@ -78,15 +108,75 @@ enum class ZVariantType
 
     List,
     Map,
-    IntegerVariantMap
+    IntegerVariantMap,
+
+    HashMap,
+    IntegerHashMap,
+
+    Int32Array,
+    Int64Array,
+    UInt8Array,
+    Float32Array,
+    Float64Array
 };
 
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZVariantPayload struct
+///
+/// Out-of-line storage of a string or container held by a ZVariant, together with its cached
+/// hash. A cached hash of zero means it has not been computed since the last modification.
+/// When the payload lives in an arena, containers allocate their elements from it as well.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+struct ZVariantPayload
+{
+    template<typename... Args>
+    explicit ZVariantPayload(ZArena *payloadArena, Args&&... args):
+        ZVariantPayload(typename std::uses_allocator<T, ZArenaAllocator<char> >::type(), payloadArena, std::forward<Args>(args)...)
+    {
+
+    }
+
+    T &mutate()
+    {
+        this->hash.store(0, std::memory_order_relaxed);
+        return this->value;
+    }
+
+    T value;
+    std::atomic<std::size_t> hash;
+    ZArena *arena;
+
+private:
+    template<typename... Args>
+    ZVariantPayload(std::true_type, ZArena *payloadArena, Args&&... args):
+        value(std::forward<Args>(args)..., typename T::allocator_type(payloadArena)),
+        hash(0),
+        arena(payloadArena)
+    {
+
+    }
+
+    template<typename... Args>
+    ZVariantPayload(std::false_type, ZArena *payloadArena, Args&&... args):
+        value(std::forward<Args>(args)...),
+        hash(0),
+        arena(payloadArena)
+    {
+
+    }
+};
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief The ZVariant class
 ///
 /// The ZVariant class acts like a union for the most common c++ data types.
+///
+/// Scalars are stored inline, strings and containers are held out-of-line behind a pointer
+/// which shares the same slot as the scalars, so a scalar ZVariant costs 16 bytes.
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 class ZVariant
 {
@@ -109,7 +199,7 @@ public:
     explicit ZVariant(const zfloat64 &param);
 
     explicit ZVariant(const std::string &param);
-    explicit ZVariant(const std::string &&param);
+    explicit ZVariant(std::string &&param);
 
     explicit ZVariant(const char *param);
 
@@ -117,15 +207,34 @@ public:
     explicit ZVariant(const ZVariantMap &param);
     explicit ZVariant(const ZIntegerVariantMap &param);
 
-    explicit ZVariant(const ZVariant &other);
+    explicit ZVariant(ZVariantList &&param);
+    explicit ZVariant(ZVariantMap &&param);
+    explicit ZVariant(ZIntegerVariantMap &&param);
+
+    explicit ZVariant(const ZVariantHashMap &param);
+    explicit ZVariant(const ZIntegerVariantHashMap &param);
+    explicit ZVariant(ZVariantHashMap &&param);
+    explicit ZVariant(ZIntegerVariantHashMap &&param);
+
+    explicit ZVariant(const ZInt32Array &param);
+    explicit ZVariant(const ZInt64Array &param);
+    explicit ZVariant(const ZUInt8Array &param);
+    explicit ZVariant(const ZFloat32Array &param);
+    explicit ZVariant(const ZFloat64Array &param);
+    explicit ZVariant(ZInt32Array &&param);
+    explicit ZVariant(ZInt64Array &&param);
+    explicit ZVariant(ZUInt8Array &&param);
+    explicit ZVariant(ZFloat32Array &&param);
+    explicit ZVariant(ZFloat64Array &&param);
 
-    explicit ZVariant(ZVariant &&rhs);
-    explicit ZVariant(const ZVariant &&other);
+    ZVariant(const ZVariant &other);
+    ZVariant(ZVariant &&rhs) noexcept;
 
-    virtual ~ZVariant();
+    ~ZVariant();
 
     ZVariantType variantType() const;
     std::string variantTypeString() const;
+    static std::string variantTypeName(const ZVariantType &variantType);
 
     bool isValid() const;
     bool isNone() const;
@@ -152,12 +261,24 @@ public:
     bool isList() const;
     bool isIntVarMap() const;
     bool isIntegerVariantMap() const;
+    bool isHashMap() const;
+    bool isIntegerHashMap() const;
+
+    bool isArray() const;
+    bool isInt32Array() const;
+    bool isInt64Array() const;
+    bool isUInt8Array() const;
+    bool isFloat32Array() const;
+    bool isFloat64Array() const;
 
     std::uint64_t mapLength() const;
     std::uint64_t listLength() const;
     std::uint64_t stringLength() const;
     std::uint64_t intVarMapLength() const;
     std::uint64_t integerVariantMapLength() const;
+    std::uint64_t hashMapLength() const;
+    std::uint64_t integerHashMapLength() const;
+    std::uint64_t arrayLength() const;
 
     bool getBool() const;
     std::int8_t getInt8() const;
@@ -182,6 +303,19 @@ public:
     const ZVariantMap &getMap() const;
     const ZIntegerVariantMap &getIntVarMap() const;
     const ZIntegerVariantMap &getIntegerVariantMap() const;
+    const ZVariantHashMap &getHashMap() const;
+    const ZIntegerVariantHashMap &getIntegerHashMap() const;
+
+    const ZInt32Array &getInt32Array() const;
+    const ZInt64Array &getInt64Array() const;
+    const ZUInt8Array &getUInt8Array() const;
+    const ZFloat32Array &getFloat32Array() const;
+    const ZFloat64Array &getFloat64Array() const;
+
+    /* the packed elements of a typed array in host byte order, nullptr for any other type */
+    const void *arrayData() const;
+    static ZVariantType arrayElementType(const ZVariantType &arrayType);
+    static std::size_t arrayElementSize(const ZVariantType &arrayType);
 
     void makeInvalid();
     void setBool(const bool &param);
@@ -199,16 +333,48 @@ public:
     void setFloat64(const zfloat64 &param);
 
     void setString(const std::string &param);
+    void setString(std::string &&param);
 
     void setList();
     void setList(const ZVariantList &param);
+    void setList(ZVariantList &&param);
 
     void setMap();
     void setMap(const ZVariantMap &param);
+    void setMap(ZVariantMap &&param);
 
     void setIntVarMap();
     void setIntVarMap(const ZIntegerVariantMap &param);
     void setIntegerVariantMap(const ZIntegerVariantMap &param);
+    void setIntegerVariantMap(ZIntegerVariantMap &&param);
+
+    void setHashMap();
+    void setHashMap(const ZVariantHashMap &param);
+    void setHashMap(ZVariantHashMap &&param);
+
+    void setIntegerHashMap();
+    void setIntegerHashMap(const ZIntegerVariantHashMap &param);
+    void setIntegerHashMap(ZIntegerVariantHashMap &&param);
+
+    void setInt32Array();
+    void setInt32Array(const ZInt32Array &param);
+    void setInt32Array(ZInt32Array &&param);
+
+    void setInt64Array();
+    void setInt64Array(const ZInt64Array &param);
+    void setInt64Array(ZInt64Array &&param);
+
+    void setUInt8Array();
+    void setUInt8Array(const ZUInt8Array &param);
+    void setUInt8Array(ZUInt8Array &&param);
+
+    void setFloat32Array();
+    void setFloat32Array(const ZFloat32Array &param);
+    void setFloat32Array(ZFloat32Array &&param);
+
+    void setFloat64Array();
+    void setFloat64Array(const ZFloat64Array &param);
+    void setFloat64Array(ZFloat64Array &&param);
 
     void setValue(const bool &param);
     void setValue(const std::int8_t &param);
@@ -229,9 +395,20 @@ public:
     void setValue(const ZVariantList &param);
     void setValue(const ZVariantMap &param);
     void setValue(const ZIntegerVariantMap &param);
-
+    void setValue(const ZVariantHashMap &param);
+    void setValue(const ZIntegerVariantHashMap &param);
+    void setValue(const ZInt32Array &param);
+    void setValue(const ZInt64Array &param);
+    void setValue(const ZUInt8Array &param);
+    void setValue(const ZFloat32Array &param);
+    void setValue(const ZFloat64Array &param);
+
+    /* reserves a typed array in place, otherwise the generic list */
     void reserveList(const std::uint64_t &length);
 
+    /* a None variant becomes a generic list, a typed array keeps elements of its element type
+     * packed and turns into a list for any other element
+     */
     bool addToList(const bool &value);
     bool addToList(const std::int8_t &value);
     bool addToList(const std::int16_t &value);
@@ -249,6 +426,28 @@ public:
     bool addToList(const char *value);
 
     bool addToList(const ZVariant &value);
+    bool addToList(ZVariant &&value);
+
+    /* appends a packed element to a typed array of the same element type, creating it when
+     * the variant is None, any other variant is left alone and false returned
+     */
+    bool addToArray(const std::int32_t &value);
+    bool addToArray(const std::int64_t &value);
+    bool addToArray(const std::uint8_t &value);
+    bool addToArray(const zfloat32 &value);
+    bool addToArray(const zfloat64 &value);
+
+    /* appends count packed elements to a typed array of the same element type, creating it
+     * when the variant is None
+     */
+    bool appendToArray(const std::int32_t *values, const std::uint64_t &count);
+    bool appendToArray(const std::int64_t *values, const std::uint64_t &count);
+    bool appendToArray(const std::uint8_t *values, const std::uint64_t &count);
+    bool appendToArray(const zfloat32 *values, const std::uint64_t &count);
+    bool appendToArray(const zfloat64 *values, const std::uint64_t &count);
+
+    /* turns a typed array into the equivalent generic list, other types are left alone */
+    void convertToList();
 
     bool addToIntVarMap(const std::uint64_t &key, const bool &value);
     bool addToIntVarMap(const std::uint64_t &key, const std::int8_t &value);
@@ -264,6 +463,7 @@ public:
     bool addToIntVarMap(const std::uint64_t &key, const std::string &value);
     bool addToIntVarMap(const std::uint64_t &key, const char *value);
     bool addToIntVarMap(const std::uint64_t &key, const ZVariant &value);
+    bool addToIntVarMap(const std::uint64_t &key, ZVariant &&value);
 
 //    bool addToMap(const std::uint64_t &key, const bool &value);
 //    bool addToMap(const std::uint64_t &key, const std::int8_t &value);
@@ -298,16 +498,17 @@ public:
 
 
     template<typename T1,typename T2>
-    bool addToMap(const T1 &key, const T2 &value)
+    bool addToMap(T1 &&key, T2 &&value)
     {
         if(this->m_variantType == ZVariantType::None)
         {
+            this->m_map = newPayload<ZVariantMap>(ZVariantType::Map);
             this->m_variantType = ZVariantType::Map;
         }
 
         if(this->m_variantType == ZVariantType::Map)
         {
-            this->m_map.emplace(key,value);
+            this->m_map->mutate().emplace(std::forward<T1>(key),std::forward<T2>(value));
             return true;
         }
         else
@@ -317,20 +518,73 @@ public:
     }
 
 
+    template<typename T1,typename T2>
+    bool addToHashMap(T1 &&key, T2 &&value)
+    {
+        if(this->m_variantType == ZVariantType::None)
+        {
+            this->m_hashMap = newPayload<ZVariantHashMap>(ZVariantType::HashMap);
+            this->m_variantType = ZVariantType::HashMap;
+        }
+
+        if(this->m_variantType == ZVariantType::HashMap)
+        {
+            this->m_hashMap->mutate().emplace(std::forward<T1>(key),std::forward<T2>(value));
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    template<typename T>
+    bool addToIntegerHashMap(const std::uint64_t &key, T &&value)
+    {
+        if(this->m_variantType == ZVariantType::None)
+        {
+            this->m_integerHashMap = newPayload<ZIntegerVariantHashMap>(ZVariantType::IntegerHashMap);
+            this->m_variantType = ZVariantType::IntegerHashMap;
+        }
+
+        if(this->m_variantType == ZVariantType::IntegerHashMap)
+        {
+            this->m_integerHashMap->mutate().emplace(key,std::forward<T>(value));
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    void reserveHashMap(const std::uint64_t &length);
+    void reserveIntegerHashMap(const std::uint64_t &length);
+
     void clear();
     void clearList();
     void clearMap();
     void clearIntVarMap();
     void clearIntegerVariantMap();
+    void clearHashMap();
+    void clearIntegerHashMap();
+    void clearArray();
 
 
     bool operator<(const ZVariant& rhs) const;
 
     ZVariant &operator=(const ZVariant &rhs);
-    ZVariant &operator=(ZVariant &&rhs);
-    ZVariant &operator=(const ZVariant &&rhs);
-    bool operator==(const ZVariant &rhs);
-    bool operator!=(const ZVariant &rhs);
+    ZVariant &operator=(ZVariant &&rhs) noexcept;
+    bool operator==(const ZVariant &rhs) const;
+    bool operator!=(const ZVariant &rhs) const;
+
+    int compare(const ZVariant &other) const;
+    std::size_t hash() const;
+
+    /* a structural hash of the value which, unlike hash(), is stable across processes and
+     * platforms, so it can key content addressed storage or verify a deserialized blob
+     */
+    std::uint64_t contentHash(const std::uint64_t &seed = 0) const;
 
     friend std::ostream &operator<<(std::ostream &os, const ZVariant &other)
     {
@@ -357,12 +611,25 @@ public:
         case ZVariantType::IntegerVariantMap:
             os << "ZVariant("<<other.variantTypeString()<<": "<<other.getLength()<<")";
             break;
+        case ZVariantType::HashMap:
+            os << "ZVariant("<<other.variantTypeString()<<": "<<other.getLength()<<")";
+            break;
+        case ZVariantType::IntegerHashMap:
+            os << "ZVariant("<<other.variantTypeString()<<": "<<other.getLength()<<")";
+            break;
         case ZVariantType::List:
             os << "ZVariant("<<other.variantTypeString()<<": "<<other.getLength()<<")";
             break;
         case ZVariantType::String:
             os << "ZVariant("<<other.variantTypeString()<<": "<<other.getString()<<")";
             break;
+        case ZVariantType::Int32Array:
+        case ZVariantType::Int64Array:
+        case ZVariantType::UInt8Array:
+        case ZVariantType::Float32Array:
+        case ZVariantType::Float64Array:
+            os << "ZVariant("<<other.variantTypeString()<<": "<<other.getLength()<<")";
+            break;
 
         default:
             os << "ZVariant("<<other.variantTypeString()<<")";
@@ -373,7 +640,54 @@ public:
     }
 
 private:
-    ZVariantType m_variantType;
+    template<typename T, typename... Args>
+    static ZVariantPayload<T> *newPayload(const ZVariantType &variantType, Args&&... args)
+    {
+        ZYXCBA_TRACE(ZTraceLevel::Debug, ZTraceEvent::Allocate, variantType);
+        (void)variantType;
+
+        ZArena *arena = ZArena::current();
+        if(arena == nullptr) return new ZVariantPayload<T>(nullptr, std::forward<Args>(args)...);
+
+        /* arena memory is released with the arena, nothing to undo if the constructor throws */
+        void *memory = arena->allocate(sizeof(ZVariantPayload<T>));
+        return new (memory) ZVariantPayload<T>(arena, std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    static void deletePayload(ZVariantPayload<T> *payload)
+    {
+        ZArena *arena = payload->arena;
+        if(arena == nullptr)
+        {
+            delete payload;
+            return;
+        }
+
+        payload->~ZVariantPayload<T>();
+        arena->deallocate(payload, sizeof(ZVariantPayload<T>));
+    }
+
+    void destroyPayload();
+    void copyPayload(const ZVariant &other);
+
+    template<typename T>
+    ZVariantPayload<ZVector<T> > *&arrayPayload();
+    template<typename T>
+    const ZVariantPayload<ZVector<T> > *arrayPayload() const;
+    template<typename T>
+    bool pushArrayElement(const T &value);
+    template<typename T>
+    bool addPackedToList(const T &value);
+    template<typename T>
+    bool appendArray(const T *values, const std::uint64_t &count);
+    template<typename T, typename... Args>
+    void setArray(Args&&... args);
+    bool addVariantToArray(const ZVariant &value);
+
+    std::atomic<std::size_t> *payloadHash() const;
+    bool cachedHashesDiffer(const ZVariant &other) const;
+    std::size_t computeHash() const;
 
     union{
         bool m_bool;
@@ -389,16 +703,37 @@ private:
 
         zfloat32 m_float32;
         zfloat64 m_float64;
+
+        ZVariantPayload<std::string> *m_string;
+        ZVariantPayload<ZVariantList> *m_list;
+        ZVariantPayload<ZVariantMap> *m_map;
+        ZVariantPayload<ZIntegerVariantMap> *m_integerVariantMap;
+        ZVariantPayload<ZVariantHashMap> *m_hashMap;
+        ZVariantPayload<ZIntegerVariantHashMap> *m_integerHashMap;
+
+        ZVariantPayload<ZInt32Array> *m_int32Array;
+        ZVariantPayload<ZInt64Array> *m_int64Array;
+        ZVariantPayload<ZUInt8Array> *m_uint8Array;
+        ZVariantPayload<ZFloat32Array> *m_float32Array;
+        ZVariantPayload<ZFloat64Array> *m_float64Array;
     };
 
-    std::string m_string;
-    ZVariantList m_list;
-    ZVariantMap m_map;
-    ZIntegerVariantMap m_integerVariantMap;
+    ZVariantType m_variantType;
+};
+
+static_assert(sizeof(ZVariant) <= 16, "ZVariant must stay within 16 bytes");
 
+/* a ZVariant owns its payload only through a pointer, so it can be moved with memcpy */
+template<>
+struct is_trivially_relocatable<ZVariant> : std::true_type
+{
 };
 
+}
 
+inline std::size_t std::hash<zyxcba::ZVariant>::operator()(const zyxcba::ZVariant &variant) const
+{
+    return variant.hash();
 }
 
 #endif // ZVARIANT_H
@@ -0,0 +1,512 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ZVARIANTSERIALIZER_H
+#define ZVARIANTSERIALIZER_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "zbytereader.h"
+#include "zendian.h"
+#include "zvariant.h"
+#include "zvarint.h"
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZStringSink class
+///
+/// ZStringSink appends serialized bytes to a caller owned std::string, which can be reused
+/// across calls to avoid reallocating the buffer.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZStringSink
+{
+public:
+    explicit ZStringSink(std::string &buffer): m_buffer(buffer) {}
+
+    void append(const char *data, const std::size_t &size)
+    {
+        this->m_buffer.append(data, size);
+    }
+
+private:
+    std::string &m_buffer;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZMemorySource class
+///
+/// ZMemorySource reads serialized bytes from a memory range without copying it. It is a
+/// ZByteReader underneath, so varints are decoded and bounds checked by ZVarint.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZMemorySource
+{
+public:
+    ZMemorySource(const char *data, const std::size_t &size): m_reader(data, size) {}
+    explicit ZMemorySource(const std::string &buffer): ZMemorySource(buffer.data(), buffer.size()) {}
+
+    /* returns the next size bytes and advances past them, or nullptr if fewer are left */
+    const char *take(const std::size_t &size)
+    {
+        const char *data = this->m_reader.current();
+        return this->m_reader.skip(size) ? data : nullptr;
+    }
+
+    bool readVarint(std::uint64_t &value) { return this->m_reader.readVarint(value); }
+
+    std::size_t remaining() const { return this->m_reader.remaining(); }
+    std::size_t offset() const { return this->m_reader.position(); }
+
+private:
+    ZByteReader m_reader;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZVariantSerializer class
+///
+/// ZVariantSerializer writes a ZVariant tree in a compact self-describing binary format and
+/// reads it back. Every value starts with its ZVariantType as one byte, followed by
+///
+///  - Bool, Int8, UInt8: one byte
+///  - Int16 to UInt64, Float32, Float64: the value in little endian byte order
+///  - String: varint length, then the bytes
+///  - List: varint count, then the values
+///  - Map, HashMap: varint count, then key and value pairs
+///  - IntegerVariantMap, IntegerHashMap: varint count, then varint key and value pairs
+///  - Int32Array to Float64Array: varint count, then the packed elements in little endian
+///
+/// A Sink needs append(const char *data, std::size_t size). A Source needs
+/// const char *take(std::size_t size) returning nullptr when the input is too short,
+/// bool readVarint(std::uint64_t &value) and std::size_t remaining(). Deserialization rejects
+/// truncated or malformed input and trees nested deeper than MaxDepth.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZVariantSerializer
+{
+public:
+    static const std::size_t MaxDepth = 512;
+
+    template<typename Sink>
+    static bool serialize(const ZVariant &variant, Sink &sink)
+    {
+        char tag = static_cast<char>(variant.variantType());
+        sink.append(&tag, 1);
+
+        switch (variant.variantType())
+        {
+        case ZVariantType::None:
+            return true;
+        case ZVariantType::Bool:
+            return ZVariantSerializer::writeFixed<std::uint8_t>(sink, variant.getBool() ? 1 : 0);
+        case ZVariantType::Int8:
+            return ZVariantSerializer::writeFixed<std::uint8_t>(sink, static_cast<std::uint8_t>(variant.getInt8()));
+        case ZVariantType::Int16:
+            return ZVariantSerializer::writeFixed<std::uint16_t>(sink, static_cast<std::uint16_t>(variant.getInt16()));
+        case ZVariantType::Int32:
+            return ZVariantSerializer::writeFixed<std::uint32_t>(sink, static_cast<std::uint32_t>(variant.getInt32()));
+        case ZVariantType::Int64:
+            return ZVariantSerializer::writeFixed<std::uint64_t>(sink, static_cast<std::uint64_t>(variant.getInt64()));
+        case ZVariantType::UInt8:
+            return ZVariantSerializer::writeFixed<std::uint8_t>(sink, variant.getUInt8());
+        case ZVariantType::UInt16:
+            return ZVariantSerializer::writeFixed<std::uint16_t>(sink, variant.getUInt16());
+        case ZVariantType::UInt32:
+            return ZVariantSerializer::writeFixed<std::uint32_t>(sink, variant.getUInt32());
+        case ZVariantType::UInt64:
+            return ZVariantSerializer::writeFixed<std::uint64_t>(sink, variant.getUInt64());
+        case ZVariantType::Float32:
+            return ZVariantSerializer::writeFixed<std::uint32_t>(sink, ZVariantSerializer::bitsOf<std::uint32_t>(variant.getFloat32()));
+        case ZVariantType::Float64:
+            return ZVariantSerializer::writeFixed<std::uint64_t>(sink, ZVariantSerializer::bitsOf<std::uint64_t>(variant.getFloat64()));
+
+        case ZVariantType::String:
+        {
+            const std::string &value = variant.getString();
+            ZVariantSerializer::writeVarint(sink, value.size());
+            sink.append(value.data(), value.size());
+            return true;
+        }
+        case ZVariantType::List:
+        {
+            const ZVariantList &list = variant.getList();
+            ZVariantSerializer::writeVarint(sink, list.size());
+            for(const ZVariant &value : list)
+            {
+                if(!ZVariantSerializer::serialize(value, sink)) return false;
+            }
+            return true;
+        }
+        case ZVariantType::Map:
+        {
+            const ZVariantMap &map = variant.getMap();
+            ZVariantSerializer::writeVarint(sink, map.size());
+            for(const auto &entry : map)
+            {
+                if(!ZVariantSerializer::serialize(entry.first, sink)) return false;
+                if(!ZVariantSerializer::serialize(entry.second, sink)) return false;
+            }
+            return true;
+        }
+        case ZVariantType::IntegerVariantMap:
+        {
+            const ZIntegerVariantMap &map = variant.getIntegerVariantMap();
+            ZVariantSerializer::writeVarint(sink, map.size());
+            for(const auto &entry : map)
+            {
+                ZVariantSerializer::writeVarint(sink, entry.first);
+                if(!ZVariantSerializer::serialize(entry.second, sink)) return false;
+            }
+            return true;
+        }
+        case ZVariantType::HashMap:
+        {
+            const ZVariantHashMap &map = variant.getHashMap();
+            ZVariantSerializer::writeVarint(sink, map.size());
+            for(auto it = map.cbegin(); it != map.cend(); ++it)
+            {
+                if(!ZVariantSerializer::serialize(it.key(), sink)) return false;
+                if(!ZVariantSerializer::serialize(it.value(), sink)) return false;
+            }
+            return true;
+        }
+        case ZVariantType::IntegerHashMap:
+        {
+            const ZIntegerVariantHashMap &map = variant.getIntegerHashMap();
+            ZVariantSerializer::writeVarint(sink, map.size());
+            for(auto it = map.cbegin(); it != map.cend(); ++it)
+            {
+                ZVariantSerializer::writeVarint(sink, it.key());
+                if(!ZVariantSerializer::serialize(it.value(), sink)) return false;
+            }
+            return true;
+        }
+        case ZVariantType::Int32Array:
+            return ZVariantSerializer::writeArray(sink, variant.getInt32Array());
+        case ZVariantType::Int64Array:
+            return ZVariantSerializer::writeArray(sink, variant.getInt64Array());
+        case ZVariantType::UInt8Array:
+            return ZVariantSerializer::writeArray(sink, variant.getUInt8Array());
+        case ZVariantType::Float32Array:
+            return ZVariantSerializer::writeArray(sink, variant.getFloat32Array());
+        case ZVariantType::Float64Array:
+            return ZVariantSerializer::writeArray(sink, variant.getFloat64Array());
+        default:
+            return false;
+        }
+    }
+
+    template<typename Source>
+    static bool deserialize(Source &source, ZVariant &variant)
+    {
+        variant.makeInvalid();
+        if(ZVariantSerializer::readValue(source, variant, 0)) return true;
+
+        variant.makeInvalid();
+        return false;
+    }
+
+private:
+    friend class ZVariantView;
+
+    template<typename T, typename F>
+    static T bitsOf(const F &value)
+    {
+        static_assert(sizeof(T) == sizeof(F), "size mismatch");
+        T bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        return bits;
+    }
+
+    template<typename T, typename Sink>
+    static bool writeFixed(Sink &sink, const T &value)
+    {
+        char buffer[sizeof(T)];
+        store_le(buffer, value);
+        sink.append(buffer, sizeof(T));
+        return true;
+    }
+
+    template<typename Sink>
+    static void writeVarint(Sink &sink, std::uint64_t value)
+    {
+        char buffer[ZVarint::MaxVarintSize];
+        sink.append(buffer, static_cast<std::size_t>(ZVarint::encodeVarint(value, buffer) - buffer));
+    }
+
+    /* little endian hosts write the elements as one block */
+    template<typename Sink, typename T>
+    static bool writeArray(Sink &sink, const ZVector<T> &array)
+    {
+        ZVariantSerializer::writeVarint(sink, array.size());
+        if(isLittleEndianHost())
+        {
+            if(!array.empty()) sink.append(reinterpret_cast<const char*>(array.data()), array.size() * sizeof(T));
+            return true;
+        }
+
+        for(const T &value : array) ZVariantSerializer::writeFixed(sink, value);
+        return true;
+    }
+
+    template<typename T, typename Source>
+    static bool readArray(Source &source, ZVariant &variant)
+    {
+        std::uint64_t count;
+        if(!source.readVarint(count) || count > source.remaining() / sizeof(T)) return false;
+        const char *data = source.take(static_cast<std::size_t>(count) * sizeof(T));
+        if(data == nullptr) return false;
+
+        ZVector<T> array;
+        array.resize(static_cast<std::size_t>(count));
+        if(isLittleEndianHost())
+        {
+            if(count > 0) std::memcpy(array.data(), data, static_cast<std::size_t>(count) * sizeof(T));
+        }
+        else
+        {
+            for(std::size_t i = 0; i < array.size(); ++i) array[i] = load_le<T>(data + i * sizeof(T));
+        }
+
+        variant = ZVariant(std::move(array));
+        return true;
+    }
+
+    template<typename T, typename Source>
+    static bool readFixed(Source &source, T &value)
+    {
+        const char *data = source.take(sizeof(T));
+        if(data == nullptr) return false;
+
+        value = load_le<T>(data);
+        return true;
+    }
+
+    /* every element takes at least one byte, larger counts cannot be satisfied by the input */
+    template<typename Source>
+    static bool readCount(Source &source, std::uint64_t &count)
+    {
+        return source.readVarint(count) && count <= source.remaining();
+    }
+
+    template<typename Source>
+    static bool readValue(Source &source, ZVariant &variant, const std::size_t &depth)
+    {
+        std::uint8_t tag;
+        if(!ZVariantSerializer::readFixed(source, tag)) return false;
+
+        switch (static_cast<ZVariantType>(tag))
+        {
+        case ZVariantType::None:
+            return true;
+        case ZVariantType::Bool:
+        {
+            std::uint8_t value;
+            if(!ZVariantSerializer::readFixed(source, value) || value > 1) return false;
+            variant.setBool(value != 0);
+            return true;
+        }
+        case ZVariantType::Int8:
+        {
+            std::uint8_t value;
+            if(!ZVariantSerializer::readFixed(source, value)) return false;
+            variant.setInt8(static_cast<std::int8_t>(value));
+            return true;
+        }
+        case ZVariantType::Int16:
+        {
+            std::uint16_t value;
+            if(!ZVariantSerializer::readFixed(source, value)) return false;
+            variant.setInt16(static_cast<std::int16_t>(value));
+            return true;
+        }
+        case ZVariantType::Int32:
+        {
+            std::uint32_t value;
+            if(!ZVariantSerializer::readFixed(source, value)) return false;
+            variant.setInt32(static_cast<std::int32_t>(value));
+            return true;
+        }
+        case ZVariantType::Int64:
+        {
+            std::uint64_t value;
+            if(!ZVariantSerializer::readFixed(source, value)) return false;
+            variant.setInt64(static_cast<std::int64_t>(value));
+            return true;
+        }
+        case ZVariantType::UInt8:
+        {
+            std::uint8_t value;
+            if(!ZVariantSerializer::readFixed(source, value)) return false;
+            variant.setUInt8(value);
+            return true;
+        }
+        case ZVariantType::UInt16:
+        {
+            std::uint16_t value;
+            if(!ZVariantSerializer::readFixed(source, value)) return false;
+            variant.setUInt16(value);
+            return true;
+        }
+        case ZVariantType::UInt32:
+        {
+            std::uint32_t value;
+            if(!ZVariantSerializer::readFixed(source, value)) return false;
+            variant.setUInt32(value);
+            return true;
+        }
+        case ZVariantType::UInt64:
+        {
+            std::uint64_t value;
+            if(!ZVariantSerializer::readFixed(source, value)) return false;
+            variant.setUInt64(value);
+            return true;
+        }
+        case ZVariantType::Float32:
+        {
+            std::uint32_t value;
+            if(!ZVariantSerializer::readFixed(source, value)) return false;
+            variant.setFloat32(ZVariantSerializer::bitsOf<zfloat32>(value));
+            return true;
+        }
+        case ZVariantType::Float64:
+        {
+            std::uint64_t value;
+            if(!ZVariantSerializer::readFixed(source, value)) return false;
+            variant.setFloat64(ZVariantSerializer::bitsOf<zfloat64>(value));
+            return true;
+        }
+
+        case ZVariantType::String:
+        {
+            std::uint64_t size;
+            if(!source.readVarint(size) || size > source.remaining()) return false;
+            const char *data = source.take(static_cast<std::size_t>(size));
+            if(data == nullptr) return false;
+            variant.setString(std::string(data, static_cast<std::size_t>(size)));
+            return true;
+        }
+
+        case ZVariantType::Int32Array:
+            return ZVariantSerializer::readArray<std::int32_t>(source, variant);
+        case ZVariantType::Int64Array:
+            return ZVariantSerializer::readArray<std::int64_t>(source, variant);
+        case ZVariantType::UInt8Array:
+            return ZVariantSerializer::readArray<std::uint8_t>(source, variant);
+        case ZVariantType::Float32Array:
+            return ZVariantSerializer::readArray<zfloat32>(source, variant);
+        case ZVariantType::Float64Array:
+            return ZVariantSerializer::readArray<zfloat64>(source, variant);
+
+        default:
+            break;
+        }
+
+        if(depth >= MaxDepth) return false;
+
+        std::uint64_t count;
+        if(!ZVariantSerializer::readCount(source, count)) return false;
+
+        switch (static_cast<ZVariantType>(tag))
+        {
+        case ZVariantType::List:
+            variant.setList();
+            variant.reserveList(count);
+            for(std::uint64_t i = 0; i < count; ++i)
+            {
+                ZVariant value;
+                if(!ZVariantSerializer::readValue(source, value, depth + 1)) return false;
+                variant.addToList(std::move(value));
+            }
+            return true;
+
+        case ZVariantType::Map:
+            variant.setMap();
+            for(std::uint64_t i = 0; i < count; ++i)
+            {
+                ZVariant key;
+                ZVariant value;
+                if(!ZVariantSerializer::readValue(source, key, depth + 1)) return false;
+                if(!ZVariantSerializer::readValue(source, value, depth + 1)) return false;
+                variant.addToMap(std::move(key), std::move(value));
+            }
+            return true;
+
+        case ZVariantType::IntegerVariantMap:
+            variant.setIntVarMap();
+            for(std::uint64_t i = 0; i < count; ++i)
+            {
+                std::uint64_t key;
+                ZVariant value;
+                if(!source.readVarint(key)) return false;
+                if(!ZVariantSerializer::readValue(source, value, depth + 1)) return false;
+                variant.addToIntVarMap(key, std::move(value));
+            }
+            return true;
+
+        case ZVariantType::HashMap:
+            variant.setHashMap();
+            variant.reserveHashMap(count);
+            for(std::uint64_t i = 0; i < count; ++i)
+            {
+                ZVariant key;
+                ZVariant value;
+                if(!ZVariantSerializer::readValue(source, key, depth + 1)) return false;
+                if(!ZVariantSerializer::readValue(source, value, depth + 1)) return false;
+                variant.addToHashMap(std::move(key), std::move(value));
+            }
+            return true;
+
+        case ZVariantType::IntegerHashMap:
+            variant.setIntegerHashMap();
+            variant.reserveIntegerHashMap(count);
+            for(std::uint64_t i = 0; i < count; ++i)
+            {
+                std::uint64_t key;
+                ZVariant value;
+                if(!source.readVarint(key)) return false;
+                if(!ZVariantSerializer::readValue(source, value, depth + 1)) return false;
+                variant.addToIntegerHashMap(key, std::move(value));
+            }
+            return true;
+
+        default:
+            return false;
+        }
+    }
+};
+
+}
+
+#endif // ZVARIANTSERIALIZER_H
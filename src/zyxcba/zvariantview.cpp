@@ -0,0 +1,625 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "zvariantview.h"
+#include "zvariantserializer.h"
+
+namespace zyxcba {
+
+namespace {
+
+bool hasIntegerKeys(const ZVariantType &variantType)
+{
+    return variantType == ZVariantType::IntegerVariantMap || variantType == ZVariantType::IntegerHashMap;
+}
+
+bool hasVariantKeys(const ZVariantType &variantType)
+{
+    return variantType == ZVariantType::Map || variantType == ZVariantType::HashMap;
+}
+
+}
+
+ZVariantView::ZVariantView():
+    m_data(nullptr),
+    m_end(nullptr)
+{
+
+}
+
+ZVariantView::ZVariantView(const char *data, const std::size_t &size):
+    m_data(data),
+    m_end(data + size)
+{
+
+}
+
+ZVariantView::ZVariantView(const std::string &buffer):
+    ZVariantView(buffer.data(), buffer.size())
+{
+
+}
+
+ZVariantType ZVariantView::variantType() const
+{
+    if(this->m_data == nullptr || this->m_data >= this->m_end) return ZVariantType::None;
+
+    std::uint8_t tag = static_cast<std::uint8_t>(*this->m_data);
+    if(tag > static_cast<std::uint8_t>(ZVariantType::Float64Array)) return ZVariantType::None;
+    return static_cast<ZVariantType>(tag);
+}
+
+std::string ZVariantView::variantTypeString() const
+{
+    return ZVariant::variantTypeName(this->variantType());
+}
+
+bool ZVariantView::isWellFormed() const
+{
+    return this->m_data != nullptr && ZVariantView::skip(this->m_data, this->m_end, 0) != nullptr;
+}
+
+std::size_t ZVariantView::encodedSize() const
+{
+    if(this->m_data == nullptr) return 0;
+
+    const char *end = ZVariantView::skip(this->m_data, this->m_end, 0);
+    return end ? static_cast<std::size_t>(end - this->m_data) : 0;
+}
+
+ZStringView ZVariantView::encoded() const
+{
+    return ZStringView(this->m_data, this->encodedSize());
+}
+
+bool ZVariantView::isValid() const
+{
+    return !this->isNone();
+}
+
+bool ZVariantView::isNone() const
+{
+    return this->variantType() == ZVariantType::None;
+}
+
+bool ZVariantView::isBool() const
+{
+    return this->variantType() == ZVariantType::Bool;
+}
+
+bool ZVariantView::isInt8() const
+{
+    return this->variantType() == ZVariantType::Int8;
+}
+
+bool ZVariantView::isInt16() const
+{
+    return this->variantType() == ZVariantType::Int16;
+}
+
+bool ZVariantView::isInt32() const
+{
+    return this->variantType() == ZVariantType::Int32;
+}
+
+bool ZVariantView::isInt64() const
+{
+    return this->variantType() == ZVariantType::Int64;
+}
+
+bool ZVariantView::isUInt8() const
+{
+    return this->variantType() == ZVariantType::UInt8;
+}
+
+bool ZVariantView::isUInt16() const
+{
+    return this->variantType() == ZVariantType::UInt16;
+}
+
+bool ZVariantView::isUInt32() const
+{
+    return this->variantType() == ZVariantType::UInt32;
+}
+
+bool ZVariantView::isUInt64() const
+{
+    return this->variantType() == ZVariantType::UInt64;
+}
+
+bool ZVariantView::isFloat32() const
+{
+    return this->variantType() == ZVariantType::Float32;
+}
+
+bool ZVariantView::isFloat64() const
+{
+    return this->variantType() == ZVariantType::Float64;
+}
+
+bool ZVariantView::isNumber() const
+{
+    ZVariantType variantType = this->variantType();
+    return variantType >= ZVariantType::Int8 && variantType <= ZVariantType::Float64;
+}
+
+bool ZVariantView::isString() const
+{
+    return this->variantType() == ZVariantType::String;
+}
+
+bool ZVariantView::isMap() const
+{
+    return this->variantType() == ZVariantType::Map;
+}
+
+bool ZVariantView::isList() const
+{
+    return this->variantType() == ZVariantType::List;
+}
+
+bool ZVariantView::isIntVarMap() const
+{
+    return this->variantType() == ZVariantType::IntegerVariantMap;
+}
+
+bool ZVariantView::isIntegerVariantMap() const
+{
+    return this->variantType() == ZVariantType::IntegerVariantMap;
+}
+
+bool ZVariantView::isHashMap() const
+{
+    return this->variantType() == ZVariantType::HashMap;
+}
+
+bool ZVariantView::isIntegerHashMap() const
+{
+    return this->variantType() == ZVariantType::IntegerHashMap;
+}
+
+bool ZVariantView::isArray() const
+{
+    return ZVariant::arrayElementSize(this->variantType()) != 0;
+}
+
+bool ZVariantView::isInt32Array() const
+{
+    return this->variantType() == ZVariantType::Int32Array;
+}
+
+bool ZVariantView::isInt64Array() const
+{
+    return this->variantType() == ZVariantType::Int64Array;
+}
+
+bool ZVariantView::isUInt8Array() const
+{
+    return this->variantType() == ZVariantType::UInt8Array;
+}
+
+bool ZVariantView::isFloat32Array() const
+{
+    return this->variantType() == ZVariantType::Float32Array;
+}
+
+bool ZVariantView::isFloat64Array() const
+{
+    return this->variantType() == ZVariantType::Float64Array;
+}
+
+template<typename T>
+T ZVariantView::scalar(const ZVariantType &variantType) const
+{
+    if(this->variantType() != variantType) return 0;
+
+    ZMemorySource source(this->m_data + 1, static_cast<std::size_t>(this->m_end - this->m_data - 1));
+    T value;
+    if(!ZVariantSerializer::readFixed(source, value)) return 0;
+    return value;
+}
+
+bool ZVariantView::getBool() const
+{
+    return this->scalar<std::uint8_t>(ZVariantType::Bool) != 0;
+}
+
+std::int8_t ZVariantView::getInt8() const
+{
+    return static_cast<std::int8_t>(this->scalar<std::uint8_t>(ZVariantType::Int8));
+}
+
+std::int16_t ZVariantView::getInt16() const
+{
+    return static_cast<std::int16_t>(this->scalar<std::uint16_t>(ZVariantType::Int16));
+}
+
+std::int32_t ZVariantView::getInt32() const
+{
+    return static_cast<std::int32_t>(this->scalar<std::uint32_t>(ZVariantType::Int32));
+}
+
+std::int64_t ZVariantView::getInt64() const
+{
+    return static_cast<std::int64_t>(this->scalar<std::uint64_t>(ZVariantType::Int64));
+}
+
+std::uint8_t ZVariantView::getUInt8() const
+{
+    return this->scalar<std::uint8_t>(ZVariantType::UInt8);
+}
+
+std::uint16_t ZVariantView::getUInt16() const
+{
+    return this->scalar<std::uint16_t>(ZVariantType::UInt16);
+}
+
+std::uint32_t ZVariantView::getUInt32() const
+{
+    return this->scalar<std::uint32_t>(ZVariantType::UInt32);
+}
+
+std::uint64_t ZVariantView::getUInt64() const
+{
+    return this->scalar<std::uint64_t>(ZVariantType::UInt64);
+}
+
+zfloat32 ZVariantView::getFloat32() const
+{
+    return ZVariantSerializer::bitsOf<zfloat32>(this->scalar<std::uint32_t>(ZVariantType::Float32));
+}
+
+zfloat64 ZVariantView::getFloat64() const
+{
+    return ZVariantSerializer::bitsOf<zfloat64>(this->scalar<std::uint64_t>(ZVariantType::Float64));
+}
+
+zfloat64 ZVariantView::getNumber() const
+{
+    switch (this->variantType()) {
+    case ZVariantType::Int8:
+        return static_cast<zfloat64>(this->getInt8());
+    case ZVariantType::Int16:
+        return static_cast<zfloat64>(this->getInt16());
+    case ZVariantType::Int32:
+        return static_cast<zfloat64>(this->getInt32());
+    case ZVariantType::Int64:
+        return static_cast<zfloat64>(this->getInt64());
+
+    case ZVariantType::UInt8:
+        return static_cast<zfloat64>(this->getUInt8());
+    case ZVariantType::UInt16:
+        return static_cast<zfloat64>(this->getUInt16());
+    case ZVariantType::UInt32:
+        return static_cast<zfloat64>(this->getUInt32());
+    case ZVariantType::UInt64:
+        return static_cast<zfloat64>(this->getUInt64());
+
+    case ZVariantType::Float32:
+        return static_cast<zfloat64>(this->getFloat32());
+    case ZVariantType::Float64:
+        return this->getFloat64();
+    default:
+        return 0;
+    }
+}
+
+std::uint64_t ZVariantView::getLength() const
+{
+    std::uint64_t count;
+    const char *body;
+    return this->header(count, body) ? count : 0;
+}
+
+ZStringView ZVariantView::getString() const
+{
+    std::uint64_t size;
+    const char *body;
+    if(!this->isString() || !this->header(size, body)) return ZStringView();
+    if(size > static_cast<std::uint64_t>(this->m_end - body)) return ZStringView();
+    return ZStringView(body, static_cast<std::size_t>(size));
+}
+
+ZStringView ZVariantView::getArrayBytes() const
+{
+    std::uint64_t count;
+    const char *body;
+    std::size_t elementSize = ZVariant::arrayElementSize(this->variantType());
+    if(elementSize == 0 || !this->header(count, body)) return ZStringView();
+    if(count > static_cast<std::uint64_t>(this->m_end - body) / elementSize) return ZStringView();
+    return ZStringView(body, static_cast<std::size_t>(count) * elementSize);
+}
+
+zfloat64 ZVariantView::numberAt(const std::uint64_t &index) const
+{
+    ZStringView bytes = this->getArrayBytes();
+    std::size_t elementSize = ZVariant::arrayElementSize(this->variantType());
+    if(elementSize == 0 || index >= bytes.size() / elementSize) return 0;
+
+    const char *element = bytes.data() + static_cast<std::size_t>(index) * elementSize;
+    switch (this->variantType())
+    {
+    case ZVariantType::Int32Array:
+        return static_cast<zfloat64>(load_le<std::int32_t>(element));
+    case ZVariantType::Int64Array:
+        return static_cast<zfloat64>(load_le<std::int64_t>(element));
+    case ZVariantType::UInt8Array:
+        return static_cast<zfloat64>(static_cast<std::uint8_t>(*element));
+    case ZVariantType::Float32Array:
+        return static_cast<zfloat64>(load_le<zfloat32>(element));
+    default:
+        return load_le<zfloat64>(element);
+    }
+}
+
+ZVariantView ZVariantView::at(const std::uint64_t &index) const
+{
+    std::uint64_t count;
+    const char *data;
+    if(!this->isList() || !this->header(count, data) || index >= count) return ZVariantView();
+
+    for(std::uint64_t i = 0; i < index; ++i)
+    {
+        data = ZVariantView::skip(data, this->m_end, 1);
+        if(data == nullptr) return ZVariantView();
+    }
+    return ZVariantView(data, static_cast<std::size_t>(this->m_end - data));
+}
+
+ZVariantView ZVariantView::keyAt(const std::uint64_t &index) const
+{
+    const char *key;
+    const char *value;
+    if(!hasVariantKeys(this->variantType()) || !this->entry(index, key, value)) return ZVariantView();
+    return ZVariantView(key, static_cast<std::size_t>(this->m_end - key));
+}
+
+ZVariantView ZVariantView::valueAt(const std::uint64_t &index) const
+{
+    const char *key;
+    const char *value;
+    if(!this->entry(index, key, value)) return ZVariantView();
+    return ZVariantView(value, static_cast<std::size_t>(this->m_end - value));
+}
+
+std::uint64_t ZVariantView::integerKeyAt(const std::uint64_t &index) const
+{
+    const char *key;
+    const char *value;
+    if(!hasIntegerKeys(this->variantType()) || !this->entry(index, key, value)) return 0;
+
+    ZMemorySource source(key, static_cast<std::size_t>(this->m_end - key));
+    std::uint64_t integerKey;
+    return source.readVarint(integerKey) ? integerKey : 0;
+}
+
+ZVariantView ZVariantView::find(const ZStringView &key) const
+{
+    std::uint64_t count;
+    const char *data;
+    if(!hasVariantKeys(this->variantType()) || !this->header(count, data)) return ZVariantView();
+
+    for(std::uint64_t i = 0; i < count; ++i)
+    {
+        ZVariantView candidate(data, static_cast<std::size_t>(this->m_end - data));
+        const char *value = ZVariantView::skip(data, this->m_end, 1);
+        if(value == nullptr) return ZVariantView();
+
+        if(candidate.isString() && candidate.getString() == key)
+        {
+            return ZVariantView(value, static_cast<std::size_t>(this->m_end - value));
+        }
+
+        data = ZVariantView::skip(value, this->m_end, 1);
+        if(data == nullptr) return ZVariantView();
+    }
+    return ZVariantView();
+}
+
+ZVariantView ZVariantView::find(const char *key) const
+{
+    return this->find(ZStringView(key));
+}
+
+ZVariantView ZVariantView::find(const std::string &key) const
+{
+    return this->find(ZStringView(key));
+}
+
+ZVariantView ZVariantView::find(const std::uint64_t &key) const
+{
+    std::uint64_t count;
+    const char *data;
+    if(!hasIntegerKeys(this->variantType()) || !this->header(count, data)) return ZVariantView();
+
+    for(std::uint64_t i = 0; i < count; ++i)
+    {
+        ZMemorySource source(data, static_cast<std::size_t>(this->m_end - data));
+        std::uint64_t candidate;
+        if(!source.readVarint(candidate)) return ZVariantView();
+
+        const char *value = data + source.offset();
+        if(candidate == key) return ZVariantView(value, static_cast<std::size_t>(this->m_end - value));
+
+        data = ZVariantView::skip(value, this->m_end, 1);
+        if(data == nullptr) return ZVariantView();
+    }
+    return ZVariantView();
+}
+
+ZVariantView ZVariantView::find(const ZVariant &key) const
+{
+    if(key.isString()) return this->find(ZStringView(key.getString()));
+
+    /* other keys match when their encoding is identical */
+    std::string encodedKey;
+    ZStringSink sink(encodedKey);
+    if(!ZVariantSerializer::serialize(key, sink)) return ZVariantView();
+
+    std::uint64_t count;
+    const char *data;
+    if(!hasVariantKeys(this->variantType()) || !this->header(count, data)) return ZVariantView();
+
+    for(std::uint64_t i = 0; i < count; ++i)
+    {
+        const char *value = ZVariantView::skip(data, this->m_end, 1);
+        if(value == nullptr) return ZVariantView();
+
+        if(ZStringView(data, static_cast<std::size_t>(value - data)) == ZStringView(encodedKey))
+        {
+            return ZVariantView(value, static_cast<std::size_t>(this->m_end - value));
+        }
+
+        data = ZVariantView::skip(value, this->m_end, 1);
+        if(data == nullptr) return ZVariantView();
+    }
+    return ZVariantView();
+}
+
+bool ZVariantView::toVariant(ZVariant &variant) const
+{
+    if(this->m_data == nullptr)
+    {
+        variant.makeInvalid();
+        return false;
+    }
+
+    ZMemorySource source(this->m_data, static_cast<std::size_t>(this->m_end - this->m_data));
+    return ZVariantSerializer::deserialize(source, variant);
+}
+
+bool ZVariantView::header(std::uint64_t &count, const char *&body) const
+{
+    ZVariantType variantType = this->variantType();
+    if(variantType < ZVariantType::String) return false;
+
+    ZMemorySource source(this->m_data + 1, static_cast<std::size_t>(this->m_end - this->m_data - 1));
+    if(!source.readVarint(count)) return false;
+
+    body = this->m_data + 1 + source.offset();
+    return true;
+}
+
+bool ZVariantView::entry(const std::uint64_t &index, const char *&key, const char *&value) const
+{
+    ZVariantType variantType = this->variantType();
+    if(!hasVariantKeys(variantType) && !hasIntegerKeys(variantType)) return false;
+
+    std::uint64_t count;
+    const char *data;
+    if(!this->header(count, data) || index >= count) return false;
+
+    for(std::uint64_t i = 0; ; ++i)
+    {
+        key = data;
+        if(hasIntegerKeys(variantType))
+        {
+            ZMemorySource source(data, static_cast<std::size_t>(this->m_end - data));
+            std::uint64_t integerKey;
+            if(!source.readVarint(integerKey)) return false;
+            value = data + source.offset();
+        }
+        else
+        {
+            value = ZVariantView::skip(data, this->m_end, 1);
+            if(value == nullptr) return false;
+        }
+
+        if(i == index) return true;
+
+        data = ZVariantView::skip(value, this->m_end, 1);
+        if(data == nullptr) return false;
+    }
+}
+
+const char *ZVariantView::skip(const char *data, const char *end, const std::size_t &depth)
+{
+    if(data >= end) return nullptr;
+
+    ZMemorySource source(data + 1, static_cast<std::size_t>(end - data - 1));
+    std::uint8_t tag = static_cast<std::uint8_t>(*data);
+
+    switch (static_cast<ZVariantType>(tag))
+    {
+    case ZVariantType::None:
+        return data + 1;
+    case ZVariantType::Bool:
+    case ZVariantType::Int8:
+    case ZVariantType::UInt8:
+        return source.take(1) ? data + 2 : nullptr;
+    case ZVariantType::Int16:
+    case ZVariantType::UInt16:
+        return source.take(2) ? data + 3 : nullptr;
+    case ZVariantType::Int32:
+    case ZVariantType::UInt32:
+    case ZVariantType::Float32:
+        return source.take(4) ? data + 5 : nullptr;
+    case ZVariantType::Int64:
+    case ZVariantType::UInt64:
+    case ZVariantType::Float64:
+        return source.take(8) ? data + 9 : nullptr;
+    default:
+        break;
+    }
+
+    std::uint64_t count;
+    if(!source.readVarint(count) || count > source.remaining()) return nullptr;
+
+    const char *next = data + 1 + source.offset();
+    ZVariantType variantType = static_cast<ZVariantType>(tag);
+    if(variantType == ZVariantType::String) return next + count;
+
+    std::size_t elementSize = ZVariant::arrayElementSize(variantType);
+    if(elementSize != 0) return count <= source.remaining() / elementSize ? next + count * elementSize : nullptr;
+
+    if(tag > static_cast<std::uint8_t>(ZVariantType::IntegerHashMap) || depth >= ZVariantSerializer::MaxDepth) return nullptr;
+
+    for(std::uint64_t i = 0; i < count && next != nullptr; ++i)
+    {
+        if(hasIntegerKeys(variantType))
+        {
+            ZMemorySource keySource(next, static_cast<std::size_t>(end - next));
+            std::uint64_t key;
+            if(!keySource.readVarint(key)) return nullptr;
+            next += keySource.offset();
+        }
+        else if(hasVariantKeys(variantType))
+        {
+            next = ZVariantView::skip(next, end, depth + 1);
+            if(next == nullptr) return nullptr;
+        }
+
+        next = ZVariantView::skip(next, end, depth + 1);
+    }
+    return next;
+}
+
+}
@@ -0,0 +1,159 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ZVARIANTVIEW_H
+#define ZVARIANTVIEW_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+
+#include "ztype.h"
+#include "zstringview.h"
+#include "zvariant.h"
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZVariantView class
+///
+/// ZVariantView reads one value of the ZVariantSerializer format in place, without building a
+/// ZVariant tree. It offers the same queries as ZVariant, strings come back as views into the
+/// buffer, and lists and maps can be indexed and searched. The buffer must outlive the view.
+///
+/// Every access is bounds checked, a malformed buffer reads as None or zero rather than out
+/// of range. Elements are found by skipping their predecessors, so indexed access and key
+/// lookup are linear in the bytes skipped. Typed arrays are the exception, their elements
+/// are packed, so numberAt() is O(1) and getArrayBytes() exposes them without a copy.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZVariantView
+{
+public:
+    ZVariantView();
+    ZVariantView(const char *data, const std::size_t &size);
+    explicit ZVariantView(const std::string &buffer);
+
+    ZVariantType variantType() const;
+    std::string variantTypeString() const;
+
+    bool isWellFormed() const;
+    std::size_t encodedSize() const;
+    ZStringView encoded() const;
+
+    bool isValid() const;
+    bool isNone() const;
+    bool isBool() const;
+
+    bool isInt8() const;
+    bool isInt16() const;
+    bool isInt32() const;
+    bool isInt64() const;
+
+    bool isUInt8() const;
+    bool isUInt16() const;
+    bool isUInt32() const;
+    bool isUInt64() const;
+
+    bool isFloat32() const;
+    bool isFloat64() const;
+
+    bool isNumber() const;
+
+    bool isString() const;
+
+    bool isMap() const;
+    bool isList() const;
+    bool isIntVarMap() const;
+    bool isIntegerVariantMap() const;
+    bool isHashMap() const;
+    bool isIntegerHashMap() const;
+
+    bool isArray() const;
+    bool isInt32Array() const;
+    bool isInt64Array() const;
+    bool isUInt8Array() const;
+    bool isFloat32Array() const;
+    bool isFloat64Array() const;
+
+    bool getBool() const;
+    std::int8_t getInt8() const;
+    std::int16_t getInt16() const;
+    std::int32_t getInt32() const;
+    std::int64_t getInt64() const;
+
+    std::uint8_t getUInt8() const;
+    std::uint16_t getUInt16() const;
+    std::uint32_t getUInt32() const;
+    std::uint64_t getUInt64() const;
+
+    zfloat32 getFloat32() const;
+    zfloat64 getFloat64() const;
+
+    zfloat64 getNumber() const;
+    std::uint64_t getLength() const;
+
+    ZStringView getString() const;
+
+    /* the packed little endian elements of a typed array */
+    ZStringView getArrayBytes() const;
+    zfloat64 numberAt(const std::uint64_t &index) const;
+
+    ZVariantView at(const std::uint64_t &index) const;
+    ZVariantView keyAt(const std::uint64_t &index) const;
+    ZVariantView valueAt(const std::uint64_t &index) const;
+    std::uint64_t integerKeyAt(const std::uint64_t &index) const;
+
+    ZVariantView find(const ZStringView &key) const;
+    ZVariantView find(const char *key) const;
+    ZVariantView find(const std::string &key) const;
+    ZVariantView find(const std::uint64_t &key) const;
+    ZVariantView find(const ZVariant &key) const;
+
+    bool toVariant(ZVariant &variant) const;
+
+private:
+    bool header(std::uint64_t &count, const char *&body) const;
+    bool entry(const std::uint64_t &index, const char *&key, const char *&value) const;
+
+    template<typename T>
+    T scalar(const ZVariantType &variantType) const;
+
+    static const char *skip(const char *data, const char *end, const std::size_t &depth);
+
+    const char *m_data;
+    const char *m_end;
+};
+
+}
+
+#endif // ZVARIANTVIEW_H
@@ -0,0 +1,246 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "zvarint.h"
+#include "zcpu.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define ZYXCBA_VARINT_X86 1
+#include <immintrin.h>
+#endif
+
+namespace zyxcba {
+
+namespace {
+
+const std::uint64_t ContinuationBits = 0x8080808080808080ULL;
+
+template<typename T>
+const char *decodeVarintArray(const char *source, const char *end, T *values, const std::size_t &count)
+{
+    std::size_t i = 0;
+    while(i < count)
+    {
+        /* eight bytes without a continuation bit are eight complete values */
+        if(count - i >= 8 && end - source >= 8)
+        {
+            const std::uint64_t word = load_le<std::uint64_t>(source);
+            if((word & ContinuationBits) == 0)
+            {
+                for(std::size_t j = 0; j < 8; ++j)
+                {
+                    values[i + j] = static_cast<T>(static_cast<unsigned char>(source[j]));
+                }
+                source += 8;
+                i += 8;
+                continue;
+            }
+        }
+
+        std::uint64_t value;
+        source = ZVarint::decodeVarint(source, end, value);
+        if(source == nullptr) return nullptr;
+        if(sizeof(T) < sizeof(std::uint64_t) && value > static_cast<T>(~static_cast<T>(0))) return nullptr;
+
+        values[i++] = static_cast<T>(value);
+    }
+    return source;
+}
+
+std::size_t byteLength(const std::uint32_t &value)
+{
+    if(value < (1U << 8)) return 1;
+    if(value < (1U << 16)) return 2;
+    if(value < (1U << 24)) return 3;
+    return 4;
+}
+
+const char *decodeScalar(const unsigned char *control, const char *data, const char *end,
+                         std::uint32_t *values, std::size_t index, const std::size_t &count)
+{
+    for(; index < count; ++index)
+    {
+        const std::size_t size = ((control[index / 4] >> (2 * (index % 4))) & 3) + 1;
+        if(static_cast<std::size_t>(end - data) < size) return nullptr;
+
+        unsigned char buffer[4] = {};
+        std::memcpy(buffer, data, size);
+        values[index] = load_le<std::uint32_t>(buffer);
+        data += size;
+    }
+    return data;
+}
+
+typedef const char *(*ZStreamVByteDecoder)(const unsigned char *control, const char *data, const char *end,
+                                           std::uint32_t *values, const std::size_t &count);
+
+/* a block spans at most sixteen bytes, while that many remain every value is read with a full
+ * four byte load and masked
+ */
+const char *decodeBlocks(const unsigned char *control, const char *data, const char *end,
+                         std::uint32_t *values, const std::size_t &count)
+{
+    std::size_t index = 0;
+    for(; index + 4 <= count && end - data >= 16; index += 4)
+    {
+        const unsigned bits = control[index / 4];
+        for(unsigned value = 0; value < 4; ++value)
+        {
+            const unsigned size = ((bits >> (2 * value)) & 3) + 1;
+            values[index + value] = load_le<std::uint32_t>(data) & (0xffffffffU >> (32 - 8 * size));
+            data += size;
+        }
+    }
+    return decodeScalar(control, data, end, values, index, count);
+}
+
+#ifdef ZYXCBA_VARINT_X86
+
+/* pshufb controls gathering the bytes of four values and their data length, per control byte */
+struct ZStreamVByteTables
+{
+    unsigned char shuffle[256][16];
+    unsigned char length[256];
+
+    ZStreamVByteTables()
+    {
+        for(unsigned control = 0; control < 256; ++control)
+        {
+            unsigned char next = 0;
+            for(unsigned value = 0; value < 4; ++value)
+            {
+                const unsigned size = ((control >> (2 * value)) & 3) + 1;
+                for(unsigned byte = 0; byte < 4; ++byte)
+                {
+                    this->shuffle[control][value * 4 + byte] = byte < size ? next++ : 0x80;
+                }
+            }
+            this->length[control] = next;
+        }
+    }
+};
+
+const ZStreamVByteTables &streamVByteTables()
+{
+    static const ZStreamVByteTables tables;
+    return tables;
+}
+
+__attribute__((target("ssse3")))
+const char *decodeSSSE3(const unsigned char *control, const char *data, const char *end,
+                        std::uint32_t *values, const std::size_t &count)
+{
+    const ZStreamVByteTables &tables = streamVByteTables();
+
+    /* a block reads sixteen data bytes, the last blocks are left to the scalar kernel */
+    std::size_t index = 0;
+    for(; index + 4 <= count && end - data >= 16; index += 4)
+    {
+        const unsigned bits = control[index / 4];
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.shuffle[bits]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(values + index), _mm_shuffle_epi8(bytes, mask));
+        data += tables.length[bits];
+    }
+    return decodeScalar(control, data, end, values, index, count);
+}
+
+#endif
+
+}
+
+const std::size_t ZVarint::MaxVarintSize;
+const std::size_t ZVarint::MaxPrefixVarintSize;
+
+const char *ZVarint::decodeVarints(const char *source, const char *end, std::uint64_t *values, const std::size_t &count)
+{
+    return decodeVarintArray(source, end, values, count);
+}
+
+const char *ZVarint::decodeVarints(const char *source, const char *end, std::uint32_t *values, const std::size_t &count)
+{
+    return decodeVarintArray(source, end, values, count);
+}
+
+std::size_t ZVarint::encodeStreamVByte(const std::uint32_t *values, const std::size_t &count, char *destination)
+{
+    if(count == 0) return 0;
+
+    unsigned char *control = reinterpret_cast<unsigned char*>(destination);
+    char *data = destination + (count + 3) / 4;
+    std::memset(control, 0, (count + 3) / 4);
+
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        const std::size_t size = byteLength(values[i]);
+        control[i / 4] = static_cast<unsigned char>(control[i / 4] | ((size - 1) << (2 * (i % 4))));
+
+        char buffer[4];
+        store_le(buffer, values[i]);
+        std::memcpy(data, buffer, size);
+        data += size;
+    }
+    return static_cast<std::size_t>(data - destination);
+}
+
+const char *ZVarint::decodeStreamVByte(const char *source, const char *end, std::uint32_t *values, const std::size_t &count)
+{
+    static const ZStreamVByteDecoder decoder = ZCpuDispatch<ZStreamVByteDecoder>(&decodeBlocks)
+#ifdef ZYXCBA_VARINT_X86
+            .add(ZCpuLevel::SSSE3, &decodeSSSE3)
+#endif
+            .resolve();
+
+    const std::size_t controlSize = (count + 3) / 4;
+    if(static_cast<std::size_t>(end - source) < controlSize) return nullptr;
+
+    return decoder(reinterpret_cast<const unsigned char*>(source), source + controlSize, end, values, count);
+}
+
+const char *ZVarint::decodeStreamVByteScalar(const char *source, const char *end, std::uint32_t *values, const std::size_t &count)
+{
+    const std::size_t controlSize = (count + 3) / 4;
+    if(static_cast<std::size_t>(end - source) < controlSize) return nullptr;
+
+    return decodeBlocks(reinterpret_cast<const unsigned char*>(source), source + controlSize, end, values, count);
+}
+
+bool ZVarint::isStreamVByteAccelerated()
+{
+#ifdef ZYXCBA_VARINT_X86
+    return ZCpu::supports(ZCpuLevel::SSSE3);
+#else
+    return false;
+#endif
+}
+
+}
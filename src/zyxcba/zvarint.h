@@ -0,0 +1,235 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef ZVARINT_H
+#define ZVARINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "zendian.h"
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZVarint class
+///
+/// ZVarint provides variable length integer codecs for values which are usually small.
+///
+/// LEB128 varints store seven bits per byte, the high bit marks that another byte follows.
+/// Signed values are zigzag mapped first so that small negative values stay short.
+///
+/// Prefix varints store the length in the trailing zero bits of the first byte, a value of n
+/// bytes (1 to 8) carries 7 * n bits and a zero first byte is followed by the full 64 bit value.
+/// Decoding needs one count trailing zeros and one unaligned load instead of a loop.
+///
+/// Stream-VByte packs the lengths of four 32 bit values into one control byte and keeps the
+/// control bytes apart from the data, so that blocks of four values decode with one shuffle.
+///
+/// Decoders take the end of the input and return nullptr when the input is truncated or the
+/// encoding is invalid, otherwise the position after the decoded bytes.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ZVarint
+{
+public:
+    static const std::size_t MaxVarintSize = 10;
+    static const std::size_t MaxPrefixVarintSize = 9;
+
+    static std::size_t varintSize(std::uint64_t value)
+    {
+        std::size_t size = 1;
+        while(value >= 0x80)
+        {
+            value >>= 7;
+            ++size;
+        }
+        return size;
+    }
+
+    static char *encodeVarint(std::uint64_t value, char *destination)
+    {
+        while(value >= 0x80)
+        {
+            *destination++ = static_cast<char>((value & 0x7f) | 0x80);
+            value >>= 7;
+        }
+        *destination++ = static_cast<char>(value);
+        return destination;
+    }
+
+    static const char *decodeVarint(const char *source, const char *end, std::uint64_t &value)
+    {
+        /* single byte values are the common case */
+        if(source != end && (static_cast<unsigned char>(*source) & 0x80) == 0)
+        {
+            value = static_cast<unsigned char>(*source);
+            return source + 1;
+        }
+
+        value = 0;
+        for(unsigned shift = 0; shift < 64 && source != end; shift += 7)
+        {
+            const std::uint64_t byte = static_cast<unsigned char>(*source++);
+            if(shift == 63 && byte > 1) return nullptr;
+
+            value |= (byte & 0x7f) << shift;
+            if((byte & 0x80) == 0) return source;
+        }
+        return nullptr;
+    }
+
+    static constexpr std::uint64_t zigzagEncode(std::int64_t value)
+    {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    static constexpr std::int64_t zigzagDecode(std::uint64_t value)
+    {
+        return static_cast<std::int64_t>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
+    static char *encodeSignedVarint(const std::int64_t &value, char *destination)
+    {
+        return ZVarint::encodeVarint(ZVarint::zigzagEncode(value), destination);
+    }
+
+    static const char *decodeSignedVarint(const char *source, const char *end, std::int64_t &value)
+    {
+        std::uint64_t encoded;
+        source = ZVarint::decodeVarint(source, end, encoded);
+        value = ZVarint::zigzagDecode(encoded);
+        return source;
+    }
+
+    static std::size_t prefixVarintSize(const std::uint64_t &value)
+    {
+        const unsigned bits = ZVarint::significantBits(value);
+        return bits > 56 ? 9 : (bits + 6) / 7;
+    }
+
+    static char *encodePrefixVarint(const std::uint64_t &value, char *destination)
+    {
+        const std::size_t size = ZVarint::prefixVarintSize(value);
+        if(size == 9)
+        {
+            *destination++ = 0;
+            store_le(destination, value);
+            return destination + 8;
+        }
+
+        const std::uint64_t encoded = (value << size) | (static_cast<std::uint64_t>(1) << (size - 1));
+        char buffer[8];
+        store_le(buffer, encoded);
+        std::memcpy(destination, buffer, size);
+        return destination + size;
+    }
+
+    static const char *decodePrefixVarint(const char *source, const char *end, std::uint64_t &value)
+    {
+        if(source == end) return nullptr;
+
+        const unsigned first = static_cast<unsigned char>(*source);
+        const std::size_t size = first == 0 ? 9 : ZVarint::trailingZeros(first) + 1;
+        const std::size_t available = static_cast<std::size_t>(end - source);
+        if(available < size) return nullptr;
+
+        if(size == 9)
+        {
+            value = load_le<std::uint64_t>(source + 1);
+            return source + 9;
+        }
+
+        std::uint64_t encoded;
+        if(available >= 8)
+        {
+            encoded = load_le<std::uint64_t>(source);
+        }
+        else
+        {
+            char buffer[8] = {};
+            std::memcpy(buffer, source, size);
+            encoded = load_le<std::uint64_t>(buffer);
+        }
+
+        /* shifting by 64 is undefined, the eight byte case keeps every bit */
+        if(size < 8) encoded &= (static_cast<std::uint64_t>(1) << (8 * size)) - 1;
+        value = encoded >> size;
+        return source + size;
+    }
+
+    /* decodes count LEB128 varints, eight single byte values are decoded per step */
+    static const char *decodeVarints(const char *source, const char *end, std::uint64_t *values, const std::size_t &count);
+    static const char *decodeVarints(const char *source, const char *end, std::uint32_t *values, const std::size_t &count);
+
+    static std::size_t streamVByteMaxSize(const std::size_t &count)
+    {
+        return (count + 3) / 4 + count * 4;
+    }
+
+    /* destination must hold streamVByteMaxSize(count) bytes, returns the encoded size */
+    static std::size_t encodeStreamVByte(const std::uint32_t *values, const std::size_t &count, char *destination);
+    static const char *decodeStreamVByte(const char *source, const char *end, std::uint32_t *values, const std::size_t &count);
+
+    /* decodes with the scalar kernel regardless of the cpu */
+    static const char *decodeStreamVByteScalar(const char *source, const char *end, std::uint32_t *values, const std::size_t &count);
+
+    static bool isStreamVByteAccelerated();
+
+private:
+    /* at least one, so that zero encodes in one byte */
+    static unsigned significantBits(const std::uint64_t &value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 64 - static_cast<unsigned>(__builtin_clzll(value | 1));
+#else
+        unsigned bits = 1;
+        while(bits < 64 && (value >> bits) != 0) ++bits;
+        return bits;
+#endif
+    }
+
+    static unsigned trailingZeros(const unsigned &value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctz(value));
+#else
+        unsigned count = 0;
+        while(((value >> count) & 1) == 0) ++count;
+        return count;
+#endif
+    }
+};
+
+}
+
+#endif // ZVARINT_H
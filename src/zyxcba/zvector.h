@@ -0,0 +1,543 @@
+/* Copyright (c) 2019, Md Kawser Munshi
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ *   Neither the names of the copyright owners nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef ZVECTOR_H
+#define ZVECTOR_H
+
+#include <new>
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
+#include <initializer_list>
+
+#include "ztype.h"
+#include "zarena.h"
+
+namespace zyxcba {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The ZVector class
+///
+/// ZVector is a contiguous sequence container with the common std::vector interface. When the
+/// element type is trivially relocatable the storage grows with realloc and bulk memory moves,
+/// otherwise elements are moved one by one like std::vector does. The allocator must provide
+/// reallocate() in addition to allocate() and deallocate(), as ZArenaAllocator does.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename T, typename Allocator = ZArenaAllocator<T> >
+class ZVector
+{
+public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T &reference;
+    typedef const T &const_reference;
+    typedef T *pointer;
+    typedef const T *const_pointer;
+    typedef T *iterator;
+    typedef const T *const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    ZVector():
+        m_data(nullptr),
+        m_size(0),
+        m_capacity(0)
+    {
+
+    }
+
+    explicit ZVector(const Allocator &allocator):
+        m_data(nullptr),
+        m_size(0),
+        m_capacity(0),
+        m_allocator(allocator)
+    {
+
+    }
+
+    explicit ZVector(size_type count):
+        m_data(nullptr),
+        m_size(0),
+        m_capacity(0)
+    {
+        this->resize(count);
+    }
+
+    ZVector(size_type count, const T &value):
+        m_data(nullptr),
+        m_size(0),
+        m_capacity(0)
+    {
+        this->resize(count, value);
+    }
+
+    ZVector(std::initializer_list<T> init):
+        m_data(nullptr),
+        m_size(0),
+        m_capacity(0)
+    {
+        this->reserve(init.size());
+        for(const T &value : init) new (this->m_data + this->m_size++) T(value);
+    }
+
+    template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    ZVector(InputIt first, InputIt last):
+        m_data(nullptr),
+        m_size(0),
+        m_capacity(0)
+    {
+        for(; first != last; ++first) this->push_back(*first);
+    }
+
+    ZVector(const ZVector &other):
+        ZVector(other, other.m_allocator.select_on_container_copy_construction())
+    {
+
+    }
+
+    ZVector(const ZVector &other, const Allocator &allocator):
+        m_data(nullptr),
+        m_size(0),
+        m_capacity(0),
+        m_allocator(allocator)
+    {
+        this->reserve(other.m_size);
+        for(; this->m_size < other.m_size; ++this->m_size)
+        {
+            new (this->m_data + this->m_size) T(other.m_data[this->m_size]);
+        }
+    }
+
+    ZVector(ZVector &&other) noexcept:
+        m_data(other.m_data),
+        m_size(other.m_size),
+        m_capacity(other.m_capacity),
+        m_allocator(other.m_allocator)
+    {
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_capacity = 0;
+    }
+
+    ZVector(ZVector &&other, const Allocator &allocator):
+        m_data(nullptr),
+        m_size(0),
+        m_capacity(0),
+        m_allocator(allocator)
+    {
+        if(this->m_allocator == other.m_allocator)
+        {
+            this->steal(other);
+            return;
+        }
+
+        /* different memory sources, the elements have to move one by one */
+        this->reserve(other.m_size);
+        for(; this->m_size < other.m_size; ++this->m_size)
+        {
+            new (this->m_data + this->m_size) T(std::move(other.m_data[this->m_size]));
+        }
+        other.clear();
+    }
+
+    ~ZVector()
+    {
+        this->clear();
+        this->deallocate();
+    }
+
+    ZVector &operator=(const ZVector &other)
+    {
+        if(this != &other)
+        {
+            /* the allocator is not propagated, the copy lands in our own memory source */
+            ZVector temp(other, this->m_allocator);
+            this->swap(temp);
+        }
+        return *this;
+    }
+
+    ZVector &operator=(ZVector &&other)
+    {
+        if(this != &other)
+        {
+            ZVector temp(std::move(other), this->m_allocator);
+            this->swap(temp);
+        }
+        return *this;
+    }
+
+    ZVector &operator=(std::initializer_list<T> init)
+    {
+        this->assign(init.begin(), init.end());
+        return *this;
+    }
+
+    void assign(size_type count, const T &value)
+    {
+        /* value may be one of our own elements */
+        T copy(value);
+        this->clear();
+        this->resize(count, copy);
+    }
+
+    template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    void assign(InputIt first, InputIt last)
+    {
+        ZVector values(this->m_allocator);
+        for(; first != last; ++first) values.push_back(*first);
+        this->swap(values);
+    }
+
+    void assign(std::initializer_list<T> init)
+    {
+        this->assign(init.begin(), init.end());
+    }
+
+    void swap(ZVector &other) noexcept
+    {
+        std::swap(this->m_data, other.m_data);
+        std::swap(this->m_size, other.m_size);
+        std::swap(this->m_capacity, other.m_capacity);
+        std::swap(this->m_allocator, other.m_allocator);
+    }
+
+    allocator_type get_allocator() const { return this->m_allocator; }
+
+    iterator begin() { return this->m_data; }
+    iterator end() { return this->m_data + this->m_size; }
+    const_iterator begin() const { return this->m_data; }
+    const_iterator end() const { return this->m_data + this->m_size; }
+    const_iterator cbegin() const { return this->m_data; }
+    const_iterator cend() const { return this->m_data + this->m_size; }
+    reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+    reverse_iterator rend() { return reverse_iterator(this->begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
+
+    bool empty() const { return this->m_size == 0; }
+    size_type size() const { return this->m_size; }
+    size_type capacity() const { return this->m_capacity; }
+    size_type max_size() const { return std::size_t(-1) / sizeof(T); }
+
+    T *data() { return this->m_data; }
+    const T *data() const { return this->m_data; }
+
+    T &operator[](size_type index) { return this->m_data[index]; }
+    const T &operator[](size_type index) const { return this->m_data[index]; }
+
+    T &at(size_type index)
+    {
+        if(index >= this->m_size) throw std::out_of_range("ZVector::at");
+        return this->m_data[index];
+    }
+
+    const T &at(size_type index) const
+    {
+        if(index >= this->m_size) throw std::out_of_range("ZVector::at");
+        return this->m_data[index];
+    }
+
+    T &front() { return this->m_data[0]; }
+    const T &front() const { return this->m_data[0]; }
+    T &back() { return this->m_data[this->m_size - 1]; }
+    const T &back() const { return this->m_data[this->m_size - 1]; }
+
+    void reserve(size_type capacity)
+    {
+        if(capacity > this->m_capacity) this->reallocate(capacity);
+    }
+
+    void shrink_to_fit()
+    {
+        if(this->m_size == 0)
+        {
+            this->deallocate();
+            this->m_data = nullptr;
+            this->m_capacity = 0;
+        }
+        else if(this->m_size < this->m_capacity)
+        {
+            this->reallocate(this->m_size);
+        }
+    }
+
+    void clear()
+    {
+        ZVector::destroy(this->m_data, this->m_data + this->m_size);
+        this->m_size = 0;
+    }
+
+    void resize(size_type count)
+    {
+        if(count < this->m_size)
+        {
+            ZVector::destroy(this->m_data + count, this->m_data + this->m_size);
+            this->m_size = count;
+            return;
+        }
+
+        this->reserve(count);
+        for(; this->m_size < count; ++this->m_size) new (this->m_data + this->m_size) T();
+    }
+
+    void resize(size_type count, const T &value)
+    {
+        if(count <= this->m_size)
+        {
+            this->resize(count);
+            return;
+        }
+
+        T copy(value);
+        this->reserve(count);
+        for(; this->m_size < count; ++this->m_size) new (this->m_data + this->m_size) T(copy);
+    }
+
+    void push_back(const T &value)
+    {
+        this->emplace_back(value);
+    }
+
+    void push_back(T &&value)
+    {
+        this->emplace_back(std::move(value));
+    }
+
+    template<typename... Args>
+    T &emplace_back(Args&&... args)
+    {
+        if(this->m_size == this->m_capacity)
+        {
+            /* the arguments may refer to our own elements, build the value before growing */
+            T value(std::forward<Args>(args)...);
+            this->reallocate(this->grownCapacity());
+            new (this->m_data + this->m_size) T(std::move(value));
+        }
+        else
+        {
+            new (this->m_data + this->m_size) T(std::forward<Args>(args)...);
+        }
+
+        return this->m_data[this->m_size++];
+    }
+
+    template<typename... Args>
+    iterator emplace(const_iterator position, Args&&... args)
+    {
+        /* built first, the arguments may refer to our own elements */
+        T value(std::forward<Args>(args)...);
+        return this->insertMoved(static_cast<size_type>(position - this->m_data), &value, 1);
+    }
+
+    iterator insert(const_iterator position, const T &value)
+    {
+        return this->emplace(position, value);
+    }
+
+    iterator insert(const_iterator position, T &&value)
+    {
+        return this->emplace(position, std::move(value));
+    }
+
+    iterator insert(const_iterator position, size_type count, const T &value)
+    {
+        ZVector values;
+        values.resize(count, value);
+        return this->insertMoved(static_cast<size_type>(position - this->m_data), values.m_data, count);
+    }
+
+    template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    iterator insert(const_iterator position, InputIt first, InputIt last)
+    {
+        ZVector values(first, last);
+        return this->insertMoved(static_cast<size_type>(position - this->m_data), values.m_data, values.m_size);
+    }
+
+    iterator insert(const_iterator position, std::initializer_list<T> init)
+    {
+        return this->insert(position, init.begin(), init.end());
+    }
+
+    void pop_back()
+    {
+        --this->m_size;
+        this->m_data[this->m_size].~T();
+    }
+
+    iterator erase(const_iterator position)
+    {
+        return this->erase(position, position + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        iterator begin = this->m_data + (first - this->m_data);
+        iterator end = this->m_data + (last - this->m_data);
+        if(begin == end) return begin;
+
+        std::move(end, this->end(), begin);
+        size_type removed = static_cast<size_type>(end - begin);
+        ZVector::destroy(this->end() - removed, this->end());
+        this->m_size -= removed;
+        return begin;
+    }
+
+    bool operator==(const ZVector &other) const
+    {
+        return this->m_size == other.m_size && std::equal(this->begin(), this->end(), other.begin());
+    }
+
+    bool operator!=(const ZVector &other) const
+    {
+        return !this->operator==(other);
+    }
+
+    bool operator<(const ZVector &other) const
+    {
+        return std::lexicographical_compare(this->begin(), this->end(), other.begin(), other.end());
+    }
+
+    bool operator>(const ZVector &other) const
+    {
+        return other.operator<(*this);
+    }
+
+    bool operator<=(const ZVector &other) const
+    {
+        return !other.operator<(*this);
+    }
+
+    bool operator>=(const ZVector &other) const
+    {
+        return !this->operator<(other);
+    }
+
+private:
+    size_type grownCapacity() const
+    {
+        return this->m_capacity ? this->m_capacity * 2 : 4;
+    }
+
+    iterator insertMoved(const size_type &index, T *values, const size_type &count)
+    {
+        /* moves count values into a gap opened at index, like reallocate() this relies on moves
+         * that do not throw
+         */
+        if(count == 0) return this->m_data + index;
+
+        if(this->m_size + count > this->m_capacity) this->reallocate(std::max(this->m_size + count, this->grownCapacity()));
+
+        T *gap = this->m_data + index;
+        if(is_trivially_relocatable<T>::value)
+        {
+            std::memmove(static_cast<void*>(gap + count), static_cast<const void*>(gap), (this->m_size - index) * sizeof(T));
+        }
+        else
+        {
+            for(T *source = this->m_data + this->m_size; source != gap;)
+            {
+                --source;
+                new (source + count) T(std::move(*source));
+                source->~T();
+            }
+        }
+
+        for(size_type i = 0; i < count; ++i) new (gap + i) T(std::move(values[i]));
+        this->m_size += count;
+        return gap;
+    }
+
+    static void destroy(T *first, T *last)
+    {
+        if(!std::is_trivially_destructible<T>::value)
+        {
+            for(; first != last; ++first) first->~T();
+        }
+    }
+
+    void deallocate()
+    {
+        if(this->m_data) this->m_allocator.deallocate(this->m_data, this->m_capacity);
+    }
+
+    void steal(ZVector &other)
+    {
+        this->m_data = other.m_data;
+        this->m_size = other.m_size;
+        this->m_capacity = other.m_capacity;
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_capacity = 0;
+    }
+
+    void reallocate(size_type capacity)
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "ZVector does not support over-aligned types");
+
+        T *data;
+        if(is_trivially_relocatable<T>::value)
+        {
+            /* realloc relocates the elements with a bulk copy, or not at all if it can grow in place */
+            data = this->m_allocator.reallocate(this->m_data, this->m_capacity, capacity);
+        }
+        else
+        {
+            data = this->m_allocator.allocate(capacity);
+            for(size_type i = 0; i < this->m_size; ++i)
+            {
+                new (data + i) T(std::move_if_noexcept(this->m_data[i]));
+                this->m_data[i].~T();
+            }
+            this->deallocate();
+        }
+
+        this->m_data = data;
+        this->m_capacity = capacity;
+    }
+
+    T *m_data;
+    size_type m_size;
+    size_type m_capacity;
+    Allocator m_allocator;
+};
+
+}
+
+#endif // ZVECTOR_H
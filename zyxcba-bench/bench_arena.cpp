@@ -0,0 +1,69 @@
+#include "zbench.h"
+
+#include <cstdio>
+#include <string>
+#include <utility>
+
+#include <ZArena>
+#include <ZVariant>
+
+using namespace zyxcba;
+
+namespace {
+
+/* a document of 8 records, each with scalars, a long string, a 6 element list and a 6 entry
+ * hash map
+ */
+std::uint64_t buildDocument(const std::size_t &iteration)
+{
+    ZVariant document;
+    document.setList();
+    for(std::size_t index = 0; index < 8; ++index)
+    {
+        ZVariant record;
+        record.setHashMap();
+        record.addToHashMap(ZVariant("id"), ZVariant(std::int64_t(iteration * 8 + index)));
+        record.addToHashMap(ZVariant("score"), ZVariant(zfloat64(index) / 3));
+        record.addToHashMap(ZVariant("active"), ZVariant(index % 2 == 0));
+        record.addToHashMap(ZVariant("description"), ZVariant(std::string(96, char('a' + index))));
+
+        ZVariant tags;
+        tags.setList();
+        for(std::int32_t tag = 0; tag < 6; ++tag) tags.addToList(ZVariant(tag));
+        record.addToHashMap(ZVariant("tags"), std::move(tags));
+
+        ZVariant attributes;
+        attributes.setHashMap();
+        for(std::int32_t key = 0; key < 6; ++key) attributes.addToHashMap(ZVariant(key), ZVariant(std::int64_t(key) * 7));
+        record.addToHashMap(ZVariant("attributes"), std::move(attributes));
+
+        document.addToList(std::move(record));
+    }
+    return document.listLength();
+}
+
+}
+
+void zbench::benchArena()
+{
+    const std::size_t iterations = 50000;
+
+    double start = zbench::now();
+    for(std::size_t i = 0; i < iterations; ++i) zbench::consume(buildDocument(i));
+    const double heap = zbench::now() - start;
+
+    ZArena arena;
+    start = zbench::now();
+    for(std::size_t i = 0; i < iterations; ++i)
+    {
+        {
+            ZArenaScope scope(arena);
+            zbench::consume(buildDocument(i));
+        }
+        arena.reset();
+    }
+    const double arenaTime = zbench::now() - start;
+
+    std::printf("build and destroy %zu documents of 8 records: heap %.3f s, arena reset per document %.3f s\n",
+                iterations, heap, arenaTime);
+}
@@ -0,0 +1,102 @@
+#include "zbench.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <ZBufferChain>
+#include <ZVariantSerializer>
+
+using namespace zyxcba;
+
+namespace {
+
+#ifdef _WIN32
+const char *const NullDevice = "NUL";
+#else
+const char *const NullDevice = "/dev/null";
+#endif
+
+bool writeString(const int &fileDescriptor, const std::string &buffer)
+{
+    std::size_t offset = 0;
+    while(offset < buffer.size())
+    {
+#ifdef _WIN32
+        const int written = ::_write(fileDescriptor, buffer.data() + offset, static_cast<unsigned>(std::min<std::size_t>(buffer.size() - offset, 1 << 30)));
+#else
+        const ssize_t written = ::write(fileDescriptor, buffer.data() + offset, buffer.size() - offset);
+#endif
+        if(written < 0) return false;
+        offset += static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+}
+
+void zbench::benchBufferChain()
+{
+    const std::size_t records = 1000000;
+
+    ZVariant document;
+    document.setList();
+    document.reserveList(records);
+    for(std::size_t index = 0; index < records; ++index)
+    {
+        ZVariant record;
+        record.setList();
+        record.addToList(ZVariant(std::int64_t(index)));
+        record.addToList(ZVariant(std::string(480 + index % 40, char('a' + index % 26))));
+        document.addToList(std::move(record));
+    }
+
+    const int fileDescriptor = ::open(NullDevice, O_WRONLY);
+    if(fileDescriptor < 0)
+    {
+        std::printf("cannot open %s\n", NullDevice);
+        return;
+    }
+
+    std::size_t before = zbench::heapBytes();
+    double start = zbench::now();
+    std::size_t stringHeap;
+    std::size_t size;
+    {
+        std::string buffer;
+        ZStringSink sink(buffer);
+        ZVariantSerializer::serialize(document, sink);
+        stringHeap = zbench::heapBytes() - before;
+        size = buffer.size();
+        writeString(fileDescriptor, buffer);
+    }
+    const double stringTime = zbench::now() - start;
+
+    before = zbench::heapBytes();
+    start = zbench::now();
+    std::size_t chainHeap;
+    std::size_t segments;
+    {
+        ZBufferChain chain;
+        ZVariantSerializer::serialize(document, chain);
+        chainHeap = zbench::heapBytes() - before;
+        segments = chain.segmentCount();
+        chain.writeTo(fileDescriptor);
+    }
+    const double chainTime = zbench::now() - start;
+
+    ::close(fileDescriptor);
+
+    std::printf("serialize %zu records, %.0f MB, and write to %s\n", records, size / 1e6, NullDevice);
+    std::printf("  std::string + write   %5.0f ms, output heap %5.0f MB\n", stringTime * 1e3, stringHeap / 1e6);
+    std::printf("  ZBufferChain + writev %5.0f ms, output heap %5.0f MB, %zu segments\n",
+                chainTime * 1e3, chainHeap / 1e6, segments);
+}
@@ -0,0 +1,72 @@
+#include "zbench.h"
+
+#include <cstdio>
+#include <vector>
+
+#include <ZBulkByteSwap>
+#include <ZEndianUtility>
+
+using namespace zyxcba;
+
+namespace {
+
+const std::size_t BytesPerMeasurement = std::size_t(1) << 31;
+
+double gigabytesPerSecond(const ZByteSwapKernel &kernel, std::vector<unsigned char> &source,
+                          std::vector<unsigned char> &destination, const std::size_t &elementSize)
+{
+    const std::size_t count = source.size() / elementSize;
+    const std::size_t rounds = BytesPerMeasurement / source.size();
+    const double start = zbench::now();
+    for(std::size_t round = 0; round < rounds; ++round)
+    {
+        ZBulkByteSwap::swapBytes(kernel, destination.data(), source.data(), count, elementSize);
+    }
+    const double elapsed = zbench::now() - start;
+    zbench::consume(destination[rounds % destination.size()]);
+    return double(rounds) * source.size() / elapsed / 1e9;
+}
+
+}
+
+void zbench::benchBulkByteSwap()
+{
+    const std::size_t bufferSizes[] = { 4096, 8 << 20 };
+    const std::size_t elementSizes[] = { 2, 4, 8 };
+
+    std::printf("GB/s, 4 KB buffer / 8 MB buffer\n");
+    for(const std::size_t &elementSize : elementSizes)
+    {
+        std::printf("  u%-3zu", elementSize * 8);
+        for(std::size_t index = 0; index < static_cast<std::size_t>(ZByteSwapKernel::KernelCount); ++index)
+        {
+            const ZByteSwapKernel kernel = static_cast<ZByteSwapKernel>(index);
+            if(!ZBulkByteSwap::isSupported(kernel)) continue;
+
+            std::printf(" %s", ZBulkByteSwap::kernelName(kernel));
+            for(const std::size_t &bufferSize : bufferSizes)
+            {
+                std::vector<unsigned char> source(bufferSize, 0x5a);
+                std::vector<unsigned char> destination(bufferSize);
+                std::printf("%s%.1f", bufferSize == bufferSizes[0] ? " " : " / ",
+                            gigabytesPerSecond(kernel, source, destination, elementSize));
+            }
+            std::printf(" ");
+        }
+        std::printf("\n");
+    }
+
+    /* the per element method the bulk kernels replace */
+    const ZEndianUtility utility;
+    std::vector<unsigned int> values(1024, 0x01020304u);
+    const std::size_t rounds = BytesPerMeasurement / (values.size() * sizeof(unsigned int));
+    const double start = zbench::now();
+    for(std::size_t round = 0; round < rounds; ++round)
+    {
+        for(unsigned int &value : values) value = utility.byteSwapUInt32(value);
+    }
+    const double elapsed = zbench::now() - start;
+    zbench::consume(values[0]);
+    std::printf("  per element byteSwapUInt32 loop, 4 KB: %.1f GB/s\n",
+                double(rounds) * values.size() * sizeof(unsigned int) / elapsed / 1e9);
+}
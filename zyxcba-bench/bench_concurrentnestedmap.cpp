@@ -0,0 +1,128 @@
+#include "zbench.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <mutex>
+#else
+#include <pthread.h>
+#endif
+
+#include <ZConcurrentNestedMap>
+#include <ZNestedMap>
+
+using namespace zyxcba;
+
+namespace {
+
+/* the reader writer lock the epoch scheme replaces, std::shared_mutex needs C++17 */
+class ZReadWriteLock
+{
+public:
+#ifdef _WIN32
+    void lockShared() { this->m_mutex.lock(); }
+    void unlockShared() { this->m_mutex.unlock(); }
+    void lock() { this->m_mutex.lock(); }
+    void unlock() { this->m_mutex.unlock(); }
+    static const char *name() { return "mutex"; }
+#else
+    ZReadWriteLock() { pthread_rwlock_init(&this->m_lock, nullptr); }
+    ~ZReadWriteLock() { pthread_rwlock_destroy(&this->m_lock); }
+    void lockShared() { pthread_rwlock_rdlock(&this->m_lock); }
+    void unlockShared() { pthread_rwlock_unlock(&this->m_lock); }
+    void lock() { pthread_rwlock_wrlock(&this->m_lock); }
+    void unlock() { pthread_rwlock_unlock(&this->m_lock); }
+    static const char *name() { return "rwlock"; }
+#endif
+
+private:
+#ifdef _WIN32
+    std::mutex m_mutex;
+#else
+    pthread_rwlock_t m_lock;
+#endif
+};
+
+/* reads from the given number of threads for one second while one writer updates five times
+ * a second, returns million reads per second
+ */
+template<typename Read, typename Write>
+double readsPerSecond(const std::vector<std::string> &keys, const int &threads, Read read, Write write)
+{
+    std::atomic<bool> stop(false);
+    std::atomic<std::uint64_t> total(0);
+    std::vector<std::thread> readers;
+    for(int thread = 0; thread < threads; ++thread)
+    {
+        readers.emplace_back([&, thread]() {
+            std::mt19937 random(thread);
+            std::uint64_t reads = 0;
+            while(!stop.load(std::memory_order_relaxed))
+            {
+                for(int i = 0; i < 256; ++i) read(keys[random() % keys.size()]);
+                reads += 256;
+            }
+            total += reads;
+        });
+    }
+    std::thread writer([&]() {
+        std::mt19937 random(77);
+        while(!stop.load())
+        {
+            write(keys[random() % keys.size()]);
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    stop = true;
+    for(std::thread &reader : readers) reader.join();
+    writer.join();
+    return total / 1e6;
+}
+
+}
+
+void zbench::benchConcurrentNestedMap()
+{
+    std::vector<std::string> keys;
+    for(int i = 0; i < 100000; ++i) keys.push_back("svc." + std::to_string(i % 100) + ".cfg." + std::to_string(i));
+
+    ZConcurrentNestedMap concurrent;
+    ZNestedMap locked;
+    ZReadWriteLock lock;
+    for(const std::string &key : keys)
+    {
+        concurrent.set(key, ZVariant(std::string(32, 'v')));
+        locked.set(key, ZVariant(std::string(32, 'v')));
+    }
+
+    std::printf("%zu keys, one writer at 5 updates/s, Mreads/s over one second (%u hardware threads)\n",
+                keys.size(), std::thread::hardware_concurrency());
+    std::printf("%8s %8s %8s\n", "threads", "epoch", ZReadWriteLock::name());
+    const int threadCounts[] = { 1, 2, 4, 8, 16, 32, 64 };
+    for(const int &threads : threadCounts)
+    {
+        const double epoch = readsPerSecond(keys, threads,
+            [&](const std::string &key) { concurrent.read(key, [](const ZVariant &) {}); },
+            [&](const std::string &key) { concurrent.set(key, ZVariant(std::string(32, 'w'))); });
+        const double baseline = readsPerSecond(keys, threads,
+            [&](const std::string &key) {
+                lock.lockShared();
+                zbench::consume(locked.find(key) != nullptr);
+                lock.unlockShared();
+            },
+            [&](const std::string &key) {
+                lock.lock();
+                locked.set(key, ZVariant(std::string(32, 'w')));
+                lock.unlock();
+            });
+        std::printf("%8d %8.2f %8.2f\n", threads, epoch, baseline);
+    }
+}
@@ -0,0 +1,104 @@
+#include "zbench.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <ZEndian>
+#include <ZEndianUtility>
+
+using namespace zyxcba;
+
+namespace {
+
+const std::size_t Count = 10000000;
+
+/* the values walk a small buffer so nothing can be folded at compile time */
+std::vector<char> randomBytes()
+{
+    std::vector<char> bytes(4096 + 8);
+    std::uint64_t state = 0x9e3779b97f4a7c15ULL;
+    for(char &byte : bytes)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        byte = static_cast<char>(state >> 56);
+    }
+    return bytes;
+}
+
+template<typename Function>
+double nanoseconds(Function function)
+{
+    std::uint64_t sum = 0;
+    const double start = zbench::now();
+    for(std::size_t i = 0; i < Count; ++i) sum += function(i & 4095);
+    const double elapsed = zbench::now() - start;
+    zbench::consume(sum);
+    return elapsed * 1e9 / Count;
+}
+
+void report(const char *label, const double &value)
+{
+    std::printf("  %-48s %6.2f\n", label, value);
+}
+
+}
+
+void zbench::benchEndianPrimitives()
+{
+    const std::vector<char> bytes = randomBytes();
+    const char *data = bytes.data();
+    const ZEndianUtility utility;
+
+    std::printf("ns per value, %zu values\n", Count);
+    report("ZEndianUtility::toBESS(uint32)", nanoseconds([&](std::size_t i) {
+        return std::uint64_t(utility.toBESS(load_le<unsigned int>(data + i)).size());
+    }));
+    report("load_be<uint64_t>", nanoseconds([&](std::size_t i) {
+        return load_be<std::uint64_t>(data + i);
+    }));
+    report("ZEndianUtility::toUInt64FromBigEndianCharString", nanoseconds([&](std::size_t i) {
+        return std::uint64_t(utility.toUInt64FromBigEndianCharString(data + i));
+    }));
+    report("byte_swap<uint64_t>", nanoseconds([&](std::size_t i) {
+        return byte_swap(load_le<std::uint64_t>(data + i));
+    }));
+    report("ZEndianUtility::byteSwapUInt64", nanoseconds([&](std::size_t i) {
+        return std::uint64_t(utility.byteSwapUInt64(load_le<unsigned long long>(data + i)));
+    }));
+}
+
+void zbench::benchEndianEncoders()
+{
+    const std::vector<char> bytes = randomBytes();
+    const char *data = bytes.data();
+    const ZEndianUtility utility;
+
+    std::printf("ns per 64 bit big endian encode, %zu values\n", Count);
+    report("std::string built byte by byte", nanoseconds([&](std::size_t i) {
+        const unsigned long long value = load_le<unsigned long long>(data + i);
+        std::string encoded;
+        for(int shift = 56; shift >= 0; shift -= 8) encoded.push_back(static_cast<char>(value >> shift));
+        return std::uint64_t(encoded[7]);
+    }));
+    report("toBESS returning std::string", nanoseconds([&](std::size_t i) {
+        return std::uint64_t(utility.toBESS(load_le<unsigned long long>(data + i))[7]);
+    }));
+
+    char buffer[8 * 4096];
+    report("toBECS into a char buffer", nanoseconds([&](std::size_t i) {
+        return std::uint64_t(utility.toBECS(load_le<unsigned long long>(data + i), buffer + (i & 4095) * 8) - buffer);
+    }));
+
+    std::string output;
+    report("appendBESS into a reused std::string", nanoseconds([&](std::size_t i) {
+        if(i == 0) output.clear();
+        utility.appendBESS(output, load_le<unsigned long long>(data + i));
+        return std::uint64_t(output.size());
+    }));
+    report("std::string += toBESS", nanoseconds([&](std::size_t i) {
+        if(i == 0) output.clear();
+        output += utility.toBESS(load_le<unsigned long long>(data + i));
+        return std::uint64_t(output.size());
+    }));
+}
@@ -0,0 +1,190 @@
+#include "zbench.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <ZChecksum>
+#include <ZCpu>
+#include <ZHash>
+#include <ZVariantSerializer>
+
+using namespace zyxcba;
+
+namespace {
+
+/* ns per call of function(i), repeated until about 2 GB went through it */
+template<typename Function>
+double nanoseconds(const std::size_t &size, Function function)
+{
+    const std::size_t rounds = std::max<std::size_t>(1, (std::size_t(1) << 31) / (size + 16) / 4);
+    std::uint64_t sum = 0;
+    const double start = zbench::now();
+    for(std::size_t i = 0; i < rounds; ++i) sum += function(i);
+    const double elapsed = zbench::now() - start;
+    zbench::consume(sum);
+    return elapsed * 1e9 / rounds;
+}
+
+/* short inputs in ns per call, longer ones in GB/s */
+std::string format(const std::size_t &size, const double &ns)
+{
+    char text[32];
+    if(size <= 64) std::snprintf(text, sizeof(text), "%.2f ns", ns);
+    else std::snprintf(text, sizeof(text), "%.1f GB/s", size / ns);
+    return text;
+}
+
+/* sorts the hashes and counts equal neighbours, for all 64 bits and for the low 32 bits */
+void reportCollisions(const char *name, std::vector<std::uint64_t> &hashes)
+{
+    const std::size_t count = hashes.size();
+    std::sort(hashes.begin(), hashes.end());
+    std::size_t full = 0;
+    for(std::size_t i = 1; i < count; ++i) full += hashes[i] == hashes[i - 1];
+
+    for(std::uint64_t &hash : hashes) hash &= 0xffffffffULL;
+    std::sort(hashes.begin(), hashes.end());
+    std::size_t low = 0;
+    for(std::size_t i = 1; i < count; ++i) low += hashes[i] == hashes[i - 1];
+
+    const double expected = double(count) * (count - 1) / 2 / 4294967296.0;
+    std::printf("  %-26s %9zu keys: %zu / %zu (%.0f)\n", name, count, full, low, expected);
+}
+
+}
+
+void zbench::benchHash()
+{
+    std::vector<char> buffer(1 << 20);
+    for(std::size_t i = 0; i < buffer.size(); ++i) buffer[i] = static_cast<char>(i * 131 + 7);
+    const char *data = buffer.data();
+
+    std::printf("dispatch level %s, crc32c %s\n", ZCpu::levelName(ZCpu::level()),
+                ZChecksum::isCrc32cAccelerated() ? "sse4.2" : "table");
+    std::printf("%8s %12s %12s %12s %12s %12s\n", "bytes", "hash64", "scalar", "hash128", "crc32c", "std::hash");
+
+    const std::size_t sizes[] = { 8, 16, 64, 240, 1024, 4096, 65536, 1 << 20 };
+    for(const std::size_t &size : sizes)
+    {
+        std::vector<std::string> strings;
+        for(std::size_t i = 0; i < 8; ++i) strings.push_back(std::string(data + i, size));
+        const std::hash<std::string> stringHash;
+
+        const double hash64 = nanoseconds(size, [&](std::size_t i) { return ZHash::hash64(data + (i & 7), size); });
+        const double scalar = nanoseconds(size, [&](std::size_t i) { return ZHash::hash64Scalar(data + (i & 7), size); });
+        const double hash128 = nanoseconds(size, [&](std::size_t i) { return ZHash::hash128(data + (i & 7), size).high; });
+        const double crc32c = nanoseconds(size, [&](std::size_t i) { return std::uint64_t(ZChecksum::crc32c(data + (i & 7), size)); });
+        const double standard = nanoseconds(size, [&](std::size_t i) { return std::uint64_t(stringHash(strings[i & 7])); });
+        std::printf("%8zu %12s %12s %12s %12s %12s\n", size, format(size, hash64).c_str(), format(size, scalar).c_str(),
+                    format(size, hash128).c_str(), format(size, crc32c).c_str(), format(size, standard).c_str());
+    }
+    std::printf("crc32c table walk, 64 KB: %.1f GB/s\n",
+                65536 / nanoseconds(65536, [&](std::size_t i) { return std::uint64_t(ZChecksum::crc32cScalar(data + (i & 7), 65536)); }));
+
+    /* structural hashing against hashing the serialized bytes */
+    ZVariant document;
+    document.setMap();
+    for(std::int64_t i = 0; i < 2000; ++i)
+    {
+        ZVariant values;
+        values.setList();
+        for(std::int64_t j = 0; j < 20; ++j) values.addToList(ZVariant(i * j));
+        values.addToList(ZVariant("name" + std::to_string(i)));
+        document.addToMap(ZVariant("k" + std::to_string(i)), std::move(values));
+    }
+    const std::size_t rounds = 50;
+    double start = zbench::now();
+    for(std::size_t round = 0; round < rounds; ++round) zbench::consume(document.contentHash(round));
+    const double contentHash = (zbench::now() - start) / rounds;
+    start = zbench::now();
+    for(std::size_t round = 0; round < rounds; ++round)
+    {
+        std::string bytes;
+        ZStringSink sink(bytes);
+        ZVariantSerializer::serialize(document, sink);
+        zbench::consume(ZHash::hash64(bytes.data(), bytes.size(), round));
+    }
+    const double serializeHash = (zbench::now() - start) / rounds;
+    std::printf("46k value document: contentHash %.2f ms, serialize + hash64 %.2f ms\n", contentHash * 1e3, serializeHash * 1e3);
+}
+
+void zbench::benchHashCollisions()
+{
+    const std::size_t count = std::size_t(1) << 24;
+    std::vector<std::uint64_t> hashes(count);
+
+    std::printf("64 bit collisions / low 32 bit collisions (birthday expectation)\n");
+    for(std::uint64_t i = 0; i < count; ++i) hashes[i] = ZHash::hash64(&i, sizeof(i));
+    reportCollisions("sequential uint64", hashes);
+
+    for(std::uint64_t i = 0; i < count; ++i)
+    {
+        char text[32];
+        const int size = std::snprintf(text, sizeof(text), "key:%llu", static_cast<unsigned long long>(i));
+        hashes[i] = ZHash::hash64(text, static_cast<std::size_t>(size));
+    }
+    reportCollisions("decimal strings", hashes);
+
+    std::mt19937_64 random(5);
+    std::vector<unsigned char> bytes(4096);
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        const std::size_t size = 8 + i % 233;
+        for(std::size_t j = 0; j < size; j += 8)
+        {
+            const std::uint64_t value = random();
+            std::memcpy(&bytes[j], &value, sizeof(value));
+        }
+        hashes[i] = ZHash::hash64(bytes.data(), size, i & 7);
+    }
+    reportCollisions("random 8-240 B, seeded", hashes);
+
+    hashes.clear();
+    std::vector<unsigned char> key(256, 0);
+    for(std::size_t first = 0; first < 2048; ++first)
+    {
+        key[first / 8] ^= static_cast<unsigned char>(1u << (first % 8));
+        for(std::size_t second = first + 1; second < 2048; ++second)
+        {
+            key[second / 8] ^= static_cast<unsigned char>(1u << (second % 8));
+            hashes.push_back(ZHash::hash64(key.data(), key.size()));
+            key[second / 8] ^= static_cast<unsigned char>(1u << (second % 8));
+        }
+        key[first / 8] ^= static_cast<unsigned char>(1u << (first % 8));
+    }
+    reportCollisions("256 B two-bit keys", hashes);
+
+    /* the largest deviation from one half of any output bit's flip probability, over every
+     * input bit
+     */
+    const int trials = 2000;
+    std::printf("single bit avalanche, worst per-bit bias over %d trials (sampling noise ~%.3f)\n",
+                trials, 4.5 / std::sqrt(double(trials)));
+    const std::size_t sizes[] = { 3, 8, 16, 33, 100, 200, 300 };
+    for(const std::size_t &size : sizes)
+    {
+        std::vector<unsigned char> input(size);
+        std::vector<int> flips(size * 8 * 64, 0);
+        for(int trial = 0; trial < trials; ++trial)
+        {
+            for(unsigned char &byte : input) byte = static_cast<unsigned char>(random());
+            const std::uint64_t base = ZHash::hash64(input.data(), size);
+            for(std::size_t bit = 0; bit < size * 8; ++bit)
+            {
+                input[bit / 8] ^= static_cast<unsigned char>(1u << (bit % 8));
+                const std::uint64_t difference = base ^ ZHash::hash64(input.data(), size);
+                input[bit / 8] ^= static_cast<unsigned char>(1u << (bit % 8));
+                for(int output = 0; output < 64; ++output) flips[bit * 64 + output] += (difference >> output) & 1;
+            }
+        }
+        double worst = 0;
+        for(const int &flipped : flips) worst = std::max(worst, std::fabs(double(flipped) / trials - 0.5));
+        std::printf("  %4zu B: %.3f\n", size, worst * 2);
+    }
+}
@@ -0,0 +1,59 @@
+#include "zbench.h"
+
+#include <cstdio>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <ZVariant>
+
+using namespace zyxcba;
+
+namespace {
+
+/* inserts the keys and then looks each one up in shuffled order, ns per operation */
+template<typename Map>
+void measure(const std::vector<std::uint64_t> &keys, const std::vector<std::uint64_t> &probes, double &insert, double &lookup)
+{
+    const std::size_t rounds = 1 + 1000000 / keys.size();
+    insert = 0;
+    lookup = 0;
+    for(std::size_t round = 0; round < rounds; ++round)
+    {
+        Map map;
+        double start = zbench::now();
+        for(const std::uint64_t &key : keys) map.emplace(key, ZVariant(std::int64_t(key)));
+        insert += zbench::now() - start;
+
+        std::uint64_t sum = 0;
+        start = zbench::now();
+        for(const std::uint64_t &key : probes) sum += map.find(key)->second.getInt64();
+        lookup += zbench::now() - start;
+        zbench::consume(sum);
+    }
+    insert = insert * 1e9 / (rounds * keys.size());
+    lookup = lookup * 1e9 / (rounds * probes.size());
+}
+
+}
+
+void zbench::benchHashMap()
+{
+    std::mt19937_64 random(5);
+    std::printf("uint64 keys, ns per operation\n");
+    std::printf("%9s %20s %20s\n", "size", "insert map/hash", "lookup map/hash");
+
+    const std::size_t sizes[] = { 1000, 100000, 1000000 };
+    for(const std::size_t &size : sizes)
+    {
+        std::vector<std::uint64_t> keys(size);
+        for(std::uint64_t &key : keys) key = random();
+        std::vector<std::uint64_t> probes(keys);
+        std::shuffle(probes.begin(), probes.end(), random);
+
+        double mapInsert, mapLookup, hashInsert, hashLookup;
+        measure<ZIntegerVariantMap>(keys, probes, mapInsert, mapLookup);
+        measure<ZIntegerVariantHashMap>(keys, probes, hashInsert, hashLookup);
+        std::printf("%9zu %9.0f / %-8.0f %9.0f / %-8.0f\n", size, mapInsert, hashInsert, mapLookup, hashLookup);
+    }
+}
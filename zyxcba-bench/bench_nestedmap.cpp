@@ -0,0 +1,211 @@
+#include "zbench.h"
+
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ZNestedMap>
+#include <ZVariant>
+
+using namespace zyxcba;
+
+namespace {
+
+/* the nested ZVariantMap navigation callers used before ZNestedMap, one key per level */
+const ZVariant *navigate(const ZVariant &root, const std::string &path)
+{
+    const ZVariant *node = &root;
+    std::size_t begin = 0;
+    for(;;)
+    {
+        const std::size_t dot = path.find('.', begin);
+        const std::string segment = path.substr(begin, dot == std::string::npos ? std::string::npos : dot - begin);
+        if(!node->isMap()) return nullptr;
+
+        const ZVariantMap &map = node->getMap();
+        const ZVariantMap::const_iterator found = map.find(ZVariant(segment));
+        if(found == map.end()) return nullptr;
+
+        node = &found->second;
+        if(dot == std::string::npos) return node;
+        begin = dot + 1;
+    }
+}
+
+ZVariant buildTree(const int &depth, const int &fan, const std::string &prefix, std::vector<std::string> &paths)
+{
+    ZVariantMap map;
+    for(int i = 0; i < fan; ++i)
+    {
+        const std::string key = "key" + std::to_string(i);
+        const std::string path = prefix.empty() ? key : prefix + "." + key;
+        if(depth == 1)
+        {
+            map.emplace(ZVariant(key), ZVariant(i));
+            paths.push_back(path);
+        }
+        else
+        {
+            map.emplace(ZVariant(key), buildTree(depth - 1, fan, path, paths));
+        }
+    }
+    return ZVariant(std::move(map));
+}
+
+}
+
+void zbench::benchNestedMap()
+{
+    const int shapes[][2] = { { 2, 300 }, { 4, 16 }, { 6, 6 } };
+    const int rounds = 20;
+
+    std::printf("ns per lookup, nested ZVariantMap navigation -> ZNestedMap\n");
+    for(const int (&shape)[2] : shapes)
+    {
+        std::vector<std::string> paths;
+        const ZVariant tree = buildTree(shape[0], shape[1], std::string(), paths);
+        ZNestedMap map;
+        for(std::size_t i = 0; i < paths.size(); ++i) map.set(paths[i], ZVariant(int(i % shape[1])));
+
+        std::uint64_t sum = 0;
+        double start = zbench::now();
+        for(int round = 0; round < rounds; ++round)
+        {
+            for(const std::string &path : paths) sum += navigate(tree, path)->getInt32();
+        }
+        const double navigated = zbench::now() - start;
+
+        start = zbench::now();
+        for(int round = 0; round < rounds; ++round)
+        {
+            for(const std::string &path : paths) sum += map.find(path)->getInt32();
+        }
+        const double found = zbench::now() - start;
+        zbench::consume(sum);
+
+        const double lookups = double(paths.size()) * rounds;
+        std::printf("  depth %d, fan %3d: %4.0f ns -> %4.0f ns\n", shape[0], shape[1],
+                    navigated * 1e9 / lookups, found * 1e9 / lookups);
+    }
+}
+
+void zbench::benchCompiledPath()
+{
+    const char *const services[] = { "service", "storage", "network", "auth", "metrics", "cache", "queue", "search" };
+    const char *const sections[] = { "limits", "timeouts", "pool", "retry", "tls", "log", "buffer", "quota" };
+    const char *const settings[] = { "rps", "burst", "max_connections", "idle_seconds", "enabled", "level", "size", "window" };
+
+    ZNestedMap map;
+    std::vector<std::string> paths;
+    for(int service = 0; service < 8; ++service)
+    {
+        for(int section = 0; section < 8; ++section)
+        {
+            for(int setting = 0; setting < 8; ++setting)
+            {
+                for(int region = 0; region < 8; ++region)
+                {
+                    paths.push_back(std::string(services[service]) + ".region" + std::to_string(region) + "." +
+                                    sections[section] + "." + settings[setting]);
+                    map.set(paths.back(), ZVariant(service + section + setting + region));
+                }
+            }
+        }
+    }
+
+    std::vector<ZPath> compiled;
+    std::vector<ZPath> cached;
+    for(const std::string &path : paths)
+    {
+        compiled.push_back(map.compile(path, false));
+        cached.push_back(map.compile(path));
+    }
+
+    const int rounds = 2000;
+    std::uint64_t sum = 0;
+    double start = zbench::now();
+    for(int round = 0; round < rounds; ++round)
+    {
+        for(const std::string &path : paths) sum += map.find(path)->getInt32();
+    }
+    const double strings = zbench::now() - start;
+
+    start = zbench::now();
+    for(int round = 0; round < rounds; ++round)
+    {
+        for(const ZPath &path : compiled) sum += map.find(path)->getInt32();
+    }
+    const double uncached = zbench::now() - start;
+
+    start = zbench::now();
+    for(int round = 0; round < rounds; ++round)
+    {
+        for(const ZPath &path : cached) sum += map.find(path)->getInt32();
+    }
+    const double hits = zbench::now() - start;
+    zbench::consume(sum);
+
+    const double lookups = double(paths.size()) * rounds;
+    std::printf("%zu paths of depth 4, each looked up %d times, ns per lookup\n", paths.size(), rounds);
+    std::printf("  string path        %5.1f\n", strings * 1e9 / lookups);
+    std::printf("  compiled           %5.1f\n", uncached * 1e9 / lookups);
+    std::printf("  compiled + cached  %5.1f\n", hits * 1e9 / lookups);
+}
+
+void zbench::benchRadixTree()
+{
+    const std::size_t count = 1000000;
+    const std::size_t probes = 1000000;
+    const std::size_t scans = 10000;
+
+    std::printf("%zu keys tenants/<t>/users/u<n>/limits/rps, 100 users per tenant\n", count);
+    const ZNestedMapStorage storages[] = { ZNestedMapStorage::HashLevels, ZNestedMapStorage::RadixTree };
+    for(const ZNestedMapStorage &storage : storages)
+    {
+        char key[96];
+        std::vector<std::string> probeKeys;
+        std::uint64_t state = 1;
+        for(std::size_t i = 0; i < probes; ++i)
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            const std::size_t index = (state >> 33) % count;
+            const int size = std::snprintf(key, sizeof(key), "tenants/%zu/users/u%zu/limits/rps", index / 100, index % 100);
+            probeKeys.push_back(std::string(key, static_cast<std::size_t>(size)));
+        }
+
+        const std::size_t before = zbench::heapBytes();
+        ZNestedMap map('/', storage);
+        double start = zbench::now();
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const int size = std::snprintf(key, sizeof(key), "tenants/%zu/users/u%zu/limits/rps", i / 100, i % 100);
+            map.set(ZStringView(key, static_cast<std::size_t>(size)), ZVariant(int(i)));
+        }
+        const double build = zbench::now() - start;
+        const std::size_t used = zbench::heapBytes() - before;
+
+        std::uint64_t sum = 0;
+        start = zbench::now();
+        for(const std::string &probe : probeKeys) sum += map.find(probe)->getInt32();
+        const double lookup = zbench::now() - start;
+
+        std::size_t scanned = 0;
+        start = zbench::now();
+        for(std::size_t i = 0; i < scans; ++i)
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            std::snprintf(key, sizeof(key), "tenants/%zu/", std::size_t((state >> 33) % (count / 100)));
+            map.scanPrefix(key, [&](const ZStringView &, const ZVariant &) {
+                ++scanned;
+                return true;
+            });
+        }
+        const double scan = zbench::now() - start;
+        zbench::consume(sum + scanned);
+
+        std::printf("  %-10s %5.0f B/key, build %5.0f ns/key, lookup %5.0f ns, scanPrefix %5.1f us for %zu results\n",
+                    storage == ZNestedMapStorage::RadixTree ? "RadixTree" : "HashLevels", double(used) / count,
+                    build * 1e9 / count, lookup * 1e9 / probes, scan * 1e6 / scans, scanned / scans);
+    }
+}
@@ -0,0 +1,124 @@
+#include "zbench.h"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ZNestedMap>
+#include <ZPersistentNestedMap>
+
+using namespace zyxcba;
+
+void zbench::benchPersistentNestedMap()
+{
+    const std::size_t count = 1000000;
+    const std::size_t updates = 1000000;
+
+    std::vector<std::string> keys;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        keys.push_back("tenant." + std::to_string(i % 1000) + ".service." + std::to_string((i / 1000) % 10) +
+                       ".key" + std::to_string(i));
+    }
+    std::mt19937 random(3);
+    std::vector<std::size_t> indices(updates);
+    for(std::size_t &index : indices) index = random() % count;
+
+    std::printf("%zu keys tenant.<t>.service.<s>.key<n>\n", count);
+
+    std::size_t before = zbench::heapBytes();
+    ZPersistentNestedMap persistent;
+    for(std::size_t i = 0; i < count; ++i) persistent = std::move(persistent).set(keys[i], ZVariant(std::int64_t(i)));
+    const std::size_t persistentBytes = zbench::heapBytes() - before;
+
+    before = zbench::heapBytes();
+    ZNestedMap nested;
+    for(std::size_t i = 0; i < count; ++i) nested.set(keys[i], ZVariant(std::int64_t(i)));
+    const std::size_t nestedBytes = zbench::heapBytes() - before;
+    std::printf("  heap per key                  %5.0f B (ZNestedMap %.0f B)\n",
+                double(persistentBytes) / count, double(nestedBytes) / count);
+
+    const std::size_t copies = 10000000;
+    double start = zbench::now();
+    for(std::size_t i = 0; i < copies; ++i)
+    {
+        ZPersistentNestedMap snapshot(persistent);
+        zbench::consume(snapshot.size());
+    }
+    const double snapshot = (zbench::now() - start) / copies;
+    start = zbench::now();
+    {
+        ZNestedMap deep(nested);
+        zbench::consume(deep.size());
+    }
+    const double deepCopy = zbench::now() - start;
+    std::printf("  snapshot (version copy)       %5.0f ns (ZNestedMap deep copy and destroy %.0f ms)\n",
+                snapshot * 1e9, deepCopy * 1e3);
+
+    start = zbench::now();
+    for(std::size_t i = 0; i < updates; ++i) persistent = persistent.set(keys[indices[i]], ZVariant(std::int64_t(i)));
+    std::printf("  update, copying               %5.2f us\n", (zbench::now() - start) * 1e6 / updates);
+
+    start = zbench::now();
+    for(std::size_t i = 0; i < updates; ++i) persistent = std::move(persistent).set(keys[indices[i]], ZVariant(std::int64_t(i)));
+    const double moved = (zbench::now() - start) * 1e6 / updates;
+    start = zbench::now();
+    for(std::size_t i = 0; i < updates; ++i) nested.set(keys[indices[i]], ZVariant(std::int64_t(i)));
+    std::printf("  update, moved head            %5.2f us (ZNestedMap in place %.2f us)\n",
+                moved, (zbench::now() - start) * 1e6 / updates);
+
+    {
+        std::vector<ZPersistentNestedMap> held;
+        start = zbench::now();
+        for(std::size_t i = 0; i < updates; ++i)
+        {
+            persistent = std::move(persistent).set(keys[indices[i]], ZVariant(std::int64_t(i)));
+            if(i % 100 != 0) continue;
+
+            held.push_back(persistent);
+            if(held.size() > 100) held.erase(held.begin());
+        }
+        std::printf("  update, snapshot every 100    %5.2f us, includes freeing old ones\n",
+                    (zbench::now() - start) * 1e6 / updates);
+    }
+
+    {
+        const std::size_t inserts = 100000;
+        ZPersistentNestedMap fresh(persistent);
+        start = zbench::now();
+        for(std::size_t i = 0; i < inserts; ++i)
+        {
+            fresh = fresh.set("fresh." + std::to_string(i % 100) + ".key" + std::to_string(i), ZVariant(std::int64_t(i)));
+        }
+        std::printf("  insert new key                %5.2f us\n", (zbench::now() - start) * 1e6 / inserts);
+    }
+
+    std::uint64_t found = 0;
+    start = zbench::now();
+    for(const std::size_t &index : indices) found += persistent.find(keys[index]) != nullptr;
+    const double persistentLookup = (zbench::now() - start) * 1e6 / updates;
+    start = zbench::now();
+    for(const std::size_t &index : indices) found += nested.find(keys[index]) != nullptr;
+    std::printf("  lookup                        %5.2f us (ZNestedMap %.2f us)\n",
+                persistentLookup, (zbench::now() - start) * 1e6 / updates);
+    zbench::consume(found);
+
+    std::printf("  100 live versions\n");
+    const std::size_t distances[] = { 1, 100, 1000 };
+    for(const std::size_t &distance : distances)
+    {
+        before = zbench::heapBytes();
+        std::vector<ZPersistentNestedMap> versions;
+        ZPersistentNestedMap version(persistent);
+        for(std::size_t k = 0; k < 100; ++k)
+        {
+            for(std::size_t j = 0; j < distance; ++j) version = std::move(version).set(keys[random() % count], ZVariant(std::int64_t(j)));
+            versions.push_back(version);
+        }
+        const double extra = double(zbench::heapBytes() - before);
+        std::printf("    %4zu updates apart          +%.1f MB (%.2f%% of one map)\n",
+                    distance, extra / 1e6, 100.0 * extra / persistentBytes);
+    }
+}
@@ -0,0 +1,90 @@
+#include "zbench.h"
+
+#include <cstdio>
+#include <string>
+#include <utility>
+
+#include <ZArena>
+#include <ZVariantSerializer>
+
+using namespace zyxcba;
+
+namespace {
+
+ZVariant buildRecords(const std::size_t &count)
+{
+    ZVariant records;
+    records.setList();
+    records.reserveList(count);
+    for(std::size_t index = 0; index < count; ++index)
+    {
+        ZVariant record;
+        record.setMap();
+        record.addToMap(ZVariant("id"), ZVariant(std::int64_t(index)));
+        record.addToMap(ZVariant("name"), ZVariant("user-" + std::to_string(index)));
+        record.addToMap(ZVariant("score"), ZVariant(zfloat64(index) / 7));
+        record.addToMap(ZVariant("active"), ZVariant(index % 3 != 0));
+
+        ZVariant tags;
+        tags.setList();
+        tags.addToList(ZVariant("alpha"));
+        tags.addToList(ZVariant("beta"));
+        tags.addToList(ZVariant(std::int32_t(index % 100)));
+        record.addToMap(ZVariant("tags"), std::move(tags));
+
+        records.addToList(std::move(record));
+    }
+    return records;
+}
+
+double megabytesPerSecond(const std::size_t &bytes, const std::size_t &rounds, const double &seconds)
+{
+    return double(bytes) * rounds / seconds / 1e6;
+}
+
+}
+
+void zbench::benchSerializer()
+{
+    const std::size_t rounds = 20;
+    const ZVariant document = buildRecords(20000);
+
+    std::string buffer;
+    double start = zbench::now();
+    for(std::size_t round = 0; round < rounds; ++round)
+    {
+        buffer.clear();
+        ZStringSink sink(buffer);
+        ZVariantSerializer::serialize(document, sink);
+    }
+    const double serialize = zbench::now() - start;
+
+    start = zbench::now();
+    for(std::size_t round = 0; round < rounds; ++round)
+    {
+        ZMemorySource source(buffer);
+        ZVariant decoded;
+        ZVariantSerializer::deserialize(source, decoded);
+        zbench::consume(decoded.listLength());
+    }
+    const double heap = zbench::now() - start;
+
+    ZArena arena;
+    start = zbench::now();
+    for(std::size_t round = 0; round < rounds; ++round)
+    {
+        {
+            ZArenaScope scope(arena);
+            ZMemorySource source(buffer);
+            ZVariant decoded;
+            ZVariantSerializer::deserialize(source, decoded);
+            zbench::consume(decoded.listLength());
+        }
+        arena.reset();
+    }
+    const double arenaTime = zbench::now() - start;
+
+    std::printf("20000 records, %.2f MB: serialize %.0f MB/s, deserialize %.0f MB/s on the heap, %.0f MB/s in a ZArenaScope\n",
+                buffer.size() / 1e6, megabytesPerSecond(buffer.size(), rounds, serialize),
+                megabytesPerSecond(buffer.size(), rounds, heap), megabytesPerSecond(buffer.size(), rounds, arenaTime));
+}
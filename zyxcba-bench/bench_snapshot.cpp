@@ -0,0 +1,97 @@
+#include "zbench.h"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <utility>
+
+#include <ZSnapshot>
+#include <ZVariantSerializer>
+
+using namespace zyxcba;
+
+namespace {
+
+const char *const SnapshotPath = "zyxcba-bench-snapshot.bin";
+
+/* resident set size in bytes, 0 where /proc is not available */
+std::size_t residentBytes()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while(std::getline(status, line))
+    {
+        if(line.compare(0, 6, "VmRSS:") == 0) return std::stoul(line.substr(6)) * 1024;
+    }
+    return 0;
+}
+
+}
+
+void zbench::benchSnapshot()
+{
+    const std::uint64_t count = 3000000;
+    const std::size_t lookups = 1000;
+    std::string serialized;
+
+    double start;
+    double write;
+    {
+        ZVariant records;
+        records.setIntVarMap();
+        for(std::uint64_t index = 0; index < count; ++index)
+        {
+            ZVariant record;
+            record.addToMap(ZVariant("name"), ZVariant(std::string(20, char('a' + index % 26))));
+            record.addToMap(ZVariant("value"), ZVariant(std::int64_t(index)));
+            records.addToIntVarMap(index * 7, std::move(record));
+        }
+
+        start = zbench::now();
+        ZSnapshot::write(records, SnapshotPath);
+        write = zbench::now() - start;
+
+        ZStringSink sink(serialized);
+        ZVariantSerializer::serialize(records, sink);
+    }
+
+    std::mt19937_64 random(10);
+    const std::size_t residentBefore = residentBytes();
+
+    start = zbench::now();
+    ZSnapshot snapshot;
+    snapshot.open(SnapshotPath);
+    const double open = zbench::now() - start;
+
+    start = zbench::now();
+    zbench::consume(static_cast<std::uint64_t>(snapshot.root().find(std::uint64_t(count / 2 * 7)).find("value").getInt64()));
+    const double first = zbench::now() - start;
+
+    start = zbench::now();
+    for(std::size_t lookup = 0; lookup < lookups; ++lookup)
+    {
+        const std::uint64_t key = random() % count * 7;
+        zbench::consume(static_cast<std::uint64_t>(snapshot.root().find(key).find("value").getInt64()));
+    }
+    const double lookupTime = zbench::now() - start;
+    const std::size_t snapshotResident = residentBytes() - residentBefore;
+
+    std::printf("%llu entry ZIntegerVariantMap, %.0f MB snapshot written in %.2f s\n",
+                static_cast<unsigned long long>(count), snapshot.fileSize() / 1e6, write);
+    std::printf("  snapshot: open %.3f ms, first lookup %.3f ms, %zu random lookups %.2f ms, RSS +%.0f MB\n",
+                open * 1e3, first * 1e3, lookups, lookupTime * 1e3, snapshotResident / 1e6);
+    snapshot.close();
+    std::remove(SnapshotPath);
+
+    const std::size_t heapBefore = zbench::heapBytes();
+    start = zbench::now();
+    ZMemorySource source(serialized);
+    ZVariant decoded;
+    ZVariantSerializer::deserialize(source, decoded);
+    zbench::consume(decoded.getIntegerVariantMap().at(count / 2 * 7).getMap().at(ZVariant("value")).getInt64());
+    const double deserialize = zbench::now() - start;
+
+    std::printf("  serializer: deserialize and first lookup %.2f s, heap +%.0f MB\n",
+                deserialize, (zbench::heapBytes() - heapBefore) / 1e6);
+}
@@ -0,0 +1,85 @@
+#include "zbench.h"
+
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ZVariant>
+
+using namespace zyxcba;
+
+void zbench::benchVariantFootprint()
+{
+    const std::size_t count = 1000000;
+
+    std::printf("sizeof(ZVariant) %zu B\n", sizeof(ZVariant));
+
+    std::size_t before = zbench::heapBytes();
+    double start = zbench::now();
+    ZVariant integers;
+    integers.reserveList(count);
+    for(std::size_t i = 0; i < count; ++i) integers.addToList(ZVariant(std::int64_t(i)));
+    double built = zbench::now();
+    std::size_t used = zbench::heapBytes() - before;
+    ZVariant copy(integers);
+    double copied = zbench::now();
+    copy = ZVariant();
+    double destroyed = zbench::now();
+    std::printf("%zu Int64 list:   %5.1f B/element, build %5.1f ns, copy %5.1f ns, destroy %5.1f ns per element\n",
+                count, double(used) / count, (built - start) * 1e9 / count,
+                (copied - built) * 1e9 / count, (destroyed - copied) * 1e9 / count);
+    zbench::consume(integers.listLength());
+
+    before = zbench::heapBytes();
+    start = zbench::now();
+    ZVariant strings;
+    strings.reserveList(count);
+    for(std::size_t i = 0; i < count; ++i) strings.addToList(ZVariant(std::to_string(i)));
+    built = zbench::now();
+    used = zbench::heapBytes() - before;
+    std::printf("%zu String list:  %5.1f B/element, build %5.1f ns per element\n",
+                count, double(used) / count, (built - start) * 1e9 / count);
+    zbench::consume(strings.listLength());
+
+    before = zbench::heapBytes();
+    ZVariant records;
+    records.reserveList(count / 10);
+    for(std::size_t i = 0; i < count / 10; ++i)
+    {
+        ZVariant record;
+        record.setList();
+        record.addToList(ZVariant(std::int64_t(i)));
+        record.addToList(ZVariant(true));
+        record.addToList(ZVariant(zfloat64(i) / 3));
+        records.addToList(std::move(record));
+    }
+    used = zbench::heapBytes() - before;
+    std::printf("%zu 3 scalar lists: %5.1f B/record\n", count / 10, double(used) / (count / 10));
+    zbench::consume(records.listLength());
+}
+
+void zbench::benchVariantList()
+{
+    const std::size_t count = 10000000;
+
+    double start = zbench::now();
+    {
+        std::vector<ZVariant> values;
+        for(std::size_t i = 0; i < count; ++i) values.push_back(ZVariant(std::int64_t(i)));
+        zbench::consume(values.size());
+    }
+    const double vector = zbench::now() - start;
+
+    start = zbench::now();
+    {
+        ZVariant values;
+        values.setList();
+        for(std::size_t i = 0; i < count; ++i) values.addToList(ZVariant(std::int64_t(i)));
+        zbench::consume(values.listLength());
+    }
+    const double list = zbench::now() - start;
+
+    std::printf("append %zu Int64 without reserving: std::vector<ZVariant> %.3f s, ZVariant::addToList %.3f s\n",
+                count, vector, list);
+}
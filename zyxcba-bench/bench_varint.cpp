@@ -0,0 +1,102 @@
+#include "zbench.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <ZEndian>
+#include <ZVarint>
+
+using namespace zyxcba;
+
+namespace {
+
+const std::size_t Count = 4000000;
+const std::size_t Rounds = 10;
+
+struct Result
+{
+    double bytesPerValue;
+    double millionValuesPerSecond;
+};
+
+template<typename Decode>
+Result measure(const std::size_t &encodedSize, Decode decode)
+{
+    const double start = zbench::now();
+    for(std::size_t round = 0; round < Rounds; ++round) zbench::consume(decode());
+    const double elapsed = zbench::now() - start;
+    Result result = { double(encodedSize) / Count, double(Count) * Rounds / elapsed / 1e6 };
+    return result;
+}
+
+void report(const char *distribution, const std::vector<std::uint32_t> &values)
+{
+    std::vector<std::uint64_t> decoded(Count);
+    std::vector<std::uint32_t> decoded32(Count);
+
+    std::vector<char> fixed(Count * 8);
+    for(std::size_t i = 0; i < Count; ++i) store_be<std::uint64_t>(fixed.data() + i * 8, values[i]);
+    const Result fixedResult = measure(fixed.size(), [&]() {
+        for(std::size_t i = 0; i < Count; ++i) decoded[i] = load_be<std::uint64_t>(fixed.data() + i * 8);
+        return decoded[Count - 1];
+    });
+
+    std::vector<char> leb128(Count * ZVarint::MaxVarintSize);
+    char *position = leb128.data();
+    for(const std::uint32_t &value : values) position = ZVarint::encodeVarint(value, position);
+    const std::size_t leb128Size = static_cast<std::size_t>(position - leb128.data());
+    const Result leb128Result = measure(leb128Size, [&]() {
+        ZVarint::decodeVarints(leb128.data(), leb128.data() + leb128Size, decoded.data(), Count);
+        return decoded[Count - 1];
+    });
+
+    std::vector<char> prefix(Count * ZVarint::MaxPrefixVarintSize);
+    position = prefix.data();
+    for(const std::uint32_t &value : values) position = ZVarint::encodePrefixVarint(value, position);
+    const std::size_t prefixSize = static_cast<std::size_t>(position - prefix.data());
+    const Result prefixResult = measure(prefixSize, [&]() {
+        const char *source = prefix.data();
+        const char *end = prefix.data() + prefixSize;
+        for(std::size_t i = 0; i < Count; ++i) source = ZVarint::decodePrefixVarint(source, end, decoded[i]);
+        return decoded[Count - 1];
+    });
+
+    std::vector<char> streamVByte(ZVarint::streamVByteMaxSize(Count));
+    const std::size_t streamVByteSize = ZVarint::encodeStreamVByte(values.data(), Count, streamVByte.data());
+    const Result scalarResult = measure(streamVByteSize, [&]() {
+        ZVarint::decodeStreamVByteScalar(streamVByte.data(), streamVByte.data() + streamVByteSize, decoded32.data(), Count);
+        return std::uint64_t(decoded32[Count - 1]);
+    });
+    const Result dispatchedResult = measure(streamVByteSize, [&]() {
+        ZVarint::decodeStreamVByte(streamVByte.data(), streamVByte.data() + streamVByteSize, decoded32.data(), Count);
+        return std::uint64_t(decoded32[Count - 1]);
+    });
+
+    const Result results[] = { fixedResult, leb128Result, prefixResult, scalarResult, dispatchedResult };
+    std::printf("%-20s", distribution);
+    for(const Result &result : results) std::printf(" %5.2f %6.0f", result.bytesPerValue, result.millionValuesPerSecond);
+    std::printf("\n");
+}
+
+}
+
+void zbench::benchVarint()
+{
+    std::mt19937_64 random(15);
+    std::vector<std::uint32_t> values(Count);
+
+    std::printf("decode of %zu values, B/value and Mvalues/s, Stream-VByte dispatched to the %s kernel\n",
+                Count, ZVarint::isStreamVByteAccelerated() ? "ssse3" : "scalar");
+    std::printf("%-20s %12s %12s %12s %12s %12s\n", "distribution", "fixed BE u64", "LEB128", "prefix", "SVB scalar", "SVB");
+
+    std::geometric_distribution<std::uint32_t> counters(1.0 / 20);
+    for(std::uint32_t &value : values) value = counters(random);
+    report("counters (geo ~20)", values);
+
+    for(std::uint32_t &value : values) value = static_cast<std::uint32_t>(random() & 0xfffff);
+    report("ids < 2^20", values);
+
+    for(std::uint32_t &value : values) value = static_cast<std::uint32_t>(random());
+    report("uniform 32 bit", values);
+}
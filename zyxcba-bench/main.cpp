@@ -0,0 +1,91 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "zbench.h"
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define ZBENCH_HAS_MALLINFO2 1
+#endif
+
+namespace {
+
+volatile std::uint64_t consumed = 0;
+
+struct Benchmark
+{
+    const char *name;
+    void (*function)();
+};
+
+const Benchmark benchmarks[] = {
+    { "variant-footprint", &zbench::benchVariantFootprint },
+    { "variant-list", &zbench::benchVariantList },
+    { "hashmap", &zbench::benchHashMap },
+    { "arena", &zbench::benchArena },
+    { "serializer", &zbench::benchSerializer },
+    { "endian-primitives", &zbench::benchEndianPrimitives },
+    { "endian-encoders", &zbench::benchEndianEncoders },
+    { "bulk-byteswap", &zbench::benchBulkByteSwap },
+    { "varint", &zbench::benchVarint },
+    { "bufferchain", &zbench::benchBufferChain },
+    { "hash-throughput", &zbench::benchHash },
+    { "hash-collisions", &zbench::benchHashCollisions },
+    { "nestedmap", &zbench::benchNestedMap },
+    { "nestedmap-compiled-path", &zbench::benchCompiledPath },
+    { "nestedmap-radixtree", &zbench::benchRadixTree },
+    { "concurrentnestedmap", &zbench::benchConcurrentNestedMap },
+    { "persistentnestedmap", &zbench::benchPersistentNestedMap },
+    { "snapshot", &zbench::benchSnapshot }
+};
+
+}
+
+double zbench::now()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void zbench::consume(const std::uint64_t &value)
+{
+    consumed = consumed + value;
+}
+
+std::size_t zbench::heapBytes()
+{
+#ifdef ZBENCH_HAS_MALLINFO2
+    const struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+/* runs every benchmark whose name contains one of the arguments, or all of them without
+ * arguments, --list prints the names
+ */
+int main(int argc, char **argv)
+{
+    if(argc == 2 && std::strcmp(argv[1], "--list") == 0)
+    {
+        for(const Benchmark &benchmark : benchmarks) std::printf("%s\n", benchmark.name);
+        return 0;
+    }
+
+    for(const Benchmark &benchmark : benchmarks)
+    {
+        bool selected = argc < 2;
+        for(int i = 1; i < argc && !selected; ++i)
+        {
+            selected = std::strstr(benchmark.name, argv[i]) != nullptr;
+        }
+        if(!selected) continue;
+
+        std::printf("== %s\n", benchmark.name);
+        std::fflush(stdout);
+        benchmark.function();
+        std::printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,39 @@
+#ifndef ZBENCH_H
+#define ZBENCH_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace zbench {
+
+/* seconds on the steady clock since an arbitrary epoch */
+double now();
+
+/* keeps a computed value alive so the work producing it cannot be optimized away */
+void consume(const std::uint64_t &value);
+
+/* bytes currently allocated from the C heap, 0 where the C library cannot report it */
+std::size_t heapBytes();
+
+void benchVariantFootprint();
+void benchVariantList();
+void benchHashMap();
+void benchArena();
+void benchSerializer();
+void benchEndianPrimitives();
+void benchEndianEncoders();
+void benchBulkByteSwap();
+void benchVarint();
+void benchBufferChain();
+void benchHash();
+void benchHashCollisions();
+void benchNestedMap();
+void benchCompiledPath();
+void benchRadixTree();
+void benchConcurrentNestedMap();
+void benchPersistentNestedMap();
+void benchSnapshot();
+
+}
+
+#endif // ZBENCH_H
@@ -0,0 +1,27 @@
+TEMPLATE = app
+CONFIG += console c++11 thread
+CONFIG -= app_bundle
+CONFIG -= qt
+CONFIG -= debug
+CONFIG += release
+
+include(../src/zyxcba.pri)
+
+HEADERS += \
+        zbench.h
+
+SOURCES += \
+        main.cpp \
+        bench_variant.cpp \
+        bench_hashmap.cpp \
+        bench_arena.cpp \
+        bench_serializer.cpp \
+        bench_endian.cpp \
+        bench_bulkbyteswap.cpp \
+        bench_varint.cpp \
+        bench_bufferchain.cpp \
+        bench_hash.cpp \
+        bench_nestedmap.cpp \
+        bench_concurrentnestedmap.cpp \
+        bench_persistentnestedmap.cpp \
+        bench_snapshot.cpp
@@ -1,59 +1,49 @@
 #include <iostream>
 
-#include <ZType>
-#include <ZVariant>
+#include "ztest.h"
 
+namespace {
 
-int main()
-{
-    zyxcba::ZVariant v;
-    v.addToMap(2,3);
-    //v.addToMap(2,"Smile");
-
-////    zyxcba::ZVariant v1;
-////    v1.addToMap(1,v);
-
-//    v1 = std::move(v);
-
-//    std::cout<<"V: "<<v.isValid()<<std::endl;
-//    //std::cout<<"V1: "<<v1.getString()<<std::endl;
-
-//    for(auto it = v1.getIntegerVariantMap().cbegin(); it != v1.getIntegerVariantMap().cend(); ++it)
-//    {
-//        std::cout << it->second<<std::endl;
-//    }
-
-    //zyxcba::ZVariant v2 = v1;
-
-//    v2 = std::move(v1);
-//    std::cout<<v2.isValid()<<std::endl;
-//    std::cout<<"v1 isValid:"<<v1.isValid()<<std::endl;
-//    std::cout<<"v2 string:"<<v2.getLength()<<std::endl;
-
-    //std::string k("S1");
-    //zyxcba::ZVariant v1(k);
-    //zyxcba::ZVariant v2(std::string("sadasd"));
-    //zyxcba::ZVariant v3(zyxcba::ZVariant(1212));
-    //v2.addToList(zyxcba::ZVariant(100));
-    //v2.addToList(zyxcba::ZVariant(100));
-    //v2 = v1;
-    //std::cout << v2.variantTypeString() <<std::endl;
-    //std::cout << v2.getString()<<std::endl;
-    //    v.addToList(1001212);
-    //    v.addToList(100);
-    //    v.addToList(100);
-    //    v.addToList(1001212);
-    //    v.addToList(100);
-    //    v.addToList(100);
+int failureCount = 0;
 
-    //qDebug() << v.getLength();
-
-    //v.setValue(100);
-    //v.addToMap(1,zyxcba::ZVariant(100));
+}
 
-    //qDebug() << v.isIntegerVariantMap();
-    //    /qDebug() << v.getLength();
+void ztest::fail(const char *file, int line, const char *expression)
+{
+    ++failureCount;
+    std::cerr << "FAIL " << file << ":" << line << ": " << expression << std::endl;
+}
 
+int ztest::failures()
+{
+    return failureCount;
+}
 
+int main()
+{
+    ztest::testVariantMove();
+    ztest::testVariantSerializer();
+    ztest::testBulkByteSwap();
+    ztest::testHash();
+    ztest::testChecksum();
+    ztest::testTrace();
+    ztest::testHashMap();
+    ztest::testVariantCompare();
+    ztest::testSnapshot();
+    ztest::testVarint();
+    ztest::testByteReader();
+    ztest::testBufferChain();
+    ztest::testTypedArray();
+    ztest::testNestedMap();
+    ztest::testRadixTree();
+    ztest::testConcurrentNestedMap();
+    ztest::testPersistentNestedMap();
+
+    if(ztest::failures())
+    {
+        std::cerr << ztest::failures() << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "all checks passed" << std::endl;
     return 0;
 }
@@ -0,0 +1,256 @@
+#include "ztest.h"
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <ZBufferChain>
+#include <ZEndianUtility>
+#include <ZVariantSerializer>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+using namespace zyxcba;
+
+const std::size_t MinimumSegmentSize = 64;
+
+std::string segmentsToString(const ZBufferChain &chain)
+{
+    std::string result;
+    for(std::size_t index = 0; index < chain.segmentCount(); ++index)
+    {
+        const ZBufferSegment part = chain.segment(index);
+        result.append(part.data, part.size);
+    }
+    return result;
+}
+
+/* random appends of every kind, many of them straddling a segment boundary */
+void fill(ZBufferChain &chain, std::string &reference, std::mt19937 &random, const int &operations)
+{
+    ZEndianUtility utility;
+    for(int i = 0; i < operations; ++i)
+    {
+        switch(random() % 6)
+        {
+        case 0:
+        {
+            const std::string text(random() % 200, char('a' + i % 26));
+            chain.append(text.data(), text.size());
+            reference += text;
+            break;
+        }
+        case 1:
+            chain.commit(utility.toBECS(static_cast<unsigned int>(i), chain.reserve(4)));
+            reference += utility.toBESS(static_cast<unsigned int>(i));
+            break;
+        case 2:
+            chain.appendLittleEndian<std::uint64_t>(static_cast<std::uint64_t>(i) * 0x0101010101ULL);
+            reference += utility.toLESS(static_cast<unsigned long long>(i) * 0x0101010101ULL);
+            break;
+        case 3:
+        {
+            const std::uint64_t value = static_cast<std::uint64_t>(random()) << (random() % 32);
+            chain.appendVarint(value);
+            char buffer[ZVarint::MaxVarintSize];
+            reference.append(buffer, ZVarint::encodeVarint(value, buffer));
+            break;
+        }
+        case 4:
+            chain.appendBigEndian<std::uint16_t>(static_cast<std::uint16_t>(i));
+            reference += utility.toBESS(static_cast<unsigned short>(i));
+            break;
+        default:
+            chain.append("", 0);
+            break;
+        }
+    }
+}
+
+void testToString()
+{
+    ZBufferPool pool(1, 4);
+    ZTEST_CHECK(pool.segmentSize() == MinimumSegmentSize);
+
+    std::mt19937 random(17);
+    {
+        ZBufferChain chain(pool);
+        ZTEST_CHECK(chain.empty());
+        ZTEST_CHECK(chain.toString().empty());
+
+        std::string reference;
+        for(int round = 0; round < 50; ++round)
+        {
+            fill(chain, reference, random, 40);
+            ZTEST_CHECK(chain.size() == reference.size());
+            ZTEST_CHECK(chain.toString() == reference);
+            ZTEST_CHECK(segmentsToString(chain) == reference);
+        }
+
+        for(std::size_t index = 0; index < chain.segmentCount(); ++index)
+            ZTEST_CHECK(chain.segment(index).size <= MinimumSegmentSize);
+
+#ifndef _WIN32
+        struct iovec vectors[3];
+        ZTEST_CHECK(chain.toIovec(vectors, 3, 1) == 3);
+        ZTEST_CHECK(vectors[0].iov_base == chain.segment(1).data && vectors[2].iov_len == chain.segment(3).size);
+        ZTEST_CHECK(chain.toIovec(vectors, 3, chain.segmentCount() - 1) == 1);
+#endif
+
+        ZBufferChain moved(std::move(chain));
+        ZTEST_CHECK(chain.segmentCount() == 0);
+        ZTEST_CHECK(moved.toString() == reference);
+        chain.append("x", 1);
+        ZTEST_CHECK(chain.toString() == "x");
+        chain = std::move(moved);
+        ZTEST_CHECK(chain.toString() == reference);
+
+        chain.clear();
+        ZTEST_CHECK(chain.empty() && chain.segmentCount() == 0);
+        ZTEST_CHECK(pool.cachedSegments() == 4);
+    }
+
+    /* the serializer writes the same bytes into a chain as into a string */
+    ZVariant list;
+    list.setList();
+    for(int i = 0; i < 300; ++i) list.addToList(ZVariant(std::string(static_cast<std::size_t>(i), 'z')));
+    std::string serialized;
+    ZStringSink sink(serialized);
+    ZVariantSerializer::serialize(list, sink);
+    ZBufferChain chain(pool);
+    ZVariantSerializer::serialize(list, chain);
+    ZTEST_CHECK(chain.toString() == serialized);
+}
+
+void testReserve()
+{
+    ZBufferPool pool(MinimumSegmentSize);
+    ZBufferChain chain(pool);
+    std::string reference;
+
+    /* a whole segment can be reserved, one byte more cannot and changes nothing */
+    char *data = chain.reserve(MinimumSegmentSize);
+    ZTEST_CHECK(data != nullptr);
+    std::memset(data, 'a', MinimumSegmentSize);
+    chain.commit(data + MinimumSegmentSize);
+    reference.append(MinimumSegmentSize, 'a');
+    ZTEST_CHECK(chain.reserve(MinimumSegmentSize + 1) == nullptr);
+    ZTEST_CHECK(chain.segmentCount() == 1);
+    ZTEST_CHECK(chain.toString() == reference);
+
+    /* committing less than was reserved, and nothing at all */
+    for(std::size_t size = 1; size <= MinimumSegmentSize; ++size)
+    {
+        data = chain.reserve(size);
+        ZTEST_CHECK(data != nullptr);
+        chain.commit(data);
+        data = chain.reserve(size);
+        std::memset(data, static_cast<int>('A' + size % 26), size);
+        chain.commit(data + size / 2);
+        reference.append(size / 2, static_cast<char>('A' + size % 26));
+        ZTEST_CHECK(chain.size() == reference.size());
+    }
+    ZTEST_CHECK(chain.toString() == reference);
+
+    /* reserving more than is left skips the rest of the segment instead of splitting */
+    ZBufferChain boundary(pool);
+    boundary.append(std::string(MinimumSegmentSize - 3, 'b').data(), MinimumSegmentSize - 3);
+    boundary.appendBigEndian<std::uint32_t>(0x01020304);
+    ZTEST_CHECK(boundary.segmentCount() == 2);
+    ZTEST_CHECK(boundary.segment(0).size == MinimumSegmentSize - 3);
+    ZTEST_CHECK(boundary.segment(1).size == 4);
+    ZTEST_CHECK(boundary.toString() == std::string(MinimumSegmentSize - 3, 'b') + std::string("\x01\x02\x03\x04", 4));
+}
+
+#ifndef _WIN32
+volatile std::sig_atomic_t interruptions = 0;
+
+void interrupt(int)
+{
+    ++interruptions;
+}
+
+void testWriteTo()
+{
+    /* tiny segments so one writev covers many of them and the pipe fills mid batch */
+    ZBufferPool pool(MinimumSegmentSize);
+    ZBufferChain chain(pool);
+    std::string reference;
+    std::mt19937 random(171);
+    fill(chain, reference, random, 20000);
+
+    int pipes[2];
+    ZTEST_CHECK(::pipe(pipes) == 0);
+#ifdef F_SETPIPE_SZ
+    ::fcntl(pipes[1], F_SETPIPE_SZ, 4096);
+#endif
+
+    /* the reader drains in odd sized chunks with the timer signal blocked, so the signal
+     * interrupts the writer in the middle of a writev and forces short writes
+     */
+    sigset_t alarmOnly;
+    sigemptyset(&alarmOnly);
+    sigaddset(&alarmOnly, SIGALRM);
+    std::string received;
+    std::thread reader([&]() {
+        pthread_sigmask(SIG_BLOCK, &alarmOnly, nullptr);
+        char buffer[777];
+        for(;;)
+        {
+            const ssize_t size = ::read(pipes[0], buffer, sizeof(buffer));
+            if(size < 0 && errno == EINTR) continue;
+            if(size <= 0) break;
+            received.append(buffer, static_cast<std::size_t>(size));
+        }
+    });
+
+    struct sigaction action;
+    struct sigaction previous;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = &interrupt;
+    sigemptyset(&action.sa_mask);
+    ::sigaction(SIGALRM, &action, &previous);
+    struct itimerval timer;
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = 200;
+    timer.it_value = timer.it_interval;
+    ::setitimer(ITIMER_REAL, &timer, nullptr);
+
+    const bool written = chain.writeTo(pipes[1]);
+
+    std::memset(&timer, 0, sizeof(timer));
+    ::setitimer(ITIMER_REAL, &timer, nullptr);
+    ::sigaction(SIGALRM, &previous, nullptr);
+    ::close(pipes[1]);
+    reader.join();
+    ::close(pipes[0]);
+
+    ZTEST_CHECK(written);
+    ZTEST_CHECK(received.size() == reference.size());
+    ZTEST_CHECK(received == reference);
+}
+#endif
+
+}
+
+void ztest::testBufferChain()
+{
+    testToString();
+    testReserve();
+#ifndef _WIN32
+    testWriteTo();
+#endif
+}
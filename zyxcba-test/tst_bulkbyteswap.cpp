@@ -0,0 +1,154 @@
+#include "ztest.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <ZBulkByteSwap>
+#include <ZCpu>
+
+namespace {
+
+using namespace zyxcba;
+
+const std::size_t GuardSize = 64;
+
+void referenceSwap(unsigned char *destination, const unsigned char *source, const std::size_t &count, const std::size_t &elementSize)
+{
+    for(std::size_t element = 0; element < count; ++element)
+    {
+        for(std::size_t byte = 0; byte < elementSize; ++byte)
+        {
+            destination[element * elementSize + byte] = source[element * elementSize + elementSize - 1 - byte];
+        }
+    }
+}
+
+/* runs one kernel on a source and a destination at the given misalignments, with guard bytes
+ * around the destination that must not be touched
+ */
+bool kernelMatches(const ZByteSwapKernel &kernel,
+                   const std::vector<unsigned char> &input,
+                   const std::size_t &count,
+                   const std::size_t &elementSize,
+                   const std::size_t &sourceOffset,
+                   const std::size_t &destinationOffset)
+{
+    const std::size_t bytes = count * elementSize;
+    if(bytes > input.size()) return false;
+
+    std::vector<unsigned char> source(sourceOffset + bytes + GuardSize);
+    if(bytes != 0) std::memcpy(source.data() + sourceOffset, input.data(), bytes);
+
+    /* one spare byte keeps data() valid for empty arrays */
+    std::vector<unsigned char> expected(bytes + 1);
+    referenceSwap(expected.data(), input.data(), count, elementSize);
+
+    std::vector<unsigned char> destination(GuardSize + destinationOffset + bytes + GuardSize, 0xa5);
+    unsigned char *target = destination.data() + GuardSize + destinationOffset;
+    if(!ZBulkByteSwap::swapBytes(kernel, target, source.data() + sourceOffset, count, elementSize)) return false;
+    if(std::memcmp(target, expected.data(), bytes) != 0) return false;
+    for(std::size_t i = 0; i < GuardSize + destinationOffset; ++i)
+    {
+        if(destination[i] != 0xa5) return false;
+    }
+    for(std::size_t i = GuardSize + destinationOffset + bytes; i < destination.size(); ++i)
+    {
+        if(destination[i] != 0xa5) return false;
+    }
+
+    /* in place */
+    if(!ZBulkByteSwap::swapBytes(kernel, source.data() + sourceOffset, source.data() + sourceOffset, count, elementSize)) return false;
+    return std::memcmp(source.data() + sourceOffset, expected.data(), bytes) == 0;
+}
+
+ZByteSwapKernel expectedKernel()
+{
+    const ZByteSwapKernel kernels[] = { ZByteSwapKernel::AVX512, ZByteSwapKernel::AVX2, ZByteSwapKernel::SSSE3 };
+    const ZCpuLevel levels[] = { ZCpuLevel::AVX512, ZCpuLevel::AVX2, ZCpuLevel::SSSE3 };
+    for(std::size_t i = 0; i < 3; ++i)
+    {
+        if(ZBulkByteSwap::isSupported(kernels[i]) && ZCpu::supports(levels[i])) return kernels[i];
+    }
+    return ZByteSwapKernel::Scalar;
+}
+
+}
+
+void ztest::testBulkByteSwap()
+{
+    std::mt19937_64 random(13);
+    std::vector<unsigned char> input(16 * 4200);
+    for(unsigned char &byte : input) byte = static_cast<unsigned char>(random());
+
+    std::vector<std::size_t> counts;
+    for(std::size_t count = 0; count <= 133; ++count) counts.push_back(count);
+    counts.push_back(1021);
+    counts.push_back(4099);
+
+    const std::size_t elementSizes[] = { 2, 4, 8, 16 };
+
+    /* every kernel the hardware has is compared against the reference, independently of the
+     * level ZYXCBA_CPU_LEVEL selects for dispatch
+     */
+    for(std::size_t index = 0; index < static_cast<std::size_t>(ZByteSwapKernel::KernelCount); ++index)
+    {
+        const ZByteSwapKernel kernel = static_cast<ZByteSwapKernel>(index);
+        if(!ZBulkByteSwap::isSupported(kernel))
+        {
+            ZTEST_CHECK(!ZBulkByteSwap::swapBytes(kernel, input.data(), input.data(), 1, 4));
+            continue;
+        }
+
+        for(const std::size_t &elementSize : elementSizes)
+        {
+            for(const std::size_t &count : counts)
+            {
+                const std::size_t offsets = count > 133 ? 4 : 16;
+                for(std::size_t sourceOffset = 0; sourceOffset < offsets; ++sourceOffset)
+                {
+                    for(std::size_t destinationOffset = 0; destinationOffset < offsets; destinationOffset += 3)
+                    {
+                        ZTEST_CHECK(kernelMatches(kernel, input, count, elementSize, sourceOffset, destinationOffset));
+                    }
+                }
+            }
+        }
+        ZTEST_CHECK(!ZBulkByteSwap::swapBytes(kernel, input.data(), input.data(), 1, 3));
+    }
+
+    /* the dispatched entry points use the kernel of ZCpu::level(), running the suite with
+     * ZYXCBA_CPU_LEVEL set to scalar, ssse3, avx2 and avx512 covers each of them
+     */
+    ZTEST_CHECK(ZBulkByteSwap::activeKernel() == expectedKernel());
+
+    for(const std::size_t &count : counts)
+    {
+        for(std::size_t offset = 0; offset < 8; ++offset)
+        {
+            /* one spare element keeps data() valid for empty arrays */
+            std::vector<unsigned char> buffer(offset + count * 8 + 1);
+            std::memcpy(buffer.data() + offset, input.data(), count * 8);
+
+            std::vector<unsigned char> expected(count * 8 + 1);
+            referenceSwap(expected.data(), input.data(), count, 8);
+
+            std::vector<std::uint64_t> loaded(count + 1);
+            ZBulkByteSwap::loadBigEndian(loaded.data(), buffer.data() + offset, count);
+            std::vector<std::uint64_t> swapped(count + 1);
+            std::memcpy(swapped.data(), input.data(), count * 8);
+            ZBulkByteSwap::swap(swapped.data(), count);
+            ZTEST_CHECK(std::memcmp(swapped.data(), expected.data(), count * 8) == 0);
+
+            std::vector<unsigned char> stored(offset + count * 8 + 1);
+            ZBulkByteSwap::storeBigEndian(stored.data() + offset, loaded.data(), count);
+            ZTEST_CHECK(std::memcmp(stored.data() + offset, input.data(), count * 8) == 0);
+
+            std::vector<std::uint16_t> halves(count * 4 + 1);
+            ZBulkByteSwap::loadLittleEndian(halves.data(), buffer.data() + offset, count * 4);
+            std::vector<unsigned char> littleStored(offset + count * 8 + 1);
+            ZBulkByteSwap::storeLittleEndian(littleStored.data() + offset, halves.data(), count * 4);
+            ZTEST_CHECK(std::memcmp(littleStored.data() + offset, input.data(), count * 8) == 0);
+        }
+    }
+}
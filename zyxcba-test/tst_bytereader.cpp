@@ -0,0 +1,223 @@
+#include "ztest.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <ZByteReader>
+#include <ZByteWriter>
+
+namespace {
+
+using namespace zyxcba;
+
+/* one record of every field type the reader and writer know */
+std::size_t writeRecord(ZByteWriter &writer)
+{
+    writer.writeBigEndian(std::uint32_t(0x01020304));
+    writer.writeLittleEndian(std::int16_t(-2));
+    writer.writeBigEndian(2.5);
+    writer.writeVarint(300);
+    writer.writeSignedVarint(-3);
+    writer.writePrefixVarint(static_cast<std::uint64_t>(1) << 40);
+    writer.writeLengthPrefixed(ZStringView("hello"));
+    writer.writeBytes("xyz", 3);
+    return writer.position();
+}
+
+/* reads the record back, stopping at the first failure like a caller checking once */
+bool readRecord(ZByteReader &reader)
+{
+    std::uint32_t a = 0;
+    std::int16_t b = 0;
+    double c = 0;
+    std::uint64_t d = 0;
+    std::int64_t e = 0;
+    std::uint64_t f = 0;
+    ZStringView g;
+    char h[3] = {};
+    reader.readBigEndian(a);
+    reader.readLittleEndian(b);
+    reader.readBigEndian(c);
+    reader.readVarint(d);
+    reader.readSignedVarint(e);
+    reader.readPrefixVarint(f);
+    reader.readLengthPrefixed(g);
+    reader.readBytes(h, sizeof(h));
+    if(reader.hasError()) return false;
+    return a == 0x01020304 && b == -2 && c == 2.5 && d == 300 && e == -3 && f == (static_cast<std::uint64_t>(1) << 40)
+            && g == ZStringView("hello") && std::memcmp(h, "xyz", 3) == 0;
+}
+
+void testRoundTrip()
+{
+    char buffer[64];
+    ZByteWriter writer(buffer, sizeof(buffer));
+    const std::size_t size = writeRecord(writer);
+    ZTEST_CHECK(!writer.hasError());
+    ZTEST_CHECK(static_cast<unsigned char>(buffer[0]) == 1 && static_cast<unsigned char>(buffer[4]) == 0xfe);
+
+    ZByteReader reader(buffer, size);
+    ZTEST_CHECK(readRecord(reader));
+    ZTEST_CHECK(reader.atEnd());
+    ZTEST_CHECK(!reader.hasError());
+}
+
+void testStickyError()
+{
+    char buffer[64];
+    ZByteWriter writer(buffer, sizeof(buffer));
+    const std::size_t size = writeRecord(writer);
+
+    /* every truncation fails at the field it cuts and leaves the position where that field starts */
+    std::size_t lastFailure = 0;
+    for(std::size_t cut = 0; cut < size; ++cut)
+    {
+        std::vector<char> truncated(buffer, buffer + cut);
+        ZByteReader reader(truncated.data(), cut);
+        ZTEST_CHECK(!readRecord(reader));
+        ZTEST_CHECK(reader.hasError());
+
+        const std::size_t failedAt = reader.position();
+        ZTEST_CHECK(failedAt <= cut);
+        ZTEST_CHECK(failedAt >= lastFailure);
+        lastFailure = failedAt;
+
+        /* later reads fail without moving, even those which would fit */
+        std::uint8_t byte;
+        char bytes[1];
+        ZStringView view;
+        std::uint64_t varint;
+        ZTEST_CHECK(!reader.readBigEndian(byte));
+        ZTEST_CHECK(!reader.readBytes(bytes, 0));
+        ZTEST_CHECK(!reader.readView(view, 0));
+        ZTEST_CHECK(!reader.readVarint(varint));
+        ZTEST_CHECK(!reader.skip(0));
+        ZTEST_CHECK(!reader.ensure(0));
+        ZTEST_CHECK(!reader.seek(0));
+        ZTEST_CHECK(reader.position() == failedAt);
+
+        /* after clearError() reading resumes at the start of the failed field */
+        reader.clearError();
+        ZTEST_CHECK(!reader.hasError());
+        ZTEST_CHECK(reader.position() == failedAt);
+        ZTEST_CHECK(reader.skip(cut - failedAt));
+        ZTEST_CHECK(reader.atEnd());
+        ZTEST_CHECK(reader.seek(0));
+        ZTEST_CHECK(!readRecord(reader));
+        ZTEST_CHECK(reader.position() == failedAt);
+    }
+
+    /* an unchecked take inside an ensured batch, then a failed checked read */
+    ZByteReader reader(buffer, 7);
+    ZTEST_CHECK(reader.ensure(6));
+    ZTEST_CHECK(reader.takeBigEndian<std::uint32_t>() == 0x01020304);
+    std::uint64_t wide;
+    ZTEST_CHECK(!reader.readBigEndian(wide));
+    ZTEST_CHECK(reader.position() == 4);
+
+    ZByteReader empty(nullptr, 0);
+    char byte;
+    ZTEST_CHECK(empty.readBytes(&byte, 0));
+    ZTEST_CHECK(!empty.readBytes(&byte, 1));
+    ZTEST_CHECK(empty.position() == 0);
+}
+
+void testVarintRewind()
+{
+    /* a varint above 32 bits is rejected by the narrow overload without consuming it */
+    const std::uint64_t values[] = {0xffffffffULL, 0x100000000ULL, static_cast<std::uint64_t>(1) << 40, ~static_cast<std::uint64_t>(0)};
+    for(std::uint64_t value : values)
+    {
+        char buffer[16];
+        ZByteWriter writer(buffer, sizeof(buffer));
+        writer.writeBigEndian(std::uint16_t(7));
+        writer.writeVarint(value);
+
+        ZByteReader reader(buffer, writer.position());
+        std::uint16_t header;
+        ZTEST_CHECK(reader.readBigEndian(header));
+
+        std::uint32_t narrow = 0;
+        const bool fits = value <= 0xffffffffULL;
+        ZTEST_CHECK(reader.readVarint(narrow) == fits);
+        if(fits)
+        {
+            ZTEST_CHECK(narrow == value);
+            ZTEST_CHECK(reader.atEnd());
+            continue;
+        }
+
+        ZTEST_CHECK(reader.hasError());
+        ZTEST_CHECK(reader.position() == 2);
+        reader.clearError();
+        std::uint64_t wide = 0;
+        ZTEST_CHECK(reader.readVarint(wide));
+        ZTEST_CHECK(wide == value);
+        ZTEST_CHECK(reader.atEnd());
+    }
+
+    /* a length prefix longer than the rest of the buffer rewinds over the length */
+    const char prefixed[] = {5, 'a', 'b'};
+    ZByteReader reader(prefixed, sizeof(prefixed));
+    ZStringView view;
+    ZTEST_CHECK(!reader.readLengthPrefixed(view));
+    ZTEST_CHECK(reader.position() == 0);
+    ZTEST_CHECK(reader.hasError());
+}
+
+void testWriter()
+{
+    /* a length prefixed blob is written completely or not at all, for every capacity */
+    const std::string blob(200, 'b');
+    const std::size_t encoded = ZVarint::varintSize(blob.size()) + blob.size();
+    for(std::size_t capacity = 0; capacity <= encoded + 1; ++capacity)
+    {
+        std::vector<char> buffer(capacity + 1, '\x5a');
+        ZByteWriter writer(buffer.data(), capacity);
+        const bool written = writer.writeLengthPrefixed(ZStringView(blob));
+        ZTEST_CHECK(written == (capacity >= encoded));
+        ZTEST_CHECK(writer.hasError() == !written);
+        ZTEST_CHECK(writer.position() == (written ? encoded : 0));
+
+        std::size_t untouched = 0;
+        for(char c : buffer) untouched += c == '\x5a';
+        ZTEST_CHECK(untouched == buffer.size() - writer.position());
+
+        if(written)
+        {
+            ZByteReader reader(writer.written());
+            ZStringView view;
+            ZTEST_CHECK(reader.readLengthPrefixed(view) && view == ZStringView(blob) && reader.atEnd());
+        }
+    }
+
+    /* failures are sticky until clearError() or reset() */
+    char small[4];
+    ZByteWriter writer(small, sizeof(small));
+    ZTEST_CHECK(writer.writeBigEndian(std::uint16_t(1)));
+    ZTEST_CHECK(!writer.writeBigEndian(std::uint32_t(2)));
+    ZTEST_CHECK(writer.position() == 2);
+    ZTEST_CHECK(!writer.writeBytes("x", 1));
+    ZTEST_CHECK(!writer.writeVarint(1));
+    ZTEST_CHECK(writer.position() == 2);
+    writer.clearError();
+    ZTEST_CHECK(writer.writeBytes("xy", 2));
+    ZTEST_CHECK(writer.remaining() == 0);
+    ZTEST_CHECK(!writer.writePrefixVarint(0));
+    writer.reset();
+    ZTEST_CHECK(!writer.hasError() && writer.position() == 0);
+    ZTEST_CHECK(!writer.writeLengthPrefixed(ZStringView("abcd")));
+    ZTEST_CHECK(writer.position() == 0);
+}
+
+}
+
+void ztest::testByteReader()
+{
+    testRoundTrip();
+    testStickyError();
+    testVarintRewind();
+    testWriter();
+}
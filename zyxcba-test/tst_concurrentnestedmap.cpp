@@ -0,0 +1,229 @@
+#include "ztest.h"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ZConcurrentNestedMap>
+#include <ZEpoch>
+#include <ZNestedMap>
+
+namespace {
+
+using namespace zyxcba;
+
+int g_live = 0;
+
+struct Tracked
+{
+    Tracked() { ++g_live; }
+    ~Tracked() { --g_live; }
+};
+
+void testNestedGuards()
+{
+    ZEpoch::reclaim();
+    ZTEST_CHECK(ZEpoch::pending() == 0);
+    {
+        ZEpochGuard outer;
+        {
+            ZEpochGuard inner;
+            ZEpoch::retire(new Tracked());
+            ZTEST_CHECK(ZEpoch::reclaim() == 0);
+        }
+
+        /* leaving the inner guard must not end the read section of the outer one */
+        ZTEST_CHECK(ZEpoch::reclaim() == 0);
+        ZTEST_CHECK(ZEpoch::pending() == 1 && g_live == 1);
+    }
+    ZTEST_CHECK(ZEpoch::reclaim() == 1);
+    ZTEST_CHECK(ZEpoch::pending() == 0 && g_live == 0);
+
+    /* a guard held by another thread keeps everything retired after it entered */
+    std::atomic<int> stage(0);
+    std::thread reader([&stage] {
+        ZEpochGuard guard;
+        stage = 1;
+        while(stage.load() != 2) std::this_thread::yield();
+    });
+    while(stage.load() != 1) std::this_thread::yield();
+    ZEpoch::retire(new Tracked());
+    ZTEST_CHECK(ZEpoch::reclaim() == 0 && g_live == 1);
+    stage = 2;
+    reader.join();
+    ZTEST_CHECK(ZEpoch::reclaim() == 1 && g_live == 0);
+
+    /* the map enters its own guard inside the caller's one */
+    ZConcurrentNestedMap map;
+    map.set("a.b", ZVariant(std::string("first")));
+    {
+        ZEpochGuard guard;
+        bool seen = false;
+        ZTEST_CHECK(map.read("a.b", [&](const ZVariant &value) {
+            map.set("a.b", ZVariant(std::string("second")));
+            seen = value.getString() == "first";
+        }));
+        ZTEST_CHECK(seen && ZEpoch::pending() > 0);
+        ZTEST_CHECK(map.get("a.b").getString() == "second");
+    }
+    ZEpoch::reclaim();
+    ZTEST_CHECK(ZEpoch::pending() == 0);
+}
+
+void testModel()
+{
+    ZConcurrentNestedMap map;
+    ZTEST_CHECK(map.empty());
+    ZTEST_CHECK(!map.set("", ZVariant(std::int32_t(1))) && !map.set("a..b", ZVariant(std::int32_t(1))));
+    ZTEST_CHECK(!map.set("a.", ZVariant(std::int32_t(1))));
+
+    std::mt19937 random(9);
+    std::map<std::string, std::int32_t> model;
+    for(std::int32_t i = 0; i < 20000; ++i)
+    {
+        std::string path;
+        for(unsigned depth = 1 + random() % 4; depth > 0; --depth)
+        {
+            if(!path.empty()) path += '.';
+            path += char('a' + random() % 5);
+            if(random() % 3 == 0) path += char('0' + random() % 10);
+        }
+
+        const unsigned action = random() % 10;
+        if(action < 6)
+        {
+            ZTEST_CHECK(map.set(path, ZVariant(i)));
+            model[path] = i;
+        }
+        else if(action < 8)
+        {
+            bool removed = false;
+            for(std::map<std::string, std::int32_t>::iterator it = model.begin(); it != model.end();)
+            {
+                if(it->first == path || it->first.compare(0, path.size() + 1, path + '.') == 0)
+                {
+                    it = model.erase(it);
+                    removed = true;
+                }
+                else ++it;
+            }
+            ZTEST_CHECK(map.erase(path) || !removed);
+        }
+        else
+        {
+            ZVariant value;
+            const std::map<std::string, std::int32_t>::const_iterator expected = model.find(path);
+            ZTEST_CHECK(map.get(path, value) == (expected != model.end()));
+            if(expected != model.end()) ZTEST_CHECK(value.getInt32() == expected->second);
+        }
+        ZTEST_CHECK(map.size() == model.size());
+    }
+
+    std::map<std::string, std::int32_t> walked;
+    map.forEach("", [&](const ZStringView &path, const ZVariant &value) {
+        walked[path.toString()] = value.getInt32();
+        return true;
+    });
+    ZTEST_CHECK(walked == model);
+
+    ZNestedMap source;
+    for(const std::map<std::string, std::int32_t>::value_type &entry : model) source.set(entry.first, ZVariant(entry.second));
+    ZConcurrentNestedMap assigned;
+    assigned.set("zz", ZVariant(std::int32_t(1)));
+    assigned.assign(source);
+    ZTEST_CHECK(assigned.size() == model.size() && !assigned.contains("zz"));
+    for(const std::map<std::string, std::int32_t>::value_type &entry : model) ZTEST_CHECK(assigned.get(entry.first).getInt32() == entry.second);
+    assigned.clear();
+    ZTEST_CHECK(assigned.empty() && !assigned.contains(model.begin()->first));
+}
+
+std::string keyPath(const unsigned &key)
+{
+    return "k." + std::to_string(key % 120) + ".v";
+}
+
+void testReadersAndWriter()
+{
+    /* every stored value equals its own path, so a reader can tell a torn or freed value apart */
+    ZConcurrentNestedMap map;
+    for(unsigned key = 0; key < 100; ++key) map.set(keyPath(key), ZVariant(keyPath(key)));
+
+    std::atomic<bool> stop(false);
+    std::atomic<int> errors(0);
+    std::atomic<long> reads(0);
+    std::vector<std::thread> readers;
+    for(unsigned thread = 0; thread < 4; ++thread)
+    {
+        readers.emplace_back([&, thread] {
+            std::mt19937 random(thread);
+            long count = 0;
+            while(!stop.load(std::memory_order_relaxed))
+            {
+                const std::string path = keyPath(random());
+                ZVariant value;
+                if(map.get(path, value) && value.getString() != path) ++errors;
+                map.read(path, [&](const ZVariant &stored) {
+                    if(stored.getString() != path) ++errors;
+                });
+                if(count % 64 == 0)
+                {
+                    std::size_t visited = 0;
+                    map.forEach("k", [&](const ZStringView &key, const ZVariant &stored) {
+                        if(stored.getString() != key.toString()) ++errors;
+                        return ++visited <= 120;
+                    });
+                    if(visited > 120) ++errors;
+                }
+                ++count;
+            }
+            reads += count;
+        });
+    }
+
+    std::mt19937 random(1);
+    for(int i = 0; i < 20000; ++i)
+    {
+        const unsigned action = random() % 100;
+        if(action < 70)
+        {
+            const std::string path = keyPath(random());
+            map.set(path, ZVariant(path));
+        }
+        else if(action < 97)
+        {
+            map.erase("k." + std::to_string(random() % 120));
+        }
+        else if(action < 99)
+        {
+            ZNestedMap replacement;
+            for(unsigned key = random() % 7; key < 120; key += 7) replacement.set(keyPath(key), ZVariant(keyPath(key)));
+            map.assign(replacement);
+        }
+        else
+        {
+            map.clear();
+        }
+    }
+    stop = true;
+    for(std::thread &reader : readers) reader.join();
+
+    ZTEST_CHECK(errors.load() == 0);
+    ZTEST_CHECK(reads.load() > 0);
+
+    /* with every reader gone nothing can hold a retired node any more */
+    ZEpoch::reclaim();
+    ZTEST_CHECK(ZEpoch::pending() == 0);
+}
+
+}
+
+void ztest::testConcurrentNestedMap()
+{
+    testNestedGuards();
+    testModel();
+    testReadersAndWriter();
+}
@@ -0,0 +1,169 @@
+#include "ztest.h"
+
+#include <cstring>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include <ZChecksum>
+#include <ZHash>
+
+namespace {
+
+using namespace zyxcba;
+
+std::size_t popcount(std::uint64_t value)
+{
+    std::size_t count = 0;
+    for(; value != 0; value &= value - 1) ++count;
+    return count;
+}
+
+/* the mean fraction of output bits that flip when one input bit flips, ideally one half */
+double avalanche(std::mt19937_64 &random, const std::size_t &size)
+{
+    std::vector<unsigned char> data(size);
+    std::size_t flipped = 0;
+    std::size_t trials = 0;
+    for(int round = 0; round < 16; ++round)
+    {
+        for(unsigned char &byte : data) byte = static_cast<unsigned char>(random());
+        const std::uint64_t base = ZHash::hash64(data.data(), size);
+        for(std::size_t bit = 0; bit < size * 8; bit += 1 + size / 64)
+        {
+            data[bit / 8] ^= static_cast<unsigned char>(1u << (bit % 8));
+            flipped += popcount(base ^ ZHash::hash64(data.data(), size));
+            data[bit / 8] ^= static_cast<unsigned char>(1u << (bit % 8));
+            ++trials;
+        }
+    }
+    return static_cast<double>(flipped) / static_cast<double>(trials * 64);
+}
+
+}
+
+void ztest::testHash()
+{
+    std::mt19937_64 random(19);
+    std::vector<unsigned char> input(4096 + 64);
+    for(unsigned char &byte : input) byte = static_cast<unsigned char>(random());
+
+    /* the dispatched long input kernels against the scalar one, at every length around the
+     * 240 byte switch and the stripe boundaries, misaligned and seeded
+     */
+    for(std::size_t size = 0; size <= 1100; ++size)
+    {
+        for(std::size_t offset = 0; offset < 64; offset += (size < 300 ? 7 : 31))
+        {
+            const std::uint64_t seed = size % 3 == 0 ? 0 : random();
+            ZTEST_CHECK(ZHash::hash64(input.data() + offset, size, seed) == ZHash::hash64Scalar(input.data() + offset, size, seed));
+        }
+    }
+    const std::size_t longSizes[] = { 2047, 2048, 2049, 4095, 4096 };
+    for(const std::size_t &size : longSizes)
+    {
+        ZTEST_CHECK(ZHash::hash64(input.data() + 3, size, 7) == ZHash::hash64Scalar(input.data() + 3, size, 7));
+    }
+
+    /* the result depends on the bytes only, not on their address */
+    std::vector<unsigned char> copy(input.begin() + 5, input.begin() + 5 + 1000);
+    ZTEST_CHECK(ZHash::hash64(copy.data(), copy.size()) == ZHash::hash64(input.data() + 5, 1000));
+    ZTEST_CHECK(ZHash::hash128(copy.data(), copy.size()) == ZHash::hash128(input.data() + 5, 1000));
+
+    /* no collisions among counters, among short strings of every length and among inputs
+     * differing in a single bit
+     */
+    std::unordered_set<std::uint64_t> counters;
+    for(std::uint64_t value = 0; value < 200000; ++value)
+    {
+        counters.insert(ZHash::hash64(&value, sizeof(value)));
+    }
+    ZTEST_CHECK(counters.size() == 200000);
+
+    std::unordered_set<std::uint64_t> zeros;
+    const std::vector<unsigned char> zeroBytes(1100, 0);
+    for(std::size_t size = 0; size <= 1100; ++size)
+    {
+        zeros.insert(ZHash::hash64(zeroBytes.data(), size));
+    }
+    ZTEST_CHECK(zeros.size() == 1101);
+
+    std::unordered_set<std::uint64_t> bits;
+    std::size_t bitCount = 0;
+    const std::size_t bitSizes[] = { 1, 7, 16, 17, 128, 240, 241, 1024 };
+    for(const std::size_t &size : bitSizes)
+    {
+        std::vector<unsigned char> data(size, 0);
+        for(std::size_t bit = 0; bit < size * 8; ++bit)
+        {
+            data[bit / 8] ^= static_cast<unsigned char>(1u << (bit % 8));
+            bits.insert(ZHash::hash64(data.data(), size));
+            bits.insert(ZHash::hash128(data.data(), size).high);
+            data[bit / 8] ^= static_cast<unsigned char>(1u << (bit % 8));
+            bitCount += 2;
+        }
+    }
+    ZTEST_CHECK(bits.size() == bitCount);
+
+    std::unordered_set<std::uint64_t> seeds;
+    for(std::uint64_t seed = 0; seed < 10000; ++seed)
+    {
+        seeds.insert(ZHash::hash64("key", 3, seed));
+    }
+    ZTEST_CHECK(seeds.size() == 10000);
+
+    /* avalanche on each input size class */
+    const std::size_t avalancheSizes[] = { 3, 8, 16, 17, 64, 128, 240, 241, 1024 };
+    for(const std::size_t &size : avalancheSizes)
+    {
+        const double ratio = avalanche(random, size);
+        ZTEST_CHECK(ratio > 0.48 && ratio < 0.52);
+    }
+
+    ZTEST_CHECK(ZHash::combine(1, 2) != ZHash::combine(2, 1));
+    std::unordered_set<std::uint64_t> mixed;
+    for(std::uint64_t value = 0; value < 100000; ++value)
+    {
+        mixed.insert(ZHash::mix(value));
+    }
+    ZTEST_CHECK(mixed.size() == 100000);
+}
+
+void ztest::testChecksum()
+{
+    /* the check value of the CRC-32C catalogue and the iSCSI vectors of RFC 3720 */
+    ZTEST_CHECK(ZChecksum::crc32c("123456789", 9) == 0xE3069283u);
+    ZTEST_CHECK(ZChecksum::crc32cScalar("123456789", 9) == 0xE3069283u);
+    ZTEST_CHECK(ZChecksum::crc32c("", 0) == 0);
+
+    unsigned char vector[32];
+    std::memset(vector, 0, sizeof(vector));
+    ZTEST_CHECK(ZChecksum::crc32c(vector, sizeof(vector)) == 0x8A9136AAu);
+    std::memset(vector, 0xff, sizeof(vector));
+    ZTEST_CHECK(ZChecksum::crc32c(vector, sizeof(vector)) == 0x62A8AB43u);
+    for(std::size_t i = 0; i < sizeof(vector); ++i) vector[i] = static_cast<unsigned char>(i);
+    ZTEST_CHECK(ZChecksum::crc32c(vector, sizeof(vector)) == 0x46DD794Eu);
+    for(std::size_t i = 0; i < sizeof(vector); ++i) vector[i] = static_cast<unsigned char>(31 - i);
+    ZTEST_CHECK(ZChecksum::crc32c(vector, sizeof(vector)) == 0x113FDB5Cu);
+
+    /* the crc32 instruction path against the table walk, at every length and misalignment */
+    std::mt19937_64 random(32);
+    std::vector<unsigned char> input(4096 + 16);
+    for(unsigned char &byte : input) byte = static_cast<unsigned char>(random());
+    for(std::size_t size = 0; size <= 1100; ++size)
+    {
+        for(std::size_t offset = 0; offset < 16; offset += (size < 300 ? 1 : 5))
+        {
+            const std::uint32_t crc = static_cast<std::uint32_t>(random());
+            ZTEST_CHECK(ZChecksum::crc32c(input.data() + offset, size, crc) == ZChecksum::crc32cScalar(input.data() + offset, size, crc));
+        }
+    }
+    ZTEST_CHECK(ZChecksum::crc32c(input.data() + 1, 4096) == ZChecksum::crc32cScalar(input.data() + 1, 4096));
+
+    /* chaining over any split equals the checksum of the whole */
+    const std::uint32_t whole = ZChecksum::crc32c(input.data(), 1000);
+    for(std::size_t split = 0; split <= 1000; split += 37)
+    {
+        ZTEST_CHECK(ZChecksum::crc32c(input.data() + split, 1000 - split, ZChecksum::crc32c(input.data(), split)) == whole);
+    }
+}
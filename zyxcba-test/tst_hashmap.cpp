@@ -0,0 +1,238 @@
+#include "ztest.h"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include <ZHashMap>
+
+namespace {
+
+using namespace zyxcba;
+
+/* only eight distinct hash values, so every probe sequence runs through long clusters */
+struct ClusteringHash
+{
+    std::size_t operator()(const std::uint64_t &key) const { return static_cast<std::size_t>(key % 8); }
+};
+
+std::size_t allocateCount = 0;
+std::size_t liveBlocks = 0;
+
+template<typename T>
+class CountingAllocator
+{
+public:
+    typedef T value_type;
+
+    CountingAllocator() {}
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U> &) {}
+
+    T *allocate(std::size_t count)
+    {
+        ++allocateCount;
+        ++liveBlocks;
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T *pointer, std::size_t count)
+    {
+        --liveBlocks;
+        std::allocator<T>().deallocate(pointer, count);
+    }
+
+    CountingAllocator select_on_container_copy_construction() const { return *this; }
+
+    template<typename U>
+    bool operator==(const CountingAllocator<U> &) const { return true; }
+    template<typename U>
+    bool operator!=(const CountingAllocator<U> &) const { return false; }
+};
+
+template<typename Map, typename Reference>
+bool sameContents(const Map &map, const Reference &reference)
+{
+    if(map.size() != reference.size()) return false;
+
+    std::size_t visited = 0;
+    for(typename Map::const_iterator it = map.begin(); it != map.end(); ++it)
+    {
+        typename Reference::const_iterator found = reference.find(it->first);
+        if(found == reference.end() || found->second != it->second) return false;
+        ++visited;
+    }
+    return visited == reference.size();
+}
+
+template<typename Map>
+bool withinLoadFactor(const Map &map)
+{
+    return map.capacity() == 0 || map.size() <= map.capacity() - map.capacity() / 8;
+}
+
+template<typename Map>
+void checkModel(std::mt19937_64 &random, std::uint64_t keyRange, int operations, int eraseWeight)
+{
+    Map map;
+    std::unordered_map<std::uint64_t, int> reference;
+
+    for(int i = 0; i < operations; ++i)
+    {
+        const std::uint64_t key = random() % keyRange;
+        const int action = static_cast<int>(random() % 10);
+        if(action < eraseWeight)
+        {
+            ZTEST_CHECK(map.erase(key) == reference.erase(key));
+        }
+        else if(action < eraseWeight + 3)
+        {
+            const bool inserted = map.emplace(key, i).second;
+            ZTEST_CHECK(inserted == reference.emplace(key, i).second);
+        }
+        else
+        {
+            typename Map::const_iterator found = static_cast<const Map&>(map).find(key);
+            std::unordered_map<std::uint64_t, int>::const_iterator expected = reference.find(key);
+            ZTEST_CHECK((found == map.cend()) == (expected == reference.end()));
+            if(found != map.cend() && expected != reference.end()) ZTEST_CHECK(found.value() == expected->second);
+        }
+        ZTEST_CHECK(map.size() == reference.size());
+        ZTEST_CHECK(withinLoadFactor(map));
+
+        if(i % 4096 == 0) ZTEST_CHECK(sameContents(map, reference));
+    }
+    ZTEST_CHECK(sameContents(map, reference));
+
+    /* every key outside the model must still be reported missing after all the shifting */
+    for(std::uint64_t key = 0; key < keyRange; ++key)
+    {
+        ZTEST_CHECK(map.count(key) == reference.count(key));
+    }
+
+    /* draining the map erases from the middle of every cluster */
+    for(std::uint64_t key = 0; key < keyRange; key += 2)
+    {
+        ZTEST_CHECK(map.erase(key) == reference.erase(key));
+    }
+    ZTEST_CHECK(sameContents(map, reference));
+    for(std::uint64_t key = keyRange; key-- > 0;)
+    {
+        ZTEST_CHECK(map.erase(key) == reference.erase(key));
+    }
+    ZTEST_CHECK(map.empty());
+    ZTEST_CHECK(map.begin() == map.end());
+}
+
+void testModel()
+{
+    std::mt19937_64 random(20240601);
+
+    /* the default hash with an erase heavy mix, then the clustering hash */
+    checkModel<ZHashMap<std::uint64_t, int> >(random, 5000, 200000, 4);
+    checkModel<ZHashMap<std::uint64_t, int, ClusteringHash> >(random, 600, 40000, 4);
+    checkModel<ZHashMap<std::uint64_t, int, ClusteringHash> >(random, 64, 20000, 6);
+}
+
+void testGrowth()
+{
+    typedef ZHashMap<std::uint64_t, std::uint64_t, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>,
+                     CountingAllocator<char> > Map;
+
+    allocateCount = 0;
+    {
+        Map map;
+        ZTEST_CHECK(map.capacity() == 0);
+        ZTEST_CHECK(allocateCount == 0);
+
+        /* the table doubles exactly when the next insert would push it past 7/8 */
+        std::size_t growths = 0;
+        for(std::uint64_t key = 0; key < 10000; ++key)
+        {
+            const std::size_t capacity = map.capacity();
+            map.emplace(key, key * 3);
+            if(map.capacity() != capacity)
+            {
+                ++growths;
+                ZTEST_CHECK(capacity == 0 ? map.capacity() == 8 : map.capacity() == capacity * 2);
+                ZTEST_CHECK(capacity == 0 || key == capacity - capacity / 8);
+            }
+            ZTEST_CHECK(withinLoadFactor(map));
+        }
+
+        /* control bytes, keys and values share a single block per table */
+        ZTEST_CHECK(allocateCount == growths);
+        ZTEST_CHECK(liveBlocks == 1);
+
+        for(std::uint64_t key = 0; key < 10000; ++key)
+        {
+            Map::const_iterator found = static_cast<const Map&>(map).find(key);
+            ZTEST_CHECK(found != map.cend() && found.value() == key * 3);
+        }
+
+        /* erasing never shrinks or reallocates */
+        const std::size_t capacity = map.capacity();
+        for(std::uint64_t key = 0; key < 10000; key += 3) map.erase(key);
+        ZTEST_CHECK(map.capacity() == capacity);
+        ZTEST_CHECK(allocateCount == growths);
+
+        allocateCount = 0;
+        Map copy(map);
+        ZTEST_CHECK(allocateCount == 1);
+        ZTEST_CHECK(copy.size() == map.size());
+        for(Map::const_iterator it = map.begin(); it != map.end(); ++it)
+        {
+            ZTEST_CHECK(copy.count(it.key()) == 1 && copy.find(it.key()).value() == it.value());
+        }
+
+        Map moved(std::move(copy));
+        ZTEST_CHECK(allocateCount == 1);
+        ZTEST_CHECK(moved.size() == map.size());
+        ZTEST_CHECK(copy.empty());
+
+        allocateCount = 0;
+        Map reserved;
+        reserved.reserve(1000);
+        ZTEST_CHECK(allocateCount == 1);
+        ZTEST_CHECK(reserved.capacity() >= 1000 + 1000 / 7);
+        for(std::uint64_t key = 0; key < 1000; ++key) reserved.emplace(key, key);
+        ZTEST_CHECK(allocateCount == 1);
+
+        reserved.clear();
+        ZTEST_CHECK(reserved.empty());
+        ZTEST_CHECK(reserved.find(7) == reserved.end());
+    }
+    ZTEST_CHECK(liveBlocks == 0);
+}
+
+void testStringKeys()
+{
+    /* non trivially relocatable keys take the move path in backward shift deletion */
+    ZHashMap<std::string, std::string> map;
+    std::unordered_map<std::string, std::string> reference;
+    std::mt19937_64 random(7);
+    for(int i = 0; i < 20000; ++i)
+    {
+        const std::string key = "key-with-a-long-enough-prefix-" + std::to_string(random() % 700);
+        if(random() % 2)
+        {
+            ZTEST_CHECK(map.erase(key) == reference.erase(key));
+        }
+        else
+        {
+            map[key] = key + std::to_string(i);
+            reference[key] = key + std::to_string(i);
+        }
+    }
+    ZTEST_CHECK(sameContents(map, reference));
+}
+
+}
+
+void ztest::testHashMap()
+{
+    testModel();
+    testGrowth();
+    testStringKeys();
+}
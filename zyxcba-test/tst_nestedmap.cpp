@@ -0,0 +1,472 @@
+#include "ztest.h"
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ZNestedMap>
+
+namespace {
+
+using namespace zyxcba;
+
+typedef std::map<std::string, std::int32_t> Model;
+
+const ZNestedMapStorage Storages[] = {ZNestedMapStorage::HashLevels, ZNestedMapStorage::RadixTree};
+
+Model contents(const ZNestedMap &map, const ZStringView &prefix = ZStringView())
+{
+    Model seen;
+    map.forEach(prefix, [&](const ZStringView &path, const ZVariant &value) {
+        seen[path.toString()] = value.getInt32();
+        return true;
+    });
+    return seen;
+}
+
+bool isAtOrBelow(const std::string &path, const std::string &prefix, const char &separator)
+{
+    if(prefix.empty()) return true;
+    return path.compare(0, prefix.size(), prefix) == 0 && (path.size() == prefix.size() || path[prefix.size()] == separator);
+}
+
+Model modelBelow(const Model &model, const std::string &prefix, const char &separator)
+{
+    Model below;
+    for(const Model::value_type &entry : model)
+    {
+        if(isAtOrBelow(entry.first, prefix, separator)) below.insert(entry);
+    }
+    return below;
+}
+
+/* the distinct next segments below prefix among the stored paths */
+std::size_t modelChildCount(const Model &model, const std::string &prefix, const char &separator)
+{
+    std::set<std::string> children;
+    const std::size_t start = prefix.empty() ? 0 : prefix.size() + 1;
+    for(const Model::value_type &entry : model)
+    {
+        if(entry.first.size() <= prefix.size() || !isAtOrBelow(entry.first, prefix, separator)) continue;
+        children.insert(entry.first.substr(start, entry.first.find(separator, start) - start));
+    }
+    return children.size();
+}
+
+void eraseFromModel(Model &model, const std::string &path, const char &separator)
+{
+    for(Model::iterator it = model.begin(); it != model.end();)
+    {
+        if(isAtOrBelow(it->first, path, separator)) it = model.erase(it);
+        else ++it;
+    }
+}
+
+std::string randomPath(std::mt19937 &random, const char &separator)
+{
+    static const char *const segments[] = {"a", "b", "cc", "d", "e", "long_segment_name", "x", "y", "zz", "q"};
+    std::string path;
+    for(std::size_t depth = 1 + random() % 4; depth > 0; --depth)
+    {
+        if(!path.empty()) path += separator;
+        path += segments[random() % 10];
+    }
+    return path;
+}
+
+void testInvalidPaths(const ZNestedMapStorage &storage)
+{
+    ZNestedMap map('.', storage);
+    ZTEST_CHECK(map.empty());
+    ZTEST_CHECK(map.storage() == storage);
+
+    const char *const invalid[] = {"", ".", "a..b", ".a", "a.", "..", "a.b."};
+    for(const char *path : invalid)
+    {
+        ZTEST_CHECK(!map.set(path, ZVariant(std::int32_t(1))));
+        ZTEST_CHECK(map.find(path) == nullptr);
+        ZTEST_CHECK(!map.contains(path));
+        ZTEST_CHECK(!map.erase(path));
+    }
+    ZTEST_CHECK(map.empty());
+    ZTEST_CHECK(map.childCount("") == 0);
+
+    ZTEST_CHECK(map.set("a.b.c", ZVariant(std::int32_t(1))));
+    ZTEST_CHECK(map.find("a.b.c.") == nullptr);
+    ZTEST_CHECK(map.find("a.b..c") == nullptr);
+    ZTEST_CHECK(map.find(".a.b.c") == nullptr);
+    ZTEST_CHECK(!map.erase("a..b"));
+    ZTEST_CHECK(map.size() == 1);
+}
+
+void testValuesAndPruning(const ZNestedMapStorage &storage)
+{
+    ZNestedMap map('.', storage);
+    ZTEST_CHECK(map.set("a.b.c", ZVariant(std::int32_t(1))));
+    ZTEST_CHECK(map.size() == 1);
+    ZTEST_CHECK(!map.contains("a.b"));
+    ZTEST_CHECK(map.contains("a.b.c"));
+    ZTEST_CHECK(map.get("a.b.c").getInt32() == 1);
+    ZTEST_CHECK(map.get("a.b.x", ZVariant(std::int32_t(7))).getInt32() == 7);
+
+    /* a path may hold a value and children at once */
+    ZTEST_CHECK(map.set("a.b", ZVariant(std::string("mid"))));
+    ZTEST_CHECK(map.size() == 2);
+    ZTEST_CHECK(map.set("a.b.c", ZVariant(std::int32_t(2))));
+    ZTEST_CHECK(map.size() == 2);
+    ZTEST_CHECK(map.childCount("a") == 1 && map.childCount("a.b") == 1 && map.childCount("a.b.c") == 0);
+    *map.find("a.b.c") = ZVariant(std::int32_t(3));
+    ZTEST_CHECK(map.get("a.b.c").getInt32() == 3);
+
+    /* erasing the last value below a level removes the now empty levels too */
+    ZTEST_CHECK(map.set("a.x.y.z", ZVariant(std::int32_t(4))));
+    ZTEST_CHECK(map.childCount("a") == 2);
+    ZTEST_CHECK(map.erase("a.x.y.z"));
+    ZTEST_CHECK(map.childCount("a") == 1);
+    ZTEST_CHECK(map.childCount("a.x") == 0);
+    ZTEST_CHECK(contents(map, "a.x").empty());
+
+    /* but a level holding a value stays */
+    ZTEST_CHECK(map.erase("a.b.c"));
+    ZTEST_CHECK(map.contains("a.b"));
+    ZTEST_CHECK(map.childCount("a") == 1 && map.childCount("a.b") == 0);
+
+    ZTEST_CHECK(!map.erase("a.x"));
+    ZTEST_CHECK(!map.erase("a.b.c"));
+    ZTEST_CHECK(map.set("a.b.c.d", ZVariant(std::int32_t(5))));
+    ZTEST_CHECK(map.erase("a"));
+    ZTEST_CHECK(map.size() == 0 && map.empty());
+    ZTEST_CHECK(map.childCount("") == 0);
+
+    /* forEach stops when the visitor says so */
+    for(std::int32_t i = 0; i < 10; ++i) map.set("k." + std::to_string(i), ZVariant(i));
+    int visited = 0;
+    ZTEST_CHECK(!map.forEach("", [&](const ZStringView &, const ZVariant &) { return ++visited < 3; }));
+    ZTEST_CHECK(visited == 3);
+    ZTEST_CHECK(map.forEach("missing", [&](const ZStringView &, const ZVariant &) { return false; }));
+    ZTEST_CHECK(contents(map, "k.3") == Model({{"k.3", 3}}));
+    ZTEST_CHECK(contents(map, "k.1").size() == 1);
+
+    map.clear();
+    ZTEST_CHECK(map.empty() && !map.contains("k.1") && map.childCount("") == 0);
+}
+
+void testModel(const ZNestedMapStorage &storage, const char &separator)
+{
+    std::mt19937 random(21);
+    ZNestedMap map(separator, storage);
+    Model model;
+
+    for(std::int32_t i = 0; i < 60000; ++i)
+    {
+        const std::string path = randomPath(random, separator);
+        const unsigned action = random() % 10;
+        if(action < 6)
+        {
+            model[path] = i;
+            ZTEST_CHECK(map.set(path, ZVariant(i)));
+        }
+        else if(action < 8)
+        {
+            const bool stored = !modelBelow(model, path, separator).empty();
+            eraseFromModel(model, path, separator);
+            ZTEST_CHECK(map.erase(path) == stored);
+        }
+        else
+        {
+            const Model::const_iterator expected = model.find(path);
+            const ZVariant *value = map.find(path);
+            ZTEST_CHECK((expected == model.end()) == (value == nullptr));
+            if(value && expected != model.end()) ZTEST_CHECK(value->getInt32() == expected->second);
+        }
+        ZTEST_CHECK(map.size() == model.size());
+
+        if(i % 2000 == 0)
+        {
+            ZTEST_CHECK(contents(map) == model);
+            const std::string prefix = randomPath(random, separator);
+            ZTEST_CHECK(contents(map, prefix) == modelBelow(model, prefix, separator));
+            ZTEST_CHECK(map.childCount(prefix) == modelChildCount(model, prefix, separator));
+            ZTEST_CHECK(map.childCount("") == modelChildCount(model, "", separator));
+        }
+    }
+}
+
+void testCopyMoveSwap(const ZNestedMapStorage &storage)
+{
+    ZNestedMap map('/', storage);
+    for(std::int32_t i = 0; i < 100; ++i) map.set("a/" + std::to_string(i % 7) + "/" + std::to_string(i), ZVariant(i));
+    const Model model = contents(map);
+    ZTEST_CHECK(model.size() == 100);
+
+    ZNestedMap copy(map);
+    ZTEST_CHECK(contents(copy) == model);
+    ZTEST_CHECK(copy.separator() == '/' && copy.storage() == storage);
+    copy.set("a/1/1", ZVariant(std::int32_t(-1)));
+    copy.erase("a/2");
+    ZTEST_CHECK(contents(map) == model);
+    ZTEST_CHECK(copy.get("a/1/1").getInt32() == -1);
+
+    ZNestedMap moved(std::move(copy));
+    ZTEST_CHECK(copy.empty());
+    ZTEST_CHECK(moved.get("a/1/1").getInt32() == -1);
+    ZTEST_CHECK(copy.set("x/y", ZVariant(std::int32_t(1))) && copy.size() == 1);
+
+    ZNestedMap assigned;
+    assigned.set("old", ZVariant(std::int32_t(0)));
+    assigned = map;
+    ZTEST_CHECK(contents(assigned) == model);
+    ZTEST_CHECK(assigned.separator() == '/' && !assigned.contains("old"));
+    const ZNestedMap &self = assigned;
+    assigned = self;
+    ZTEST_CHECK(contents(assigned) == model);
+
+    assigned = std::move(moved);
+    ZTEST_CHECK(assigned.get("a/1/1").getInt32() == -1);
+    ZTEST_CHECK(!assigned.contains("a/2/2"));
+
+    ZNestedMap dotted;
+    dotted.set("p.q", ZVariant(std::int32_t(9)));
+    dotted.swap(assigned);
+    ZTEST_CHECK(dotted.separator() == '/' && assigned.separator() == '.');
+    ZTEST_CHECK(assigned.get("p.q").getInt32() == 9 && assigned.size() == 1);
+    ZTEST_CHECK(dotted.get("a/1/1").getInt32() == -1);
+}
+
+void testManyChildren(const ZNestedMapStorage &storage)
+{
+    /* one level growing to 10k children and shrinking back, with deletes throughout the table */
+    ZNestedMap map('/', storage);
+    for(std::int32_t i = 0; i < 10000; ++i) ZTEST_CHECK(map.set("root/" + std::to_string(i), ZVariant(i)));
+    ZTEST_CHECK(map.childCount("root") == 10000);
+    ZTEST_CHECK(map.childCount("") == 1);
+
+    for(std::int32_t i = 0; i < 10000; i += 2) ZTEST_CHECK(map.erase("root/" + std::to_string(i)));
+    ZTEST_CHECK(map.childCount("root") == 5000);
+    for(std::int32_t i = 0; i < 10000; ++i)
+    {
+        const ZVariant *value = map.find("root/" + std::to_string(i));
+        ZTEST_CHECK((value != nullptr) == (i % 2 == 1));
+        if(value) ZTEST_CHECK(value->getInt32() == i);
+    }
+    ZTEST_CHECK(!map.contains("root.1"));
+
+    for(std::int32_t i = 1; i < 10000; i += 2) ZTEST_CHECK(map.erase("root/" + std::to_string(i)));
+    ZTEST_CHECK(map.empty());
+    ZTEST_CHECK(map.childCount("") == 0);
+
+    for(std::int32_t i = 0; i < 100; ++i) ZTEST_CHECK(map.set("root/" + std::to_string(i), ZVariant(i)));
+    ZTEST_CHECK(map.childCount("root") == 100 && map.size() == 100);
+}
+
+void testCompiledPaths(const ZNestedMapStorage &storage)
+{
+    ZNestedMap map('.', storage);
+    ZTEST_CHECK(!map.compile("").isValid());
+    ZTEST_CHECK(!map.compile("a..b").isValid());
+    const ZPath invalid = map.compile(".a");
+    ZTEST_CHECK(!map.set(invalid, ZVariant(std::int32_t(1))));
+    ZTEST_CHECK(map.find(invalid) == nullptr && !map.erase(invalid));
+
+    const ZPath rps = map.compile("service.limits.rps");
+    ZTEST_CHECK(rps.isValid() && rps.isCached() && rps.depth() == 3);
+    ZTEST_CHECK(rps.path() == ZStringView("service.limits.rps"));
+    ZTEST_CHECK(map.find(rps) == nullptr);
+
+    /* lookups and overwrites keep the generation, so the cached handle stays warm */
+    ZTEST_CHECK(map.set("service.limits.rps", ZVariant(std::int32_t(100))));
+    const std::uint64_t generation = map.generation();
+    ZTEST_CHECK(map.find(rps) == map.find("service.limits.rps"));
+    ZTEST_CHECK(map.find(rps)->getInt32() == 100);
+    ZTEST_CHECK(map.set(rps, ZVariant(std::int32_t(200))));
+    ZTEST_CHECK(map.set("service.other", ZVariant(std::int32_t(1))));
+    ZTEST_CHECK(map.generation() == generation);
+    ZTEST_CHECK(map.get("service.limits.rps").getInt32() == 200);
+
+    const ZPath burst = map.compile("service.limits.burst", false);
+    ZTEST_CHECK(burst.isValid() && !burst.isCached());
+    ZTEST_CHECK(map.set(burst, ZVariant(std::int32_t(5))) && map.get(burst).getInt32() == 5);
+
+    /* erasing the path, or a level above it, moves to a new generation and the handle misses */
+    ZTEST_CHECK(map.erase(rps));
+    ZTEST_CHECK(map.generation() != generation);
+    ZTEST_CHECK(map.find(rps) == nullptr && !map.contains(rps));
+    ZTEST_CHECK(map.get(rps, ZVariant(std::int32_t(-1))).getInt32() == -1);
+    ZTEST_CHECK(map.set(rps, ZVariant(std::int32_t(300))));
+    ZTEST_CHECK(map.find(rps) == map.find("service.limits.rps") && map.get(rps).getInt32() == 300);
+    ZTEST_CHECK(map.erase("service"));
+    ZTEST_CHECK(map.find(rps) == nullptr && map.find(burst) == nullptr && map.empty());
+
+    std::uint64_t before = map.generation();
+    ZTEST_CHECK(!map.erase("service"));
+    ZTEST_CHECK(map.generation() == before);
+    map.set(rps, ZVariant(std::int32_t(1)));
+    ZTEST_CHECK(map.find(rps) != nullptr);
+    map.clear();
+    ZTEST_CHECK(map.generation() != before);
+    ZTEST_CHECK(map.find(rps) == nullptr);
+
+    /* a handle compiled against another map falls back to the segment bytes */
+    ZNestedMap other('.', storage);
+    ZTEST_CHECK(other.generation() != map.generation());
+    other.set("zz.yy", ZVariant(std::int32_t(1)));
+    other.set("service.limits.rps", ZVariant(std::int32_t(7)));
+    map.set("service.limits.rps", ZVariant(std::int32_t(8)));
+    const ZPath otherRps = other.compile("service.limits.rps");
+    for(int round = 0; round < 3; ++round)
+    {
+        ZTEST_CHECK(other.find(rps) == other.find("service.limits.rps") && other.get(rps).getInt32() == 7);
+        ZTEST_CHECK(map.find(rps) == map.find("service.limits.rps") && map.get(rps).getInt32() == 8);
+        ZTEST_CHECK(map.find(otherRps) == map.find("service.limits.rps"));
+        ZTEST_CHECK(other.find(otherRps)->getInt32() == 7);
+    }
+
+    /* and so does one used on a copy, which must not see the values of its source */
+    ZNestedMap copy(map);
+    ZTEST_CHECK(copy.generation() != map.generation());
+    ZTEST_CHECK(copy.find(rps) == copy.find("service.limits.rps"));
+    ZTEST_CHECK(copy.find(rps) != map.find("service.limits.rps"));
+    ZTEST_CHECK(copy.set(rps, ZVariant(std::int32_t(9))));
+    ZTEST_CHECK(map.get(rps).getInt32() == 8 && copy.get(rps).getInt32() == 9);
+
+    /* moving hands the nodes over under a new generation, the source is invalidated too */
+    before = copy.generation();
+    ZNestedMap moved(std::move(copy));
+    ZTEST_CHECK(copy.generation() != before && moved.generation() != before);
+    ZTEST_CHECK(copy.find(rps) == nullptr);
+    ZTEST_CHECK(moved.find(rps) == moved.find("service.limits.rps") && moved.get(rps).getInt32() == 9);
+
+    /* swapping invalidates both sides */
+    const ZPath movedRps = moved.compile("service.limits.rps");
+    ZTEST_CHECK(moved.get(movedRps).getInt32() == 9);
+    before = moved.generation();
+    const std::uint64_t mapBefore = map.generation();
+    moved.swap(map);
+    ZTEST_CHECK(moved.generation() != before && map.generation() != mapBefore);
+    ZTEST_CHECK(moved.get(movedRps).getInt32() == 8 && map.get(movedRps).getInt32() == 9);
+    ZTEST_CHECK(moved.find(movedRps) == moved.find("service.limits.rps"));
+
+    /* assignment replaces every node, a warm handle must not return the old ones */
+    ZTEST_CHECK(map.find(rps)->getInt32() == 9);
+    before = map.generation();
+    map = other;
+    ZTEST_CHECK(map.generation() != before);
+    ZTEST_CHECK(map.find(rps) == map.find("service.limits.rps") && map.get(rps).getInt32() == 7);
+    ZNestedMap empty('.', storage);
+    map = empty;
+    ZTEST_CHECK(map.find(rps) == nullptr);
+    map.set(rps, ZVariant(std::int32_t(11)));
+    ZTEST_CHECK(map.get(rps).getInt32() == 11);
+    map = std::move(moved);
+    ZTEST_CHECK(map.find(rps) == map.find("service.limits.rps") && map.get(rps).getInt32() == 8);
+}
+
+void testCachedValues(const ZNestedMapStorage &storage)
+{
+    /* inserting around a cached path reshapes the storage, the cached value has to stay put */
+    ZNestedMap map('/', storage);
+    map.set("tenants/4/users", ZVariant(std::int32_t(4)));
+    std::vector<ZPath> paths;
+    for(std::int32_t i = 0; i < 64; ++i) paths.push_back(map.compile("tenants/4/users/" + std::to_string(i)));
+    const ZPath users = map.compile("tenants/4/users");
+    ZTEST_CHECK(map.find(users)->getInt32() == 4);
+
+    for(std::int32_t i = 0; i < 2000; ++i)
+    {
+        map.set("tenants/" + std::to_string(i) + "/users", ZVariant(i));
+        map.set("tenants/4/users/" + std::to_string(i % 64), ZVariant(i));
+        map.set("tenants/4/user" + std::to_string(i), ZVariant(i));
+        ZTEST_CHECK(map.find(users) == map.find("tenants/4/users"));
+        ZTEST_CHECK(map.find(users)->getInt32() == 4);
+    }
+    for(std::size_t i = 0; i < paths.size(); ++i)
+    {
+        ZTEST_CHECK(map.find(paths[i]) == map.find("tenants/4/users/" + std::to_string(i)));
+        const std::int32_t last = 1999 - static_cast<std::int32_t>((1999 - i) % 64);
+        ZTEST_CHECK(map.find(paths[i])->getInt32() == last);
+    }
+
+    /* erasing a sibling advances the generation, erasing the path itself must miss */
+    ZTEST_CHECK(map.erase("tenants/4/user7"));
+    ZTEST_CHECK(map.find(users) == map.find("tenants/4/users"));
+    ZTEST_CHECK(map.erase(paths[3]));
+    ZTEST_CHECK(map.find(paths[3]) == nullptr);
+    ZTEST_CHECK(map.find(paths[4]) == map.find("tenants/4/users/4"));
+    ZTEST_CHECK(map.erase("tenants/4/users"));
+    ZTEST_CHECK(map.find(users) == nullptr);
+    for(const ZPath &path : paths) ZTEST_CHECK(map.find(path) == nullptr);
+}
+
+void testCompiledModel(const ZNestedMapStorage &storage)
+{
+    /* string and compiled access mixed at random, compared with a model and with each other */
+    std::mt19937 random(22);
+    ZNestedMap map('.', storage);
+    Model model;
+    std::vector<std::string> names;
+    std::vector<ZPath> compiled;
+    for(int i = 0; i < 300; ++i)
+    {
+        names.push_back(randomPath(random, '.'));
+        compiled.push_back(map.compile(names.back(), random() % 2 == 0));
+    }
+
+    /* only hash levels intern segments, a radix tree is keyed by the whole path */
+    const std::size_t segments = storage == ZNestedMapStorage::HashLevels ? 10 : 0;
+    ZTEST_CHECK(map.segmentCount() == segments);
+
+    for(std::int32_t i = 0; i < 60000; ++i)
+    {
+        const std::size_t index = random() % names.size();
+        const std::string &path = names[index];
+        const unsigned action = random() % 20;
+        if(action < 6)
+        {
+            model[path] = i;
+            ZTEST_CHECK(random() % 2 ? map.set(compiled[index], ZVariant(i)) : map.set(path, ZVariant(i)));
+        }
+        else if(action < 7)
+        {
+            eraseFromModel(model, path, '.');
+            random() % 2 ? map.erase(compiled[index]) : map.erase(path);
+        }
+        else if(action < 8)
+        {
+            /* replace the whole map with a copy of itself, every handle is now stale */
+            ZNestedMap copy(map);
+            map = copy;
+        }
+        else
+        {
+            const Model::const_iterator expected = model.find(path);
+            const ZVariant *value = map.find(compiled[index]);
+            ZTEST_CHECK((expected == model.end()) == (value == nullptr));
+            if(value && expected != model.end()) ZTEST_CHECK(value->getInt32() == expected->second);
+            ZTEST_CHECK(map.find(path) == value);
+        }
+        ZTEST_CHECK(map.size() == model.size());
+    }
+    ZTEST_CHECK(map.segmentCount() == segments);
+}
+
+}
+
+void ztest::testNestedMap()
+{
+    for(ZNestedMapStorage storage : Storages)
+    {
+        testInvalidPaths(storage);
+        testValuesAndPruning(storage);
+        testModel(storage, '.');
+        testModel(storage, '/');
+        testCopyMoveSwap(storage);
+        testManyChildren(storage);
+        testCompiledPaths(storage);
+        testCachedValues(storage);
+        testCompiledModel(storage);
+    }
+}
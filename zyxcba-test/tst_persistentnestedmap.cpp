@@ -0,0 +1,283 @@
+#include "ztest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <ZHash>
+#include <ZNestedMap>
+#include <ZPersistentNestedMap>
+
+namespace {
+
+using namespace zyxcba;
+
+typedef std::map<std::string, std::int32_t> Model;
+
+bool sameContents(const ZPersistentNestedMap &map, const Model &model)
+{
+    if(map.size() != model.size()) return false;
+
+    Model walked;
+    map.forEach("", [&](const ZStringView &path, const ZVariant &value) {
+        walked[path.toString()] = value.getInt32();
+        return true;
+    });
+    if(walked != model) return false;
+
+    for(const Model::value_type &entry : model)
+    {
+        const ZVariant *value = map.find(entry.first);
+        if(value == nullptr || value->getInt32() != entry.second) return false;
+    }
+    return true;
+}
+
+void eraseFromModel(Model &model, const std::string &path)
+{
+    for(Model::iterator it = model.begin(); it != model.end();)
+    {
+        if(it->first == path || it->first.compare(0, path.size() + 1, path + '.') == 0) it = model.erase(it);
+        else ++it;
+    }
+}
+
+/* 256 byte names whose 64 bit hashes are all equal. The first lane of the first two stripes is
+ * keyed to zero in its low half, so it adds nothing but its own value, and only the sum of the
+ * two high halves reaches the hash
+ */
+std::string collidingSegment(const std::uint32_t &variant)
+{
+    std::string segment(256, 'z');
+    const unsigned char secretLow[2][4] = {{0x94, 0x3e, 0x94, 0xb4}, {0x4c, 0x25, 0x91, 0x09}};
+    const std::uint32_t high[2] = {variant, 0x40000000u - variant};
+    for(std::size_t stripe = 0; stripe < 2; ++stripe)
+    {
+        for(std::size_t byte = 0; byte < 4; ++byte)
+        {
+            segment[64 * stripe + byte] = static_cast<char>(secretLow[stripe][byte]);
+            segment[64 * stripe + 4 + byte] = static_cast<char>((high[stripe] >> (8 * byte)) & 0xff);
+        }
+    }
+    return segment;
+}
+
+void testVersions()
+{
+    ZPersistentNestedMap empty;
+    ZTEST_CHECK(empty.empty());
+    const ZPersistentNestedMap first = empty.set("a.b.c", ZVariant(std::int32_t(1)));
+    ZTEST_CHECK(empty.empty() && first.size() == 1 && first.contains("a.b.c") && !first.contains("a.b"));
+    ZTEST_CHECK(first.set("", ZVariant(std::int32_t(1))).isSharedWith(first));
+    ZTEST_CHECK(first.set("a..b", ZVariant(std::int32_t(1))).isSharedWith(first));
+
+    const ZPersistentNestedMap second = first.set("a.b", ZVariant(std::string("mid")));
+    ZTEST_CHECK(first.size() == 1 && second.size() == 2 && second.get("a.b").getString() == "mid");
+    const ZPersistentNestedMap third = second.set("a.b.c", ZVariant(std::int32_t(2)));
+    ZTEST_CHECK(third.size() == 2 && second.get("a.b.c").getInt32() == 1 && third.get("a.b.c").getInt32() == 2);
+    ZTEST_CHECK(third.childCount("") == 1 && third.childCount("a.b") == 1);
+    ZTEST_CHECK(third.erase("a.x").isSharedWith(third));
+
+    const ZPersistentNestedMap erased = third.erase("a.b");
+    ZTEST_CHECK(erased.empty() && erased.childCount("") == 0 && third.size() == 2);
+    ZTEST_CHECK(third.erase("a.b.c").size() == 1 && third.erase("a.b.c").childCount("a.b") == 0);
+
+    ZNestedMap source;
+    for(std::int32_t i = 0; i < 1000; ++i) source.set("s." + std::to_string(i % 10) + "." + std::to_string(i), ZVariant(i));
+    const ZPersistentNestedMap converted(source);
+    ZTEST_CHECK(converted.size() == 1000 && converted.get("s.3.13").getInt32() == 13);
+}
+
+void testModel()
+{
+    /* every thousandth version is kept and has to stay as it was until the end */
+    std::mt19937 random(11);
+    ZPersistentNestedMap map;
+    Model model;
+    std::vector<std::pair<ZPersistentNestedMap, Model> > kept;
+    for(std::int32_t i = 0; i < 30000; ++i)
+    {
+        std::string path;
+        const unsigned depth = 1 + random() % 3;
+        for(unsigned level = 0; level < depth; ++level)
+        {
+            if(level) path += '.';
+            path += char('a' + random() % 6);
+            path += std::to_string(random() % (level == depth - 1 ? 200 : 4));
+        }
+
+        if(random() % 10 < 7)
+        {
+            /* the rvalue set updates in place whatever no kept version holds */
+            if(i % 2) map = std::move(map).set(path, ZVariant(i));
+            else map = map.set(path, ZVariant(i));
+            model[path] = i;
+        }
+        else
+        {
+            const std::size_t before = model.size();
+            eraseFromModel(model, path);
+            const ZPersistentNestedMap next = map.erase(path);
+            ZTEST_CHECK(next.isSharedWith(map) == (model.size() == before));
+            map = next;
+        }
+        ZTEST_CHECK(map.size() == model.size());
+        if(i % 1000 == 0)
+        {
+            ZTEST_CHECK(sameContents(map, model));
+            kept.push_back(std::make_pair(map, model));
+        }
+    }
+    ZTEST_CHECK(sameContents(map, model));
+    for(const std::pair<ZPersistentNestedMap, Model> &version : kept) ZTEST_CHECK(sameContents(version.first, version.second));
+
+    /* removing everything again folds the tries back level by level */
+    const Model all(model);
+    for(Model::const_reverse_iterator it = all.rbegin(); it != all.rend(); ++it)
+    {
+        map = map.erase(it->first);
+        eraseFromModel(model, it->first);
+        ZTEST_CHECK(map.size() == model.size());
+    }
+    ZTEST_CHECK(map.empty() && map.childCount("") == 0);
+    for(const std::pair<ZPersistentNestedMap, Model> &version : kept) ZTEST_CHECK(sameContents(version.first, version.second));
+}
+
+void testInPlaceUpdates()
+{
+    ZPersistentNestedMap head;
+    for(std::int32_t i = 0; i < 200; ++i) head = std::move(head).set("q." + std::to_string(i % 7) + "." + std::to_string(i), ZVariant(i));
+    const ZPersistentNestedMap before = head;
+    head = std::move(head).set("q.3", ZVariant(std::int32_t(-1)));
+    const ZPersistentNestedMap middle = head;
+
+    /* mixes both kinds of set, a copying one makes the head share nothing with itself again */
+    for(std::int32_t i = 0; i < 200; ++i)
+    {
+        const std::string path = "q." + std::to_string(i % 7) + "." + std::to_string(i);
+        if(i % 3 == 0) head = head.set(path, ZVariant(i + 1000));
+        else head = std::move(head).set(path, ZVariant(i + 1000));
+    }
+    head = std::move(head).set("q.3", ZVariant(std::int32_t(-2)));
+
+    for(std::int32_t i = 0; i < 200; ++i)
+    {
+        const std::string path = "q." + std::to_string(i % 7) + "." + std::to_string(i);
+        ZTEST_CHECK(before.get(path).getInt32() == i && middle.get(path).getInt32() == i);
+        ZTEST_CHECK(head.get(path).getInt32() == i + 1000);
+    }
+    ZTEST_CHECK(!before.contains("q.3") && middle.get("q.3").getInt32() == -1 && head.get("q.3").getInt32() == -2);
+    ZTEST_CHECK(before.size() == 200 && middle.size() == 201 && head.size() == 201);
+
+    const ZPersistentNestedMap same = std::move(head).set("", ZVariant(std::int32_t(1)));
+    ZTEST_CHECK(same.size() == 201);
+
+    /* many children on one level, the snapshot keeps every trie the erases fold */
+    ZPersistentNestedMap wide;
+    for(std::int32_t i = 0; i < 5000; ++i) wide = std::move(wide).set("x." + std::to_string(i), ZVariant(i));
+    ZTEST_CHECK(wide.childCount("x") == 5000);
+    ZPersistentNestedMap halved = wide;
+    for(std::int32_t i = 0; i < 5000; i += 2) halved = halved.erase("x." + std::to_string(i));
+    ZTEST_CHECK(halved.childCount("x") == 2500 && wide.childCount("x") == 5000);
+    for(std::int32_t i = 0; i < 5000; ++i)
+    {
+        ZTEST_CHECK(wide.get("x." + std::to_string(i)).getInt32() == i);
+        ZTEST_CHECK(halved.contains("x." + std::to_string(i)) == (i % 2 == 1));
+    }
+
+    /* snapshots copied to other threads are updated there without reaching the original */
+    std::vector<std::thread> threads;
+    std::vector<int> mismatches(4, 0);
+    for(std::size_t thread = 0; thread < 4; ++thread)
+    {
+        threads.emplace_back([&wide, &mismatches, thread] {
+            ZPersistentNestedMap local = wide;
+            for(std::int32_t i = 0; i < 5000; ++i)
+            {
+                if(local.get("x." + std::to_string(i)).getInt32() != i) ++mismatches[thread];
+                local = std::move(local).set("x." + std::to_string(i), ZVariant(-i));
+            }
+        });
+    }
+    for(std::thread &thread : threads) thread.join();
+    for(int mismatch : mismatches) ZTEST_CHECK(mismatch == 0);
+    for(std::int32_t i = 0; i < 5000; ++i) ZTEST_CHECK(wide.get("x." + std::to_string(i)).getInt32() == i);
+}
+
+void testCollisions()
+{
+    /* the high halves must not contain the separator */
+    std::vector<std::string> colliding;
+    for(std::uint32_t variant = 1; colliding.size() < 12; variant += 977)
+    {
+        const std::string segment = collidingSegment(variant);
+        if(segment.find('.') == std::string::npos) colliding.push_back(segment);
+    }
+    for(const std::string &segment : colliding)
+    {
+        ZTEST_CHECK(ZHash::hash64(segment.data(), segment.size()) == ZHash::hash64(colliding[0].data(), colliding[0].size()));
+        ZTEST_CHECK(ZHash::hash64Scalar(segment.data(), segment.size()) == ZHash::hash64(segment.data(), segment.size()));
+    }
+    ZTEST_CHECK(colliding[0] != colliding[1]);
+
+    /* the colliding names share one level with ordinary ones, below and beside a value */
+    for(unsigned seed = 0; seed < 8; ++seed)
+    {
+        std::mt19937 random(seed);
+        ZPersistentNestedMap map;
+        Model model;
+        std::vector<std::pair<ZPersistentNestedMap, Model> > kept;
+        for(std::int32_t i = 0; i < 600; ++i)
+        {
+            std::string path = "c";
+            if(random() % 4 != 0) path += "." + colliding[random() % colliding.size()];
+            else path += ".n" + std::to_string(random() % 20);
+            if(random() % 3 == 0) path += "." + colliding[random() % 3];
+
+            if(random() % 3 != 0)
+            {
+                if(random() % 2) map = std::move(map).set(path, ZVariant(i));
+                else map = map.set(path, ZVariant(i));
+                model[path] = i;
+            }
+            else
+            {
+                map = map.erase(path);
+                eraseFromModel(model, path);
+            }
+            ZTEST_CHECK(map.size() == model.size());
+            if(i % 50 == 0)
+            {
+                ZTEST_CHECK(sameContents(map, model));
+                kept.push_back(std::make_pair(map, model));
+            }
+        }
+        ZTEST_CHECK(sameContents(map, model));
+
+        /* draining the list down to one name and to none folds it away again */
+        std::vector<std::string> order(colliding);
+        std::shuffle(order.begin(), order.end(), random);
+        for(const std::string &segment : order)
+        {
+            map = map.erase("c." + segment);
+            eraseFromModel(model, "c." + segment);
+            ZTEST_CHECK(sameContents(map, model));
+        }
+        for(const std::pair<ZPersistentNestedMap, Model> &version : kept) ZTEST_CHECK(sameContents(version.first, version.second));
+    }
+}
+
+}
+
+void ztest::testPersistentNestedMap()
+{
+    testVersions();
+    testModel();
+    testInPlaceUpdates();
+    testCollisions();
+}
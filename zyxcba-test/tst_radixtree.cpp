@@ -0,0 +1,269 @@
+#include "ztest.h"
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ZRadixTree>
+
+namespace {
+
+using namespace zyxcba;
+
+typedef std::map<std::string, std::int32_t> Model;
+
+/* short keys over a tiny alphabet collide often, raw bytes include zeros, the prefixes are shared */
+std::string randomKey(std::mt19937 &random)
+{
+    static const char *const prefixes[] = {"", "tenants/", "tenants/42/", "tenants/42/users/very_long_shared_segment/",
+                                           "a", "ab", "abc", "x/y/z/"};
+    std::string key = prefixes[random() % 8];
+    for(std::size_t count = random() % 6; count > 0; --count)
+    {
+        const unsigned kind = random() % 10;
+        if(kind < 5) key += char('a' + random() % 3);
+        else if(kind < 8) key += static_cast<char>(random() % 256);
+        else key += "/seg";
+    }
+    if(random() % 4 == 0) key += std::string(random() % 30, char('p' + random() % 2));
+    return key;
+}
+
+bool sameContents(const ZRadixTree &tree, const Model &model)
+{
+    if(tree.size() != model.size()) return false;
+
+    /* forEach() has to visit in the byte order of std::map<std::string> */
+    Model::const_iterator expected = model.begin();
+    bool same = true;
+    const bool completed = tree.forEach([&](const ZStringView &key, const ZVariant &value) {
+        if(expected == model.end() || key.toString() != expected->first || value.getInt32() != expected->second) same = false;
+        if(expected != model.end()) ++expected;
+        return same;
+    });
+    return same && completed && expected == model.end();
+}
+
+std::vector<std::string> scanned(const ZRadixTree &tree, const std::string &prefix)
+{
+    std::vector<std::string> keys;
+    tree.scanPrefix(prefix, [&](const ZStringView &key, const ZVariant &) {
+        keys.push_back(key.toString());
+        return true;
+    });
+    return keys;
+}
+
+std::vector<std::string> modelScan(const Model &model, const std::string &prefix)
+{
+    std::vector<std::string> keys;
+    for(Model::const_iterator it = model.lower_bound(prefix); it != model.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it)
+        keys.push_back(it->first);
+    return keys;
+}
+
+void testModel()
+{
+    for(unsigned seed = 0; seed < 12; ++seed)
+    {
+        std::mt19937 random(seed);
+        ZRadixTree tree;
+        Model model;
+        const int operations = 3000 + static_cast<int>(seed % 4) * 3000;
+        for(std::int32_t i = 0; i < operations; ++i)
+        {
+            const std::string key = randomKey(random);
+            const unsigned action = random() % 20;
+            if(action < 10)
+            {
+                ZTEST_CHECK(tree.insert(key, ZVariant(i)) == (model.count(key) == 0));
+                model[key] = i;
+            }
+            else if(action < 14)
+            {
+                ZTEST_CHECK(tree.erase(key) == (model.erase(key) == 1));
+            }
+            else if(action < 15)
+            {
+                const std::string prefix = key.substr(0, key.size() / 2);
+                const std::vector<std::string> removed = modelScan(model, prefix);
+                for(const std::string &erased : removed) model.erase(erased);
+                ZTEST_CHECK(tree.erasePrefix(prefix) == removed.size());
+            }
+            else if(action < 17)
+            {
+                const std::string prefix = key.substr(0, random() % (key.size() + 1));
+                ZTEST_CHECK(scanned(tree, prefix) == modelScan(model, prefix));
+            }
+            else
+            {
+                const ZVariant *value = tree.find(key);
+                const Model::const_iterator expected = model.find(key);
+                ZTEST_CHECK((value == nullptr) == (expected == model.end()));
+                if(value && expected != model.end()) ZTEST_CHECK(value->getInt32() == expected->second);
+                ZTEST_CHECK(tree.contains(key) == (value != nullptr));
+            }
+            ZTEST_CHECK(tree.size() == model.size());
+            if(i % 997 == 0) ZTEST_CHECK(sameContents(tree, model));
+        }
+        ZTEST_CHECK(sameContents(tree, model));
+
+        /* copies are deep, moves leave an empty tree behind */
+        ZRadixTree copy(tree);
+        ZTEST_CHECK(sameContents(copy, model));
+        if(!model.empty())
+        {
+            copy.erase(model.begin()->first);
+            ZTEST_CHECK(sameContents(tree, model));
+        }
+        ZRadixTree moved(std::move(tree));
+        ZTEST_CHECK(tree.empty() && tree.memoryUsage() == 0);
+        ZTEST_CHECK(sameContents(moved, model));
+        tree = moved;
+        ZTEST_CHECK(sameContents(tree, model));
+        copy.swap(moved);
+        ZTEST_CHECK(sameContents(copy, model));
+
+        const Model drained(model);
+        for(const Model::value_type &entry : drained)
+        {
+            ZTEST_CHECK(tree.erase(entry.first));
+            model.erase(entry.first);
+            if(model.size() % 101 == 0) ZTEST_CHECK(sameContents(tree, model));
+        }
+        ZTEST_CHECK(tree.empty() && tree.memoryUsage() == 0);
+    }
+}
+
+void testPrefixKeys()
+{
+    /* every key is a prefix of the next, down to the empty key */
+    ZRadixTree tree;
+    std::string key;
+    Model model;
+    for(std::int32_t i = 0; i < 64; ++i)
+    {
+        ZTEST_CHECK(tree.insert(key, ZVariant(i)));
+        model[key] = i;
+        key += static_cast<char>(i % 3 == 0 ? '\0' : 'a' + i % 5);
+    }
+    ZTEST_CHECK(sameContents(tree, model));
+    ZTEST_CHECK(tree.find("")->getInt32() == 0);
+    ZTEST_CHECK(scanned(tree, "").size() == 64);
+    ZTEST_CHECK(scanned(tree, std::string(1, '\0')).size() == 63);
+
+    /* removing an inner prefix key keeps the longer and shorter ones */
+    const std::string middle = model.rbegin()->first.substr(0, 30);
+    ZTEST_CHECK(tree.erase(middle));
+    model.erase(middle);
+    ZTEST_CHECK(sameContents(tree, model));
+    ZTEST_CHECK(tree.erasePrefix(middle) == 33);
+    for(Model::iterator it = model.begin(); it != model.end();)
+    {
+        if(it->first.compare(0, middle.size(), middle) == 0) it = model.erase(it);
+        else ++it;
+    }
+    ZTEST_CHECK(sameContents(tree, model));
+    ZTEST_CHECK(tree.size() == 30);
+
+    /* keys sharing a prefix far longer than the inline part, diverging before, at and after it */
+    ZRadixTree shared;
+    Model sharedModel;
+    const std::string common(3 * ZRadixTree::MaxInlinePrefix + 5, 's');
+    std::int32_t value = 0;
+    for(std::size_t at = 0; at <= common.size(); ++at)
+    {
+        std::string diverging = common;
+        if(at < diverging.size()) diverging[at] = 't';
+        else diverging += 'u';
+        shared.insert(diverging, ZVariant(value));
+        sharedModel[diverging] = value++;
+        shared.insert(common.substr(0, at), ZVariant(value));
+        sharedModel[common.substr(0, at)] = value++;
+    }
+    ZTEST_CHECK(sameContents(shared, sharedModel));
+    for(std::size_t at = 0; at <= common.size(); at += 3)
+    {
+        const std::string prefix = common.substr(0, at);
+        ZTEST_CHECK(scanned(shared, prefix) == modelScan(sharedModel, prefix));
+        std::string wrong = prefix;
+        wrong += 'v';
+        ZTEST_CHECK(scanned(shared, wrong).empty());
+        ZTEST_CHECK(!shared.contains(wrong));
+    }
+    ZTEST_CHECK(shared.erasePrefix(common.substr(0, 2 * ZRadixTree::MaxInlinePrefix)) == modelScan(sharedModel, common.substr(0, 2 * ZRadixTree::MaxInlinePrefix)).size());
+
+    ZRadixTree single;
+    ZTEST_CHECK(single.insert("", ZVariant(std::int32_t(2))));
+    ZTEST_CHECK(!single.insert("", ZVariant(std::int32_t(3))));
+    ZTEST_CHECK(single.size() == 1 && single.find("")->getInt32() == 3);
+    single["k"] = ZVariant(std::int32_t(1));
+    ZTEST_CHECK(single.find("k")->getInt32() == 1 && !single.contains("kk"));
+    int visited = 0;
+    ZTEST_CHECK(!single.forEach([&](const ZStringView &, const ZVariant &) { return ++visited < 1; }));
+    ZTEST_CHECK(visited == 1);
+}
+
+void testFanOut()
+{
+    /* one node grows through every size to 256 children, then shrinks back, pointers stay put */
+    ZRadixTree tree;
+    std::vector<const ZVariant*> pointers;
+    std::size_t previousMemory = 0;
+    for(int byte = 0; byte < 256; ++byte)
+    {
+        tree.insert(std::string("n") + static_cast<char>(byte), ZVariant(std::int32_t(byte)));
+        pointers.push_back(tree.find(std::string("n") + static_cast<char>(byte)));
+        ZTEST_CHECK(tree.memoryUsage() > previousMemory);
+        previousMemory = tree.memoryUsage();
+        for(int check = 0; check <= byte; check += 17)
+            ZTEST_CHECK(tree.find(std::string("n") + static_cast<char>(check)) == pointers[static_cast<std::size_t>(check)]);
+    }
+    for(int byte = 255; byte >= 0; --byte)
+    {
+        ZTEST_CHECK(tree.erase(std::string("n") + static_cast<char>(byte)));
+        ZTEST_CHECK(tree.memoryUsage() < previousMemory);
+        previousMemory = tree.memoryUsage();
+        for(int check = 0; check < byte; check += 13)
+        {
+            const ZVariant *value = tree.find(std::string("n") + static_cast<char>(check));
+            ZTEST_CHECK(value == pointers[static_cast<std::size_t>(check)] && value->getInt32() == check);
+        }
+    }
+    ZTEST_CHECK(tree.empty() && tree.memoryUsage() == 0);
+
+    /* two dense levels, drained by prefix and by key */
+    ZRadixTree dense;
+    for(int i = 0; i < 256; ++i)
+    {
+        for(int j = 0; j < 256; j += 3)
+            dense.insert(std::string(1, static_cast<char>(i)) + static_cast<char>(j) + "tail", ZVariant(std::int32_t(i * 256 + j)));
+    }
+    for(int i = 0; i < 256; ++i)
+    {
+        for(int j = 0; j < 256; j += 3)
+        {
+            const ZVariant *value = dense.find(std::string(1, static_cast<char>(i)) + static_cast<char>(j) + "tail");
+            ZTEST_CHECK(value && value->getInt32() == i * 256 + j);
+        }
+    }
+    for(int i = 0; i < 256; i += 2) ZTEST_CHECK(dense.erasePrefix(std::string(1, static_cast<char>(i))) == 86);
+    for(int i = 1; i < 256; i += 2)
+    {
+        for(int j = 0; j < 256; j += 3)
+            ZTEST_CHECK(dense.erase(std::string(1, static_cast<char>(i)) + static_cast<char>(j) + "tail"));
+    }
+    ZTEST_CHECK(dense.empty() && dense.memoryUsage() == 0);
+}
+
+}
+
+void ztest::testRadixTree()
+{
+    testModel();
+    testPrefixKeys();
+    testFanOut();
+}
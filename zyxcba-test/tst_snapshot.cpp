@@ -0,0 +1,220 @@
+#include "ztest.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+
+#include <ZSnapshot>
+
+namespace {
+
+using namespace zyxcba;
+
+const char *const SnapshotPath = "zyxcba-tst-snapshot.bin";
+
+std::string readFile(const std::string &path)
+{
+    std::ifstream file(path.c_str(), std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string &path, const std::string &data)
+{
+    std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+template<typename T>
+void patch(std::string &data, const std::size_t &offset, const T &value)
+{
+    std::memcpy(&data[offset], &value, sizeof(value));
+}
+
+template<typename T>
+T peek(const std::string &data, const std::size_t &offset)
+{
+    T value;
+    std::memcpy(&value, data.data() + offset, sizeof(value));
+    return value;
+}
+
+bool opens(const std::string &data)
+{
+    writeFile(SnapshotPath, data);
+    ZSnapshot snapshot;
+    return snapshot.open(SnapshotPath);
+}
+
+/* walks everything reachable, a corrupt file may read as anything but must stay in bounds */
+void touch(const ZSnapshotView &view, int depth)
+{
+    ZVariant variant;
+    view.toVariant(variant);
+    view.getString();
+    view.getNumber();
+    view.getArrayBytes();
+    view.find("a");
+    view.find(std::uint64_t(3));
+    view.find(ZVariant(std::int32_t(3)));
+    if(depth > 3) return;
+
+    const std::uint64_t length = view.getLength() < 8 ? view.getLength() : 8;
+    for(std::uint64_t i = 0; i <= length; ++i)
+    {
+        touch(view.at(i), depth + 1);
+        touch(view.keyAt(i), depth + 1);
+        touch(view.valueAt(i), depth + 1);
+        view.integerKeyAt(i);
+        view.numberAt(i);
+    }
+}
+
+void testHeader(const std::string &file)
+{
+    ZTEST_CHECK(opens(file));
+
+    const std::uint64_t dataOffset = peek<std::uint64_t>(file, offsetof(ZSnapshotHeader, dataOffset));
+    const std::uint64_t dataSize = peek<std::uint64_t>(file, offsetof(ZSnapshotHeader, dataSize));
+    ZTEST_CHECK(dataOffset == ZSnapshot::PageSize);
+    ZTEST_CHECK(dataOffset + dataSize <= file.size());
+
+    /* every cut that loses part of the header page or of the data section is refused */
+    const std::size_t cuts[] = {0, 5, sizeof(ZSnapshotHeader) - 1, sizeof(ZSnapshotHeader),
+                                ZSnapshot::PageSize - 1, ZSnapshot::PageSize,
+                                static_cast<std::size_t>(dataOffset + dataSize / 2),
+                                static_cast<std::size_t>(dataOffset + dataSize - 1)};
+    for(std::size_t cut : cuts) ZTEST_CHECK(!opens(file.substr(0, cut)));
+
+    std::string corrupted(file);
+    corrupted[0] = 'z';
+    ZTEST_CHECK(!opens(corrupted));
+
+    corrupted = file;
+    patch(corrupted, offsetof(ZSnapshotHeader, version), std::uint32_t(ZSnapshot::Version + 1));
+    ZTEST_CHECK(!opens(corrupted));
+
+    corrupted = file;
+    patch(corrupted, offsetof(ZSnapshotHeader, byteOrder), std::uint8_t(peek<std::uint8_t>(file, offsetof(ZSnapshotHeader, byteOrder)) ^ 3));
+    ZTEST_CHECK(!opens(corrupted));
+
+    const std::uint64_t dataOffsets[] = {0, dataOffset + 8, dataOffset + ZSnapshot::PageSize * 1024, ~std::uint64_t(0) - ZSnapshot::PageSize + 1};
+    for(std::uint64_t offset : dataOffsets)
+    {
+        corrupted = file;
+        patch(corrupted, offsetof(ZSnapshotHeader, dataOffset), offset);
+        ZTEST_CHECK(!opens(corrupted));
+    }
+
+    const std::uint64_t dataSizes[] = {file.size() - dataOffset + 1, ~std::uint64_t(0), ~std::uint64_t(0) - dataOffset + 1};
+    for(std::uint64_t size : dataSizes)
+    {
+        corrupted = file;
+        patch(corrupted, offsetof(ZSnapshotHeader, dataSize), size);
+        ZTEST_CHECK(!opens(corrupted));
+    }
+
+    const std::uint64_t rootOffsets[] = {dataSize, dataSize + 8, ~std::uint64_t(0)};
+    for(std::uint64_t offset : rootOffsets)
+    {
+        corrupted = file;
+        patch(corrupted, offsetof(ZSnapshotHeader, rootOffset), offset);
+        ZTEST_CHECK(!opens(corrupted));
+    }
+
+    corrupted = file;
+    patch(corrupted, offsetof(ZSnapshotHeader, dataSize), std::uint64_t(0));
+    ZTEST_CHECK(!opens(corrupted));
+}
+
+void testOffsetTable()
+{
+    /* a root list of nested lists, the root table is the last thing in the data section */
+    ZVariant root;
+    root.setList();
+    for(std::int32_t i = 0; i < 16; ++i)
+    {
+        ZVariant inner;
+        inner.addToList(ZVariant(std::string(12, char('a' + i))));
+        inner.addToList(ZVariant(i));
+        root.addToList(inner);
+    }
+    ZTEST_CHECK(ZSnapshot::write(root, SnapshotPath));
+    const std::string file = readFile(SnapshotPath);
+    testHeader(file);
+
+    const std::uint64_t dataOffset = peek<std::uint64_t>(file, offsetof(ZSnapshotHeader, dataOffset));
+    const std::uint64_t rootOffset = peek<std::uint64_t>(file, offsetof(ZSnapshotHeader, rootOffset));
+    const std::size_t countAt = static_cast<std::size_t>(dataOffset + rootOffset + 8);
+    const std::size_t entriesAt = countAt + 8;
+    ZTEST_CHECK(peek<std::uint64_t>(file, countAt) == 16);
+
+    /* counts that would run the table past the data section read as an empty container */
+    const std::uint64_t counts[] = {17, 1u << 20, ~std::uint64_t(0), ~std::uint64_t(0) / 8 + 1};
+    for(std::uint64_t count : counts)
+    {
+        std::string corrupted(file);
+        patch(corrupted, countAt, count);
+        writeFile(SnapshotPath, corrupted);
+        ZSnapshot snapshot;
+        ZTEST_CHECK(snapshot.open(SnapshotPath));
+        ZTEST_CHECK(snapshot.root().isList());
+        ZTEST_CHECK(snapshot.root().getLength() == 0);
+        ZTEST_CHECK(snapshot.root().at(0).isNone());
+        ZVariant variant;
+        ZTEST_CHECK(!snapshot.root().toVariant(variant));
+    }
+
+    /* an entry may only point backwards, at a child written before its parent */
+    const std::uint64_t children[] = {rootOffset, rootOffset + 8, ~std::uint64_t(0)};
+    for(std::uint64_t child : children)
+    {
+        std::string corrupted(file);
+        patch(corrupted, entriesAt + 3 * 8, child);
+        writeFile(SnapshotPath, corrupted);
+        ZSnapshot snapshot;
+        ZTEST_CHECK(snapshot.open(SnapshotPath));
+        ZTEST_CHECK(snapshot.root().getLength() == 16);
+        ZTEST_CHECK(snapshot.root().at(2).at(1).getInt32() == 2);
+        ZTEST_CHECK(snapshot.root().at(3).isNone());
+        ZVariant variant;
+        ZTEST_CHECK(!snapshot.root().toVariant(variant));
+    }
+
+    /* an entry pointing into the middle of a node reads garbage, but within the file */
+    const std::uint64_t firstChild = peek<std::uint64_t>(file, entriesAt);
+    for(std::uint64_t skew = 1; skew < 24; ++skew)
+    {
+        std::string corrupted(file);
+        patch(corrupted, entriesAt + 8, firstChild + skew);
+        writeFile(SnapshotPath, corrupted);
+        ZSnapshot snapshot;
+        ZTEST_CHECK(snapshot.open(SnapshotPath));
+        touch(snapshot.root(), 0);
+    }
+
+    std::mt19937_64 random(10);
+    for(int round = 0; round < 500; ++round)
+    {
+        std::string corrupted(file);
+        for(int i = 0; i < 4; ++i)
+        {
+            const std::size_t at = static_cast<std::size_t>(dataOffset + random() % (corrupted.size() - dataOffset));
+            corrupted[at] = static_cast<char>(random());
+        }
+        writeFile(SnapshotPath, corrupted);
+        ZSnapshot snapshot;
+        if(snapshot.open(SnapshotPath)) touch(snapshot.root(), 0);
+    }
+}
+
+}
+
+void ztest::testSnapshot()
+{
+    testOffsetTable();
+    std::remove(SnapshotPath);
+}
@@ -0,0 +1,33 @@
+#include "ztest.h"
+
+#include <string>
+#include <utility>
+
+#include <ZTrace>
+#include <ZVariant>
+
+void ztest::testTrace()
+{
+    using namespace zyxcba;
+
+#if ZYXCBA_TRACE_LEVEL >= 4
+    ZTrace::resetCounters();
+
+    ZVariant text("payload");
+    ZVariant list((ZVariantList()));
+    ZVariant number(std::int32_t(7));
+    ZTEST_CHECK(ZTrace::counter(ZTraceEvent::Construct, ZVariantType::String) == 1);
+    ZTEST_CHECK(ZTrace::counter(ZTraceEvent::Allocate, ZVariantType::String) == 1);
+    ZTEST_CHECK(ZTrace::counter(ZTraceEvent::Construct, ZVariantType::List) == 1);
+    ZTEST_CHECK(ZTrace::counter(ZTraceEvent::Construct, ZVariantType::Int32) == 0);
+
+    /* copies allocate a payload but are traced as copies, not constructions */
+    ZVariant copy(text);
+    ZVariant moved(std::move(copy));
+    ZTEST_CHECK(ZTrace::counter(ZTraceEvent::Copy, ZVariantType::String) == 1);
+    ZTEST_CHECK(ZTrace::counter(ZTraceEvent::Move, ZVariantType::String) == 1);
+    ZTEST_CHECK(ZTrace::counter(ZTraceEvent::Construct, ZVariantType::String) == 1);
+    ZTEST_CHECK(ZTrace::counter(ZTraceEvent::Allocate, ZVariantType::String) == 2);
+    ZTEST_CHECK(std::string(ZTrace::eventName(ZTraceEvent::Construct)) == "Construct");
+#endif
+}
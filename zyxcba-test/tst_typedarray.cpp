@@ -0,0 +1,237 @@
+#include "ztest.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <ZArena>
+#include <ZVariantSerializer>
+#include <ZVariantView>
+
+namespace {
+
+using namespace zyxcba;
+
+ZVariant roundTrip(const ZVariant &variant)
+{
+    std::string buffer;
+    ZStringSink sink(buffer);
+    ZTEST_CHECK(ZVariantSerializer::serialize(variant, sink));
+    ZMemorySource source(buffer);
+    ZVariant decoded;
+    ZTEST_CHECK(ZVariantSerializer::deserialize(source, decoded));
+    return decoded;
+}
+
+void testPromotion()
+{
+    /* addToList() on None builds a generic list, packed arrays are opt-in through addToArray() */
+    ZVariant list;
+    ZTEST_CHECK(list.addToList(ZVariant(std::int32_t(1))));
+    ZTEST_CHECK(list.isList());
+    ZTEST_CHECK(list.listLength() == 1);
+    ZTEST_CHECK(list.getList()[0].getInt32() == 1);
+
+    ZVariant generic;
+    generic.setList();
+    ZTEST_CHECK(!generic.addToArray(zfloat64(1.0)));
+    ZTEST_CHECK(generic.isList() && generic.listLength() == 0);
+
+    ZVariant map;
+    map.setMap();
+    ZTEST_CHECK(!map.addToArray(std::int32_t(1)));
+    ZTEST_CHECK(!map.addToList(ZVariant(std::int32_t(1))));
+    ZTEST_CHECK(map.isMap());
+
+    ZVariant values;
+    for(int i = 0; i < 1000; ++i) ZTEST_CHECK(values.addToArray(zfloat64(i) * 0.5));
+    ZTEST_CHECK(values.isFloat64Array());
+    ZTEST_CHECK(values.getLength() == 1000 && values.arrayLength() == 1000);
+    ZTEST_CHECK(values.getFloat64Array()[10] == 5.0);
+    ZTEST_CHECK(static_cast<const zfloat64*>(values.arrayData())[999] == 499.5);
+
+    /* elements of the array type stay packed when added through addToList() */
+    ZTEST_CHECK(values.addToList(ZVariant(zfloat64(500.0))));
+    ZTEST_CHECK(values.isFloat64Array() && values.getLength() == 1001);
+
+    /* anything else demotes the array to a list of the same values */
+    ZVariant demoted(values);
+    ZTEST_CHECK(demoted == values);
+    ZTEST_CHECK(demoted.addToList(ZVariant("x")));
+    ZTEST_CHECK(demoted.isList() && demoted.getLength() == 1002);
+    ZTEST_CHECK(demoted.getList()[3].getFloat64() == 1.5);
+    ZTEST_CHECK(demoted.getList()[1001].getString() == "x");
+
+    ZVariant narrow;
+    ZTEST_CHECK(narrow.addToArray(std::int32_t(1)));
+    ZTEST_CHECK(narrow.addToList(ZVariant(std::int32_t(2))));
+    ZTEST_CHECK(narrow.isInt32Array() && narrow.getLength() == 2);
+    ZTEST_CHECK(!narrow.addToArray(std::int64_t(3)));
+    ZTEST_CHECK(narrow.isInt32Array() && narrow.getLength() == 2);
+    ZTEST_CHECK(narrow.addToList(ZVariant(std::int64_t(3))));
+    ZTEST_CHECK(narrow.isList() && narrow.listLength() == 3);
+    ZTEST_CHECK(narrow.getList()[0].isInt32() && narrow.getList()[2].isInt64());
+
+    ZVariant converted(values);
+    converted.convertToList();
+    ZTEST_CHECK(converted.isList() && converted.getLength() == 1001);
+    ZTEST_CHECK(converted != values);
+    ZTEST_CHECK(converted.contentHash() != values.contentHash());
+
+    ZVariant int32;
+    ZVariant int64;
+    ZVariant uint8;
+    ZVariant float32;
+    int32.addToArray(std::int32_t(-7));
+    int64.addToArray(std::int64_t(-8));
+    uint8.addToArray(std::uint8_t(200));
+    float32.addToArray(zfloat32(1.5f));
+    ZTEST_CHECK(int32.isInt32Array() && int64.isInt64Array() && uint8.isUInt8Array() && float32.isFloat32Array());
+    ZTEST_CHECK(int32.variantTypeString() == "Int32Array");
+    ZTEST_CHECK(int32 < int64);
+
+    /* promotion inside an arena scope copies and demotes with arena storage */
+    {
+        ZArena arena;
+        ZArenaScope scope(arena);
+        ZVariant packed;
+        for(std::int32_t i = 0; i < 10000; ++i) packed.addToArray(i);
+        ZVariant copy(packed);
+        ZTEST_CHECK(copy == packed);
+        ZTEST_CHECK(packed.addToList(ZVariant("s")));
+        ZTEST_CHECK(packed.isList() && packed.getLength() == 10001);
+        ZTEST_CHECK(packed.getList()[9999].getInt32() == 9999);
+    }
+
+    /* every array type survives the serializer, the view and a clear */
+    ZVariant document;
+    document.setMap();
+    document.addToMap(ZVariant("f64"), values);
+    document.addToMap(ZVariant("i32"), int32);
+    document.addToMap(ZVariant("i64"), int64);
+    document.addToMap(ZVariant("u8"), uint8);
+    document.addToMap(ZVariant("f32"), float32);
+    ZVariant empty;
+    empty.setInt32Array();
+    document.addToMap(ZVariant("empty"), empty);
+    const ZVariant decoded = roundTrip(document);
+    ZTEST_CHECK(decoded == document);
+    ZTEST_CHECK(decoded.contentHash() == document.contentHash());
+
+    std::string buffer;
+    ZStringSink sink(buffer);
+    ZVariantSerializer::serialize(document, sink);
+    ZVariantView view(buffer);
+    ZTEST_CHECK(view.find("f64").isFloat64Array() && view.find("f64").getLength() == 1001);
+    ZTEST_CHECK(view.find("f64").numberAt(7) == 3.5);
+    ZTEST_CHECK(view.find("u8").numberAt(0) == 200);
+    ZTEST_CHECK(view.find("f64").numberAt(5000) == 0);
+
+    values.clearArray();
+    ZTEST_CHECK(values.isFloat64Array() && values.getLength() == 0);
+}
+
+void testAliasingAppend()
+{
+    /* appending a range of the array to itself must survive the reallocation it causes */
+    const std::int64_t raw[5] = {1, 2, 3, 4, 5};
+    ZVariant array;
+    ZTEST_CHECK(array.appendToArray(raw, 5));
+    ZTEST_CHECK(array.appendToArray(array.getInt64Array().data(), 5));
+    ZTEST_CHECK(array.getLength() == 10);
+
+    std::vector<std::int64_t> expected(raw, raw + 5);
+    expected.insert(expected.end(), raw, raw + 5);
+    for(int round = 0; round < 8; ++round)
+    {
+        const std::uint64_t length = array.arrayLength();
+        ZTEST_CHECK(array.appendToArray(array.getInt64Array().data() + 1, length - 1));
+        const std::vector<std::int64_t> tail(expected.begin() + 1, expected.end());
+        expected.insert(expected.end(), tail.begin(), tail.end());
+        ZTEST_CHECK(array.arrayLength() == expected.size());
+    }
+    ZTEST_CHECK(std::vector<std::int64_t>(array.getInt64Array().begin(), array.getInt64Array().end()) == expected);
+
+    /* the same through a single element push of the array's own last element */
+    ZVariant floats;
+    floats.addToArray(zfloat32(0.25f));
+    for(int i = 0; i < 100; ++i) ZTEST_CHECK(floats.addToArray(floats.getFloat32Array().back()));
+    ZTEST_CHECK(floats.getLength() == 101 && floats.getFloat32Array()[100] == 0.25f);
+
+    /* an empty append and a type mismatch change nothing */
+    ZTEST_CHECK(!array.appendToArray(static_cast<const zfloat64*>(nullptr), 0));
+    ZVariant int32;
+    int32.addToArray(std::int32_t(1));
+    ZTEST_CHECK(!int32.appendToArray(raw, 1));
+    ZTEST_CHECK(int32.getLength() == 1);
+}
+
+/* a zero or NaN at position in an array of length, built with its two spellings */
+template<typename T>
+void checkFloatPosition(const std::size_t &length, const std::size_t &position)
+{
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+    ZVector<T> positiveZero;
+    ZVector<T> negativeZero;
+    ZVector<T> quietNaN;
+    ZVector<T> negativeNaN;
+    for(std::size_t k = 0; k < length; ++k)
+    {
+        T value = static_cast<T>(k) - static_cast<T>(20.5);
+        if(k % 7 == 3) value = std::numeric_limits<T>::infinity();
+        if(k % 11 == 5) value = std::numeric_limits<T>::denorm_min();
+        positiveZero.push_back(k == position ? T(0) : value);
+        negativeZero.push_back(k == position ? -T(0) : value);
+        quietNaN.push_back(k == position ? nan : value);
+        negativeNaN.push_back(k == position ? -nan : value);
+    }
+
+    const ZVariant a(positiveZero);
+    const ZVariant b(negativeZero);
+    const ZVariant c(quietNaN);
+    const ZVariant d(negativeNaN);
+    ZTEST_CHECK(a == b && a.compare(b) == 0);
+    ZTEST_CHECK(a.hash() == b.hash());
+    ZTEST_CHECK(a.contentHash() == b.contentHash());
+    ZTEST_CHECK(c == d && c.compare(d) == 0);
+    ZTEST_CHECK(c.hash() == d.hash());
+    ZTEST_CHECK(c.contentHash() == d.contentHash());
+    ZTEST_CHECK(a != c && a < c);
+    ZTEST_CHECK(a.contentHash() != c.contentHash());
+
+    /* an array hashes like its elements would, however they are spelled */
+    std::unordered_set<ZVariant> set = {a, c};
+    ZTEST_CHECK(set.count(b) == 1 && set.count(d) == 1);
+}
+
+void testFloatRules()
+{
+    /* positions in the first and second 16 element block and in the tail after them */
+    for(std::size_t position = 0; position < 40; ++position)
+    {
+        checkFloatPosition<zfloat64>(40, position);
+        checkFloatPosition<zfloat32>(40, position);
+    }
+
+    /* and at the edges of the 4 KiB chunks the hash works through */
+    const std::size_t positions[] = {0, 511, 512, 513, 1023, 1024, 1025, 1299};
+    for(std::size_t position : positions)
+    {
+        checkFloatPosition<zfloat64>(1300, position);
+        checkFloatPosition<zfloat32>(1300, position);
+    }
+    checkFloatPosition<zfloat64>(1, 0);
+    checkFloatPosition<zfloat32>(17, 16);
+}
+
+}
+
+void ztest::testTypedArray()
+{
+    testPromotion();
+    testAliasingAppend();
+    testFloatRules();
+}
@@ -0,0 +1,240 @@
+#include "ztest.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <ZVariant>
+
+namespace {
+
+using namespace zyxcba;
+
+/* compare() has to be antisymmetric and agree with == and < */
+bool consistent(const ZVariant &a, const ZVariant &b)
+{
+    const int ab = a.compare(b);
+    const int ba = b.compare(a);
+    if((ab < 0) != (ba > 0) || (ab == 0) != (ba == 0)) return false;
+    if((ab == 0) != (a == b)) return false;
+    if((ab < 0) != (a < b)) return false;
+    return ab != 0 || a.hash() == b.hash();
+}
+
+void testStrings()
+{
+    /* equal length strings used to compare equal and collapse into one map key */
+    ZVariantMap map;
+    map[ZVariant("abc")] = ZVariant(std::int32_t(1));
+    map[ZVariant("abd")] = ZVariant(std::int32_t(2));
+    map[ZVariant("xyz")] = ZVariant(std::int32_t(3));
+    ZTEST_CHECK(map.size() == 3);
+    ZTEST_CHECK(map[ZVariant("abd")] == ZVariant(std::int32_t(2)));
+
+    ZTEST_CHECK(ZVariant("abc") != ZVariant("abd"));
+    ZTEST_CHECK(ZVariant("abc") < ZVariant("abd"));
+    ZTEST_CHECK(!(ZVariant("abd") < ZVariant("abc")));
+    ZTEST_CHECK(ZVariant("ab") < ZVariant("abc"));
+    ZTEST_CHECK(ZVariant(std::string("a\0b", 3)) != ZVariant(std::string("a\0c", 3)));
+    ZTEST_CHECK(consistent(ZVariant("abc"), ZVariant(std::string("abc"))));
+
+    std::set<std::string> names;
+    std::set<ZVariant> variants;
+    std::mt19937 random(6);
+    for(int i = 0; i < 2000; ++i)
+    {
+        std::string name(8, 'a');
+        for(char &c : name) c = static_cast<char>('a' + random() % 4);
+        names.insert(name);
+        variants.insert(ZVariant(name));
+    }
+    ZTEST_CHECK(variants.size() == names.size());
+
+    std::set<std::string>::const_iterator name = names.begin();
+    for(const ZVariant &variant : variants) ZTEST_CHECK(variant.getString() == *name++);
+}
+
+void testTypeRank()
+{
+    /* values of different types order by type, whatever their content */
+    const std::vector<ZVariant> ranked = {
+        ZVariant(),
+        ZVariant(true),
+        ZVariant(std::int8_t(100)),
+        ZVariant(std::int32_t(-5)),
+        ZVariant(std::uint64_t(0)),
+        ZVariant(zfloat64(-1e300)),
+        ZVariant(""),
+        ZVariant(ZVariantList()),
+        ZVariant(ZVariantMap()),
+        ZVariant(ZVariantHashMap()),
+    };
+    for(std::size_t i = 0; i < ranked.size(); ++i)
+    {
+        for(std::size_t j = 0; j < ranked.size(); ++j)
+        {
+            ZTEST_CHECK(consistent(ranked[i], ranked[j]));
+            ZTEST_CHECK((ranked[i].compare(ranked[j]) < 0) == (i < j));
+        }
+    }
+
+    /* equal numbers of different widths are still distinct keys */
+    ZTEST_CHECK(ZVariant(std::int32_t(5)) != ZVariant(std::int64_t(5)));
+    ZTEST_CHECK(ZVariant(std::int32_t(5)) < ZVariant("a"));
+
+    std::set<ZVariant> keys = {ZVariant("b"), ZVariant("a"), ZVariant(std::int32_t(3)), ZVariant(zfloat64(2.5)),
+                               ZVariant(std::numeric_limits<zfloat64>::quiet_NaN())};
+    ZTEST_CHECK(keys.size() == 5);
+}
+
+void testFloats()
+{
+    const zfloat64 nan = std::numeric_limits<zfloat64>::quiet_NaN();
+    const zfloat64 infinity = std::numeric_limits<zfloat64>::infinity();
+
+    /* NaN sorts after every number and equals other NaNs, -0 equals 0 */
+    ZTEST_CHECK(ZVariant(nan) == ZVariant(nan));
+    ZTEST_CHECK(ZVariant(nan) == ZVariant(-nan));
+    ZTEST_CHECK(ZVariant(nan).hash() == ZVariant(-nan).hash());
+    ZTEST_CHECK(ZVariant(infinity) < ZVariant(nan));
+    ZTEST_CHECK(ZVariant(zfloat64(1.0)) < ZVariant(nan));
+    ZTEST_CHECK(!(ZVariant(nan) < ZVariant(-infinity)));
+    ZTEST_CHECK(ZVariant(zfloat64(-0.0)) == ZVariant(zfloat64(0.0)));
+    ZTEST_CHECK(ZVariant(zfloat64(-0.0)).hash() == ZVariant(zfloat64(0.0)).hash());
+    ZTEST_CHECK(ZVariant(zfloat32(-0.0f)) == ZVariant(zfloat32(0.0f)));
+    ZTEST_CHECK(ZVariant(zfloat32(-0.0f)).hash() == ZVariant(zfloat32(0.0f)).hash());
+    ZTEST_CHECK(ZVariant(std::numeric_limits<zfloat32>::max()) < ZVariant(std::numeric_limits<zfloat32>::quiet_NaN()));
+
+    /* equality is exact, not epsilon based */
+    ZTEST_CHECK(ZVariant(zfloat64(0.1 + 0.2)) != ZVariant(zfloat64(0.3)));
+
+    const std::vector<zfloat64> values = {-infinity, -1.5, -0.0, 0.0, 1e-300, 2.0, infinity, nan, -nan};
+    for(zfloat64 a : values)
+    {
+        for(zfloat64 b : values) ZTEST_CHECK(consistent(ZVariant(a), ZVariant(b)));
+    }
+
+    ZVariantMap map;
+    map[ZVariant(nan)] = ZVariant(std::int32_t(1));
+    map[ZVariant(-nan)] = ZVariant(std::int32_t(2));
+    map[ZVariant(zfloat64(0.0))] = ZVariant(std::int32_t(3));
+    map[ZVariant(zfloat64(-0.0))] = ZVariant(std::int32_t(4));
+    ZTEST_CHECK(map.size() == 2);
+}
+
+void testContainers()
+{
+    ZVariant a;
+    ZVariant b;
+    a.addToList(ZVariant(std::int32_t(1)));
+    a.addToList(ZVariant("x"));
+    b.addToList(ZVariant(std::int32_t(1)));
+    b.addToList(ZVariant("y"));
+    ZTEST_CHECK(a < b && !(b < a) && a != b);
+    ZTEST_CHECK(consistent(a, b));
+
+    /* hash maps are equal, and hash equal, whatever their insertion order */
+    ZVariant forward;
+    ZVariant backward;
+    for(std::int32_t i = 0; i < 100; ++i) forward.addToHashMap(ZVariant(i), ZVariant(i * 2));
+    for(std::int32_t i = 99; i >= 0; --i) backward.addToHashMap(ZVariant(i), ZVariant(i * 2));
+    ZTEST_CHECK(forward == backward);
+    ZTEST_CHECK(forward.compare(backward) == 0);
+    ZTEST_CHECK(forward.hash() == backward.hash());
+
+    ZVariant other;
+    for(std::int32_t i = 0; i < 100; ++i) other.addToHashMap(ZVariant(i), ZVariant(i == 5 ? 0 : i * 2));
+    ZTEST_CHECK(forward != other);
+    ZTEST_CHECK(consistent(forward, other));
+
+    /* integer keyed hash maps agree with the order of their key sorted entries */
+    std::mt19937 random(4);
+    for(int round = 0; round < 2000; ++round)
+    {
+        ZIntegerVariantHashMap left;
+        const int count = 1 + static_cast<int>(random() % 8);
+        for(int i = 0; i < count; ++i) left[random() % 12] = ZVariant(std::int32_t(random() % 3));
+        ZIntegerVariantHashMap right(left);
+        if(random() % 2)
+        {
+            const std::uint64_t key = random() % 12;
+            if(right.count(key)) right[key] = ZVariant(std::int32_t(random() % 3));
+        }
+        if(random() % 3 == 0)
+        {
+            right.erase(random() % 12);
+            right[random() % 12] = ZVariant(std::int32_t(1));
+        }
+
+        std::map<std::uint64_t, std::int32_t> leftModel;
+        std::map<std::uint64_t, std::int32_t> rightModel;
+        for(ZIntegerVariantHashMap::const_iterator it = left.cbegin(); it != left.cend(); ++it) leftModel[it.key()] = it.value().getInt32();
+        for(ZIntegerVariantHashMap::const_iterator it = right.cbegin(); it != right.cend(); ++it) rightModel[it.key()] = it.value().getInt32();
+
+        const ZVariant leftVariant(left);
+        const ZVariant rightVariant(right);
+        const std::size_t before = ztest::allocations();
+        const int r = leftVariant.compare(rightVariant);
+        ZTEST_CHECK(ztest::allocations() == before);
+        ZTEST_CHECK((r == 0) == (leftModel == rightModel));
+        ZTEST_CHECK(consistent(leftVariant, rightVariant));
+    }
+}
+
+void testHashInvalidation()
+{
+    /* every mutating accessor drops the cached hash */
+    ZVariant text("abc");
+    const std::size_t textHash = text.hash();
+    text.setString("abd");
+    ZTEST_CHECK(text.hash() != textHash);
+    ZTEST_CHECK(text.hash() == ZVariant("abd").hash());
+    text.setString(std::string("abc"));
+    ZTEST_CHECK(text.hash() == textHash);
+
+    ZVariant list;
+    list.addToList(ZVariant(std::int32_t(1)));
+    const std::size_t listHash = list.hash();
+    ZTEST_CHECK(list.hash() == listHash);
+    list.addToList(ZVariant("z"));
+    ZTEST_CHECK(list.hash() != listHash);
+    ZVariant expected;
+    expected.addToList(ZVariant(std::int32_t(1)));
+    expected.addToList(ZVariant("z"));
+    ZTEST_CHECK(list == expected && list.hash() == expected.hash());
+
+    ZVariant map;
+    map.addToHashMap(ZVariant("key"), ZVariant(std::int32_t(1)));
+    const std::size_t mapHash = map.hash();
+    map.addToHashMap(ZVariant("other"), ZVariant(std::int32_t(2)));
+    ZTEST_CHECK(map.hash() != mapHash);
+
+    ZVariant integers;
+    integers.addToIntVarMap(1, ZVariant(std::int32_t(1)));
+    const std::size_t integersHash = integers.hash();
+    integers.addToIntVarMap(2, ZVariant(std::int32_t(2)));
+    ZTEST_CHECK(integers.hash() != integersHash);
+
+    /* a copy keeps an equal hash and is invalidated independently of its source */
+    ZVariant copy(list);
+    ZTEST_CHECK(copy.hash() == list.hash());
+    copy.addToList(ZVariant(true));
+    ZTEST_CHECK(copy.hash() != list.hash());
+    ZTEST_CHECK(list.hash() == expected.hash());
+}
+
+}
+
+void ztest::testVariantCompare()
+{
+    testStrings();
+    testTypeRank();
+    testFloats();
+    testContainers();
+    testHashInvalidation();
+}
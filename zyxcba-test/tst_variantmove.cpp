@@ -0,0 +1,63 @@
+#include "ztest.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#include <ZVariant>
+
+namespace {
+
+std::atomic<std::size_t> allocationCount(0);
+
+}
+
+void *operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if(void *memory = std::malloc(size ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+std::size_t ztest::allocations()
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+void ztest::testVariantMove()
+{
+    using zyxcba::ZVariant;
+
+    ZVariant nested;
+    nested.setList();
+    for(std::int32_t i = 0; i < 1000; ++i)
+    {
+        ZVariant inner;
+        for(std::int32_t j = 0; j < 1000; ++j)
+            inner.addToList(i * 1000 + j);
+        nested.addToList(std::move(inner));
+    }
+    ZTEST_CHECK(nested.listLength() == 1000);
+
+    std::size_t before = ztest::allocations();
+    ZVariant moved(std::move(nested));
+    ZVariant assigned;
+    assigned = std::move(moved);
+    std::size_t after = ztest::allocations();
+
+    ZTEST_CHECK(after == before);
+    ZTEST_CHECK(assigned.isList());
+    ZTEST_CHECK(assigned.listLength() == 1000);
+    ZTEST_CHECK(assigned.getList()[999].listLength() == 1000);
+    ZTEST_CHECK(assigned.getList()[999].getList()[999].getInt32() == 999999);
+
+    ZTEST_CHECK(std::is_nothrow_move_constructible<ZVariant>::value);
+    ZTEST_CHECK(std::is_nothrow_move_assignable<ZVariant>::value);
+}
@@ -0,0 +1,248 @@
+#include "ztest.h"
+
+#include <memory>
+#include <random>
+#include <string>
+
+#include <ZVariantSerializer>
+#include <ZVariantView>
+
+namespace {
+
+using namespace zyxcba;
+
+ZVariant randomVariant(std::mt19937_64 &random, int depth)
+{
+    switch(random() % (depth > 3 ? 13 : 23))
+    {
+    case 0: return ZVariant();
+    case 1: return ZVariant(bool(random() & 1));
+    case 2: return ZVariant(std::int8_t(random()));
+    case 3: return ZVariant(std::int16_t(random()));
+    case 4: return ZVariant(std::int32_t(random()));
+    case 5: return ZVariant(std::int64_t(random()));
+    case 6: return ZVariant(std::uint8_t(random()));
+    case 7: return ZVariant(std::uint16_t(random()));
+    case 8: return ZVariant(std::uint32_t(random()));
+    case 9: return ZVariant(std::uint64_t(random()));
+    case 10: return ZVariant(zfloat32(random() % 1000) / 7.0f);
+    case 11: return ZVariant(zfloat64(random() % 100000) / 3.0);
+    case 12: return ZVariant(std::string(random() % 40, char('a' + random() % 26)));
+    case 13:
+    {
+        ZVariant variant;
+        variant.setList();
+        for(std::uint64_t i = random() % 6; i > 0; --i)
+            variant.addToList(randomVariant(random, depth + 1));
+        return variant;
+    }
+    case 14:
+    {
+        ZVariant variant;
+        variant.setMap();
+        for(std::uint64_t i = random() % 6; i > 0; --i)
+            variant.addToMap(randomVariant(random, depth + 1), randomVariant(random, depth + 1));
+        return variant;
+    }
+    case 15:
+    {
+        ZVariant variant;
+        variant.setIntVarMap();
+        for(std::uint64_t i = random() % 6; i > 0; --i)
+            variant.addToIntVarMap(random(), randomVariant(random, depth + 1));
+        return variant;
+    }
+    case 16:
+    {
+        ZVariant variant;
+        variant.setHashMap();
+        for(std::uint64_t i = random() % 6; i > 0; --i)
+            variant.addToHashMap(randomVariant(random, depth + 1), randomVariant(random, depth + 1));
+        return variant;
+    }
+    case 17:
+    {
+        ZVariant variant;
+        variant.setIntegerHashMap();
+        for(std::uint64_t i = random() % 6; i > 0; --i)
+            variant.addToIntegerHashMap(random() % 1000, randomVariant(random, depth + 1));
+        return variant;
+    }
+    case 18:
+    {
+        ZVariant variant;
+        for(std::uint64_t i = 1 + random() % 20; i > 0; --i)
+            variant.addToArray(std::int32_t(random()));
+        return variant;
+    }
+    case 19:
+    {
+        ZVariant variant;
+        for(std::uint64_t i = 1 + random() % 20; i > 0; --i)
+            variant.addToArray(std::int64_t(random()));
+        return variant;
+    }
+    case 20:
+    {
+        ZVariant variant;
+        for(std::uint64_t i = 1 + random() % 20; i > 0; --i)
+            variant.addToArray(std::uint8_t(random()));
+        return variant;
+    }
+    case 21:
+    {
+        ZVariant variant;
+        for(std::uint64_t i = 1 + random() % 20; i > 0; --i)
+            variant.addToArray(zfloat32(random() % 1000) / 3.0f);
+        return variant;
+    }
+    default:
+    {
+        ZVariant variant;
+        for(std::uint64_t i = 1 + random() % 20; i > 0; --i)
+            variant.addToArray(zfloat64(random() % 100000) / 7.0);
+        return variant;
+    }
+    }
+}
+
+/* a view over a truncated buffer reads what survived the cut, or None and zero, never more */
+void checkTruncatedView(const ZVariantView &truncated, const ZVariantView &full, int depth)
+{
+    if(truncated.isWellFormed())
+    {
+        ZTEST_CHECK(truncated.encoded() == full.encoded());
+    }
+    else
+    {
+        ZTEST_CHECK(truncated.encodedSize() == 0);
+        ZVariant variant;
+        ZTEST_CHECK(!truncated.toVariant(variant));
+    }
+
+    if(truncated.isNone()) return;
+    ZTEST_CHECK(truncated.variantType() == full.variantType());
+
+    ZTEST_CHECK(truncated.getBool() == full.getBool() || !truncated.getBool());
+    ZTEST_CHECK(truncated.getInt64() == full.getInt64() || truncated.getInt64() == 0);
+    ZTEST_CHECK(truncated.getUInt64() == full.getUInt64() || truncated.getUInt64() == 0);
+    ZTEST_CHECK(truncated.getInt32() == full.getInt32() || truncated.getInt32() == 0);
+    ZTEST_CHECK(truncated.getUInt16() == full.getUInt16() || truncated.getUInt16() == 0);
+    ZTEST_CHECK(truncated.getInt8() == full.getInt8() || truncated.getInt8() == 0);
+    ZTEST_CHECK(truncated.getFloat32() == full.getFloat32() || truncated.getFloat32() == 0);
+    ZTEST_CHECK(truncated.getFloat64() == full.getFloat64() || truncated.getFloat64() == 0);
+    ZTEST_CHECK(truncated.getNumber() == full.getNumber() || truncated.getNumber() == 0);
+    ZTEST_CHECK(truncated.getString() == full.getString() || truncated.getString().size() == 0);
+    ZTEST_CHECK(truncated.getArrayBytes() == full.getArrayBytes() || truncated.getArrayBytes().size() == 0);
+
+    const std::uint64_t length = full.getLength();
+    ZTEST_CHECK(truncated.getLength() == length || truncated.getLength() == 0);
+    if(truncated.isArray())
+    {
+        for(std::uint64_t i = 0; i <= length; ++i)
+            ZTEST_CHECK(truncated.numberAt(i) == full.numberAt(i) || truncated.numberAt(i) == 0);
+    }
+    if(depth > 3) return;
+
+    for(std::uint64_t i = 0; i <= length; ++i)
+    {
+        if(truncated.isList())
+        {
+            checkTruncatedView(truncated.at(i), full.at(i), depth + 1);
+            continue;
+        }
+
+        checkTruncatedView(truncated.valueAt(i), full.valueAt(i), depth + 1);
+        if(truncated.isIntVarMap() || truncated.isIntegerHashMap())
+        {
+            const std::uint64_t key = full.integerKeyAt(i);
+            ZTEST_CHECK(truncated.integerKeyAt(i) == key || truncated.integerKeyAt(i) == 0);
+            checkTruncatedView(truncated.find(key), full.find(key), depth + 1);
+        }
+        else if(truncated.isMap() || truncated.isHashMap())
+        {
+            checkTruncatedView(truncated.keyAt(i), full.keyAt(i), depth + 1);
+            ZVariant key;
+            if(full.keyAt(i).toVariant(key))
+            {
+                checkTruncatedView(truncated.find(key), full.find(key), depth + 1);
+                if(key.isString()) checkTruncatedView(truncated.find(key.getString()), full.find(key.getString()), depth + 1);
+            }
+        }
+    }
+}
+
+}
+
+void ztest::testVariantSerializer()
+{
+    std::mt19937_64 random(8);
+
+    for(int round = 0; round < 2000; ++round)
+    {
+        ZVariant variant = randomVariant(random, 0);
+        std::string buffer;
+        ZStringSink sink(buffer);
+        ZTEST_CHECK(ZVariantSerializer::serialize(variant, sink));
+
+        ZMemorySource source(buffer);
+        ZVariant decoded;
+        ZTEST_CHECK(ZVariantSerializer::deserialize(source, decoded));
+        ZTEST_CHECK(source.remaining() == 0);
+        ZTEST_CHECK(decoded == variant);
+
+        // every strict prefix is truncated input and has to be rejected without output
+        for(std::size_t cut = 0; cut < buffer.size(); ++cut)
+        {
+            ZMemorySource truncated(buffer.data(), cut);
+            ZVariant partial;
+            ZTEST_CHECK(!ZVariantSerializer::deserialize(truncated, partial));
+            ZTEST_CHECK(partial.isNone());
+
+            // the same prefix read in place, copied so reading past the cut is out of bounds
+            std::unique_ptr<char[]> prefix(new char[cut]);
+            buffer.copy(prefix.get(), cut);
+            const ZVariantView view(prefix.get(), cut);
+            ZTEST_CHECK(!view.isWellFormed());
+            checkTruncatedView(view, ZVariantView(buffer), 0);
+        }
+
+        // flipped bits either decode to something or fail, but never read out of bounds
+        for(int flip = 0; flip < 4 && !buffer.empty(); ++flip)
+        {
+            std::string corrupted(buffer);
+            corrupted[random() % corrupted.size()] ^= char(1u << (random() % 8));
+            ZMemorySource corruptedSource(corrupted);
+            ZVariant ignored;
+            if(ZVariantSerializer::deserialize(corruptedSource, ignored))
+                ZTEST_CHECK(corruptedSource.offset() <= corrupted.size());
+        }
+    }
+
+    // oversized counts and overlong varints are malformed, not allocation requests
+    const char hugeList[] = { char(ZVariantType::List), '\xff', '\xff', '\xff', '\xff', '\xff', '\xff', '\xff', '\xff', '\x7f' };
+    ZMemorySource hugeSource(hugeList, sizeof(hugeList));
+    ZVariant huge;
+    ZTEST_CHECK(!ZVariantSerializer::deserialize(hugeSource, huge));
+
+    const char overlong[] = { char(ZVariantType::String), '\xff', '\xff', '\xff', '\xff', '\xff', '\xff', '\xff', '\xff', '\xff', '\xff', '\x01' };
+    ZMemorySource overlongSource(overlong, sizeof(overlong));
+    ZVariant text;
+    ZTEST_CHECK(!ZVariantSerializer::deserialize(overlongSource, text));
+
+    std::string nested;
+    for(std::size_t depth = 0; depth < 100; ++depth)
+        nested.append({ char(ZVariantType::List), '\x01' });
+    nested.push_back(char(ZVariantType::None));
+    ZMemorySource nestedSource(nested);
+    ZVariant shallow;
+    ZTEST_CHECK(ZVariantSerializer::deserialize(nestedSource, shallow));
+
+    std::string deep;
+    for(std::size_t depth = 0; depth <= ZVariantSerializer::MaxDepth; ++depth)
+        deep.append({ char(ZVariantType::List), '\x01' });
+    deep.push_back(char(ZVariantType::None));
+    ZMemorySource deepSource(deep);
+    ZVariant tooDeep;
+    ZTEST_CHECK(!ZVariantSerializer::deserialize(deepSource, tooDeep));
+}
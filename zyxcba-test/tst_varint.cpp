@@ -0,0 +1,248 @@
+#include "ztest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <ZVarint>
+
+namespace {
+
+using namespace zyxcba;
+
+/* the plain decodeVarint() loop decodeVarints() has to agree with */
+template<typename T>
+const char *decodeVarintsLoop(const char *source, const char *end, T *values, const std::size_t &count)
+{
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        std::uint64_t value;
+        source = ZVarint::decodeVarint(source, end, value);
+        if(source == nullptr || value > std::numeric_limits<T>::max()) return nullptr;
+        values[i] = static_cast<T>(value);
+    }
+    return source;
+}
+
+std::vector<std::uint64_t> boundaryValues()
+{
+    /* both sides of every power of two, which covers every size boundary of each codec */
+    std::vector<std::uint64_t> values = {0, std::numeric_limits<std::uint64_t>::max()};
+    for(unsigned bits = 1; bits < 64; ++bits)
+    {
+        const std::uint64_t power = static_cast<std::uint64_t>(1) << bits;
+        values.push_back(power - 1);
+        values.push_back(power);
+        values.push_back(power + 1);
+    }
+    return values;
+}
+
+unsigned significantBits(const std::uint64_t &value)
+{
+    unsigned bits = 1;
+    while(bits < 64 && (value >> bits) != 0) ++bits;
+    return bits;
+}
+
+void testLeb128()
+{
+    for(std::uint64_t value : boundaryValues())
+    {
+        const std::size_t expected = (significantBits(value) + 6) / 7;
+        char buffer[ZVarint::MaxVarintSize];
+        char *end = ZVarint::encodeVarint(value, buffer);
+        ZTEST_CHECK(static_cast<std::size_t>(end - buffer) == expected);
+        ZTEST_CHECK(ZVarint::varintSize(value) == expected);
+
+        std::uint64_t decoded = ~value;
+        ZTEST_CHECK(ZVarint::decodeVarint(buffer, end, decoded) == end);
+        ZTEST_CHECK(decoded == value);
+
+        /* every strict prefix is truncated */
+        for(char *cut = buffer; cut < end; ++cut) ZTEST_CHECK(ZVarint::decodeVarint(buffer, cut, decoded) == nullptr);
+
+        const std::int64_t signedValues[] = {static_cast<std::int64_t>(value), -static_cast<std::int64_t>(value >> 1)};
+        for(std::int64_t signedValue : signedValues)
+        {
+            end = ZVarint::encodeSignedVarint(signedValue, buffer);
+            std::int64_t signedDecoded;
+            ZTEST_CHECK(ZVarint::decodeSignedVarint(buffer, end, signedDecoded) == end);
+            ZTEST_CHECK(signedDecoded == signedValue);
+        }
+    }
+
+    ZTEST_CHECK(ZVarint::zigzagEncode(-1) == 1);
+    ZTEST_CHECK(ZVarint::zigzagEncode(1) == 2);
+    ZTEST_CHECK(ZVarint::zigzagEncode(std::numeric_limits<std::int64_t>::min()) == std::numeric_limits<std::uint64_t>::max());
+
+    /* the tenth byte carries only bit 63, anything above 1 overflows */
+    char overflow[11];
+    std::memset(overflow, '\xff', 9);
+    std::uint64_t decoded;
+    for(unsigned last = 0; last < 0x80; ++last)
+    {
+        overflow[9] = static_cast<char>(last);
+        const char *end = ZVarint::decodeVarint(overflow, overflow + 10, decoded);
+        ZTEST_CHECK((end != nullptr) == (last <= 1));
+        if(end) ZTEST_CHECK(decoded == (last ? std::numeric_limits<std::uint64_t>::max() : std::numeric_limits<std::uint64_t>::max() >> 1));
+    }
+
+    /* and no varint has an eleventh byte */
+    overflow[9] = '\x81';
+    overflow[10] = 0;
+    ZTEST_CHECK(ZVarint::decodeVarint(overflow, overflow + 11, decoded) == nullptr);
+    ZTEST_CHECK(ZVarint::decodeVarint(overflow, overflow, decoded) == nullptr);
+}
+
+void testPrefixVarint()
+{
+    for(std::uint64_t value : boundaryValues())
+    {
+        const unsigned bits = significantBits(value);
+        const std::size_t expected = bits > 56 ? 9 : (bits + 6) / 7;
+        char buffer[ZVarint::MaxPrefixVarintSize];
+        char *end = ZVarint::encodePrefixVarint(value, buffer);
+        ZTEST_CHECK(static_cast<std::size_t>(end - buffer) == expected);
+        ZTEST_CHECK(ZVarint::prefixVarintSize(value) == expected);
+
+        /* the short input path copies, the long one loads eight bytes at once */
+        std::uint64_t decoded = ~value;
+        ZTEST_CHECK(ZVarint::decodePrefixVarint(buffer, end, decoded) == end);
+        ZTEST_CHECK(decoded == value);
+
+        char padded[32];
+        std::memset(padded, '\x55', sizeof(padded));
+        std::memcpy(padded, buffer, expected);
+        decoded = ~value;
+        ZTEST_CHECK(ZVarint::decodePrefixVarint(padded, padded + sizeof(padded), decoded) == padded + expected);
+        ZTEST_CHECK(decoded == value);
+
+        for(char *cut = buffer; cut < end; ++cut) ZTEST_CHECK(ZVarint::decodePrefixVarint(buffer, cut, decoded) == nullptr);
+    }
+}
+
+void testStreamVByte()
+{
+    std::mt19937_64 random(15);
+
+    /* the byte length boundaries of a 32 bit value in every lane of a block */
+    const std::uint32_t boundaries[] = {0, 0xff, 0x100, 0xffff, 0x10000, 0xffffff, 0x1000000, 0xffffffff};
+    std::vector<std::uint32_t> values;
+    for(std::uint32_t a : boundaries)
+    {
+        for(std::uint32_t b : boundaries)
+        {
+            values.push_back(a);
+            values.push_back(b);
+            values.push_back(b);
+            values.push_back(a);
+        }
+    }
+
+    for(std::size_t count = 0; count <= 300; ++count)
+    {
+        for(int mode = 0; mode < 4; ++mode)
+        {
+            std::vector<std::uint32_t> input(count);
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                switch(mode)
+                {
+                case 0: input[i] = values[(i + count) % values.size()]; break;
+                case 1: input[i] = static_cast<std::uint32_t>(random() % 200); break;
+                case 2: input[i] = static_cast<std::uint32_t>(random() >> (32 + random() % 32)); break;
+                default: input[i] = static_cast<std::uint32_t>(random()); break;
+                }
+            }
+
+            std::vector<char> buffer(ZVarint::streamVByteMaxSize(count) + 1);
+            const std::size_t size = ZVarint::encodeStreamVByte(input.data(), count, buffer.data());
+            ZTEST_CHECK(size <= ZVarint::streamVByteMaxSize(count));
+
+            /* an exact size copy, so a read past the end is out of bounds under ASan */
+            std::vector<char> exact(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(size));
+            const char *begin = exact.data();
+            const char *end = begin + size;
+            std::vector<std::uint32_t> fast(count + 1);
+            std::vector<std::uint32_t> scalar(count + 1);
+            ZTEST_CHECK(ZVarint::decodeStreamVByte(begin, end, fast.data(), count) == end);
+            ZTEST_CHECK(ZVarint::decodeStreamVByteScalar(begin, end, scalar.data(), count) == end);
+            ZTEST_CHECK(std::equal(input.begin(), input.end(), fast.begin()));
+            ZTEST_CHECK(std::equal(input.begin(), input.end(), scalar.begin()));
+
+            if(count != 0)
+            {
+                ZTEST_CHECK(ZVarint::decodeStreamVByte(begin, end - 1, fast.data(), count) == nullptr);
+                ZTEST_CHECK(ZVarint::decodeStreamVByteScalar(begin, end - 1, scalar.data(), count) == nullptr);
+                const std::size_t cut = static_cast<std::size_t>(random() % size);
+                ZTEST_CHECK(ZVarint::decodeStreamVByte(begin, begin + cut, fast.data(), count) == nullptr);
+                ZTEST_CHECK(ZVarint::decodeStreamVByteScalar(begin, begin + cut, scalar.data(), count) == nullptr);
+            }
+        }
+    }
+}
+
+void testDecodeVarints()
+{
+    std::mt19937_64 random(16);
+    for(std::size_t count = 0; count <= 300; ++count)
+    {
+        /* mostly single byte values, so the eight at a time path is taken and left again */
+        std::vector<std::uint64_t> input(count);
+        for(std::uint64_t &value : input)
+        {
+            value = random() % 4 == 0 ? random() >> (random() % 64) : random() % 128;
+        }
+
+        std::vector<char> buffer(count * ZVarint::MaxVarintSize + 1);
+        char *end = buffer.data();
+        for(std::uint64_t value : input) end = ZVarint::encodeVarint(value, end);
+        const char *begin = buffer.data();
+
+        std::vector<std::uint64_t> bulk(count + 1);
+        std::vector<std::uint64_t> loop(count + 1);
+        ZTEST_CHECK(ZVarint::decodeVarints(begin, end, bulk.data(), count) == end);
+        ZTEST_CHECK(decodeVarintsLoop(begin, end, loop.data(), count) == end);
+        ZTEST_CHECK(std::equal(input.begin(), input.end(), bulk.begin()));
+        ZTEST_CHECK(std::equal(input.begin(), input.end(), loop.begin()));
+
+        /* the 32 bit overload rejects what does not fit, like the loop */
+        std::vector<std::uint32_t> bulk32(count + 1);
+        std::vector<std::uint32_t> loop32(count + 1);
+        const char *bulkEnd = ZVarint::decodeVarints(begin, end, bulk32.data(), count);
+        ZTEST_CHECK(bulkEnd == decodeVarintsLoop(begin, end, loop32.data(), count));
+        if(bulkEnd) ZTEST_CHECK(std::equal(bulk32.begin(), bulk32.begin() + static_cast<std::ptrdiff_t>(count), loop32.begin()));
+
+        if(count == 0) continue;
+        ZTEST_CHECK(ZVarint::decodeVarints(begin, end - 1, bulk.data(), count) == nullptr);
+        const char *cut = begin + random() % static_cast<std::size_t>(end - begin);
+        ZTEST_CHECK(ZVarint::decodeVarints(begin, cut, bulk.data(), count) == decodeVarintsLoop(begin, cut, loop.data(), count));
+
+        /* an overlong varint in the middle of a run of single byte values */
+        std::vector<char> invalid(begin, static_cast<const char*>(end));
+        const std::size_t at = static_cast<std::size_t>(random() % invalid.size());
+        invalid.insert(invalid.begin() + static_cast<std::ptrdiff_t>(at), 10, '\xff');
+        ZTEST_CHECK(ZVarint::decodeVarints(invalid.data(), invalid.data() + invalid.size(), bulk.data(), count)
+                    == decodeVarintsLoop(invalid.data(), invalid.data() + invalid.size(), loop.data(), count));
+    }
+
+    char large[ZVarint::MaxVarintSize];
+    char *end = ZVarint::encodeVarint(static_cast<std::uint64_t>(1) << 40, large);
+    std::uint32_t narrow;
+    ZTEST_CHECK(ZVarint::decodeVarints(large, end, &narrow, 1) == nullptr);
+}
+
+}
+
+void ztest::testVarint()
+{
+    testLeb128();
+    testPrefixVarint();
+    testStreamVByte();
+    testDecodeVarints();
+}
@@ -0,0 +1,36 @@
+#ifndef ZTEST_H
+#define ZTEST_H
+
+#include <cstddef>
+
+namespace ztest {
+
+void fail(const char *file, int line, const char *expression);
+int failures();
+
+std::size_t allocations();
+
+void testVariantMove();
+void testVariantSerializer();
+void testBulkByteSwap();
+void testHash();
+void testChecksum();
+void testTrace();
+void testHashMap();
+void testVariantCompare();
+void testSnapshot();
+void testVarint();
+void testByteReader();
+void testBufferChain();
+void testTypedArray();
+void testNestedMap();
+void testRadixTree();
+void testConcurrentNestedMap();
+void testPersistentNestedMap();
+
+}
+
+#define ZTEST_CHECK(condition) \
+    do { if(!(condition)) ztest::fail(__FILE__, __LINE__, #condition); } while(false)
+
+#endif // ZTEST_H
@@ -1,5 +1,5 @@
 TEMPLATE = app
-CONFIG += console c++11
+CONFIG += console c++11 thread
 CONFIG -= app_bundle
 CONFIG -= qt
 
@@ -7,5 +7,24 @@ DEFINES += ZYXCBA_DEBUG
 
 include(../src/zyxcba.pri)
 
+HEADERS += \
+        ztest.h
+
 SOURCES += \
-        main.cpp
+        main.cpp \
+        tst_variantmove.cpp \
+        tst_variantserializer.cpp \
+        tst_bulkbyteswap.cpp \
+        tst_hash.cpp \
+        tst_trace.cpp \
+        tst_hashmap.cpp \
+        tst_variantcompare.cpp \
+        tst_snapshot.cpp \
+        tst_varint.cpp \
+        tst_bytereader.cpp \
+        tst_bufferchain.cpp \
+        tst_typedarray.cpp \
+        tst_nestedmap.cpp \
+        tst_radixtree.cpp \
+        tst_concurrentnestedmap.cpp \
+        tst_persistentnestedmap.cpp